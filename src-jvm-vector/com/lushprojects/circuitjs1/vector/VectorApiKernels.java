@@ -0,0 +1,182 @@
+/*
+    Copyright (C) Paul Falstad and Iain Sharp
+
+    This file is part of CircuitJS1.
+*/
+
+package com.lushprojects.circuitjs1.vector;
+
+import com.lushprojects.circuitjs1.client.core.NumericKernels;
+
+import jdk.incubator.vector.DoubleVector;
+import jdk.incubator.vector.VectorMask;
+import jdk.incubator.vector.VectorOperators;
+import jdk.incubator.vector.VectorSpecies;
+
+/**
+ * {@link NumericKernels} on the incubating Vector API, using the widest
+ * double species the CPU offers. Short runs fall through to the scalar
+ * loops, where lane setup would cost more than it saves.
+ *
+ * Built only on JDK 17+ from this separate source directory (never by GWT
+ * or the main source set) and loaded by name from the JVM runner.
+ */
+public final class VectorApiKernels extends NumericKernels {
+
+    private static final VectorSpecies<Double> SPECIES = DoubleVector.SPECIES_PREFERRED;
+    private static final int LANES = SPECIES.length();
+    private static final int MIN_LENGTH = 2 * LANES;
+    private static final int[] EVEN = new int[LANES];
+    private static final int[] ODD = new int[LANES];
+
+    static {
+        for (int i = 0; i < LANES; i++) {
+            EVEN[i] = 2 * i;
+            ODD[i] = 2 * i + 1;
+        }
+    }
+
+    public VectorApiKernels() {
+    }
+
+    @Override
+    public boolean isAccelerated() {
+        return true;
+    }
+
+    @Override
+    public String getName() {
+        return "vector-" + SPECIES.vectorBitSize() + "bit";
+    }
+
+    @Override
+    public double dotSubtract(double init, double[] a, int aOff, double[] b, int bOff, int len) {
+        if (len < MIN_LENGTH) {
+            return super.dotSubtract(init, a, aOff, b, bOff, len);
+        }
+        DoubleVector acc = DoubleVector.zero(SPECIES);
+        int upper = SPECIES.loopBound(len);
+        int k = 0;
+        for (; k < upper; k += LANES) {
+            DoubleVector va = DoubleVector.fromArray(SPECIES, a, aOff + k);
+            DoubleVector vb = DoubleVector.fromArray(SPECIES, b, bOff + k);
+            acc = va.fma(vb, acc);
+        }
+        double sum = acc.reduceLanes(VectorOperators.ADD);
+        for (; k < len; k++) {
+            sum += a[aOff + k] * b[bOff + k];
+        }
+        return init - sum;
+    }
+
+    @Override
+    public void subtractScaled(double[] y, int yOff, double alpha, double[] x, int xOff, int len) {
+        if (len < MIN_LENGTH) {
+            super.subtractScaled(y, yOff, alpha, x, xOff, len);
+            return;
+        }
+        DoubleVector scale = DoubleVector.broadcast(SPECIES, alpha);
+        int upper = SPECIES.loopBound(len);
+        int k = 0;
+        for (; k < upper; k += LANES) {
+            DoubleVector vy = DoubleVector.fromArray(SPECIES, y, yOff + k);
+            DoubleVector vx = DoubleVector.fromArray(SPECIES, x, xOff + k);
+            vy.sub(vx.mul(scale)).intoArray(y, yOff + k);
+        }
+        for (; k < len; k++) {
+            y[yOff + k] -= alpha * x[xOff + k];
+        }
+    }
+
+    @Override
+    public int pairwiseMinMax(double[] min, double[] max, int size) {
+        int half = size / 2;
+        if (half < MIN_LENGTH) {
+            return super.pairwiseMinMax(min, max, size);
+        }
+        // each block reads [2i, 2i + 2*LANES) before writing [i, i + LANES),
+        // and later blocks only read beyond what has been written
+        int upper = SPECIES.loopBound(half);
+        int i = 0;
+        for (; i < upper; i += LANES) {
+            DoubleVector lo = DoubleVector.fromArray(SPECIES, min, 2 * i, EVEN, 0);
+            DoubleVector lo2 = DoubleVector.fromArray(SPECIES, min, 2 * i, ODD, 0);
+            DoubleVector hi = DoubleVector.fromArray(SPECIES, max, 2 * i, EVEN, 0);
+            DoubleVector hi2 = DoubleVector.fromArray(SPECIES, max, 2 * i, ODD, 0);
+            lo.min(lo2).intoArray(min, i);
+            hi.max(hi2).intoArray(max, i);
+        }
+        for (; i < half; i++) {
+            min[i] = Math.min(min[2 * i], min[2 * i + 1]);
+            max[i] = Math.max(max[2 * i], max[2 * i + 1]);
+        }
+        if ((size & 1) != 0) {
+            min[half] = min[size - 1];
+            max[half] = max[size - 1];
+            half++;
+        }
+        return half;
+    }
+
+    /**
+     * The segment search stays scalar (it is a data-dependent walk); the
+     * interpolation arithmetic is gathered and done a vector at a time with
+     * the same operation order, so values match the scalar path exactly.
+     */
+    @Override
+    public void interpolate(double[] xs, double[] ys, int n, double[] x, double[] out, int count, boolean clamp) {
+        if (n < 2 || count < MIN_LENGTH) {
+            super.interpolate(xs, ys, n, x, out, count, clamp);
+            return;
+        }
+        int[] seg = new int[count];
+        boolean[] pending = new boolean[count];
+        for (int i = 0; i < count; i++) {
+            double xi = x[i];
+            if (xi < xs[0]) {
+                if (clamp) {
+                    out[i] = ys[0];
+                    continue;
+                }
+                seg[i] = 0;
+            } else {
+                int j = 1;
+                while (j < n && !(xi < xs[j])) {
+                    j++;
+                }
+                if (j < n) {
+                    seg[i] = j - 1;
+                } else if (clamp) {
+                    out[i] = ys[n - 1];
+                    continue;
+                } else {
+                    seg[i] = n - 2;
+                }
+            }
+            pending[i] = true;
+        }
+
+        int upper = SPECIES.loopBound(count);
+        int i = 0;
+        for (; i < upper; i += LANES) {
+            VectorMask<Double> todo = VectorMask.fromArray(SPECIES, pending, i);
+            if (!todo.anyTrue()) {
+                continue;
+            }
+            DoubleVector x0 = DoubleVector.fromArray(SPECIES, xs, 0, seg, i);
+            DoubleVector x1 = DoubleVector.fromArray(SPECIES, xs, 1, seg, i);
+            DoubleVector y0 = DoubleVector.fromArray(SPECIES, ys, 0, seg, i);
+            DoubleVector y1 = DoubleVector.fromArray(SPECIES, ys, 1, seg, i);
+            DoubleVector dx = x1.sub(x0);
+            DoubleVector v = DoubleVector.fromArray(SPECIES, x, i).sub(x0).mul(y1.sub(y0)).div(dx).add(y0);
+            v = v.blend(y0, dx.abs().compare(VectorOperators.LT, 1e-12));
+            v.intoArray(out, i, todo);
+        }
+        for (; i < count; i++) {
+            if (pending[i]) {
+                int s = seg[i];
+                out[i] = linear(x[i], xs[s], ys[s], xs[s + 1], ys[s + 1]);
+            }
+        }
+    }
+}
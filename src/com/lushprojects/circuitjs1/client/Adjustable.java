@@ -160,15 +160,10 @@ public class Adjustable implements Command {
     }
     
     private void executeSlider() {
-	// For non-linear elements, trigger full circuit analysis
-	// For linear elements, skip analysis - matrix coefficients update on next stamp
-	// if (elm.nonLinear()) {
-	    elm.sim.analyzeFlag = true;
-	// }
-	
+	// parameter-only edits patch the stamped matrix; everything else re-analyzes
 	EditInfo ei = elm.getEditInfo(editItem);
 	ei.value = getSliderValue();
-	elm.setEditValue(editItem, ei);
+	elm.sim.getCircuitAnalyzer().applyParameterEdit(elm, editItem, ei);
 	
 	// Update label to show current value
 	if (label != null) {
@@ -75,6 +75,7 @@ import com.lushprojects.circuitjs1.client.core.CircuitNode;
 import com.lushprojects.circuitjs1.client.core.SimulationContext;
 import com.lushprojects.circuitjs1.client.core.SimulationTimingState;
 import com.lushprojects.circuitjs1.client.core.SolverMatrixState;
+import com.lushprojects.circuitjs1.client.io.CompactCircuitCodec;
 import com.lushprojects.circuitjs1.client.io.ImportExportHelper;
 import com.lushprojects.circuitjs1.client.io.LoadFile;
 import com.lushprojects.circuitjs1.client.io.ClipboardManager;
@@ -503,6 +504,13 @@ public class CirSim implements ConfigProvider, ConsoleLogger {
 	// Experimental: Broyden quasi-Newton updates for EquationTable Jacobians.
 	public boolean equationTableBroydenJacobianEnabled = false;
 
+	// Experimental: Anderson acceleration of non-MNA equation table subiterations.
+	public boolean equationTableAndersonAccelerationEnabled = false;
+
+	// Reuse recent LU factorizations of linear circuits (timestep toggles,
+	// slider values seen before) and low-rank updates for small changes.
+	public boolean luFactorCacheEnabled = true;
+
 	// Global base convergence tolerance used by all EquationTableElm instances
     private double equationTableConvergenceTolerance = 0.001;
 
@@ -520,6 +528,9 @@ public class CirSim implements ConfigProvider, ConsoleLogger {
 
 	// When true, auto-open model info viewer after loading SFCR with info content
 	public boolean autoOpenModelInfoOnLoad = true;
+
+	// When true, undo snapshots and stored clipboard use the compact binary dump encoding
+	public boolean compactInternalDumps = true;
 	
 	// Circuit hint types - show helpful formulas when related elements are present
 	static final int HINT_LC = 1;      // LC resonant frequency hint
@@ -567,6 +578,8 @@ public class CirSim implements ConfigProvider, ConsoleLogger {
     boolean hideInfoBox;
     int scopeColCount[];
     boolean isExporting; // flag to indicate we're exporting an image
+    private boolean headlessPrintable;
+    private boolean headlessShowValues;
     // Class dumpTypes[], shortcuts[];
     String shortcuts[];
     String clipboard;
@@ -635,6 +648,16 @@ public class CirSim implements ConfigProvider, ConsoleLogger {
 		return decompressUri(dump);
 	}
 
+	// Decode a "cjb=" URL parameter (compact binary dump, base64url).
+	String decodeCompactUrlDump(String value) {
+		try {
+			return CompactCircuitCodec.decodeFromBase64Url(value);
+		} catch (IllegalArgumentException e) {
+			console("Invalid cjb circuit data: " + e.getMessage());
+			return null;
+		}
+	}
+
 //    Circuit applet;
 
 
@@ -672,6 +695,7 @@ public CirSim() {
 	private final ExportCompositeActions exportCompositeActions = new ExportCompositeActions(this);
 	private final CircuitValueSlotManager circuitValueSlotManager = new CircuitValueSlotManager(this);
 	private final VariableHistoryStore variableHistoryStore = new VariableHistoryStore();
+	private final VariableCatalog variableCatalog = new VariableCatalog(this);
 	private final JsApiBridge jsApiBridge = new JsApiBridge(this);
 	private final CirSimPreferencesManager preferencesManager = new CirSimPreferencesManager(this);
 	private final TableMasterRegistryManager tableMasterRegistryManager = new TableMasterRegistryManager(this);
@@ -679,6 +703,7 @@ public CirSim() {
 	private final CirSimPlatformInterop platformInterop = new CirSimPlatformInterop(this);
 	private final CirSimBootstrap bootstrap = new CirSimBootstrap(this);
 	private final CirSimDiagnostics diagnostics = new CirSimDiagnostics(this);
+	private final CircuitLoadPipeline circuitLoadPipeline = new CircuitLoadPipeline();
 
 	MouseInputHandler getMouseInputHandler() {
 	    return mouseInputHandler;
@@ -778,10 +803,19 @@ public CirSim() {
 	    return circuitIOService;
 	}
 
+	public CircuitLoadPipeline getCircuitLoadPipeline() {
+	    return circuitLoadPipeline;
+	}
+
 	public void readCircuitFromModel(String circuitText) {
 	    circuitIOService.readCircuit(circuitText);
 	}
 
+	/** Like readCircuitFromModel, but large texts load over several frames; onLoaded runs when done. */
+	public void readCircuitFromModelIncremental(String circuitText, Command onLoaded) {
+	    circuitIOService.readCircuitIncremental(circuitText, 0, onLoaded);
+	}
+
     public String dumpCircuit() {
 	    return circuitIOService.dumpCircuit();
 	}
@@ -822,6 +856,10 @@ public CirSim() {
 	    getCircuitIOService().readCircuit(circuitText, flags);
 	}
 
+	public void readCircuitFromImportHelperIncremental(String circuitText, int flags, Command onLoaded) {
+	    getCircuitIOService().readCircuitIncremental(circuitText, flags, onLoaded);
+	}
+
 	public void setAllowSaveFromImportHelper(boolean allowSave) {
 	    getUiPanelManager().allowSave(allowSave);
 	}
@@ -843,7 +881,26 @@ public CirSim() {
 	}
 
 	public boolean isShowValuesEnabledForExport() {
-	    return showValuesCheckItem != null && showValuesCheckItem.getState();
+	    return showValuesCheckItem != null ? showValuesCheckItem.getState() : headlessShowValues;
+	}
+
+	public boolean isPrintableEnabledForExport() {
+	    return printableCheckItem != null ? printableCheckItem.getState() : headlessPrintable;
+	}
+
+	// stand-ins for the menu check items when drawing offscreen without a UI
+	public void setHeadlessDrawOptions(boolean printable, boolean showValues) {
+	    headlessPrintable = printable;
+	    headlessShowValues = showValues;
+	}
+
+	/** Schematic-only drawing for headless image export; see CircuitRenderer. */
+	public void drawSchematicOffscreen(Graphics g) {
+	    circuitRenderer.drawSchematicOffscreen(g);
+	}
+
+	public Rectangle getCircuitBoundsForExport() {
+	    return getCircuitBounds();
 	}
 
 	public boolean isAdjustTimeStepEnabledForExport() {
@@ -890,6 +947,10 @@ public CirSim() {
 	    return equationTableBroydenJacobianEnabled;
 	}
 
+	public boolean isEquationTableAndersonAccelerationEnabledForExport() {
+	    return equationTableAndersonAccelerationEnabled;
+	}
+
 	public double getEquationTableConvergenceToleranceForExport() {
 	    return equationTableConvergenceTolerance;
 	}
@@ -968,6 +1029,10 @@ public CirSim() {
 	    return variableHistoryStore;
 	}
 
+	public VariableCatalog getVariableCatalog() {
+	    return variableCatalog;
+	}
+
 	public double getLabeledNodeVoltageForUi(String name) {
 	    return circuitValueSlotManager.getLabeledNodeVoltage(name);
 	}
@@ -1597,11 +1662,11 @@ public CirSim() {
     }
 
     public boolean isEuroResistorForUi() {
-	return euroResistorCheckItem.getState();
+	return euroResistorCheckItem != null && euroResistorCheckItem.getState();
     }
 
     public boolean isEuroGatesForUi() {
-	return euroGatesCheckItem.getState();
+	return euroGatesCheckItem != null && euroGatesCheckItem.getState();
     }
 
     public int getElementCount() {
@@ -100,6 +100,9 @@ final class CirSimInitializer {
             String ctz = qp.getValue("ctz");
             if (ctz != null)
                 sim.startCircuitText = sim.decompress(ctz);
+            String cjb = qp.getValue("cjb");
+            if (cjb != null)
+                sim.startCircuitText = sim.decodeCompactUrlDump(cjb);
             String nonInteractiveDumpKey = qp.getValue("nonInteractiveDumpKey");
             if (sim.startCircuitText == null && nonInteractiveDumpKey != null)
                 sim.startCircuitText = sim.getCircuitIOService().getRunnerDumpFromStorage(nonInteractiveDumpKey);
@@ -121,8 +124,11 @@ final class CirSimInitializer {
             sim.enableCacheBustedUrls = sim.getPreferencesManager().getOptionFromStorage("enableCacheBustedUrls", true);
             sim.tableRenderCacheEnabled = sim.getPreferencesManager().getOptionFromStorage("tableRenderCacheEnabled", true);
             sim.autoOpenModelInfoOnLoad = sim.getPreferencesManager().getOptionFromStorage("autoOpenModelInfoOnLoad", true);
+            sim.compactInternalDumps = sim.getPreferencesManager().getOptionFromStorage("compactInternalDumps", true);
             sim.equationTableNewtonJacobianEnabled = sim.getPreferencesManager().getOptionFromStorage("equationTableNewtonJacobianEnabled", false);
             sim.equationTableBroydenJacobianEnabled = sim.getPreferencesManager().getOptionFromStorage("equationTableBroydenJacobianEnabled", false);
+            sim.equationTableAndersonAccelerationEnabled = sim.getPreferencesManager().getOptionFromStorage("equationTableAndersonAccelerationEnabled", false);
+            sim.luFactorCacheEnabled = sim.getPreferencesManager().getOptionFromStorage("luFactorCacheEnabled", true);
             positiveColor = qp.getValue("positiveColor");
             negativeColor = qp.getValue("negativeColor");
             neutralColor = qp.getValue("neutralColor");
@@ -130,6 +136,7 @@ final class CirSimInitializer {
             currentColor = qp.getValue("currentColor");
             mouseModeReq = qp.getValue("mouseMode");
             sim.hideInfoBox = qp.getBooleanValue("hideInfoBox", false);
+            SolverLog.setConsoleLevel(SolverLog.parseLevel(qp.getValue("solverLog"), SolverLog.INFO));
         } catch (Exception e) {
         }
 
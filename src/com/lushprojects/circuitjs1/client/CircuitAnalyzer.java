@@ -7,7 +7,10 @@ import com.lushprojects.circuitjs1.client.elements.ActionTimeDialog;
 import com.lushprojects.circuitjs1.client.core.CircuitMatrixOps;
 import com.lushprojects.circuitjs1.client.core.CircuitNode;
 import com.lushprojects.circuitjs1.client.core.CircuitNodeLink;
+import com.lushprojects.circuitjs1.client.core.DisjointSet;
+import com.lushprojects.circuitjs1.client.core.MatrixStamper;
 import com.lushprojects.circuitjs1.client.core.RowInfo;
+import com.lushprojects.circuitjs1.client.core.SolverMatrixState;
 import com.lushprojects.circuitjs1.client.elements.annotation.GraphicElm;
 import com.lushprojects.circuitjs1.client.elements.economics.*;
 import com.lushprojects.circuitjs1.client.elements.electronics.analog.VCCSElm;
@@ -18,6 +21,7 @@ import com.lushprojects.circuitjs1.client.elements.electronics.wiring.*;
 import com.lushprojects.circuitjs1.client.elements.misc.ScopeElm;
 import com.lushprojects.circuitjs1.client.runner.RuntimeMode;
 
+import com.lushprojects.circuitjs1.client.ui.EditInfo;
 import com.lushprojects.circuitjs1.client.ui.VariableBrowserDialog;
 
 import java.util.HashMap;
@@ -32,6 +36,11 @@ public class CircuitAnalyzer {
     private Vector<Integer> unconnectedNodes;
     private Vector<CircuitElm> nodesWithGroundConnection;
     private int nodesWithGroundConnectionCount;
+    // True once labels and variable slots have been built for the current node list;
+    // timestep-change restamps reuse them instead of re-walking every element.
+    private boolean namesCoordinatedForNodeList;
+    // counts stampCircuit() calls; elements stamped by the last one carry it
+    private int stampPass;
 
     CircuitAnalyzer(CirSim sim) {
         this.sim = sim;
@@ -63,15 +72,23 @@ public class CircuitAnalyzer {
         return nodeList.elementAt(n);
     }
 
+    /**
+     * Group posts joined by wires (and labeled-node links) into shared
+     * NodeMapEntry objects. Posts get dense ids and are merged with a
+     * union-find, so closure is near-linear in the number of wires; the
+     * entries are handed out per set once all wires have been merged.
+     */
     private void calculateWireClosure() {
         int i;
         LabeledNodeElm.resetNodeList();
         GroundElm.resetNodeList();
-        nodeMap = new HashMap<Point, CirSim.NodeMapEntry>();
 
         for (i = 0; i != sim.elmList.size(); i++)
             sim.getElm(i).registerLabels();
 
+        HashMap<Point, Integer> postIds = new HashMap<Point, Integer>();
+        Vector<Point> posts = new Vector<Point>();
+        DisjointSet sets = new DisjointSet();
         wireInfoList = new Vector<CirSim.WireInfo>();
         for (i = 0; i != sim.elmList.size(); i++) {
             CircuitElm ce = sim.getElm(i);
@@ -79,39 +96,32 @@ public class CircuitAnalyzer {
                 continue;
             ce.hasWireInfo = false;
             wireInfoList.add(new CirSim.WireInfo(ce));
-            Point p0 = ce.getPost(0);
-            CirSim.NodeMapEntry cn = nodeMap.get(p0);
-
+            int id0 = getPostId(ce.getPost(0), postIds, posts, sets);
             Point p1 = ce.getConnectedPost();
-            if (p1 == null) {
-                if (cn == null) {
-                    cn = new CirSim.NodeMapEntry();
-                    nodeMap.put(p0, cn);
-                }
-                continue;
-            }
-            CirSim.NodeMapEntry cn2 = nodeMap.get(p1);
-            if (cn != null && cn2 != null) {
-                for (Map.Entry<Point, CirSim.NodeMapEntry> entry : nodeMap.entrySet()) {
-                    if (entry.getValue() == cn2)
-                        entry.setValue(cn);
-                }
-                continue;
-            }
-            if (cn != null) {
-                nodeMap.put(p1, cn);
-                continue;
-            }
-            if (cn2 != null) {
-                nodeMap.put(p0, cn2);
-                continue;
-            }
-            cn = new CirSim.NodeMapEntry();
-            nodeMap.put(p0, cn);
-            nodeMap.put(p1, cn);
+            if (p1 != null)
+                sets.union(id0, getPostId(p1, postIds, posts, sets));
+        }
+
+        nodeMap = new HashMap<Point, CirSim.NodeMapEntry>();
+        CirSim.NodeMapEntry entries[] = new CirSim.NodeMapEntry[sets.size()];
+        for (i = 0; i != posts.size(); i++) {
+            int root = sets.find(i);
+            if (entries[root] == null)
+                entries[root] = new CirSim.NodeMapEntry();
+            nodeMap.put(posts.get(i), entries[root]);
         }
     }
 
+    private static int getPostId(Point pt, HashMap<Point, Integer> postIds, Vector<Point> posts, DisjointSet sets) {
+        Integer id = postIds.get(pt);
+        if (id != null)
+            return id.intValue();
+        int n = sets.add();
+        postIds.put(pt, n);
+        posts.add(pt);
+        return n;
+    }
+
     private boolean calcWireInfo() {
         int i;
         int moved = 0;
@@ -324,25 +334,32 @@ public class CircuitAnalyzer {
         }
     }
 
+    /**
+     * Topology checks for inductors, current sources, voltage source loops,
+     * rails and ideal capacitors. Each check asks whether two nodes are
+     * joined without passing through the element itself. The answers come
+     * from per-type {@link TopologyGraph}s built once per analysis
+     * (components plus bridges); only ambiguous cases fall back to an exact
+     * {@link FindPathInfo} search.
+     */
     private boolean validateCircuit() {
         int i;
+        TopologyChecks checks = new TopologyChecks();
         for (i = 0; i != sim.elmList.size(); i++) {
             CircuitElm ce = sim.getElm(i);
             if (ce instanceof InductorElm) {
-                FindPathInfo fpi = new FindPathInfo(FindPathInfo.INDUCT, ce, ce.getNode(1));
-                if (!fpi.findPath(ce.getNode(0))) {
+                if (!checks.hasPath(FindPathInfo.INDUCT, ce, i, ce.getNode(0), ce.getNode(1))) {
                     ce.reset();
                 }
             }
             if (ce instanceof CurrentElm) {
                 CurrentElm cur = (CurrentElm) ce;
-                FindPathInfo fpi = new FindPathInfo(FindPathInfo.INDUCT, ce, ce.getNode(1));
-                cur.setBroken(!fpi.findPath(ce.getNode(0)));
+                cur.setBroken(!checks.hasPath(FindPathInfo.INDUCT, ce, i, ce.getNode(0), ce.getNode(1)));
             }
             if (ce instanceof VCCSElm) {
                 VCCSElm cur = (VCCSElm) ce;
-                FindPathInfo fpi = new FindPathInfo(FindPathInfo.INDUCT, ce, cur.getOutputNode(0));
-                if (cur.hasCurrentOutput() && !fpi.findPath(cur.getOutputNode(1))) {
+                if (cur.hasCurrentOutput() &&
+                    !checks.hasPath(FindPathInfo.INDUCT, ce, i, cur.getOutputNode(1), cur.getOutputNode(0))) {
                     cur.broken = true;
                 } else
                     cur.broken = false;
@@ -350,8 +367,7 @@ public class CircuitAnalyzer {
 
             if (ce.getPostCount() == 2) {
                 if (ce instanceof VoltageElm) {
-                    FindPathInfo fpi = new FindPathInfo(FindPathInfo.VOLTAGE, ce, ce.getNode(1));
-                    if (fpi.findPath(ce.getNode(0))) {
+                    if (checks.hasPath(FindPathInfo.VOLTAGE, ce, i, ce.getNode(0), ce.getNode(1))) {
                         sim.stop("Voltage source/wire loop with no resistance!", ce);
                         return false;
                     }
@@ -359,21 +375,18 @@ public class CircuitAnalyzer {
             }
 
             if (ce instanceof RailElm || ce instanceof LogicInputElm) {
-                FindPathInfo fpi = new FindPathInfo(FindPathInfo.VOLTAGE, ce, ce.getNode(0));
-                if (fpi.findPath(0)) {
+                if (checks.hasPath(FindPathInfo.VOLTAGE, ce, i, 0, ce.getNode(0))) {
                     sim.stop("Path to ground with no resistance!", ce);
                     return false;
                 }
             }
 
             if (ce.isIdealCapacitor()) {
-                FindPathInfo fpi = new FindPathInfo(FindPathInfo.SHORT, ce, ce.getNode(1));
-                if (fpi.findPath(ce.getNode(0))) {
+                if (checks.hasPath(FindPathInfo.SHORT, ce, i, ce.getNode(0), ce.getNode(1))) {
                     CirSim.console(ce + " shorted");
                     ((CapacitorElm) ce).shorted();
                 } else {
-                    fpi = new FindPathInfo(FindPathInfo.CAP_V, ce, ce.getNode(1));
-                    if (fpi.findPath(ce.getNode(0))) {
+                    if (checks.hasPath(FindPathInfo.CAP_V, ce, i, ce.getNode(0), ce.getNode(1))) {
                         ((CapacitorElm) ce).setSeriesResistance(.1);
                         return false;
                     }
@@ -383,7 +396,70 @@ public class CircuitAnalyzer {
         return true;
     }
 
+    /**
+     * Lazily built graphs for {@link #validateCircuit()}, one per search type.
+     * Upper-bound graphs include every element the search may cross (inductors
+     * regardless of current, either conduction direction); lower-bound graphs
+     * only elements it always crosses in both directions.
+     */
+    private class TopologyChecks {
+        private final TopologyGraph upper[] = new TopologyGraph[FindPathInfo.CAP_V + 1];
+        private TopologyGraph inductLower;
+        private TopologyGraph shortLower;
+
+        boolean hasPath(int type, CircuitElm ce, int elmIndex, int from, int to) {
+            int r = getUpper(type).pathAvoidingUpperBound(elmIndex, from, to);
+            if (r == TopologyGraph.UNKNOWN) {
+                TopologyGraph lower = getLower(type);
+                if (lower != null)
+                    r = lower.pathAvoidingLowerBound(elmIndex, from, to);
+            }
+            if (r != TopologyGraph.UNKNOWN)
+                return r == TopologyGraph.YES;
+            return new FindPathInfo(type, ce, to).findPath(from);
+        }
+
+        private TopologyGraph getUpper(final int type) {
+            if (upper[type] == null) {
+                upper[type] = new TopologyGraph(sim.elmList, nodeList.size(), new TopologyGraph.EdgeFilter() {
+                    public boolean allows(CircuitElm ce) {
+                        return pathSearchAllows(type, ce);
+                    }
+                }, false);
+            }
+            return upper[type];
+        }
+
+        private TopologyGraph getLower(int type) {
+            if (type == FindPathInfo.INDUCT) {
+                if (inductLower == null) {
+                    inductLower = new TopologyGraph(sim.elmList, nodeList.size(), new TopologyGraph.EdgeFilter() {
+                        public boolean allows(CircuitElm ce) {
+                            return !(ce instanceof CurrentElm || ce instanceof InductorElm || ce instanceof VCCSElm);
+                        }
+                    }, true);
+                }
+                return inductLower;
+            }
+            if (type == FindPathInfo.SHORT) {
+                if (shortLower == null) {
+                    shortLower = new TopologyGraph(sim.elmList, nodeList.size(), new TopologyGraph.EdgeFilter() {
+                        public boolean allows(CircuitElm ce) {
+                            return ce.isWireEquivalent();
+                        }
+                    }, true);
+                }
+                return shortLower;
+            }
+            // voltage and capacitor loops are rare and stop or adjust the
+            // circuit anyway; the exact search settles them
+            return null;
+        }
+    }
+
     void analyzeCircuit() {
+        CircuitLoadPipeline pipeline = sim.getCircuitLoadPipeline();
+        pipeline.beginStage(CircuitLoadPipeline.Stage.ANALYZE);
         sim.stopMessage = null;
         sim.warningMessage = null;
         sim.stopElm = null;
@@ -391,16 +467,19 @@ public class CircuitAnalyzer {
         if (sim.elmList.isEmpty()) {
             sim.postDrawList = new Vector<Point>();
             sim.badConnectionList = new Vector<Point>();
+            pipeline.finishLoad();
             return;
         }
         makePostDrawList();
 
         sim.needsStamp = true;
+        pipeline.endStage();
     }
 
     boolean preStampCircuit(boolean subcircuit) {
         int i, j;
         nodeList = new Vector<CircuitNode>();
+        namesCoordinatedForNodeList = false;
 
         sim.getStatusInfoRenderer().updateEquationParameterCollisionWarning();
 
@@ -463,10 +542,13 @@ public class CircuitAnalyzer {
     }
 
     void preStampAndStampCircuit() {
+        CircuitLoadPipeline pipeline = sim.getCircuitLoadPipeline();
+        pipeline.beginStage(CircuitLoadPipeline.Stage.ANALYZE);
         int i;
         for (i = 0; i != 10; i++)
             if (preStampCircuit(false) || sim.stopMessage != null)
                 break;
+        pipeline.endStage();
         if (sim.stopMessage != null)
             return;
         if (i == 10) {
@@ -474,14 +556,18 @@ public class CircuitAnalyzer {
             return;
         }
 
+        pipeline.beginStage(CircuitLoadPipeline.Stage.STAMP);
         stampCircuit();
+        pipeline.finishLoad();
     }
 
     void stampCircuit() {
         int i;
         // Cache node list size for stamp methods to avoid repeated accessor chain
         sim.getMatrixStamper().cacheNodeListSize();
+        stampPass++;
         int matrixSize = nodeList.size() - 1 + sim.voltageSourceCount;
+        sim.getSolverMatrixState().lowRankUpdate = null;
         sim.getSolverMatrixState().circuitMatrix = new double[matrixSize][matrixSize];
         sim.getSolverMatrixState().circuitRightSide = new double[matrixSize];
         sim.getSolverMatrixState().nodeVoltages = new double[nodeList.size() - 1];
@@ -498,15 +584,21 @@ public class CircuitAnalyzer {
 
         connectUnconnectedNodes();
 
-        EquationTableElm.coordinateLabelsForStamp(sim.elmList);
+        boolean coordinateNames = !namesCoordinatedForNodeList;
+        if (coordinateNames)
+            EquationTableElm.coordinateLabelsForStamp(sim.elmList);
 
         for (i = 0; i != sim.elmList.size(); i++) {
             CircuitElm ce = sim.getElm(i);
             ce.setParentList(sim.elmList);
+            ce.stampPass = stampPass;
             ce.stamp();
         }
 
-        sim.getCircuitValueSlotManager().buildCircuitVariableSlots();
+        if (coordinateNames) {
+            sim.getCircuitValueSlotManager().buildCircuitVariableSlots();
+            namesCoordinatedForNodeList = true;
+        }
 
         for (i = 0; i != sim.elmList.size(); i++) {
             CircuitElm ce = sim.getElm(i);
@@ -520,7 +612,7 @@ public class CircuitAnalyzer {
             return;
 
         if (!sim.getSolverMatrixState().circuitNonLinear) {
-            int badRow = CircuitMatrixOps.luFactor(sim.getSolverMatrixState().circuitMatrix, sim.getSolverMatrixState().circuitMatrixSize, sim.getSolverMatrixState().circuitPermute);
+            int badRow = factorLinearMatrix();
             if (badRow >= 0) {
                 sim.stop("Singular matrix! " + sim.getMatrixStamper().getMatrixRowInfo(badRow), null);
                 return;
@@ -545,6 +637,61 @@ public class CircuitAnalyzer {
         sim.needsStamp = false;
     }
 
+    /**
+     * Apply a slider edit, updating the stamped matrix in place when possible.
+     *
+     * If the element reports the item as parameter-only, its stamp is recorded
+     * before and after the edit and only the difference is added to
+     * origMatrix/origRightSide; a linear circuit is then refactored once. Edits
+     * that change nothing in the matrix (e.g. a parameter read in doStep) need no
+     * solver work at all. Anything the delta can't express (a stamp into a row
+     * eliminated by simplifyMatrix(), a singular result, pending analysis) falls
+     * back to a full re-analysis.
+     *
+     * @return true if the fast path was used
+     */
+    public boolean applyParameterEdit(CircuitElm ce, int item, EditInfo ei) {
+        SolverMatrixState sms = sim.getSolverMatrixState();
+        boolean fast = ce.isParameterOnlyEdit(item) && !sim.analyzeFlag && !sim.needsStamp
+                && sim.stopMessage == null && sms.circuitNeedsMap && sms.origMatrix != null
+                && sim.elmArr != null && ce.stampPass == stampPass;
+        if (!fast) {
+            sim.analyzeFlag = true;
+            ce.setEditValue(item, ei);
+            return false;
+        }
+
+        MatrixStamper stamper = sim.getMatrixStamper();
+        stamper.beginDeltaRecording();
+        ce.stamp();
+        ce.setEditValue(item, ei);
+        stamper.recordNewStamp();
+        ce.stamp();
+        int changed = stamper.endDeltaRecording(sms.origMatrix, sms.origRightSide);
+        if (changed < 0 || sim.analyzeFlag) {
+            sim.analyzeFlag = true;
+            return false;
+        }
+        if (changed > 0 && !sms.circuitNonLinear) {
+            sms.restoreMatrixFromOrig();
+            if (factorLinearMatrix() >= 0) {
+                // let the full restamp report the singular matrix
+                sim.analyzeFlag = true;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Factor the freshly stamped matrix of a linear circuit, reusing a recent
+    // factorization of the same or a nearly identical matrix when enabled.
+    private int factorLinearMatrix() {
+        SolverMatrixState sms = sim.getSolverMatrixState();
+        if (sim.luFactorCacheEnabled)
+            return sms.factorCache.factor(sms);
+        return CircuitMatrixOps.luFactor(sms);
+    }
+
     private boolean simplifyMatrix(int matrixSize) {
         int i, j;
         for (i = 0; i != matrixSize; i++) {
@@ -699,6 +846,25 @@ public class CircuitAnalyzer {
         }
     }
 
+    /** Element types a search of this type may pass through (ignoring the inductor current rule). */
+    private static boolean pathSearchAllows(int type, CircuitElm ce) {
+        if (type == FindPathInfo.INDUCT)
+            return !(ce instanceof CurrentElm);
+        if (type == FindPathInfo.VOLTAGE)
+            return ce.isWireEquivalent() || ce instanceof VoltageElm || ce instanceof GroundElm;
+        if (type == FindPathInfo.SHORT)
+            return ce.isWireEquivalent();
+        if (type == FindPathInfo.CAP_V)
+            return ce.isWireEquivalent() || ce.isIdealCapacitor() || ce instanceof VoltageElm;
+        return true;
+    }
+
+    /**
+     * Exact path search used when {@link TopologyChecks} cannot decide from
+     * the bulk graphs. Iterative (explicit node stack) so long chains cannot
+     * overflow the call stack; the inductor current rule makes it directional,
+     * which is why the bulk graphs only bound it.
+     */
     class FindPathInfo {
         static final int INDUCT = 1;
         static final int VOLTAGE = 2;
@@ -708,67 +874,64 @@ public class CircuitAnalyzer {
         int dest;
         CircuitElm firstElm;
         int type;
+        private int stack[];
+        private int sp;
 
         FindPathInfo(int type_, CircuitElm elm_, int dest_) {
             dest = dest_;
             type = type_;
             firstElm = elm_;
             visited = new boolean[nodeList.size()];
+            stack = new int[16];
         }
 
-        boolean findPath(int n1) {
-            if (n1 == dest)
-                return true;
-            if (visited[n1])
-                return false;
-
-            visited[n1] = true;
-            CircuitNode cn = sim.getCircuitNode(n1);
-            int i;
-            if (cn == null)
-                return false;
-            for (i = 0; i != cn.links.size(); i++) {
-                CircuitNodeLink cnl = cn.links.get(i);
-                CircuitElm ce = cnl.elm;
-                if (checkElm(n1, ce))
+        boolean findPath(int start) {
+            sp = 0;
+            push(start);
+            while (sp > 0) {
+                int n1 = stack[--sp];
+                if (n1 == dest)
                     return true;
-            }
-            if (n1 == 0) {
-                for (i = 0; i != nodesWithGroundConnection.size(); i++)
-                    if (checkElm(0, nodesWithGroundConnection.get(i)))
-                        return true;
+                if (visited[n1])
+                    continue;
+
+                visited[n1] = true;
+                CircuitNode cn = sim.getCircuitNode(n1);
+                int i;
+                if (cn == null)
+                    continue;
+                for (i = 0; i != cn.links.size(); i++)
+                    pushNeighbors(n1, cn.links.get(i).elm);
+                if (n1 == 0) {
+                    for (i = 0; i != nodesWithGroundConnection.size(); i++)
+                        pushNeighbors(0, nodesWithGroundConnection.get(i));
+                }
             }
             return false;
         }
 
-        boolean checkElm(int n1, CircuitElm ce) {
-            if (ce == firstElm)
-                return false;
-            if (type == INDUCT) {
-                if (ce instanceof CurrentElm)
-                    return false;
-            }
-            if (type == VOLTAGE) {
-                if (!(ce.isWireEquivalent() || ce instanceof VoltageElm || ce instanceof GroundElm))
-                    return false;
-            }
-            if (type == SHORT && !ce.isWireEquivalent())
-                return false;
-            if (type == CAP_V) {
-                if (!(ce.isWireEquivalent() || ce.isIdealCapacitor() || ce instanceof VoltageElm))
-                    return false;
+        private void push(int n) {
+            if (sp == stack.length) {
+                int ns[] = new int[sp * 2];
+                System.arraycopy(stack, 0, ns, 0, sp);
+                stack = ns;
             }
+            stack[sp++] = n;
+        }
+
+        private void pushNeighbors(int n1, CircuitElm ce) {
+            if (ce == firstElm || !pathSearchAllows(type, ce))
+                return;
+            int j;
             if (n1 == 0) {
-                int j;
                 for (j = 0; j != ce.getConnectionNodeCount(); j++)
-                    if (ce.hasGroundConnection(j) && findPath(ce.getConnectionNode(j)))
-                        return true;
+                    if (ce.hasGroundConnection(j))
+                        push(ce.getConnectionNode(j));
             }
-            int j;
             for (j = 0; j != ce.getConnectionNodeCount(); j++) {
                 if (ce.getConnectionNode(j) == n1) {
-                    if (ce.hasGroundConnection(j) && findPath(0))
-                        return true;
+                    if (ce.hasGroundConnection(j))
+                        push(0);
                     if (type == INDUCT && ce instanceof InductorElm) {
                         double c = ce.getCurrent();
                         if (j == 0)
@@ -780,13 +943,11 @@ public class CircuitAnalyzer {
                     for (k = 0; k != ce.getConnectionNodeCount(); k++) {
                         if (j == k)
                             continue;
-                        if (ce.getConnection(j, k) && findPath(ce.getConnectionNode(k))) {
-                            return true;
-                        }
+                        if (ce.getConnection(j, k))
+                            push(ce.getConnectionNode(k));
                     }
                 }
             }
-            return false;
         }
     }
 }
@@ -28,8 +28,6 @@ import com.lushprojects.circuitjs1.client.util.*;
 
 import java.util.Vector;
 
-import com.google.gwt.canvas.dom.client.CanvasGradient;
-import com.google.gwt.canvas.dom.client.Context2d;
 import com.google.gwt.canvas.dom.client.Context2d.LineCap;
 import com.google.gwt.core.client.JavaScriptObject;
 import com.google.gwt.core.client.JsArrayString;
@@ -157,7 +155,13 @@ public abstract class CircuitElm implements Editable {
     
     public boolean selected;
     
+    // bumped when the element's exportable content is edited, so exporters
+    // can reuse text generated for an earlier version
+    private int contentVersion;
+    private static int contentGeneration; // bumped with any element's contentVersion
+    
     boolean hasWireInfo; // used in calcWireInfo()
+    int stampPass; // stampCircuit() pass that last stamped this element
     
 //    abstract int getDumpType();
     protected int getDumpType() {
@@ -331,6 +335,22 @@ public abstract class CircuitElm implements Editable {
 
     public void setPersistentUid(String uid) {
 	persistentUid = uid;
+	bumpContentVersion();
+    }
+
+    public int getContentVersion() {
+	return contentVersion;
+    }
+
+    public void bumpContentVersion() {
+	contentVersion++;
+	contentGeneration++;
+    }
+
+    // changes whenever any element's content version does, so caches can
+    // skip rescanning the element list when nothing was edited
+    public static int getContentGeneration() {
+	return contentGeneration;
     }
 
 	public boolean hasAssignedZOrder() {
@@ -539,7 +559,7 @@ public abstract class CircuitElm implements Editable {
 
     // draw current dots from point a to b
     protected void drawDots(Graphics g, Point pa, Point pb, double pos) {
-	 if ((!sim.simIsRunning()) || pos == 0 || !sim.dotsCheckItem.getState())
+	 if ((!sim.simIsRunning()) || pos == 0 || !sim.isDotsEnabledForExport())
 	    return;
 	int dx = pb.x-pa.x;
 	int dy = pb.y-pa.y;
@@ -550,15 +570,14 @@ public abstract class CircuitElm implements Editable {
 	    // current is moving too fast, avoid aliasing by drawing dots at
 	    // random position with transparent yellow line underneath
 	    g.save();
-	    Context2d ctx = g.context;
-	    ctx.setLineWidth(4);
-	    ctx.setGlobalAlpha(.5);
-	    ctx.beginPath();
-	    ctx.moveTo(pa.x, pa.y);
-	    ctx.lineTo(pb.x, pb.y);
-	    ctx.stroke();
+	    g.setLineWidth(4);
+	    g.setGlobalAlpha(.5);
+	    g.beginPath();
+	    g.moveTo(pa.x, pa.y);
+	    g.lineTo(pb.x, pb.y);
+	    g.stroke();
 	    g.restore();
-	    pos = Random.nextDouble()*ds;
+	    pos = (RuntimeMode.isNonInteractiveRuntime() ? nonInteractiveRandom.nextDouble() : Random.nextDouble())*ds;
 	}
 	pos %= ds;
 	if (pos < 0)
@@ -879,21 +898,21 @@ public abstract class CircuitElm implements Editable {
     boolean isCenteredText() { return false; }
     
     public void drawCenteredText(Graphics g, String s, int x, int y, boolean cx) {
-    	int w=(int)g.context.measureText(s).getWidth();
+    	int w=(int)g.measureWidth(s);
     	int h2=(int)g.currentFontSize/2;
 		String prevBaseline = g.getTextBaseline();
 		String prevAlign = g.getTextAlign();
-		g.context.setTextBaseline("middle");
+		g.setTextBaseline("middle");
 		if (cx) {
-			g.context.setTextAlign("center");
+			g.setTextAlign("center");
 			adjustBbox(x-w/2,y-h2,x+w/2,y+h2);
 		} else {
 			adjustBbox(x,y-h2,x+w,y+h2);
 		}
 		g.drawString(s, x, y);
 		// Restore only changed properties instead of full canvas save/restore
-		g.context.setTextBaseline(prevBaseline);
-		g.context.setTextAlign(prevAlign);
+		g.setTextBaseline(prevBaseline);
+		g.setTextAlign(prevAlign);
     }
     
     // draw component values (number of resistor ohms, etc).  hs = offset
@@ -902,7 +921,7 @@ public abstract class CircuitElm implements Editable {
 	    return;
 	g.setFont(unitsFont);
 	//FontMetrics fm = g.getFontMetrics();
-	int w = (int)g.context.measureText(s).getWidth();
+	int w = (int)g.measureWidth(s);
 	g.setColor(whiteColor);
 	int ya = (int)g.currentFontSize/2;
 	int xc, yc;
@@ -931,10 +950,10 @@ public abstract class CircuitElm implements Editable {
 	    lineOver = true;
 	    str = str.substring(1);
 	}
-        int w=(int)g.context.measureText(str).getWidth();
+        int w=(int)g.measureWidth(str);
         int h=(int)g.currentFontSize;
         String prevBaseline = g.getTextBaseline();
-        g.context.setTextBaseline("middle");
+        g.setTextBaseline("middle");
         int x = pt2.x, y = pt2.y;
         if (pt1.y != pt2.y) {
             x -= w/2;
@@ -947,7 +966,7 @@ public abstract class CircuitElm implements Editable {
         }
         g.drawString(str, x, y);
         adjustBbox(x, y-h/2, x+w, y+h/2);
-        g.context.setTextBaseline(prevBaseline);
+        g.setTextBaseline(prevBaseline);
 	if (lineOver) {
 	    int ya = y-h/2-1;
 	    g.drawLine(x, ya, x+w, ya);
@@ -959,28 +978,24 @@ public abstract class CircuitElm implements Editable {
 	double len = distance(p1, p2);
 
 	g.save();
-	g.context.setLineWidth(3.0);
-	g.context.transform(((double)(p2.x-p1.x))/len, ((double)(p2.y-p1.y))/len,
+	g.setLineWidth(3.0);
+	g.transform(((double)(p2.x-p1.x))/len, ((double)(p2.y-p1.y))/len,
 		-((double)(p2.y-p1.y))/len,((double)(p2.x-p1.x))/len,p1.x,p1.y);
-	if (sim.voltsCheckItem.getState() ) {
-	    CanvasGradient grad = g.context.createLinearGradient(0,0,len,0);
-	    grad.addColorStop(0, getVoltageColor(g,v1).getHexValue());
-	    grad.addColorStop(1.0, getVoltageColor(g,v2).getHexValue());
-	    g.context.setStrokeStyle(grad);
-	}
-	g.context.setLineCap(LineCap.ROUND);
-	g.context.scale(1, hs > 0 ? 1 : -1);
+	if (sim.isVoltsEnabledForExport() )
+	    g.setStrokeGradient(0, 0, len, 0, getVoltageColor(g,v1), getVoltageColor(g,v2));
+	g.setLineCap(LineCap.ROUND);
+	g.scale(1, hs > 0 ? 1 : -1);
 
 	int loop;
 	// draw more loops for a longer coil
 	int loopCt = (int)Math.ceil(len/11);
 	for (loop = 0; loop != loopCt; loop++) {
-	    g.context.beginPath();
+	    g.beginPath();
 	    double start = len*loop/loopCt;
-	    g.context.moveTo(start,0);
-	    g.context.arc(len*(loop+.5)/loopCt, 0, len/(2*loopCt), Math.PI, Math.PI*2);
-	    g.context.lineTo(len*(loop+1)/loopCt, 0);
-	    g.context.stroke();
+	    g.moveTo(start,0);
+	    g.arc(len*(loop+.5)/loopCt, 0, len/(2*loopCt), Math.PI, Math.PI*2);
+	    g.lineTo(len*(loop+1)/loopCt, 0);
+	    g.stroke();
 	}
 
 	g.restore();
@@ -1026,9 +1041,7 @@ public abstract class CircuitElm implements Editable {
     
     protected static void drawThickCircle(Graphics g, int cx, int cy, int ri) {
     	g.setLineWidth(3.0);
-    	g.context.beginPath();
-    	g.context.arc(cx, cy, ri*.98, 0, 2*Math.PI);
-    	g.context.stroke();
+    	g.drawCircle(cx, cy, ri*.98);
     	g.setLineWidth(1.0);
     }
 
@@ -1083,6 +1096,50 @@ public abstract class CircuitElm implements Editable {
     public static String getShortUnitText(double v, String u) {
     	return getUnitText(v,u, true);
     }
+
+    // Formatted-value cache for renderers that format the same values every frame
+    private static final FormattedValueCache unitTextCache = new FormattedValueCache(1024);
+    private static String unitTextCacheVoltageSymbol, unitTextCacheTimeSymbol;
+
+    /** Same as getUnitText(), but reuses the string if this value was formatted recently. */
+    public static String getCachedUnitText(double v, String u) {
+	return getCachedUnitText(v, u, false);
+    }
+
+    public static String getCachedShortUnitText(double v, String u) {
+	return getCachedUnitText(v, u, true);
+    }
+
+    private static String getCachedUnitText(double v, String u, boolean sf) {
+	int precision = getUnitTextPrecisionKey(sf);
+	String text = unitTextCache.get(v, u, precision);
+	if (text == null) {
+	    text = getUnitText(v, u, sf);
+	    unitTextCache.put(v, u, precision, text);
+	}
+	return text;
+    }
+
+    /** Changes whenever getUnitText() would format the same value differently. */
+    public static int getUnitTextFormatKey() {
+	int key = getUnitTextPrecisionKey(false) ^ (shortDecimalDigits << 8);
+	if (sim != null && sim.voltageUnitSymbol != null)
+	    key ^= sim.voltageUnitSymbol.hashCode() * 31;
+	return key;
+    }
+
+    // everything besides (value, unit) that changes getUnitText() output
+    private static int getUnitTextPrecisionKey(boolean sf) {
+	if (sim != null && (sim.voltageUnitSymbol != unitTextCacheVoltageSymbol || sim.timeUnitSymbol != unitTextCacheTimeSymbol)) {
+	    unitTextCache.clear();
+	    unitTextCacheVoltageSymbol = sim.voltageUnitSymbol;
+	    unitTextCacheTimeSymbol = sim.timeUnitSymbol;
+	}
+	int key = (sf ? shortDecimalDigits : decimalDigits) * 2 + (sf ? 1 : 0);
+	if (sim != null && sim.currentToolbarType == CirSim.ToolbarType.ECONOMICS)
+	    key |= 1 << 16;
+	return key;
+    }
     
     // Number format for economics mode (2 decimal places)
 	private static NumFmt.Formatter economicsFormat = NumFmt.forPattern("#,##0.00");
@@ -1224,7 +1281,7 @@ public abstract class CircuitElm implements Editable {
     	if (needsHighlight()) {
     	    	return (getHighlightColor());
     	}
-    	if (!sim.voltsCheckItem.getState()) {
+    	if (!sim.isVoltsEnabledForExport()) {
     	    	return(whiteColor);
     	}
     	int c = (int) ((volts+voltageRange)*(colorScaleCount-1)/
@@ -1251,14 +1308,14 @@ public abstract class CircuitElm implements Editable {
 		setConductanceColor(g, current/getVoltageDiff());
 		return;
 		}*/
-		if (!sim.powerCheckItem.getState() )
+		if (!sim.isPowerEnabledForExport() )
 			return;
 		setPowerColor(g, getPower());
     }
     
     protected void setPowerColor(Graphics g, double w0) {
 
-		if (!sim.powerCheckItem.getState() )
+		if (!sim.isPowerEnabledForExport() )
 			return;
 			if (needsHighlight()) {
 				g.setColor(selectColor);
@@ -1316,6 +1373,11 @@ public abstract class CircuitElm implements Editable {
     // Override this method to provide custom slider text formatting
     // Return null to use default formatting
     public String getSliderUnitText(int n, EditInfo ei, double value) { return null; }
+
+    // Override to return true for edit items whose slider changes can skip re-analysis:
+    // the edit must not change posts, nodes, voltage source count or nonlinearity, and
+    // stamp() must be free of side effects so it can be replayed with the old and new value.
+    public boolean isParameterOnlyEdit(int n) { return false; }
     
     // get number of nodes that can be retrieved by getConnectionNode()
     int getConnectionNodeCount() { return getPostCount(); }
@@ -12,6 +12,8 @@ import com.lushprojects.circuitjs1.client.elements.electronics.TransistorModel;
 import com.lushprojects.circuitjs1.client.elements.electronics.sources.AudioInputElm;
 import com.lushprojects.circuitjs1.client.elements.electronics.sources.DataInputElm;
 import com.google.gwt.core.client.GWT;
+import com.google.gwt.core.client.Scheduler;
+import com.google.gwt.core.client.Scheduler.RepeatingCommand;
 import com.google.gwt.http.client.Request;
 import com.google.gwt.http.client.RequestBuilder;
 import com.google.gwt.http.client.RequestCallback;
@@ -38,8 +40,13 @@ import com.lushprojects.circuitjs1.client.util.Locale;
 
 final class CircuitIOService {
     private static final String LEFT_PANEL_OPEN_KEY = "leftPanelOpen";
+    /** Loads at least this long (in characters) are time-sliced in the browser. */
+    private static final int INCREMENTAL_LOAD_MIN_CHARS = 64 * 1024;
+    /** Work budget per incremental load slice, leaving room for a frame. */
+    private static final double INCREMENTAL_LOAD_SLICE_MS = 12;
     private final CirSim sim;
     private String recovery;
+    private CircuitLoadJob activeLoadJob;
 
     CircuitIOService(CirSim sim) {
         this.sim = sim;
@@ -163,81 +170,105 @@ final class CircuitIOService {
         return dump;
     }
 
+    /** Load a circuit synchronously; the staged {@link CircuitLoadJob} is run to completion. */
     void readCircuit(String text, int flags) {
-        if (text != null && !text.trim().isEmpty()) {
-            String preview = text.length() > 200 ? text.substring(0, 200) : text;
-            CirSim.console("readCircuit text preview: " + preview.replace("\n", "\\n"));
-            CirSim.console("isSFCRFormat result: " + SFCRParser.isSFCRFormat(text));
-        }
+        cancelActiveLoad();
+        new CircuitLoadJob(this, sim, text, flags).runToCompletion();
+    }
 
-        if (SFCRParser.isSFCRFormat(text)) {
-            String currentFile = sim.getSFCRDocumentManager().getCurrentCircuitFile();
-            CirSim.console("Parsing mode: SFCRParser (SFCR format detected)" + (currentFile != null ? " - " + currentFile : ""));
-            readCircuit(new byte[0], flags);
-
-            SFCRParser parser = new SFCRParser(sim);
-            if (parser.parse(text)) {
-                CirSim.console("Loaded SFCR model with " + parser.getCreatedElements().size() + " elements");
-                sim.getSFCRDocumentManager().setModelInfoSourceText(text);
-                sim.getSFCRDocumentManager().setModelInfoContent(InfoViewerContentBuilder.buildModelInfoMarkdown(text, parser.getInfoContent()));
-                String editorContent = sim.getModelInfoEditorContent();
-                sim.getSFCRDocumentManager().refreshModelInfoMenuItems();
-
-                if (RuntimeMode.isGwt() && shouldAutoOpenModelInfo(editorContent)) {
-                    sim.getInfoDialogActions().openModelInfoEditorInLeftPanel();
-                    sim.getInfoDialogActions().doViewModelInfo();
+    /**
+     * Load a circuit, spreading element construction over several frames when the
+     * text is large and we are running in the browser. The simulation loop shows
+     * load progress instead of analyzing a half-built circuit until the job is done.
+     * onLoaded runs after the load finishes (immediately for small or headless loads).
+     */
+    void readCircuitIncremental(String text, int flags, final Command onLoaded) {
+        if (!RuntimeMode.isGwt() || text == null || text.length() < INCREMENTAL_LOAD_MIN_CHARS) {
+            readCircuit(text, flags);
+            if (onLoaded != null)
+                onLoaded.execute();
+            return;
+        }
+        cancelActiveLoad();
+        final CircuitLoadJob job = new CircuitLoadJob(this, sim, text, flags);
+        activeLoadJob = job;
+        Scheduler.get().scheduleIncremental(new RepeatingCommand() {
+            public boolean execute() {
+                if (activeLoadJob != job)
+                    return false;
+                boolean more;
+                try {
+                    more = job.step(INCREMENTAL_LOAD_SLICE_MS);
+                } catch (Exception e) {
+                    CirSim.console("exception during incremental load " + e);
+                    more = false;
                 }
+                sim.repaint();
+                if (more)
+                    return true;
+                activeLoadJob = null;
+                if (onLoaded != null)
+                    onLoaded.execute();
+                return false;
+            }
+        });
+    }
 
-                java.util.ArrayList<String> rawLines = parser.getRawCircuitLines();
-                if (!rawLines.isEmpty()) {
-                    CirSim.console("Processing " + rawLines.size() + " raw circuit elements");
-                    for (String line : rawLines) {
-                        try {
-                            processCircuitLine(line);
-                        } catch (Exception e) {
-                            CirSim.console("Error processing circuit line: " + line + " - " + e.getMessage());
-                        }
-                    }
-                }
+    /** The incremental load in progress, or null. */
+    CircuitLoadJob getActiveLoadJob() {
+        return activeLoadJob;
+    }
 
-                if (RuntimeMode.isGwt())
-                    parser.applyParsedScopes();
+    /** Drop an unfinished incremental load; a newer load supersedes it. */
+    private void cancelActiveLoad() {
+        if (activeLoadJob != null) {
+            CirSim.console("Abandoning incremental load superseded by a new load");
+            activeLoadJob = null;
+        }
+    }
 
-                parser.applyParsedZOrders();
+    /**
+     * After a successful SFCR parse: publish the model info, construct the raw
+     * {@code @circuit} lines, then attach scopes and z-order metadata.
+     */
+    void applyParsedSFCRModel(SFCRParser parser, String text) {
+        CircuitLoadPipeline pipeline = sim.getCircuitLoadPipeline();
+        CirSim.console("Loaded SFCR model with " + parser.getCreatedElements().size() + " elements");
+        sim.getSFCRDocumentManager().setModelInfoSourceText(text);
+        sim.getSFCRDocumentManager().setModelInfoContent(InfoViewerContentBuilder.buildModelInfoMarkdown(text, parser.getInfoContent()));
+        String editorContent = sim.getModelInfoEditorContent();
+        sim.getSFCRDocumentManager().refreshModelInfoMenuItems();
+
+        if (RuntimeMode.isGwt() && shouldAutoOpenModelInfo(editorContent)) {
+            sim.getInfoDialogActions().openModelInfoEditorInLeftPanel();
+            sim.getInfoDialogActions().doViewModelInfo();
+        }
 
-                if ((flags & CirSim.RC_NO_CENTER) == 0) {
-                    ViewportElm viewportElm = sim.getViewportController().findViewportElm();
-                    if (viewportElm != null) {
-                        sim.getViewportController().applyViewportTransform(viewportElm);
-                    } else {
-                        sim.getViewportController().centreCircuit();
-                    }
+        pipeline.beginStage(CircuitLoadPipeline.Stage.CONSTRUCT);
+        java.util.ArrayList<String> rawLines = parser.getRawCircuitLines();
+        if (!rawLines.isEmpty()) {
+            CirSim.console("Processing " + rawLines.size() + " raw circuit elements");
+            for (String line : rawLines) {
+                try {
+                    processCircuitLine(line);
+                } catch (Exception e) {
+                    CirSim.console("Error processing circuit line: " + line + " - " + e.getMessage());
                 }
-
-                sim.needAnalyze();
-            } else {
-                CirSim.console("Failed to parse SFCR model");
             }
-            if ((flags & CirSim.RC_KEEP_TITLE) == 0)
-                sim.clearCircuitTitle();
-            return;
         }
 
-        if (text != null && !text.trim().isEmpty()) {
-            sim.getSFCRDocumentManager().clearModelInfo();
-            String currentFile = sim.getSFCRDocumentManager().getCurrentCircuitFile();
-            CirSim.console("Parsing mode: Standard circuit format" + (currentFile != null ? " - " + currentFile : ""));
-        }
-        readCircuit(text.getBytes(), flags);
-        if ((flags & CirSim.RC_KEEP_TITLE) == 0)
-            sim.clearCircuitTitle();
+        if (RuntimeMode.isGwt())
+            parser.applyParsedScopes();
+
+        parser.applyParsedZOrders();
+        pipeline.endStage();
     }
 
     void readCircuit(String text) {
         readCircuit(text, 0);
     }
 
-    private void processCircuitLine(String line) {
+    void processCircuitLine(String line) {
         if (line == null || line.trim().isEmpty()) {
             return;
         }
@@ -428,238 +459,265 @@ final class CircuitIOService {
         return result + (result.indexOf('?') >= 0 ? "&" : "?") + "v=" + System.currentTimeMillis();
     }
 
-    private void readCircuit(byte b[], int flags) {
+    /** Reset simulator state ahead of loading a new (non-retained) circuit. */
+    void clearCircuitForLoad() {
         int i;
-        int len = b.length;
-        boolean transformLoaded = false;
-        if ((flags & CirSim.RC_RETAIN) == 0) {
-            StockFlowRegistry.clearRegistry();
-            ComputedValues.clearMasterTables();
-            ComputedValues.clearComputedValues();
-            EquationTableElm.resetGlobalTraceState(sim);
-            LookupTableRegistry.clear();
-            HintRegistry.clear();
-            ActionScheduler scheduler = ActionScheduler.getInstance(sim);
-            scheduler.clearAll();
-
-            sim.getMouseInputHandler().clearMouseElm();
-            for (i = 0; i != sim.elmList.size(); i++) {
-                CircuitElm ce = sim.getElm(i);
-                ce.delete();
-            }
-            sim.setTime(0);
-            sim.getTimingState().timeStepAccum = 0;
-            sim.elmList.removeAllElements();
-            sim.hintType = -1;
-            sim.setMaxTimeStep((sim.currentToolbarType == CirSim.ToolbarType.ECONOMICS) ? 0.01 : 5e-6);
-            sim.getTimingState().minTimeStep = 50e-12;
-            if (sim.dotsCheckItem != null)
-                sim.dotsCheckItem.setState(false);
-            if (sim.smallGridCheckItem != null)
-                sim.smallGridCheckItem.setState(false);
-            if (sim.powerCheckItem != null)
-                sim.powerCheckItem.setState(false);
-            if (sim.voltsCheckItem != null)
-                sim.voltsCheckItem.setState(true);
-            if (sim.showValuesCheckItem != null)
-                sim.showValuesCheckItem.setState(true);
-            sim.getPreferencesManager().setGrid();
-            sim.setDefaultControlBars();
-            CircuitElm.voltageRange = 5;
-            sim.scopeCount = 0;
-            sim.lastIterTime = 0;
-            sim.voltageUnitSymbol = (sim.currentToolbarType == CirSim.ToolbarType.ECONOMICS) ? "$" : "V";
-            sim.timeUnitSymbol = (sim.currentToolbarType == CirSim.ToolbarType.ECONOMICS) ? "yr" : "s";
+        StockFlowRegistry.clearRegistry();
+        ComputedValues.clearMasterTables();
+        ComputedValues.clearComputedValues();
+        EquationTableElm.resetGlobalTraceState(sim);
+        LookupTableRegistry.clear();
+        HintRegistry.clear();
+        ActionScheduler scheduler = ActionScheduler.getInstance(sim);
+        scheduler.clearAll();
+
+        sim.getMouseInputHandler().clearMouseElm();
+        for (i = 0; i != sim.elmList.size(); i++) {
+            CircuitElm ce = sim.getElm(i);
+            ce.delete();
         }
+        sim.setTime(0);
+        sim.getTimingState().timeStepAccum = 0;
+        sim.elmList.removeAllElements();
+        sim.hintType = -1;
+        sim.setMaxTimeStep((sim.currentToolbarType == CirSim.ToolbarType.ECONOMICS) ? 0.01 : 5e-6);
+        sim.getTimingState().minTimeStep = 50e-12;
+        if (sim.dotsCheckItem != null)
+            sim.dotsCheckItem.setState(false);
+        if (sim.smallGridCheckItem != null)
+            sim.smallGridCheckItem.setState(false);
+        if (sim.powerCheckItem != null)
+            sim.powerCheckItem.setState(false);
+        if (sim.voltsCheckItem != null)
+            sim.voltsCheckItem.setState(true);
+        if (sim.showValuesCheckItem != null)
+            sim.showValuesCheckItem.setState(true);
+        sim.getPreferencesManager().setGrid();
+        sim.setDefaultControlBars();
+        CircuitElm.voltageRange = 5;
+        sim.scopeCount = 0;
+        sim.lastIterTime = 0;
+        sim.voltageUnitSymbol = (sim.currentToolbarType == CirSim.ToolbarType.ECONOMICS) ? "$" : "V";
+        sim.timeUnitSymbol = (sim.currentToolbarType == CirSim.ToolbarType.ECONOMICS) ? "yr" : "s";
+    }
+
+    /**
+     * Undump one line of a text dump: an element, model, scope or setting.
+     * @return true if the line set the view transform
+     */
+    boolean undumpLine(String line, int flags) {
+        boolean transformLoaded = false;
         boolean subs = (flags & CirSim.RC_SUBCIRCUITS) != 0;
-        int p;
-        for (p = 0; p < len; ) {
-            int l;
-            int linelen = len-p;
-            for (l = 0; l != len-p; l++)
-                if (b[l+p] == '\n' || b[l+p] == '\r') {
-                    linelen = l++;
-                    if (l+p < b.length && b[l+p] == '\n')
-                        l++;
-                    break;
-                }
-            String line = new String(b, p, linelen);
-            StringTokenizer st = new StringTokenizer(line, " +\t\n\r\f");
-            while (st.hasMoreTokens()) {
-                String type = st.nextToken();
-                int tint = type.charAt(0);
-                try {
-                    if (subs && tint != '.')
-                        continue;
-	                    if (tint == 'o') {
-	                        if (RuntimeMode.isNonInteractiveRuntime()) {
-	                            break;
-	                        }
-	                        Scope sc = new Scope(sim);
-	                        sc.setPositionForEmbedded(sim.scopeCount);
-	                        sc.undump(st);
-	                        sim.scopes[sim.scopeCount++] = sc;
-                        break;
-                    }
-                    if (tint == 'h') {
-                        sim.readHint(st);
+        StringTokenizer st = new StringTokenizer(line, " +\t\n\r\f");
+        while (st.hasMoreTokens()) {
+            String type = st.nextToken();
+            int tint = type.charAt(0);
+            try {
+                if (subs && tint != '.')
+                    continue;
+                if (tint == 'o') {
+                    if (RuntimeMode.isNonInteractiveRuntime()) {
                         break;
                     }
-                    if (tint == '$') {
-                        sim.readOptions(st, flags);
-                        break;
-                    }
-                    if (tint == '!') {
-                        CustomLogicModel.undumpModel(st);
-                        break;
-                    }
-                    if (tint == '%') {
-                        if (st.hasMoreTokens()) {
-                            String settingType = st.nextToken();
-                            if (settingType.equals("voltageUnit") && st.hasMoreTokens()) {
-                                sim.voltageUnitSymbol = CustomLogicModel.unescape(st.nextToken());
-                            } else if (settingType.equals("viewport") && st.hasMoreTokens()) {
-                                try {
-                                    int viewMinX = Integer.parseInt(st.nextToken());
-                                    int viewMinY = Integer.parseInt(st.nextToken());
-                                    int viewMaxX = Integer.parseInt(st.nextToken());
-                                    int viewMaxY = Integer.parseInt(st.nextToken());
+                    Scope sc = new Scope(sim);
+                    sc.setPositionForEmbedded(sim.scopeCount);
+                    sc.undump(st);
+                    sim.scopes[sim.scopeCount++] = sc;
+                    break;
+                }
+                if (tint == 'h') {
+                    sim.readHint(st);
+                    break;
+                }
+                if (tint == '$') {
+                    sim.readOptions(st, flags);
+                    break;
+                }
+                if (tint == '!') {
+                    CustomLogicModel.undumpModel(st);
+                    break;
+                }
+                if (tint == '%') {
+                    if (st.hasMoreTokens()) {
+                        String settingType = st.nextToken();
+                        if (settingType.equals("voltageUnit") && st.hasMoreTokens()) {
+                            sim.voltageUnitSymbol = CustomLogicModel.unescape(st.nextToken());
+                        } else if (settingType.equals("viewport") && st.hasMoreTokens()) {
+                            try {
+                                int viewMinX = Integer.parseInt(st.nextToken());
+                                int viewMinY = Integer.parseInt(st.nextToken());
+                                int viewMaxX = Integer.parseInt(st.nextToken());
+                                int viewMaxY = Integer.parseInt(st.nextToken());
 
-                                    sim.getViewportController().setCircuitArea();
-                                    int viewWidth = viewMaxX - viewMinX;
-                                    int viewHeight = viewMaxY - viewMinY;
+                                sim.getViewportController().setCircuitArea();
+                                int viewWidth = viewMaxX - viewMinX;
+                                int viewHeight = viewMaxY - viewMinY;
 
-                                    if (viewWidth > 0 && viewHeight > 0) {
-                                        double scaleX = (double)sim.circuitArea.width / viewWidth;
-                                        double scaleY = (double)sim.circuitArea.height / viewHeight;
-                                        double scale = Math.min(scaleX, scaleY);
+                                if (viewWidth > 0 && viewHeight > 0) {
+                                    double scaleX = (double)sim.circuitArea.width / viewWidth;
+                                    double scaleY = (double)sim.circuitArea.height / viewHeight;
+                                    double scale = Math.min(scaleX, scaleY);
 
-                                        double translateX = (sim.circuitArea.width - viewWidth * scale) / 2 - viewMinX * scale;
-                                        double translateY = (sim.circuitArea.height - viewHeight * scale) / 2 - viewMinY * scale;
+                                    double translateX = (sim.circuitArea.width - viewWidth * scale) / 2 - viewMinX * scale;
+                                    double translateY = (sim.circuitArea.height - viewHeight * scale) / 2 - viewMinY * scale;
 
-                                        sim.getViewportController().setTransform(scale, translateX, translateY);
-                                        transformLoaded = true;
-                                    }
-                                } catch (Exception e) {
-                                }
-                            } else if (settingType.equals("transform") && st.hasMoreTokens()) {
-                                try {
-                                    double scale = Double.parseDouble(st.nextToken());
-                                    double translateX = Double.parseDouble(st.nextToken());
-                                    double translateY = Double.parseDouble(st.nextToken());
                                     sim.getViewportController().setTransform(scale, translateX, translateY);
                                     transformLoaded = true;
-                                } catch (Exception e) {
-                                }
-                            } else if (settingType.equals("showToolbar") && st.hasMoreTokens()) {
-                                String value = st.nextToken();
-                                if (sim.toolbarCheckItem != null) {
-                                    sim.toolbarCheckItem.setState(value.equals("true"));
-                                    sim.setToolbar();
-                                }
-                            } else if (settingType.equals("equationTableMnaMode") && st.hasMoreTokens()) {
-                                sim.setEquationTableMnaMode(st.nextToken().equals("true"));
-                            } else if (settingType.equals("equationTableNewtonJacobianEnabled") && st.hasMoreTokens()) {
-                                sim.equationTableNewtonJacobianEnabled = st.nextToken().equals("true");
-                            } else if (settingType.equals("equationTableBroydenJacobianEnabled") && st.hasMoreTokens()) {
-                                sim.equationTableBroydenJacobianEnabled = st.nextToken().equals("true");
-                            } else if (settingType.equals("equationTableConvergenceTolerance") && st.hasMoreTokens()) {
-                                try {
-                                    sim.setEquationTableConvergenceTolerance(Double.parseDouble(st.nextToken()));
-                                } catch (Exception e) {
-                                }
-                            } else if (settingType.equals("sfcrLookupClampDefault") && st.hasMoreTokens()) {
-                                sim.setSfcrLookupClampDefault(st.nextToken().equals("true"));
-                            } else if (settingType.equals("convergenceCheckThreshold") && st.hasMoreTokens()) {
-                                try {
-                                    sim.convergenceCheckThreshold = Integer.parseInt(st.nextToken());
-                                } catch (Exception e) {
                                 }
-                            } else if (settingType.equals("AS") || settingType.equals("AST")) {
-                                ActionScheduler scheduler = ActionScheduler.getInstance(sim);
-                                scheduler.load(line);
-                            } else if (settingType.equals("Hint")) {
-                                HintRegistry.parseHintLine(line);
-                            } else if (settingType.equals("lookup") && st.hasMoreTokens()) {
-                                LookupDefinition def = new LookupDefinition();
-                                def.name = st.nextToken();
-                                while (st.hasMoreTokens()) {
-                                    String tok = st.nextToken();
-                                    if (tok.startsWith("scope=")) {
-                                        def.scope = tok.substring(6).trim();
-                                    } else {
-                                        int comma = tok.indexOf(',');
-                                        if (comma > 0) {
-                                            try {
-                                                def.xs.add(Double.valueOf(Double.parseDouble(tok.substring(0, comma))));
-                                                def.ys.add(Double.valueOf(Double.parseDouble(tok.substring(comma + 1))));
-                                            } catch (Exception e) { }
-                                        }
+                            } catch (Exception e) {
+                            }
+                        } else if (settingType.equals("transform") && st.hasMoreTokens()) {
+                            try {
+                                double scale = Double.parseDouble(st.nextToken());
+                                double translateX = Double.parseDouble(st.nextToken());
+                                double translateY = Double.parseDouble(st.nextToken());
+                                sim.getViewportController().setTransform(scale, translateX, translateY);
+                                transformLoaded = true;
+                            } catch (Exception e) {
+                            }
+                        } else if (settingType.equals("showToolbar") && st.hasMoreTokens()) {
+                            String value = st.nextToken();
+                            if (sim.toolbarCheckItem != null) {
+                                sim.toolbarCheckItem.setState(value.equals("true"));
+                                sim.setToolbar();
+                            }
+                        } else if (settingType.equals("equationTableMnaMode") && st.hasMoreTokens()) {
+                            sim.setEquationTableMnaMode(st.nextToken().equals("true"));
+                        } else if (settingType.equals("equationTableNewtonJacobianEnabled") && st.hasMoreTokens()) {
+                            sim.equationTableNewtonJacobianEnabled = st.nextToken().equals("true");
+                        } else if (settingType.equals("equationTableBroydenJacobianEnabled") && st.hasMoreTokens()) {
+                            sim.equationTableBroydenJacobianEnabled = st.nextToken().equals("true");
+                        } else if (settingType.equals("equationTableAndersonAccelerationEnabled") && st.hasMoreTokens()) {
+                            sim.equationTableAndersonAccelerationEnabled = st.nextToken().equals("true");
+                        } else if (settingType.equals("equationTableConvergenceTolerance") && st.hasMoreTokens()) {
+                            try {
+                                sim.setEquationTableConvergenceTolerance(Double.parseDouble(st.nextToken()));
+                            } catch (Exception e) {
+                            }
+                        } else if (settingType.equals("sfcrLookupClampDefault") && st.hasMoreTokens()) {
+                            sim.setSfcrLookupClampDefault(st.nextToken().equals("true"));
+                        } else if (settingType.equals("convergenceCheckThreshold") && st.hasMoreTokens()) {
+                            try {
+                                sim.convergenceCheckThreshold = Integer.parseInt(st.nextToken());
+                            } catch (Exception e) {
+                            }
+                        } else if (settingType.equals("AS") || settingType.equals("AST")) {
+                            ActionScheduler scheduler = ActionScheduler.getInstance(sim);
+                            scheduler.load(line);
+                        } else if (settingType.equals("Hint")) {
+                            HintRegistry.parseHintLine(line);
+                        } else if (settingType.equals("lookup") && st.hasMoreTokens()) {
+                            LookupDefinition def = new LookupDefinition();
+                            def.name = st.nextToken();
+                            while (st.hasMoreTokens()) {
+                                String tok = st.nextToken();
+                                if (tok.startsWith("scope=")) {
+                                    def.scope = tok.substring(6).trim();
+                                } else {
+                                    int comma = tok.indexOf(',');
+                                    if (comma > 0) {
+                                        try {
+                                            def.xs.add(Double.valueOf(Double.parseDouble(tok.substring(0, comma))));
+                                            def.ys.add(Double.valueOf(Double.parseDouble(tok.substring(comma + 1))));
+                                        } catch (Exception e) { }
                                     }
                                 }
-                                if (def.name != null && !def.name.isEmpty() && def.xs.size() >= 2) {
-                                    LookupTableRegistry.register(def);
-                                }
+                            }
+                            if (def.name != null && !def.name.isEmpty() && def.xs.size() >= 2) {
+                                LookupTableRegistry.register(def);
                             }
                         }
-                        break;
-                    }
-                    if (tint == '?' || tint == 'B') {
-                        break;
                     }
+                    break;
+                }
+                if (tint == '?' || tint == 'B') {
+                    break;
+                }
 
-                    if (tint >= '0' && tint <= '9')
-                        tint = Integer.parseInt(type);
+                if (tint >= '0' && tint <= '9')
+                    tint = Integer.parseInt(type);
 
-                    if (tint == 34) {
-                        DiodeModel.undumpModel(st);
-                        break;
-                    }
-                    if (tint == 32) {
-                        TransistorModel.undumpModel(st);
-                        break;
-                    }
-                    if (tint == 38) {
-                        Adjustable adj = new Adjustable(st, sim);
-                        if (adj.elm != null)
-                            sim.adjustables.add(adj);
-                        break;
-                    }
-                    if (tint == '.') {
-                        CustomCompositeModel.undumpModel(st);
-                        break;
-                    }
-                    int x1 = Integer.parseInt(st.nextToken());
-                    int y1 = Integer.parseInt(st.nextToken());
-                    int x2 = Integer.parseInt(st.nextToken());
-                    int y2 = Integer.parseInt(st.nextToken());
-                    int f  = Integer.parseInt(st.nextToken());
-                    ImportExportHelper.ElementDumpParseResult parsed = sim.getImportExportHelper().parseElementTokensWithUid(st);
-                    CircuitElm newce = ElementFactoryFacade.createFromDumpType(tint, x1, y1, x2, y2, f, parsed.tokenizer);
-                    if (newce==null) {
-                        System.out.println("unrecognized dump type: " + type);
-                        break;
-                    }
-                    newce.setPoints();
-                    sim.getImportExportHelper().assignPersistentUid(newce, parsed.uid);
-                    if (parsed.zOrder != null)
-			sim.setElementZOrderForImportExport(newce, parsed.zOrder.intValue());
-                    sim.addElement(newce);
-                } catch (Exception ee) {
-                    ee.printStackTrace();
-                    CirSim.console("exception while undumping " + ee);
+                if (tint == 34) {
+                    DiodeModel.undumpModel(st);
+                    break;
+                }
+                if (tint == 32) {
+                    TransistorModel.undumpModel(st);
+                    break;
+                }
+                if (tint == 38) {
+                    Adjustable adj = new Adjustable(st, sim);
+                    if (adj.elm != null)
+                        sim.adjustables.add(adj);
                     break;
                 }
+                if (tint == '.') {
+                    CustomCompositeModel.undumpModel(st);
+                    break;
+                }
+                int x1 = Integer.parseInt(st.nextToken());
+                int y1 = Integer.parseInt(st.nextToken());
+                int x2 = Integer.parseInt(st.nextToken());
+                int y2 = Integer.parseInt(st.nextToken());
+                int f  = Integer.parseInt(st.nextToken());
+                ImportExportHelper.ElementDumpParseResult parsed = sim.getImportExportHelper().parseElementTokensWithUid(st);
+                CircuitElm newce = ElementFactoryFacade.createFromDumpType(tint, x1, y1, x2, y2, f, parsed.tokenizer);
+                if (newce==null) {
+                    System.out.println("unrecognized dump type: " + type);
+                    break;
+                }
+                newce.setPoints();
+                sim.getImportExportHelper().assignPersistentUid(newce, parsed.uid);
+                if (parsed.zOrder != null)
+                    sim.setElementZOrderForImportExport(newce, parsed.zOrder.intValue());
+                sim.addElement(newce);
+            } catch (Exception ee) {
+                ee.printStackTrace();
+                CirSim.console("exception while undumping " + ee);
                 break;
             }
-            p += l;
+            break;
+        }
+        return transformLoaded;
+    }
 
+    /** Split a raw dump into lines, treating CR, LF and CRLF as line terminators. */
+    static java.util.ArrayList<String> splitCircuitLines(byte b[]) {
+        java.util.ArrayList<String> lines = new java.util.ArrayList<String>();
+        int len = b.length;
+        int p;
+        for (p = 0; p < len; ) {
+            int l;
+            int linelen = len-p;
+            for (l = 0; l != len-p; l++)
+                if (b[l+p] == '\n' || b[l+p] == '\r') {
+                    linelen = l++;
+                    if (l+p < b.length && b[l+p] == '\n')
+                        l++;
+                    break;
+                }
+            lines.add(new String(b, p, linelen));
+            p += l;
         }
+        return lines;
+    }
+
+    /**
+     * Shared tail of every load: UI refresh, viewport, then the one-time
+     * register-names and sync-tables stages. Analysis and stamping follow
+     * from the pending analyzeFlag.
+     *
+     * @param dumpLoad true for text dumps, whose adjustables still need sliders and whose
+     *                 elements are reset here; SFCR loads are reset before parsing
+     */
+    void finishCircuitLoad(int flags, boolean transformLoaded, boolean dumpLoad) {
+        CircuitLoadPipeline pipeline = sim.getCircuitLoadPipeline();
+        int i;
         if (RuntimeMode.isGwt()) {
             sim.setPowerBarEnable();
             sim.enableItems();
         }
-        if ((flags & CirSim.RC_RETAIN) == 0) {
+        if ((flags & CirSim.RC_RETAIN) == 0 && dumpLoad) {
             if (RuntimeMode.isGwt()) {
                 for (i = 0; i < sim.adjustables.size(); i++) {
                     if (!sim.adjustables.get(i).createSlider(sim))
@@ -680,11 +738,18 @@ final class CircuitIOService {
         if ((flags & CirSim.RC_SUBCIRCUITS) != 0)
             sim.updateModels();
 
-        if ((flags & CirSim.RC_RETAIN) == 0) {
+        // Element reset() refreshes each table's name registries; the explicit
+        // pass below only does work for tables that were not reset (SFCR, retain).
+        pipeline.beginStage(CircuitLoadPipeline.Stage.REGISTER_NAMES);
+        if ((flags & CirSim.RC_RETAIN) == 0 && dumpLoad) {
             sim.resetAction();
         }
+        EquationTableElm.registerNamesForLoad(sim.elmList);
 
+        pipeline.beginStage(CircuitLoadPipeline.Stage.SYNC_TABLES);
         StockFlowRegistry.synchronizeAllTables();
+        pipeline.endStage();
+        pipeline.setElementCount(sim.elmList.size());
 
         AudioInputElm.clearCache();
         DataInputElm.clearCache();
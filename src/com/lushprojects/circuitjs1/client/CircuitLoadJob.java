@@ -0,0 +1,195 @@
+package com.lushprojects.circuitjs1.client;
+
+import java.util.ArrayList;
+
+import com.lushprojects.circuitjs1.client.io.SFCRParser;
+
+/**
+ * A circuit load split into resumable phases so a large import can be spread
+ * over several frames instead of blocking the page.
+ *
+ * PREPARE splits (dump) or normalizes and pre-scans (SFCR) the text, BUILD
+ * constructs elements a line or block at a time, and FINISH runs the shared
+ * load tail ({@link CircuitIOService#finishCircuitLoad}). {@link #step(double)}
+ * does as much as fits in a time budget; {@link #runToCompletion()} is the
+ * synchronous path used by {@link CircuitIOService#readCircuit(String, int)},
+ * so both paths build exactly the same circuit.
+ *
+ * Pipeline stage timings accumulate per slice, so they report work done
+ * rather than wall-clock time spent waiting between frames.
+ */
+final class CircuitLoadJob {
+
+    enum Phase {
+        PREPARE,
+        BUILD,
+        FINISH,
+        DONE
+    }
+
+    /** Dump lines built between clock checks. */
+    private static final int LINES_PER_CLOCK_CHECK = 16;
+
+    private final CircuitIOService io;
+    private final CirSim sim;
+    private final String text;
+    private final int flags;
+    private final boolean sfcr;
+
+    private Phase phase = Phase.PREPARE;
+    private SFCRParser parser;
+    private ArrayList<String> dumpLines;
+    private int dumpIndex;
+    private boolean transformLoaded;
+
+    CircuitLoadJob(CircuitIOService io, CirSim sim, String text, int flags) {
+        this.io = io;
+        this.sim = sim;
+        this.text = text;
+        this.flags = flags;
+        this.sfcr = SFCRParser.isSFCRFormat(text);
+    }
+
+    Phase getPhase() {
+        return phase;
+    }
+
+    boolean isDone() {
+        return phase == Phase.DONE;
+    }
+
+    /** Fraction of the load completed, 0..1. */
+    double getProgress() {
+        switch (phase) {
+        case PREPARE:
+            return 0;
+        case BUILD: {
+            int total = sfcr ? parser.getParseLineCount() : dumpLines.size();
+            int done = sfcr ? parser.getParseLineIndex() : dumpIndex;
+            return total == 0 ? .95 : .95 * done / total;
+        }
+        case FINISH:
+            return .95;
+        default:
+            return 1;
+        }
+    }
+
+    /** Run every remaining phase now. */
+    void runToCompletion() {
+        step(Double.POSITIVE_INFINITY);
+    }
+
+    /**
+     * Do up to budgetMs of work. PREPARE and FINISH are not divisible and run
+     * whole; BUILD yields between lines or blocks once the budget is spent.
+     * @return true while work remains
+     */
+    boolean step(double budgetMs) {
+        double deadline = System.currentTimeMillis() + budgetMs;
+        while (phase != Phase.DONE) {
+            switch (phase) {
+            case PREPARE:
+                prepare();
+                break;
+            case BUILD:
+                build(deadline);
+                break;
+            case FINISH:
+                finish();
+                break;
+            default:
+                break;
+            }
+            if (phase != Phase.DONE && System.currentTimeMillis() >= deadline)
+                break;
+        }
+        return phase != Phase.DONE;
+    }
+
+    private void prepare() {
+        if (text != null && !text.trim().isEmpty()) {
+            String preview = text.length() > 200 ? text.substring(0, 200) : text;
+            CirSim.console("readCircuit text preview: " + preview.replace("\n", "\\n"));
+            CirSim.console("isSFCRFormat result: " + sfcr);
+        }
+
+        CircuitLoadPipeline pipeline = sim.getCircuitLoadPipeline();
+        pipeline.beginLoad();
+
+        String currentFile = sim.getSFCRDocumentManager().getCurrentCircuitFile();
+        if (sfcr) {
+            CirSim.console("Parsing mode: SFCRParser (SFCR format detected)" + (currentFile != null ? " - " + currentFile : ""));
+            if ((flags & CirSim.RC_RETAIN) == 0) {
+                io.clearCircuitForLoad();
+                sim.resetAction();
+            }
+            pipeline.beginStage(CircuitLoadPipeline.Stage.PARSE);
+            parser = new SFCRParser(sim);
+            boolean begun = parser.beginParse(text);
+            pipeline.endStage();
+            phase = begun ? Phase.BUILD : Phase.FINISH;
+            return;
+        }
+
+        if (text != null && !text.trim().isEmpty()) {
+            sim.getSFCRDocumentManager().clearModelInfo();
+            CirSim.console("Parsing mode: Standard circuit format" + (currentFile != null ? " - " + currentFile : ""));
+        }
+        if ((flags & CirSim.RC_RETAIN) == 0)
+            io.clearCircuitForLoad();
+
+        pipeline.beginStage(CircuitLoadPipeline.Stage.PARSE);
+        dumpLines = CircuitIOService.splitCircuitLines(text.getBytes());
+        pipeline.endStage();
+        phase = Phase.BUILD;
+    }
+
+    private void build(double deadline) {
+        CircuitLoadPipeline pipeline = sim.getCircuitLoadPipeline();
+        if (sfcr) {
+            // SFCR blocks create their elements while parsing, as in SFCRParser.parse()
+            pipeline.beginStage(CircuitLoadPipeline.Stage.PARSE);
+            boolean more;
+            do {
+                more = parser.parseNextBlock();
+            } while (more && System.currentTimeMillis() < deadline);
+            pipeline.endStage();
+            if (!more)
+                phase = Phase.FINISH;
+            return;
+        }
+
+        pipeline.beginStage(CircuitLoadPipeline.Stage.CONSTRUCT);
+        int size = dumpLines.size();
+        while (dumpIndex < size) {
+            if (io.undumpLine(dumpLines.get(dumpIndex++), flags))
+                transformLoaded = true;
+            if (dumpIndex % LINES_PER_CLOCK_CHECK == 0 && System.currentTimeMillis() >= deadline)
+                break;
+        }
+        pipeline.endStage();
+        if (dumpIndex >= size)
+            phase = Phase.FINISH;
+    }
+
+    private void finish() {
+        phase = Phase.DONE;
+        if (sfcr) {
+            CircuitLoadPipeline pipeline = sim.getCircuitLoadPipeline();
+            pipeline.beginStage(CircuitLoadPipeline.Stage.PARSE);
+            boolean parsed = parser != null && parser.finishParse();
+            pipeline.endStage();
+            if (parsed) {
+                io.applyParsedSFCRModel(parser, text);
+                io.finishCircuitLoad(flags, false, false);
+            } else {
+                CirSim.console("Failed to parse SFCR model");
+            }
+        } else {
+            io.finishCircuitLoad(flags, transformLoaded, true);
+        }
+        if ((flags & CirSim.RC_KEEP_TITLE) == 0)
+            sim.clearCircuitTitle();
+    }
+}
@@ -0,0 +1,136 @@
+package com.lushprojects.circuitjs1.client;
+
+/**
+ * Stage bookkeeping for a circuit load.
+ *
+ * A load runs as an explicit sequence of stages:
+ * parse -> construct -> register names -> sync tables -> analyze -> stamp.
+ * The first four run inside a {@link CircuitLoadJob}, either synchronously from
+ * {@link CircuitIOService#readCircuit(String, int)} or spread over frames;
+ * analyze and stamp run later from {@link CircuitAnalyzer} when the simulation
+ * loop (or the headless runner) picks up the pending analysis. Each stage is
+ * timed so the cost of a large model load is visible per stage.
+ *
+ * Timings accumulate across repeated entries of the same stage (e.g. the
+ * preStampCircuit retry loop), and are reset by {@link #beginLoad()}.
+ */
+public final class CircuitLoadPipeline {
+
+    public enum Stage {
+        PARSE("parse"),
+        CONSTRUCT("construct"),
+        REGISTER_NAMES("registerNames"),
+        SYNC_TABLES("syncTables"),
+        ANALYZE("analyze"),
+        STAMP("stamp");
+
+        private final String label;
+
+        Stage(String label) {
+            this.label = label;
+        }
+
+        public String getLabel() {
+            return label;
+        }
+    }
+
+    private static final Stage[] STAGES = Stage.values();
+
+    private final double[] stageMillis = new double[STAGES.length];
+    private final boolean[] stageRan = new boolean[STAGES.length];
+    private boolean loadActive;
+    private boolean loadComplete;
+    private Stage currentStage;
+    private long currentStageStart;
+    private int elementCount;
+
+    CircuitLoadPipeline() {
+    }
+
+    /** Start timing a new load; clears timings from any previous load. */
+    void beginLoad() {
+        for (int i = 0; i < STAGES.length; i++) {
+            stageMillis[i] = 0;
+            stageRan[i] = false;
+        }
+        currentStage = null;
+        elementCount = 0;
+        loadActive = true;
+        loadComplete = false;
+    }
+
+    boolean isLoadActive() {
+        return loadActive;
+    }
+
+    /** True once every stage of the most recent load has run. */
+    public boolean isLoadComplete() {
+        return loadComplete;
+    }
+
+    void beginStage(Stage stage) {
+        if (!loadActive)
+            return;
+        if (currentStage != null)
+            endStage();
+        currentStage = stage;
+        currentStageStart = System.currentTimeMillis();
+    }
+
+    void endStage() {
+        if (!loadActive || currentStage == null)
+            return;
+        int idx = currentStage.ordinal();
+        stageMillis[idx] += System.currentTimeMillis() - currentStageStart;
+        stageRan[idx] = true;
+        currentStage = null;
+    }
+
+    void setElementCount(int count) {
+        elementCount = count;
+    }
+
+    /**
+     * Close the load after the stamp stage. Logs a one-line summary and
+     * stops collecting so later restamps (timestep changes) are not counted.
+     */
+    void finishLoad() {
+        if (!loadActive)
+            return;
+        endStage();
+        loadActive = false;
+        loadComplete = true;
+        CirSim.console(getTimingSummary());
+    }
+
+    public double getStageMillis(Stage stage) {
+        return stageMillis[stage.ordinal()];
+    }
+
+    public boolean hasStageRun(Stage stage) {
+        return stageRan[stage.ordinal()];
+    }
+
+    public double getTotalMillis() {
+        double total = 0;
+        for (int i = 0; i < STAGES.length; i++)
+            total += stageMillis[i];
+        return total;
+    }
+
+    public String getTimingSummary() {
+        StringBuilder sb = new StringBuilder("[load] ");
+        sb.append(elementCount).append(" elements");
+        for (int i = 0; i < STAGES.length; i++) {
+            sb.append(i == 0 ? ": " : ", ");
+            sb.append(STAGES[i].getLabel()).append('=');
+            if (stageRan[i])
+                sb.append((long) stageMillis[i]).append("ms");
+            else
+                sb.append('-');
+        }
+        sb.append(", total=").append((long) getTotalMillis()).append("ms");
+        return sb.toString();
+    }
+}
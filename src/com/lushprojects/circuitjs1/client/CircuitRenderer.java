@@ -50,7 +50,7 @@ class CircuitRenderer {
 
             g.setFont(CircuitElm.unitsFont);
 
-            g.context.setLineCap(LineCap.ROUND);
+            g.setLineCap(LineCap.ROUND);
 
             if (sim.noEditCheckItem.getState())
                 g.drawLock(20, 30);
@@ -143,6 +143,49 @@ class CircuitRenderer {
         return shouldDrawGraphics;
     }
 
+    /**
+     * Draw just the schematic (elements and posts, no UI chrome) into an
+     * offscreen Graphics such as the JVM image backend; the caller fills the
+     * background and sets the transform. Element draw() code must stick to
+     * the Graphics primitives, which the offscreen backend overrides.
+     */
+    void drawSchematicOffscreen(Graphics g) {
+        boolean printable = sim.isPrintableEnabledForExport();
+        CircuitElm.whiteColor = printable ? Color.black : Color.white;
+        CircuitElm.lightGrayColor = printable ? Color.black : Color.lightGray;
+        g.setFont(CircuitElm.unitsFont);
+        g.setLineCap(LineCap.ROUND);
+
+        ArrayList<CircuitElm> drawOrder = sim.getElementsInDrawOrder();
+        for (int i = 0; i != drawOrder.size(); i++) {
+            CircuitElm ce = drawOrder.get(i);
+            g.save();
+            ce.draw(g);
+            g.restore();
+        }
+        for (int i = 0; i != sim.postDrawList.size(); i++)
+            CircuitElm.drawPost(g, sim.postDrawList.get(i));
+    }
+
+    /** Frame shown while an incremental load is still building the circuit. */
+    void drawLoadProgress(double progress) {
+        Graphics g = new Graphics(sim.cvcontext);
+        boolean printable = sim.printableCheckItem.getState();
+        g.setColor(printable ? new Color(245, 245, 245) : Color.black);
+        g.fillRect(0, 0, sim.canvasWidth, sim.canvasHeight);
+
+        int barWidth = Math.min(300, sim.canvasWidth / 2);
+        int barHeight = 8;
+        int x = (sim.canvasWidth - barWidth) / 2;
+        int y = sim.canvasHeight / 2;
+        Color fg = printable ? Color.black : Color.white;
+        g.setColor(fg);
+        g.setFont(CircuitElm.unitsFont);
+        g.drawString(Locale.LS("Loading...") + " " + (int) Math.round(progress * 100) + "%", x, y - 8);
+        g.drawRect(x, y, barWidth, barHeight);
+        g.fillRect(x, y, (int) Math.round(barWidth * Math.max(0, Math.min(1, progress))), barHeight);
+    }
+
     void drawStatus(Graphics g, boolean shouldDrawGraphics, PerfMonitor perfmon, double iterCount) {
         g.setColor(CircuitElm.whiteColor);
         int height = 15;
@@ -177,6 +220,8 @@ class CircuitRenderer {
             g.drawString("Steprate: " + CircuitElm.showFormat.format(sim.steprate), 10, height += increment);
             g.drawString("Steprate/iter: " + CircuitElm.showFormat.format(sim.steprate / iterCount), 10, height += increment);
             g.drawString("iterc: " + CircuitElm.showFormat.format(iterCount), 10, height += increment);
+            if (sim.equationTableAndersonAccelerationEnabled)
+                g.drawString("accel: " + CircuitElm.showFormat.format(sim.getSimulationLoop().getSubiterationAccelerator().getAccelerationFactor()) + "x", 10, height += increment);
 
             g.drawString("Frames: " + sim.frames, 10, height += increment);
 
@@ -76,6 +76,7 @@ final class CircuitValueSlotManager {
         // Build per-slot resolution strategy to avoid repeated HashMap probes at runtime
         buildSlotResolutionStrategies(slot);
 
+        sim.getVariableCatalog().invalidateElements();
         sim.getVariableHistoryStore().refreshTrackedVariableNames(sim);
 
         syncAllSlots();
@@ -255,8 +256,7 @@ final class CircuitValueSlotManager {
             EditInfo ei = adj.elm.getEditInfo(adj.editItem);
             if (ei != null) {
                 ei.value = value;
-                adj.elm.setEditValue(adj.editItem, ei);
-                sim.analyzeFlag = true;
+                sim.getCircuitAnalyzer().applyParameterEdit(adj.elm, adj.editItem, ei);
             sim.getUiPanelManager().refreshModelInfoEditorAfterCircuitMutation();
 
                 if (adj.label != null) {
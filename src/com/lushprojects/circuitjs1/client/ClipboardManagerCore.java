@@ -3,6 +3,7 @@ package com.lushprojects.circuitjs1.client;
 import com.lushprojects.circuitjs1.client.util.*;
 
 import com.google.gwt.storage.client.Storage;
+import com.lushprojects.circuitjs1.client.io.CompactCircuitCodec;
 import com.lushprojects.circuitjs1.client.elements.electronics.DiodeModel;
 import com.lushprojects.circuitjs1.client.elements.electronics.TransistorModel;
 import com.lushprojects.circuitjs1.client.elements.misc.ScopeElm;
@@ -51,14 +52,23 @@ public class ClipboardManagerCore {
 		Storage stor = Storage.getLocalStorageIfSupported();
 		if (stor == null)
 			return;
-		stor.setItem("circuitClipboard", sim.clipboard);
+		String value = sim.clipboard;
+		if (sim.compactInternalDumps && value != null && value.length() > 0)
+			value = CompactCircuitCodec.encodeForStorage(value);
+		stor.setItem("circuitClipboard", value);
 	}
 
 	private void readClipboardFromStorage() {
 		Storage stor = Storage.getLocalStorageIfSupported();
 		if (stor == null)
 			return;
-		sim.clipboard = stor.getItem("circuitClipboard");
+		String value = stor.getItem("circuitClipboard");
+		try {
+			sim.clipboard = CompactCircuitCodec.decodeFromStorage(value);
+		} catch (IllegalArgumentException e) {
+			CirSim.console("Ignoring unreadable stored clipboard: " + e.getMessage());
+			sim.clipboard = null;
+		}
 	}
 
 	public void doDelete(boolean pushUndoFlag) {
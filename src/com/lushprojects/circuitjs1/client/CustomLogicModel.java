@@ -29,6 +29,7 @@ public class CustomLogicModel implements Editable {
     public Vector<String> rulesLeft, rulesRight;
     public boolean dumped;
     public boolean triState;
+    private CustomLogicRuleTable ruleTable;
     
     public static CustomLogicModel getModelWithName(String name) {
 	if (modelMap == null)
@@ -72,6 +73,7 @@ public class CustomLogicModel implements Editable {
 	rulesLeft = new Vector<String>();
 	rulesRight = new Vector<String>();
 	rules = "";
+	ruleTable = CustomLogicRuleTable.compile(rulesLeft, rulesRight);
     }
     
     private CustomLogicModel(CustomLogicModel copy) {
@@ -82,6 +84,7 @@ public class CustomLogicModel implements Editable {
 	rules = copy.rules;
 	rulesLeft = copy.rulesLeft;
 	rulesRight = copy.rulesRight;
+	ruleTable = copy.ruleTable;
     }
     
     static void undumpModel(StringTokenizer st) {
@@ -169,7 +172,17 @@ public class CustomLogicModel implements Editable {
 	CirSim.getInstance().updateModels();
     }
 
+    /** Rules compiled to bitmasks, or null if they need the string interpreter. */
+    public CustomLogicRuleTable getRuleTable() {
+	return ruleTable;
+    }
+
     private void parseRules() {
+	parseRuleLines();
+	ruleTable = CustomLogicRuleTable.compile(rulesLeft, rulesRight);
+    }
+
+    private void parseRuleLines() {
 	String lines[] = rules.split("\n");
 	int i;
 	rulesLeft = new Vector<String>();
@@ -0,0 +1,200 @@
+package com.lushprojects.circuitjs1.client;
+
+import java.util.Vector;
+
+/**
+ * Custom logic rules compiled to bitmasks over the packed pin word
+ * (bit i = value of pin i: inputs first, then outputs).
+ *
+ * Each rule becomes a care/value mask for its 0/1 positions, rise and fall
+ * masks for +/- transitions, one mask per repeated pattern letter (all
+ * occurrences must agree), and output masks for the right side. Matching is
+ * then a few integer operations per rule instead of a character walk.
+ * When no rule uses transitions and the rules span few pins, the first
+ * matching rule for every possible pin word is precomputed into a lookup
+ * table, so matching is a single array read.
+ *
+ * {@link #compile} returns null for rule sets that cannot be expressed this
+ * way (more than 31 pins, or a right-side letter not bound on the left);
+ * {@link com.lushprojects.circuitjs1.client.elements.electronics.digital.CustomLogicElm}
+ * then interprets the rule strings as before.
+ */
+public final class CustomLogicRuleTable {
+
+    /** Rules spanning at most this many pins get a direct lookup table. */
+    static final int MAX_LOOKUP_BITS = 10;
+    private static final int MAX_PINS = 31;
+
+    private final int ruleCount;
+    private final int care[];
+    private final int value[];
+    private final int rise[];
+    private final int fall[];
+    private final int letterMasks[][];
+    private final int outputSet[];
+    private final int outputHighZ[];
+    private final int outputCount[];
+    private final int copyOutput[][];
+    private final int copySource[][];
+    private int pinSpan;
+    private int lookup[];
+
+    private CustomLogicRuleTable(int n) {
+        ruleCount = n;
+        care = new int[n];
+        value = new int[n];
+        rise = new int[n];
+        fall = new int[n];
+        letterMasks = new int[n][];
+        outputSet = new int[n];
+        outputHighZ = new int[n];
+        outputCount = new int[n];
+        copyOutput = new int[n][];
+        copySource = new int[n][];
+    }
+
+    /**
+     * Compile parsed rules (see CustomLogicModel.parseRules: repeated letters
+     * are upper-cased after their first occurrence).
+     * @return the compiled table, or null if the rules need the interpreter
+     */
+    public static CustomLogicRuleTable compile(Vector<String> rulesLeft, Vector<String> rulesRight) {
+        int n = Math.min(rulesLeft.size(), rulesRight.size());
+        CustomLogicRuleTable t = new CustomLogicRuleTable(n);
+        boolean edges = false;
+        for (int r = 0; r != n; r++) {
+            String rl = rulesLeft.get(r);
+            String rr = rulesRight.get(r);
+            if (rl.length() > MAX_PINS || rr.length() > MAX_PINS)
+                return null;
+            t.pinSpan = Math.max(t.pinSpan, rl.length());
+
+            int letters[] = new int[26];
+            int firstPos[] = new int[26];
+            for (int j = 0; j != rl.length(); j++) {
+                char x = rl.charAt(j);
+                int bit = 1 << j;
+                if (x == '0' || x == '1') {
+                    t.care[r] |= bit;
+                    if (x == '1')
+                        t.value[r] |= bit;
+                } else if (x == '+') {
+                    t.rise[r] |= bit;
+                    edges = true;
+                } else if (x == '-') {
+                    t.fall[r] |= bit;
+                    edges = true;
+                } else if (x >= 'a' && x <= 'z') {
+                    if (letters[x - 'a'] == 0)
+                        firstPos[x - 'a'] = j;
+                    letters[x - 'a'] |= bit;
+                } else if (x >= 'A' && x <= 'Z') {
+                    letters[x - 'A'] |= bit;
+                }
+            }
+            int repeated = 0;
+            for (int k = 0; k != 26; k++)
+                if (Integer.bitCount(letters[k]) > 1)
+                    repeated++;
+            t.letterMasks[r] = new int[repeated];
+            repeated = 0;
+            for (int k = 0; k != 26; k++)
+                if (Integer.bitCount(letters[k]) > 1)
+                    t.letterMasks[r][repeated++] = letters[k];
+
+            int copies = 0;
+            for (int j = 0; j != rr.length(); j++) {
+                char x = rr.charAt(j);
+                if (x >= 'a' && x <= 'z') {
+                    if (letters[x - 'a'] == 0)
+                        return null;
+                    copies++;
+                }
+            }
+            t.outputCount[r] = rr.length();
+            t.copyOutput[r] = new int[copies];
+            t.copySource[r] = new int[copies];
+            copies = 0;
+            for (int j = 0; j != rr.length(); j++) {
+                char x = rr.charAt(j);
+                if (x >= 'a' && x <= 'z') {
+                    t.copyOutput[r][copies] = j;
+                    t.copySource[r][copies++] = firstPos[x - 'a'];
+                } else if (x == '_') {
+                    t.outputHighZ[r] |= 1 << j;
+                } else if (x == '1') {
+                    t.outputSet[r] |= 1 << j;
+                }
+            }
+        }
+        if (!edges && t.pinSpan <= MAX_LOOKUP_BITS) {
+            int size = 1 << t.pinSpan;
+            int table[] = new int[size];
+            for (int w = 0; w != size; w++)
+                table[w] = t.scan(w, 0);
+            t.lookup = table;
+        }
+        return t;
+    }
+
+    /** Number of pins the rules look at; callers need at least this many. */
+    public int getPinSpan() {
+        return pinSpan;
+    }
+
+    boolean hasLookupTable() {
+        return lookup != null;
+    }
+
+    /**
+     * Index of the first rule matching the current and previous pin words,
+     * or -1 if none matches.
+     */
+    public int match(int word, int lastWord) {
+        if (lookup != null)
+            return lookup[word & (lookup.length - 1)];
+        return scan(word, lastWord);
+    }
+
+    private int scan(int word, int lastWord) {
+        int rising = word & ~lastWord;
+        int falling = ~word & lastWord;
+        for (int r = 0; r != ruleCount; r++) {
+            if (((word ^ value[r]) & care[r]) != 0)
+                continue;
+            if ((rise[r] & ~rising) != 0 || (fall[r] & ~falling) != 0)
+                continue;
+            int masks[] = letterMasks[r];
+            int k;
+            for (k = 0; k != masks.length; k++) {
+                int w = word & masks[k];
+                if (w != 0 && w != masks[k])
+                    break;
+            }
+            if (k == masks.length)
+                return r;
+        }
+        return -1;
+    }
+
+    /** Number of outputs the rule assigns (its right-side length). */
+    public int getOutputCount(int rule) {
+        return outputCount[rule];
+    }
+
+    /** Output values of a matched rule, bit j = output j. */
+    public int getOutputBits(int rule, int word) {
+        int out = outputSet[rule];
+        int dst[] = copyOutput[rule];
+        int src[] = copySource[rule];
+        for (int k = 0; k != dst.length; k++)
+            if ((word & (1 << src[k])) != 0)
+                out |= 1 << dst[k];
+        return out;
+    }
+
+    /** Outputs the matched rule puts in high impedance, bit j = output j. */
+    public int getHighImpedanceMask(int rule) {
+        return outputHighZ[rule];
+    }
+}
@@ -49,6 +49,9 @@ final class RunnerController {
         String ctz = normalizeOptionalQueryValue(qp.getValue("ctz"));
         if (ctz != null)
             startCircuitText = sim.decompress(ctz);
+        String cjb = normalizeOptionalQueryValue(qp.getValue("cjb"));
+        if (cjb != null)
+            startCircuitText = sim.decodeCompactUrlDump(cjb);
         String nonInteractiveDumpKey = normalizeOptionalQueryValue(qp.getValue("nonInteractiveDumpKey"));
         if (startCircuitText == null && nonInteractiveDumpKey != null) {
             startCircuitText = sim.getCircuitIOService().getRunnerDumpFromStorage(nonInteractiveDumpKey);
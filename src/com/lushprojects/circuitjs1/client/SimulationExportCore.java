@@ -14,12 +14,18 @@ public final class SimulationExportCore {
         void log(String message);
     }
 
+    /** Called after each completed step, e.g. to write images at chosen times. */
+    public interface StepObserver {
+        void stepFinished(int step, double time);
+    }
+
     public static final class RunRequest {
         public String circuitPath; 
         public String outputPath;
         public String htmlPath;
         public int steps;
         public String format;
+        public StepObserver stepObserver;
     }
 
     public static final class RunResult {
@@ -46,6 +52,7 @@ public final class SimulationExportCore {
         int convergenceCheckThreshold;
         boolean eqnTableNewtonJacobian;
         boolean eqnTableBroydenJacobian;
+        boolean eqnTableAndersonAcceleration;
         boolean autoAdjustTimestep;
         double minTimeStep;
         double maxTimeStep;
@@ -95,6 +102,7 @@ public final class SimulationExportCore {
         {"convergenceCheckThreshold", "convergenceCheckThreshold"},
         {"EqnTable Newton Jacobian", "eqnTableNewtonJacobian"},
         {"EqnTable Broyden Jacobian", "eqnTableBroydenJacobian"},
+        {"EqnTable Anderson Acceleration", "eqnTableAndersonAcceleration"},
         {"Auto-Adjust Timestep", "autoAdjustTimestep"},
         {"minTimeStep", "minTimeStep"},
         {"maxTimeStep", "maxTimeStep"},
@@ -130,6 +138,8 @@ public final class SimulationExportCore {
 
         boolean warnedNoTimeAdvance = false;
         int rowsWritten = 0;
+        SubiterationAccelerator accelerator = sim.getSimulationLoop().getSubiterationAccelerator();
+        accelerator.resetStatistics();
         for (int step = 0; step < request.steps; step++) {
             double prevT = sim.getTime();
             sim.getSimulationLoop().runCircuit(step == 0);
@@ -156,11 +166,19 @@ public final class SimulationExportCore {
             }
             rowsWritten++;
 
+            if (request.stepObserver != null) {
+                request.stepObserver.stepFinished(step, sim.getTime());
+            }
+
             if (sim.stopMessage != null) {
                 break;
             }
         }
 
+        if (runParameters.eqnTableAndersonAcceleration) {
+            log(diagnostics, "CircuitJavaRunner: " + accelerator.getReport());
+        }
+
         RunResult result = new RunResult();
         result.world2Format = world2Format;
         result.outputText = output.toString();
@@ -326,6 +344,7 @@ public final class SimulationExportCore {
         parameters.convergenceCheckThreshold = sim.convergenceCheckThreshold;
         parameters.eqnTableNewtonJacobian = sim.equationTableNewtonJacobianEnabled;
         parameters.eqnTableBroydenJacobian = sim.equationTableBroydenJacobianEnabled;
+        parameters.eqnTableAndersonAcceleration = sim.equationTableAndersonAccelerationEnabled;
         parameters.autoAdjustTimestep = sim.adjustTimeStep;
         parameters.minTimeStep = sim.getTimingState().minTimeStep;
         parameters.maxTimeStep = sim.getMaxTimeStep();
@@ -356,6 +375,7 @@ public final class SimulationExportCore {
             case "convergenceCheckThreshold": return Integer.toString(p.convergenceCheckThreshold);
             case "eqnTableNewtonJacobian": return Boolean.toString(p.eqnTableNewtonJacobian);
             case "eqnTableBroydenJacobian": return Boolean.toString(p.eqnTableBroydenJacobian);
+            case "eqnTableAndersonAcceleration": return Boolean.toString(p.eqnTableAndersonAcceleration);
             case "autoAdjustTimestep": return Boolean.toString(p.autoAdjustTimestep);
             case "minTimeStep": return fmtParamNumber(p.minTimeStep);
             case "maxTimeStep": return fmtParamNumber(p.maxTimeStep);
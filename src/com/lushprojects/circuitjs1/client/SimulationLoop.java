@@ -19,8 +19,12 @@ import com.lushprojects.circuitjs1.client.runner.RuntimeMode;
 import com.lushprojects.circuitjs1.client.util.PerfMonitor;
 
 class SimulationLoop {
+    // solver events printed from the SolverLog ring buffer when convergence fails
+    private static final int RECENT_EVENTS_ON_FAILURE = 16;
+
     private final CirSim sim;
     private final CircuitRenderer circuitRenderer;
+    private final SubiterationAccelerator subiterationAccelerator = new SubiterationAccelerator();
 
     SimulationLoop(CirSim sim) {
         this.sim = sim;
@@ -33,6 +37,15 @@ class SimulationLoop {
 
         sim.getViewportController().checkCanvasSize();
 
+        // A time-sliced load owns the circuit until it finishes; don't analyze
+        // or simulate a half-built element list.
+        CircuitLoadJob loadJob = sim.getCircuitIOService().getActiveLoadJob();
+        if (loadJob != null) {
+            circuitRenderer.drawLoadProgress(loadJob.getProgress());
+            perfmon.stopContext();
+            return;
+        }
+
         boolean didAnalyze = sim.analyzeFlag;
         if (sim.analyzeFlag || sim.dcAnalysisFlag) {
             perfmon.startContext("analyzeCircuit()");
@@ -62,7 +75,7 @@ class SimulationLoop {
 
         if (sim.simRunning) {
             if (sim.needsStamp)
-                CirSim.console("needsStamp while simRunning?");
+                SolverLog.log(SolverLog.WARN, "needsStamp while simRunning?");
 
             perfmon.startContext("runCircuit()");
             try {
@@ -122,6 +135,10 @@ class SimulationLoop {
         return .1 * Math.exp((val - 61) / 24.);
     }
 
+    SubiterationAccelerator getSubiterationAccelerator() {
+        return subiterationAccelerator;
+    }
+
     private boolean canDelayWireProcessing() {
         int i;
         for (i = 0; i != sim.scopeCount; i++)
@@ -175,7 +192,8 @@ class SimulationLoop {
 
             if (goodIterations >= 3 && timingState.timeStep < timingState.maxTimeStep) {
                 timingState.timeStep = Math.min(timingState.timeStep * 2, timingState.maxTimeStep);
-                CirSim.console("timestep up = " + timingState.timeStep + " at " + timingState.t);
+                if (SolverLog.DEBUG_ENABLED)
+                    SolverLog.log(SolverLog.DEBUG, "timestep up = {} at {}", timingState.timeStep, timingState.t);
                 sim.stampCircuit();
                 goodIterations = 0;
             }
@@ -186,10 +204,16 @@ class SimulationLoop {
 
             ComputedValues.clearPendingValues();
             Expr.clearUnresolvedReferences();
+            Expr.beginTimestep();
 
             sim.steps++;
 
             int subiterCount = (sim.adjustTimeStep && timingState.timeStep / 2 > timingState.minTimeStep) ? 100 : 200;
+            // t=0 is skipped: initial-value rows follow their own subiteration protocol there
+            boolean accelerate = sim.equationTableAndersonAccelerationEnabled && !sim.isEquationTableMnaMode()
+                    && timingState.t > 0;
+            if (accelerate)
+                subiterationAccelerator.beginTimestep();
             for (subiter = 0; subiter != subiterCount; subiter++) {
                 sim.setConverged(true);
                 sim.subIterations = subiter;
@@ -198,10 +222,8 @@ class SimulationLoop {
                 com.lushprojects.circuitjs1.client.core.SolverMatrixState sms = sim.getSolverMatrixState();
                 int matSize = sms.circuitMatrixSize;
                 System.arraycopy(sms.origRightSide, 0, sms.circuitRightSide, 0, matSize);
-                if (sms.circuitNonLinear) {
-                    for (i = 0; i != matSize; i++)
-                        System.arraycopy(sms.origMatrix[i], 0, sms.circuitMatrix[i], 0, matSize);
-                }
+                if (sms.circuitNonLinear)
+                    sms.restoreMatrixFromOrig();
 
                 ComputedValues.resetComputedFlags();
 
@@ -211,14 +233,15 @@ class SimulationLoop {
 
                     if (preConverged && !sim.isConverged() && subiter > sim.convergenceCheckThreshold) {
                         sim.elmArr[i].nonConverged = true;
-                        if (!(sim.elmArr[i] instanceof EquationTableElm)) {
-                            CirSim.console("CirSim: t=" + timingState.t + " dt=" + timingState.timeStep + " Element causing convergence failure: " +
-                                          sim.elmArr[i].getClass().getSimpleName() + " at (" +
-                                          sim.elmArr[i].x + "," + sim.elmArr[i].y + ")");
+                        if (SolverLog.DEBUG_ENABLED && !(sim.elmArr[i] instanceof EquationTableElm)) {
+                            SolverLog.log(SolverLog.DEBUG, "t={} dt={} Element causing convergence failure: {@}",
+                                    sim.elmArr[i], timingState.t, timingState.timeStep);
                         }
                     }
                 }
 
+                if (accelerate)
+                    subiterationAccelerator.afterSubiteration(sim);
                 ComputedValues.commitPendingToCurrentValues();
 
                 if (sim.stopMessage != null)
@@ -231,7 +254,7 @@ class SimulationLoop {
                             double x = sim.getSolverMatrixState().circuitMatrix[i][j];
                             if (Double.isNaN(x) || Double.isInfinite(x)) {
                                 sim.stop("nan/infinite matrix!", null);
-                                CirSim.console("circuitMatrix " + i + " " + j + " is " + x);
+                                SolverLog.log(SolverLog.ERROR, "circuitMatrix {} {} is {}", i, j, x);
                                 return;
                             }
                         }
@@ -250,21 +273,20 @@ class SimulationLoop {
                 if (sim.getSolverMatrixState().circuitNonLinear) {
                     if (sim.isConverged() && subiter > 0)
                         break;
-                    int badRow = CircuitMatrixOps.luFactor(sim.getSolverMatrixState().circuitMatrix, sim.getSolverMatrixState().circuitMatrixSize, sim.getSolverMatrixState().circuitPermute);
+                    int badRow = CircuitMatrixOps.luFactor(sim.getSolverMatrixState());
                     if (badRow >= 0) {
                         sim.stop("Singular matrix! " + sim.getMatrixStamper().getMatrixRowInfo(badRow), null);
                         return;
                     }
                 }
-                CircuitMatrixOps.luSolve(sim.getSolverMatrixState().circuitMatrix, sim.getSolverMatrixState().circuitMatrixSize, sim.getSolverMatrixState().circuitPermute,
-                        sim.getSolverMatrixState().circuitRightSide);
+                CircuitMatrixOps.luSolve(sim.getSolverMatrixState(), sim.getSolverMatrixState().circuitRightSide);
                 applySolvedRightSide(sim.getSolverMatrixState().circuitRightSide);
                 // syncAllSlots() is already called inside applySolvedRightSide() after
                 // setNodeVoltages(). No need to call it again here — the slots are
                 // already aligned with the latest solved node voltages.
                 if (!sim.getSolverMatrixState().circuitNonLinear) {
-                    if (sim.getSolverMatrixState().circuitMatrixSize == 1) {
-                        CirSim.console("[runCircuit] circuitNonLinear=false, exiting after first iteration");
+                    if (SolverLog.DEBUG_ENABLED && sim.getSolverMatrixState().circuitMatrixSize == 1) {
+                        SolverLog.log(SolverLog.DEBUG, "[runCircuit] circuitNonLinear=false, exiting after first iteration");
                     }
                     break;
                 }
@@ -273,10 +295,11 @@ class SimulationLoop {
                 goodIterations = 0;
                 if (sim.adjustTimeStep) {
                     timingState.timeStep /= 2;
-                    CirSim.console("timestep down to " + timingState.timeStep + " at " + timingState.t);
+                    SolverLog.log(SolverLog.INFO, "timestep down to {} at {}", timingState.timeStep, timingState.t);
                 }
                 if (timingState.timeStep < timingState.minTimeStep || !sim.adjustTimeStep) {
-                    CirSim.console("convergence failed after " + subiter + " iterations");
+                    SolverLog.log(SolverLog.WARN, "convergence failed after {} iterations at t={}", subiter, timingState.t);
+                    SolverLog.dumpRecentEvents(RECENT_EVENTS_ON_FAILURE);
                     sim.stop("Convergence failed!", null);
                     break;
                 }
@@ -284,8 +307,10 @@ class SimulationLoop {
                 sim.stampCircuit();
                 continue;
             }
-            if (subiter > 20 || timingState.timeStep < timingState.maxTimeStep)
-                CirSim.console("converged after " + subiter + " iterations, timeStep = " + timingState.timeStep);
+            if (accelerate)
+                subiterationAccelerator.endTimestep(subiter);
+            if (SolverLog.DEBUG_ENABLED && (subiter > 20 || timingState.timeStep < timingState.maxTimeStep))
+                SolverLog.log(SolverLog.DEBUG, "converged after {} iterations, timeStep = {}", subiter, timingState.timeStep);
             if (subiter < 3)
                 goodIterations++;
             else
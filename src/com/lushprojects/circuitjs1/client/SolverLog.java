@@ -0,0 +1,233 @@
+package com.lushprojects.circuitjs1.client;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Leveled solver diagnostics with a ring buffer of recent events.
+ *
+ * Call sites pass a constant message template and primitive arguments, so
+ * nothing is formatted unless the event actually reaches the console or the
+ * buffer is read back. Placeholders: {@code {}} takes the next numeric
+ * argument, {@code {@}} the element/object argument. A {@link Source}
+ * argument describes itself (and the part given with it, e.g. a row index)
+ * only at that point, so hot paths can log without building strings.
+ *
+ * Every event at or above the record level (DEBUG by default) is kept in a
+ * fixed-size ring buffer, which only costs a few array stores, so the last
+ * solver events before a failure can still be retrieved with
+ * {@link #getRecentEvents} when console output is quiet.
+ *
+ * DEBUG call sites are written as {@code if (SolverLog.DEBUG_ENABLED) ...};
+ * setting the constant to false removes them from the build entirely.
+ */
+public final class SolverLog {
+    public static final int DEBUG = 0;
+    public static final int INFO = 1;
+    public static final int WARN = 2;
+    public static final int ERROR = 3;
+    public static final int OFF = 4;
+
+    /** Compile-time switch for DEBUG call sites. */
+    public static final boolean DEBUG_ENABLED = false;
+
+    public static final int CAPACITY = 256;
+    private static final int MAX_ARGS = 6;
+    private static final String LEVEL_NAMES[] = { "DEBUG", "INFO", "WARN", "ERROR", "OFF" };
+
+    private static int consoleLevel = INFO;
+    private static int recordLevel = DEBUG;
+
+    private static final int levels[] = new int[CAPACITY];
+    private static final String templates[] = new String[CAPACITY];
+    private static final Object refs[] = new Object[CAPACITY];
+    private static final int parts[] = new int[CAPACITY];
+    private static final double args[] = new double[CAPACITY * MAX_ARGS];
+    private static int head;
+    private static int count;
+
+    /** An event argument that is only described when the event is formatted. */
+    public interface Source {
+        /** Append a description of this object, or of one of its parts (e.g. a row). */
+        void appendLogDescription(StringBuilder sb, int part);
+    }
+
+    private SolverLog() {
+    }
+
+    public static int getConsoleLevel() {
+        return consoleLevel;
+    }
+
+    /** Minimum level printed through {@link CirSim#console}; default INFO. */
+    public static void setConsoleLevel(int level) {
+        consoleLevel = level;
+    }
+
+    /** Minimum level kept in the ring buffer; default DEBUG. */
+    public static void setRecordLevel(int level) {
+        recordLevel = level;
+    }
+
+    /**
+     * True if an event at this level would be printed or recorded. With the
+     * default record level this holds for every level, so guard only work that
+     * allocates; log calls themselves are cheap.
+     */
+    public static boolean isLoggable(int level) {
+        return level < OFF && (level >= consoleLevel || level >= recordLevel);
+    }
+
+    /** Parse a level name ("debug", "info", "warn", "error", "off"); returns fallback if unknown. */
+    public static int parseLevel(String name, int fallback) {
+        if (name == null) {
+            return fallback;
+        }
+        String n = name.trim().toUpperCase();
+        if (n.equals("WARNING")) {
+            return WARN;
+        }
+        for (int i = 0; i < LEVEL_NAMES.length; i++) {
+            if (LEVEL_NAMES[i].equals(n)) {
+                return i;
+            }
+        }
+        return fallback;
+    }
+
+    public static void log(int level, String template) {
+        record(level, template, null, 0, 0, 0, 0, 0, 0, 0);
+    }
+
+    public static void log(int level, String template, double a) {
+        record(level, template, null, 0, a, 0, 0, 0, 0, 0);
+    }
+
+    public static void log(int level, String template, double a, double b) {
+        record(level, template, null, 0, a, b, 0, 0, 0, 0);
+    }
+
+    public static void log(int level, String template, double a, double b, double c) {
+        record(level, template, null, 0, a, b, c, 0, 0, 0);
+    }
+
+    public static void log(int level, String template, Object ref, double a, double b) {
+        record(level, template, ref, 0, a, b, 0, 0, 0, 0);
+    }
+
+    public static void log(int level, String template, Object ref, double a, double b, double c) {
+        record(level, template, ref, 0, a, b, c, 0, 0, 0);
+    }
+
+    /** Event about one part of a {@link Source}, with up to six numbers. */
+    public static void log(int level, String template, Source ref, int part,
+            double a, double b, double c, double d, double e, double f) {
+        record(level, template, ref, part, a, b, c, d, e, f);
+    }
+
+    /** Forget all recorded events. */
+    public static void clear() {
+        for (int i = 0; i < CAPACITY; i++) {
+            templates[i] = null;
+            refs[i] = null;
+        }
+        head = 0;
+        count = 0;
+    }
+
+    public static int getRecordedCount() {
+        return count;
+    }
+
+    /** Format up to {@code max} most recent events, oldest first. */
+    public static List<String> getRecentEvents(int max) {
+        int n = Math.min(max, count);
+        ArrayList<String> out = new ArrayList<String>(n);
+        int start = (head - n + CAPACITY) % CAPACITY;
+        for (int i = 0; i < n; i++) {
+            int k = (start + i) % CAPACITY;
+            out.add(format(levels[k], templates[k], refs[k], parts[k], args, k * MAX_ARGS));
+        }
+        return out;
+    }
+
+    /** Print the most recent events to the console, e.g. after a convergence failure. */
+    public static void dumpRecentEvents(int max) {
+        List<String> events = getRecentEvents(max);
+        if (events.isEmpty()) {
+            return;
+        }
+        CirSim.console("recent solver events (" + events.size() + " of " + count + "):");
+        for (int i = 0; i < events.size(); i++) {
+            CirSim.console("  " + events.get(i));
+        }
+    }
+
+    private static void record(int level, String template, Object ref, int part,
+            double a, double b, double c, double d, double e, double f) {
+        if (level >= recordLevel && level < OFF) {
+            levels[head] = level;
+            templates[head] = template;
+            refs[head] = ref;
+            parts[head] = part;
+            int base = head * MAX_ARGS;
+            args[base] = a;
+            args[base + 1] = b;
+            args[base + 2] = c;
+            args[base + 3] = d;
+            args[base + 4] = e;
+            args[base + 5] = f;
+            head = (head + 1) % CAPACITY;
+            if (count < CAPACITY) {
+                count++;
+            }
+        }
+        if (level >= consoleLevel && level < OFF) {
+            CirSim.console(format(level, template, ref, part, new double[] { a, b, c, d, e, f }, 0));
+        }
+    }
+
+    static String format(int level, String template, Object ref, int part, double values[], int base) {
+        StringBuilder sb = new StringBuilder(template.length() + 32);
+        if (level != INFO) {
+            sb.append(LEVEL_NAMES[level]).append(": ");
+        }
+        int arg = 0;
+        int i = 0;
+        while (i < template.length()) {
+            char ch = template.charAt(i);
+            if (ch == '{' && i + 1 < template.length() && template.charAt(i + 1) == '}') {
+                appendNumber(sb, arg < MAX_ARGS ? values[base + arg] : 0);
+                arg++;
+                i += 2;
+            } else if (ch == '{' && i + 2 < template.length() && template.charAt(i + 1) == '@'
+                    && template.charAt(i + 2) == '}') {
+                appendRef(sb, ref, part);
+                i += 3;
+            } else {
+                sb.append(ch);
+                i++;
+            }
+        }
+        return sb.toString();
+    }
+
+    private static void appendNumber(StringBuilder sb, double v) {
+        if (v == Math.rint(v) && Math.abs(v) < 1e15) {
+            sb.append((long) v);
+        } else {
+            sb.append(v);
+        }
+    }
+
+    private static void appendRef(StringBuilder sb, Object ref, int part) {
+        if (ref instanceof Source) {
+            ((Source) ref).appendLogDescription(sb, part);
+        } else if (ref instanceof CircuitElm) {
+            CircuitElm ce = (CircuitElm) ref;
+            sb.append(ce.getClass().getSimpleName()).append(" at (").append(ce.x).append(",").append(ce.y).append(")");
+        } else {
+            sb.append(ref);
+        }
+    }
+}
@@ -0,0 +1,193 @@
+package com.lushprojects.circuitjs1.client;
+
+import java.util.Map;
+import java.util.Set;
+
+import com.lushprojects.circuitjs1.client.core.AndersonAccelerator;
+import com.lushprojects.circuitjs1.client.elements.economics.ComputedValues;
+import com.lushprojects.circuitjs1.client.util.NumFmt;
+
+/**
+ * Optional Anderson acceleration of the ComputedValues fixed-point iteration
+ * that non-MNA equation tables run across subiterations.
+ *
+ * After every subiteration's doStep() pass the pending values g = G(x) are
+ * mixed with the recent history and the accelerated iterate is written back
+ * into the pending buffer before it is committed. Convergence is still judged
+ * by the elements on plain evaluations: when they report convergence right
+ * after an accelerated step, one more unaccelerated subiteration is forced so
+ * the accepted values are a genuine G(x). The accelerator disables itself for
+ * the rest of a timestep after repeated restarts.
+ */
+final class SubiterationAccelerator {
+    private static final int DEPTH = 5;
+    private static final int MAX_RESTARTS_PER_STEP = 3;
+    private static final NumFmt.Formatter FACTOR_FMT = NumFmt.forPattern("0.00");
+
+    private final AndersonAccelerator anderson = new AndersonAccelerator(DEPTH);
+    private String names[] = new String[0];
+    private Map.Entry<String, Double> entries[];
+    private double x[] = new double[0];
+    private double g[] = new double[0];
+    private double out[] = new double[0];
+    private int n;
+    private boolean haveX;
+    private boolean lastAccelerated;
+    private boolean disabled;
+    private int restartsAtStepStart;
+
+    // Residual norms of the first two plain iterations give the linear rate
+    // used to estimate how many subiterations plain iteration would need.
+    private double firstNorm;
+    private double secondNorm;
+    private int normsSeen;
+    private boolean acceleratedThisStep;
+
+    private int acceleratedTimesteps;
+    private double estimatedPlainIterations;
+    private double actualIterations;
+
+    void beginTimestep() {
+        anderson.reset();
+        haveX = false;
+        lastAccelerated = false;
+        disabled = false;
+        restartsAtStepStart = anderson.getRestartCount();
+        normsSeen = 0;
+        acceleratedThisStep = false;
+    }
+
+    /**
+     * Called after all elements have run doStep() for a subiteration and
+     * before the pending values are committed.
+     */
+    void afterSubiteration(CirSim sim) {
+        if (!loadPending()) {
+            haveX = false;
+            lastAccelerated = false;
+            return;
+        }
+        if (sim.isConverged()) {
+            if (lastAccelerated) {
+                // confirm with one plain iteration from the accelerated point
+                sim.setConverged(false);
+                lastAccelerated = false;
+                System.arraycopy(g, 0, x, 0, n);
+            }
+            return;
+        }
+        if (!haveX || disabled) {
+            System.arraycopy(g, 0, x, 0, n);
+            haveX = true;
+            lastAccelerated = false;
+            return;
+        }
+
+        boolean accelerated = anderson.accelerate(x, g, n, out);
+        recordNorm(anderson.getLastResidualNorm());
+        if (anderson.getRestartCount() - restartsAtStepStart > MAX_RESTARTS_PER_STEP) {
+            disabled = true;
+            accelerated = false;
+        }
+        if (accelerated) {
+            for (int i = 0; i != n; i++) {
+                entries[i].setValue(out[i]);
+            }
+            System.arraycopy(out, 0, x, 0, n);
+            acceleratedThisStep = true;
+        } else {
+            System.arraycopy(g, 0, x, 0, n);
+        }
+        lastAccelerated = accelerated;
+    }
+
+    /** Record the statistics of a converged timestep that took subiter passes. */
+    void endTimestep(int subiter) {
+        if (!acceleratedThisStep || normsSeen < 2) {
+            return;
+        }
+        double finalNorm = anderson.getLastResidualNorm();
+        double rate = secondNorm / firstNorm;
+        if (!(rate > 0 && rate < 1) || !(finalNorm > 0) || finalNorm >= firstNorm) {
+            return;
+        }
+        acceleratedTimesteps++;
+        estimatedPlainIterations += 1 + Math.log(finalNorm / firstNorm) / Math.log(rate);
+        actualIterations += subiter + 1;
+    }
+
+    /** Estimated plain-iteration subiterations divided by those actually used. */
+    double getAccelerationFactor() {
+        return actualIterations > 0 ? estimatedPlainIterations / actualIterations : 1;
+    }
+
+    int getAcceleratedTimesteps() {
+        return acceleratedTimesteps;
+    }
+
+    int getRestartCount() {
+        return anderson.getRestartCount();
+    }
+
+    void resetStatistics() {
+        acceleratedTimesteps = 0;
+        estimatedPlainIterations = 0;
+        actualIterations = 0;
+    }
+
+    String getReport() {
+        return "subiteration acceleration: " + FACTOR_FMT.format(getAccelerationFactor())
+            + "x over " + acceleratedTimesteps + " timesteps, " + anderson.getAcceleratedStepCount()
+            + " accelerated steps, " + anderson.getRestartCount() + " restarts";
+    }
+
+    private void recordNorm(double norm) {
+        if (normsSeen == 0) {
+            firstNorm = norm;
+        } else if (normsSeen == 1) {
+            secondNorm = norm;
+        }
+        normsSeen++;
+    }
+
+    // Copy the pending buffer into g. Returns false if it holds a null value;
+    // a change in the set of names restarts the history.
+    @SuppressWarnings("unchecked")
+    private boolean loadPending() {
+        Set<Map.Entry<String, Double>> pending = ComputedValues.getPendingEntries();
+        if (pending == null) {
+            return false;
+        }
+        int count = pending.size();
+        boolean sameNames = count == n && entries != null;
+        if (count > names.length) {
+            int cap = Math.max(count, names.length * 2);
+            names = new String[cap];
+            entries = new Map.Entry[cap];
+            x = new double[cap];
+            g = new double[cap];
+            out = new double[cap];
+            sameNames = false;
+        }
+        int i = 0;
+        for (Map.Entry<String, Double> e : pending) {
+            Double v = e.getValue();
+            if (v == null) {
+                n = 0;
+                return false;
+            }
+            if (sameNames && !e.getKey().equals(names[i])) {
+                sameNames = false;
+            }
+            names[i] = e.getKey();
+            entries[i] = e;
+            g[i++] = v.doubleValue();
+        }
+        n = count;
+        if (!sameNames) {
+            anderson.reset();
+            haveX = false;
+        }
+        return true;
+    }
+}
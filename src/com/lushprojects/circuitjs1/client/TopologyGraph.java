@@ -0,0 +1,191 @@
+package com.lushprojects.circuitjs1.client;
+
+import com.lushprojects.circuitjs1.client.core.DisjointSet;
+
+import java.util.Vector;
+
+/**
+ * Undirected node graph over the elements accepted by a filter, used by
+ * {@link CircuitAnalyzer} to answer "is there a path between these nodes
+ * that avoids this element?" for many elements at once.
+ *
+ * Each element contributes an edge for every connected pair of its
+ * connection nodes and one to ground for every ground connection. Connected
+ * components come from a union-find and bridges from an iterative lowlink
+ * DFS, so building costs O(nodes + edges) with no recursion. Answers are
+ * {@link #NO}, {@link #YES} or {@link #UNKNOWN}; the caller falls back to an
+ * exact search only for UNKNOWN.
+ *
+ * Built in "superset" mode an edge exists if either direction conducts, so a
+ * missing path is definite. Built in "subset" mode only edges that conduct
+ * both ways count, so a found path is definite.
+ */
+final class TopologyGraph {
+
+    interface EdgeFilter {
+        boolean allows(CircuitElm ce);
+    }
+
+    static final int NO = 0;
+    static final int YES = 1;
+    static final int UNKNOWN = 2;
+
+    private final int nodeCount;
+    private int edgeA[] = new int[64];
+    private int edgeB[] = new int[64];
+    private int edgeCount;
+    private final int elmEdgeCount[];
+    private final int elmFirstEdge[];
+    private final DisjointSet components;
+    private boolean bridge[];
+
+    TopologyGraph(Vector<CircuitElm> elms, int nodeCount, EdgeFilter filter, boolean subset) {
+        this.nodeCount = nodeCount;
+        int n = elms.size();
+        elmEdgeCount = new int[n];
+        elmFirstEdge = new int[n];
+        components = new DisjointSet(nodeCount);
+        for (int i = 0; i != nodeCount; i++)
+            components.add();
+
+        for (int i = 0; i != n; i++) {
+            CircuitElm ce = elms.get(i);
+            elmFirstEdge[i] = edgeCount;
+            if (!filter.allows(ce))
+                continue;
+            int cc = ce.getConnectionNodeCount();
+            for (int j = 0; j != cc; j++) {
+                if (ce.hasGroundConnection(j))
+                    addEdge(i, ce.getConnectionNode(j), 0);
+                for (int k = j + 1; k < cc; k++) {
+                    boolean jk = ce.getConnection(j, k);
+                    boolean kj = ce.getConnection(k, j);
+                    if (subset ? (jk && kj) : (jk || kj))
+                        addEdge(i, ce.getConnectionNode(j), ce.getConnectionNode(k));
+                }
+            }
+        }
+    }
+
+    private void addEdge(int elm, int a, int b) {
+        if (a < 0 || b < 0 || a >= nodeCount || b >= nodeCount)
+            return;
+        if (edgeCount == edgeA.length) {
+            int na[] = new int[edgeCount * 2];
+            int nb[] = new int[edgeCount * 2];
+            System.arraycopy(edgeA, 0, na, 0, edgeCount);
+            System.arraycopy(edgeB, 0, nb, 0, edgeCount);
+            edgeA = na;
+            edgeB = nb;
+        }
+        edgeA[edgeCount] = a;
+        edgeB[edgeCount] = b;
+        edgeCount++;
+        elmEdgeCount[elm]++;
+        components.union(a, b);
+    }
+
+    boolean connected(int a, int b) {
+        return components.connected(a, b);
+    }
+
+    /** Number of edges contributed by the element at this elmList index. */
+    int getEdgeCount(int elmIndex) {
+        return elmEdgeCount[elmIndex];
+    }
+
+    /**
+     * Superset query: is there a path from -> to that avoids the element?
+     * NO is definite; otherwise UNKNOWN.
+     */
+    int pathAvoidingUpperBound(int elmIndex, int from, int to) {
+        if (from == to)
+            return YES;
+        if (!connected(from, to))
+            return NO;
+        if (elmEdgeCount[elmIndex] == 1) {
+            int e = elmFirstEdge[elmIndex];
+            boolean joins = (edgeA[e] == from && edgeB[e] == to) || (edgeA[e] == to && edgeB[e] == from);
+            if (joins && isBridge(e))
+                return NO;
+        }
+        return UNKNOWN;
+    }
+
+    /**
+     * Subset query: YES is definite when the element itself is not part of
+     * this graph; otherwise UNKNOWN.
+     */
+    int pathAvoidingLowerBound(int elmIndex, int from, int to) {
+        if (from == to || (elmEdgeCount[elmIndex] == 0 && connected(from, to)))
+            return YES;
+        return UNKNOWN;
+    }
+
+    private boolean isBridge(int e) {
+        if (bridge == null)
+            findBridges();
+        return bridge[e];
+    }
+
+    /** Iterative lowlink DFS; parallel edges are told apart by edge id. */
+    private void findBridges() {
+        bridge = new boolean[edgeCount];
+        int adjStart[] = new int[nodeCount + 1];
+        for (int e = 0; e != edgeCount; e++) {
+            adjStart[edgeA[e] + 1]++;
+            adjStart[edgeB[e] + 1]++;
+        }
+        for (int v = 0; v != nodeCount; v++)
+            adjStart[v + 1] += adjStart[v];
+        int adjEdge[] = new int[edgeCount * 2];
+        int fill[] = new int[nodeCount];
+        for (int e = 0; e != edgeCount; e++) {
+            adjEdge[adjStart[edgeA[e]] + fill[edgeA[e]]++] = e;
+            adjEdge[adjStart[edgeB[e]] + fill[edgeB[e]]++] = e;
+        }
+
+        int disc[] = new int[nodeCount];
+        int low[] = new int[nodeCount];
+        int parentEdge[] = new int[nodeCount];
+        int next[] = new int[nodeCount];
+        int stack[] = new int[nodeCount];
+        int time = 0;
+        for (int root = 0; root != nodeCount; root++) {
+            if (disc[root] != 0)
+                continue;
+            int sp = 0;
+            stack[sp++] = root;
+            disc[root] = low[root] = ++time;
+            parentEdge[root] = -1;
+            next[root] = adjStart[root];
+            while (sp > 0) {
+                int v = stack[sp - 1];
+                if (next[v] < adjStart[v + 1]) {
+                    int e = adjEdge[next[v]++];
+                    if (e == parentEdge[v])
+                        continue;
+                    int w = edgeA[e] == v ? edgeB[e] : edgeA[e];
+                    if (disc[w] == 0) {
+                        disc[w] = low[w] = ++time;
+                        parentEdge[w] = e;
+                        next[w] = adjStart[w];
+                        stack[sp++] = w;
+                    } else if (disc[w] < low[v]) {
+                        low[v] = disc[w];
+                    }
+                } else {
+                    sp--;
+                    int pe = parentEdge[v];
+                    if (pe >= 0) {
+                        int u = edgeA[pe] == v ? edgeB[pe] : edgeA[pe];
+                        if (low[v] < low[u])
+                            low[u] = low[v];
+                        if (low[v] > disc[u])
+                            bridge[pe] = true;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -1,25 +1,41 @@
 package com.lushprojects.circuitjs1.client;
 
 
+import java.util.Arrays;
 import java.util.Vector;
 
+import com.lushprojects.circuitjs1.client.io.CompactCircuitCodec;
+
 class UndoRedoManager {
     private final CirSim sim;
     private final Vector<UndoItem> undoStack = new Vector<UndoItem>();
     private final Vector<UndoItem> redoStack = new Vector<UndoItem>();
 
     static class UndoItem {
-        final String dump;
+        // Exactly one of dump / compactDump is set, depending on sim.compactInternalDumps.
+        private final String dump;
+        private final byte[] compactDump;
         final double scale;
         final double transform4;
         final double transform5;
 
-        UndoItem(String dump, double[] transform) {
-            this.dump = dump;
+        UndoItem(String dump, boolean compact, double[] transform) {
+            this.dump = compact ? null : dump;
+            this.compactDump = compact ? CompactCircuitCodec.encode(dump, true) : null;
             this.scale = transform[0];
             this.transform4 = transform[4];
             this.transform5 = transform[5];
         }
+
+        String getDump() {
+            return compactDump != null ? CompactCircuitCodec.decode(compactDump) : dump;
+        }
+
+        boolean sameDump(UndoItem other) {
+            if (compactDump != null && other.compactDump != null)
+                return Arrays.equals(compactDump, other.compactDump);
+            return getDump().equals(other.getDump());
+        }
     }
 
     UndoRedoManager(CirSim sim) {
@@ -27,21 +43,20 @@ class UndoRedoManager {
     }
 
     private UndoItem createUndoItem(String dump) {
-        return new UndoItem(dump, sim.getTransform());
+        return new UndoItem(dump, sim.compactInternalDumps, sim.getTransform());
     }
 
     private void applyUndoItem(UndoItem ui) {
-        sim.getCircuitIOService().readCircuit(ui.dump, CirSim.RC_NO_CENTER);
+        sim.getCircuitIOService().readCircuit(ui.getDump(), CirSim.RC_NO_CENTER);
         sim.getViewportController().setTransform(ui.scale, ui.transform4, ui.transform5);
     }
 
     void pushUndo() {
         redoStack.removeAllElements();
-        String s = sim.getCircuitIOService().dumpCircuit();
-        if (undoStack.size() > 0 &&
-                s.compareTo(undoStack.lastElement().dump) == 0)
+        UndoItem item = createUndoItem(sim.getCircuitIOService().dumpCircuit());
+        if (undoStack.size() > 0 && item.sameDump(undoStack.lastElement()))
             return;
-        undoStack.add(createUndoItem(s));
+        undoStack.add(item);
         enableUndoRedo();
         sim.savedFlag = false;
     }
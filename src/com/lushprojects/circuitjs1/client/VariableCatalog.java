@@ -2,20 +2,34 @@ package com.lushprojects.circuitjs1.client;
 
 import java.util.ArrayList;
 import java.util.Collections;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.Iterator;
 import java.util.LinkedHashSet;
 import java.util.List;
+import java.util.Map;
 import java.util.Set;
+import java.util.TreeMap;
 
 import com.lushprojects.circuitjs1.client.elements.economics.ComputedValues;
+import com.lushprojects.circuitjs1.client.elements.economics.EquationTableElm;
 import com.lushprojects.circuitjs1.client.elements.economics.StockFlowRegistry;
+import com.lushprojects.circuitjs1.client.elements.economics.StockTableView;
+import com.lushprojects.circuitjs1.client.elements.economics.TableElm;
+import com.lushprojects.circuitjs1.client.elements.electronics.wiring.LabeledNodeElm;
 
 /**
- * Collects the variables exposed to UI features like the Variable Browser and
+ * Catalog of the variables exposed to UI features like the Variable Browser and
  * variable history tracing.
+ *
+ * The catalog is owned by CirSim and kept up to date incrementally. Each source
+ * (stock registry, labeled nodes, parameter names, and the equation/cell names of
+ * each table) carries a version counter; a sync re-reads only the sources whose
+ * version moved and applies the difference. Names are indexed by lower-case sort
+ * key (for prefix queries) and by every 1-3 character substring (for substring
+ * queries), so lookups cost O(result) rather than O(model).
  */
 public final class VariableCatalog {
-    private VariableCatalog() {
-    }
 
     public static final String TYPE_STOCK = "Stock";
     public static final String TYPE_EQUATION = "Equation";
@@ -23,13 +37,92 @@ public final class VariableCatalog {
     public static final String TYPE_PARAMETER = "Parameter";
     public static final String TYPE_VARIABLE = "Variable";
 
+    // kinds in priority order: a name's type is its highest-priority kind
+    private static final int KIND_STOCK = 0;
+    private static final int KIND_EQUATION = 1;
+    private static final int KIND_NODE = 2;
+    private static final int KIND_PARAMETER = 3;
+    private static final int KIND_VARIABLE = 4;
+    private static final int KIND_COUNT = 5;
+    private static final String KIND_TYPES[] = {
+        TYPE_STOCK, TYPE_EQUATION, TYPE_NODE, TYPE_PARAMETER, TYPE_VARIABLE
+    };
+
+    private static final int MAX_GRAM = 3;
+
     public static final class VariableEntry implements Comparable<VariableEntry> {
         public final String name;
-        public final String type;
+        /** Display type (one of the TYPE_ constants); maintained by the catalog. */
+        public String type;
+
+        private final String lowerName;
+        private final String sortKey;
+        private final int kindCounts[] = new int[KIND_COUNT];
+        private final ArrayList<CircuitElm> owners = new ArrayList<CircuitElm>(1);
+        private final VariableCatalog catalog;
 
-        public VariableEntry(String name, String type) {
+        private VariableEntry(VariableCatalog catalog, String name) {
+            this.catalog = catalog;
             this.name = name;
-            this.type = type;
+            lowerName = name.toLowerCase();
+            sortKey = lowerName + '\0' + name;
+        }
+
+        /** Table that defines this variable, or null for nodes and parameters. */
+        public CircuitElm getOwner() {
+            if (isStock()) {
+                List<StockTableView> tables = StockFlowRegistry.getTablesForStock(name);
+                for (int i = 0; i < tables.size(); i++) {
+                    if (tables.get(i) instanceof CircuitElm) {
+                        return (CircuitElm) tables.get(i);
+                    }
+                }
+            }
+            return owners.isEmpty() ? null : owners.get(0);
+        }
+
+        /** Unit symbol of the owning table, or null if it has none. */
+        public String getUnit() {
+            CircuitElm owner = getOwner();
+            if (owner instanceof TableElm) {
+                String units = ((TableElm) owner).tableUnits;
+                return units == null || units.isEmpty() ? null : units;
+            }
+            return null;
+        }
+
+        public boolean isStock() {
+            return kindCounts[KIND_STOCK] > 0;
+        }
+
+        /** True if a legacy-flow value is currently computed for this name. */
+        public boolean isFlow() {
+            String flowKey = ComputedValues.getFlowComputedKeyForName(name);
+            return flowKey != null && ComputedValues.hasComputedValue(flowKey);
+        }
+
+        /** Index into CirSim.circuitVariables, or -1 if the name has no slot. */
+        public int getSlot() {
+            Map<String, Integer> slots = catalog.sim != null ? catalog.sim.nameToSlot : null;
+            Integer slot = slots != null ? slots.get(name) : null;
+            return slot != null ? slot.intValue() : -1;
+        }
+
+        private int totalCount() {
+            int total = 0;
+            for (int i = 0; i < KIND_COUNT; i++) {
+                total += kindCounts[i];
+            }
+            return total;
+        }
+
+        private String computeType() {
+            for (int i = 0; i < KIND_COUNT; i++) {
+                if (kindCounts[i] > 0) {
+                    return KIND_TYPES[i];
+                }
+            }
+            return null;
         }
 
         @Override
@@ -37,73 +130,315 @@ public final class VariableCatalog {
             if (other == null || other.name == null) {
                 return -1;
             }
-            if (name == null) {
-                return 1;
-            }
-            return name.compareToIgnoreCase(other.name);
+            return sortKey.compareTo(other.sortKey);
         }
     }
 
+    // names one table contributes, with the content version they were read at
+    private static final class ElementNames {
+        int version;
+        int pass;
+        Set<String> outputs = Collections.emptySet();
+        Set<String> cellVariables = Collections.emptySet();
+    }
+
+    private final CirSim sim;
+    private final HashMap<String, VariableEntry> byName = new HashMap<String, VariableEntry>();
+    private final TreeMap<String, VariableEntry> sorted = new TreeMap<String, VariableEntry>();
+    private final HashMap<String, HashSet<VariableEntry>> grams = new HashMap<String, HashSet<VariableEntry>>();
+
+    private Set<String> stockNames = Collections.emptySet();
+    private Set<String> nodeNames = Collections.emptySet();
+    private Set<String> parameterNames = Collections.emptySet();
+    private final HashMap<CircuitElm, ElementNames> elementNames = new HashMap<CircuitElm, ElementNames>();
+
+    private int stockVersion = -1;
+    private int labelVersion = -1;
+    private int parameterVersion = -1;
+    private int contentGeneration = -1;
+    private boolean elementsDirty = true;
+    private int pass;
+
+    private int modCount;
+    private int viewModCount = -1;
+    private List<VariableEntry> variablesView;
+    private Set<String> namesView;
+
+    public VariableCatalog(CirSim sim) {
+        this.sim = sim;
+    }
+
+    /** Sorted snapshot of all variables (shared until the catalog changes). */
     public static List<VariableEntry> collectVariables(CirSim sim) {
-        ArrayList<VariableEntry> variables = new ArrayList<VariableEntry>();
-        LinkedHashSet<String> addedNames = new LinkedHashSet<String>();
+        if (sim == null) {
+            return Collections.emptyList();
+        }
+        return sim.getVariableCatalog().getVariables();
+    }
 
-        addEntries(variables, addedNames, StockFlowRegistry.getAllStockNames(), TYPE_STOCK);
-        addEntries(variables, addedNames, StockFlowRegistry.getAllEquationOutputNames(), TYPE_EQUATION);
+    public static Set<String> collectVariableNames(CirSim sim) {
+        if (sim == null) {
+            return Collections.emptySet();
+        }
+        return sim.getVariableCatalog().getNames();
+    }
 
-        String[] labeledNodes = sim != null ? sim.getSortedLabeledNodeNames() : null;
-        if (labeledNodes != null) {
-            for (int i = 0; i < labeledNodes.length; i++) {
-                addEntry(variables, addedNames, labeledNodes[i], TYPE_NODE);
-            }
+    /**
+     * Note that elements may have been added or removed, so the next sync walks
+     * the element list. Called after circuit analysis.
+     */
+    public void invalidateElements() {
+        elementsDirty = true;
+    }
+
+    /** Bumped whenever the set of names or any name's type changes. */
+    public int getVersion() {
+        sync();
+        return modCount;
+    }
+
+    public int size() {
+        sync();
+        return byName.size();
+    }
+
+    public VariableEntry get(String name) {
+        sync();
+        return name == null ? null : byName.get(name);
+    }
+
+    public boolean contains(String name) {
+        return get(name) != null;
+    }
+
+    public List<VariableEntry> getVariables() {
+        sync();
+        updateViews();
+        return variablesView;
+    }
+
+    public Set<String> getNames() {
+        sync();
+        updateViews();
+        return namesView;
+    }
+
+    /** Variables whose name starts with prefix (ignoring case), sorted. */
+    public List<VariableEntry> findByPrefix(String prefix) {
+        sync();
+        if (prefix == null || prefix.isEmpty()) {
+            return getVariables();
         }
+        String lower = prefix.toLowerCase();
+        return new ArrayList<VariableEntry>(sorted.subMap(lower, lower + '\uffff').values());
+    }
 
-        addEntries(variables, addedNames, ComputedValues.getAllParameterNames(), TYPE_PARAMETER);
-        addEntries(variables, addedNames, StockFlowRegistry.getAllCellEquationVariables(), TYPE_VARIABLE);
-        Collections.sort(variables);
-        return variables;
+    /** Variables whose name contains text (ignoring case), sorted. */
+    public List<VariableEntry> findContaining(String text) {
+        sync();
+        if (text == null || text.isEmpty()) {
+            return getVariables();
+        }
+        String lower = text.toLowerCase();
+        ArrayList<VariableEntry> result = new ArrayList<VariableEntry>();
+        if (lower.length() <= MAX_GRAM) {
+            HashSet<VariableEntry> posting = grams.get(lower);
+            if (posting != null) {
+                result.addAll(posting);
+            }
+        } else {
+            // scan the rarest trigram's posting list and verify each candidate
+            HashSet<VariableEntry> best = null;
+            for (int i = 0; i + MAX_GRAM <= lower.length(); i++) {
+                HashSet<VariableEntry> posting = grams.get(lower.substring(i, i + MAX_GRAM));
+                if (posting == null) {
+                    return result;
+                }
+                if (best == null || posting.size() < best.size()) {
+                    best = posting;
+                }
+            }
+            for (VariableEntry e : best) {
+                if (e.lowerName.contains(lower)) {
+                    result.add(e);
+                }
+            }
+        }
+        Collections.sort(result);
+        return result;
     }
 
-    public static Set<String> collectVariableNames(CirSim sim) {
+    private void updateViews() {
+        if (viewModCount == modCount && variablesView != null) {
+            return;
+        }
+        ArrayList<VariableEntry> list = new ArrayList<VariableEntry>(sorted.values());
         LinkedHashSet<String> names = new LinkedHashSet<String>();
-        addNames(names, StockFlowRegistry.getAllStockNames());
-        addNames(names, StockFlowRegistry.getAllEquationOutputNames());
-
-        String[] labeledNodes = sim != null ? sim.getSortedLabeledNodeNames() : null;
-        if (labeledNodes != null) {
-            for (int i = 0; i < labeledNodes.length; i++) {
-                if (labeledNodes[i] != null && !labeledNodes[i].isEmpty()) {
-                    names.add(labeledNodes[i]);
+        for (int i = 0; i < list.size(); i++) {
+            names.add(list.get(i).name);
+        }
+        variablesView = Collections.unmodifiableList(list);
+        namesView = Collections.unmodifiableSet(names);
+        viewModCount = modCount;
+    }
+
+    // Bring the index up to date with every source whose version moved.
+    private void sync() {
+        int v = StockFlowRegistry.getVersion();
+        if (v != stockVersion) {
+            stockVersion = v;
+            stockNames = replaceNames(stockNames, StockFlowRegistry.getAllStockNames(), KIND_STOCK, null);
+        }
+
+        v = LabeledNodeElm.getLabelVersion();
+        if (v != labelVersion) {
+            labelVersion = v;
+            String labels[] = sim != null ? sim.getSortedLabeledNodeNames() : null;
+            HashSet<String> current = new HashSet<String>();
+            if (labels != null) {
+                Collections.addAll(current, labels);
+            }
+            nodeNames = replaceNames(nodeNames, current, KIND_NODE, null);
+        }
+
+        v = ComputedValues.getParameterNamesVersion();
+        if (v != parameterVersion) {
+            parameterVersion = v;
+            parameterNames = replaceNames(parameterNames, ComputedValues.getAllParameterNames(), KIND_PARAMETER, null);
+        }
+
+        v = CircuitElm.getContentGeneration();
+        if (v != contentGeneration || elementsDirty) {
+            contentGeneration = v;
+            elementsDirty = false;
+            syncElements();
+        }
+    }
+
+    // Re-read names from tables that are new or were edited, and drop tables
+    // that are gone. Unchanged tables cost one version comparison.
+    private void syncElements() {
+        pass++;
+        if (sim != null && sim.elmList != null) {
+            for (int i = 0; i < sim.elmList.size(); i++) {
+                CircuitElm elm = sim.elmList.get(i);
+                if (!(elm instanceof EquationTableElm) && !(elm instanceof TableElm)) {
+                    continue;
+                }
+                ElementNames en = elementNames.get(elm);
+                boolean fresh = en == null;
+                if (fresh) {
+                    en = new ElementNames();
+                    elementNames.put(elm, en);
+                }
+                en.pass = pass;
+                if (!fresh && en.version == elm.getContentVersion()) {
+                    continue;
+                }
+                en.version = elm.getContentVersion();
+                if (elm instanceof EquationTableElm) {
+                    HashSet<String> outputs = new HashSet<String>();
+                    StockFlowRegistry.collectEquationOutputNames((EquationTableElm) elm, outputs);
+                    en.outputs = replaceNames(en.outputs, outputs, KIND_EQUATION, elm);
+                }
+                if (elm instanceof TableElm) {
+                    HashSet<String> cellVariables = new HashSet<String>();
+                    StockFlowRegistry.collectCellEquationVariables((TableElm) elm, cellVariables);
+                    en.cellVariables = replaceNames(en.cellVariables, cellVariables, KIND_VARIABLE, elm);
                 }
             }
         }
+        Iterator<Map.Entry<CircuitElm, ElementNames>> it = elementNames.entrySet().iterator();
+        while (it.hasNext()) {
+            Map.Entry<CircuitElm, ElementNames> e = it.next();
+            if (e.getValue().pass != pass) {
+                replaceNames(e.getValue().outputs, null, KIND_EQUATION, e.getKey());
+                replaceNames(e.getValue().cellVariables, null, KIND_VARIABLE, e.getKey());
+                it.remove();
+            }
+        }
+    }
 
-        addNames(names, ComputedValues.getAllParameterNames());
-        addNames(names, StockFlowRegistry.getAllCellEquationVariables());
-        return names;
+    // Apply the difference between a source's old and new name sets; returns
+    // the set to remember for the next sync.
+    private Set<String> replaceNames(Set<String> old, Set<String> current, int kind, CircuitElm owner) {
+        if (current == null) {
+            current = Collections.emptySet();
+        }
+        for (String name : old) {
+            if (!current.contains(name)) {
+                release(name, kind, owner);
+            }
+        }
+        for (String name : current) {
+            if (name != null && !name.isEmpty() && !old.contains(name)) {
+                acquire(name, kind, owner);
+            }
+        }
+        return current;
     }
 
-    private static void addEntries(List<VariableEntry> variables, Set<String> addedNames, Set<String> names, String type) {
-        if (names == null || names.isEmpty()) {
-            return;
+    private void acquire(String name, int kind, CircuitElm owner) {
+        VariableEntry e = byName.get(name);
+        if (e == null) {
+            e = new VariableEntry(this, name);
+            byName.put(name, e);
+            sorted.put(e.sortKey, e);
+            indexGrams(e, true);
         }
-        for (String name : names) {
-            addEntry(variables, addedNames, name, type);
+        e.kindCounts[kind]++;
+        if (owner != null) {
+            e.owners.add(owner);
         }
+        updateType(e);
     }
 
-    private static void addEntry(List<VariableEntry> variables, Set<String> addedNames, String name, String type) {
-        if (name == null || name.isEmpty() || addedNames.contains(name)) {
+    private void release(String name, int kind, CircuitElm owner) {
+        VariableEntry e = byName.get(name);
+        if (e == null || e.kindCounts[kind] == 0) {
+            return;
+        }
+        e.kindCounts[kind]--;
+        if (owner != null) {
+            e.owners.remove(owner);
+        }
+        if (e.totalCount() == 0) {
+            byName.remove(name);
+            sorted.remove(e.sortKey);
+            indexGrams(e, false);
+            modCount++;
             return;
         }
-        variables.add(new VariableEntry(name, type));
-        addedNames.add(name);
+        updateType(e);
     }
 
-    private static void addNames(Set<String> allNames, Set<String> names) {
-        if (names == null || names.isEmpty()) {
-            return;
+    private void updateType(VariableEntry e) {
+        String type = e.computeType();
+        if (!type.equals(e.type)) {
+            e.type = type;
+            modCount++;
+        }
+    }
+
+    private void indexGrams(VariableEntry e, boolean add) {
+        String s = e.lowerName;
+        for (int len = 1; len <= MAX_GRAM; len++) {
+            for (int i = 0; i + len <= s.length(); i++) {
+                String gram = s.substring(i, i + len);
+                HashSet<VariableEntry> posting = grams.get(gram);
+                if (add) {
+                    if (posting == null) {
+                        posting = new HashSet<VariableEntry>();
+                        grams.put(gram, posting);
+                    }
+                    posting.add(e);
+                } else if (posting != null) {
+                    posting.remove(e);
+                    if (posting.isEmpty()) {
+                        grams.remove(gram);
+                    }
+                }
+            }
         }
-        allNames.addAll(names);
     }
-}
\ No newline at end of file
+}
@@ -1,8 +1,10 @@
 package com.lushprojects.circuitjs1.client;
 
+import com.lushprojects.circuitjs1.client.core.NumericKernels;
+
 import java.util.Arrays;
+import java.util.Collections;
 import java.util.LinkedHashMap;
-import java.util.LinkedHashSet;
 import java.util.Map;
 import java.util.Set;
 
@@ -95,19 +97,9 @@ public final class VariableHistoryStore {
             if (size <= 1) {
                 return;
             }
-            int newSize = 0;
-            for (int src = 0; src < size; src += 2) {
-                int src2 = src + 1;
-                if (src2 < size) {
-                    time[newSize] = time[src];
-                    minValues[newSize] = Math.min(minValues[src], minValues[src2]);
-                    maxValues[newSize] = Math.max(maxValues[src], maxValues[src2]);
-                } else {
-                    time[newSize] = time[src];
-                    minValues[newSize] = minValues[src];
-                    maxValues[newSize] = maxValues[src];
-                }
-                newSize++;
+            int newSize = NumericKernels.get().pairwiseMinMax(minValues, maxValues, size);
+            for (int i = 0; i < newSize; i++) {
+                time[i] = time[2 * i];
             }
             size = newSize;
             if (sampleInterval > 0) {
@@ -134,12 +126,13 @@ public final class VariableHistoryStore {
     }
 
     private final Map<String, Series> seriesByName = new LinkedHashMap<String, Series>();
-    private Set<String> trackedVariableNames = new LinkedHashSet<String>();
+    // shared read-only view from the VariableCatalog; replaced, never mutated
+    private Set<String> trackedVariableNames = Collections.emptySet();
     private double lastCaptureTime = Double.NaN;
 
     public void clear() {
         seriesByName.clear();
-        trackedVariableNames.clear();
+        trackedVariableNames = Collections.emptySet();
         lastCaptureTime = Double.NaN;
     }
 
@@ -182,7 +175,7 @@ public final class VariableHistoryStore {
     }
 
     public void refreshTrackedVariableNames(CirSim sim) {
-        trackedVariableNames = new LinkedHashSet<String>(VariableCatalog.collectVariableNames(sim));
+        trackedVariableNames = VariableCatalog.collectVariableNames(sim);
     }
 
     public void capture(CirSim sim, double sampleTime) {
@@ -192,9 +185,8 @@ public final class VariableHistoryStore {
         if (!Double.isNaN(lastCaptureTime) && sampleTime + TIME_RESET_TOLERANCE < lastCaptureTime) {
             clearVariableSeries();
         }
-        if (trackedVariableNames.isEmpty()) {
-            refreshTrackedVariableNames(sim);
-        }
+        // cheap unless a variable source changed since the last sample
+        refreshTrackedVariableNames(sim);
         for (String name : trackedVariableNames) {
             captureVariableSample(name, sampleTime, sim.resolveSlotValueForUi(name));
         }
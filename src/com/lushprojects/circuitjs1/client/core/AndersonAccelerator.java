@@ -0,0 +1,253 @@
+/*
+    Copyright (C) Paul Falstad and Iain Sharp
+
+    This file is part of CircuitJS1.
+*/
+
+package com.lushprojects.circuitjs1.client.core;
+
+/**
+ * Anderson mixing for a fixed-point iteration x = G(x).
+ *
+ * Each call receives the iterate x that was fed in and the evaluation g = G(x),
+ * and proposes the next iterate from the last {@code depth} residual
+ * differences (type-II Anderson, mixing parameter 1):
+ *
+ * $$ \gamma = \arg\min \| f_k - \Delta F \gamma \|, \quad x_{k+1} = g_k - \Delta G \gamma $$
+ *
+ * For a single scalar value with depth 1 this is the secant step, i.e. Aitken's
+ * delta-squared extrapolation.
+ *
+ * Safeguards: the history restarts when the residual grows, when the least
+ * squares system is singular, or when the proposed step is non-finite or
+ * implausibly large; the caller then uses g unchanged (plain iteration).
+ * Components are weighted by 1/max(1,|g|) as captured at restart, so values of
+ * very different magnitude contribute comparably.
+ */
+public final class AndersonAccelerator {
+
+    private static final double RESIDUAL_GROWTH_LIMIT = 2.0;
+    private static final double MAX_STEP_RATIO = 1e3;
+    private static final double REGULARIZATION = 1e-12;
+
+    private final int depth;
+    private int n = -1;
+    private double weight[];
+    private double prevF[];
+    private double prevG[];
+    private double f[];
+    private double dF[][];
+    private double dG[][];
+    private int columns;
+    private int head; // index of the next column to overwrite
+    private boolean havePrev;
+    private double prevNorm;
+    private double lastNorm;
+
+    private double normal[][];
+    private double rhs[];
+    private double gamma[];
+
+    private int restarts;
+    private int acceleratedSteps;
+
+    public AndersonAccelerator(int depth) {
+        this.depth = Math.max(1, depth);
+    }
+
+    /** Forget the history (e.g. at the start of a new timestep). */
+    public void reset() {
+        havePrev = false;
+        columns = 0;
+        head = 0;
+    }
+
+    /** Weighted 2-norm of the residual g - x seen by the last call. */
+    public double getLastResidualNorm() {
+        return lastNorm;
+    }
+
+    public int getRestartCount() {
+        return restarts;
+    }
+
+    public int getAcceleratedStepCount() {
+        return acceleratedSteps;
+    }
+
+    /**
+     * Propose the next iterate.
+     *
+     * @param x iterate that produced g
+     * @param g evaluation G(x)
+     * @param count number of components in use
+     * @param out receives the accelerated iterate when true is returned
+     * @return true if out holds an accelerated iterate, false to use g as is
+     */
+    public boolean accelerate(double x[], double g[], int count, double out[]) {
+        if (count != n) {
+            allocate(count);
+        }
+        if (!havePrev) {
+            for (int i = 0; i != n; i++) {
+                weight[i] = 1 / Math.max(1, Math.abs(g[i]));
+            }
+        }
+        double norm = 0;
+        for (int i = 0; i != n; i++) {
+            f[i] = g[i] - x[i];
+            double w = f[i] * weight[i];
+            norm += w * w;
+        }
+        norm = Math.sqrt(norm);
+        lastNorm = norm;
+        if (Double.isNaN(norm) || Double.isInfinite(norm)) {
+            restart();
+            return false;
+        }
+
+        if (havePrev && norm > RESIDUAL_GROWTH_LIMIT * prevNorm) {
+            // diverging: start over from this point
+            restart();
+            remember(g, norm);
+            return false;
+        }
+
+        if (havePrev) {
+            double cf[] = dF[head];
+            double cg[] = dG[head];
+            for (int i = 0; i != n; i++) {
+                cf[i] = f[i] - prevF[i];
+                cg[i] = g[i] - prevG[i];
+            }
+            head = (head + 1) % depth;
+            if (columns < depth) {
+                columns++;
+            }
+        }
+        remember(g, norm);
+        if (columns == 0 || norm == 0) {
+            return false;
+        }
+
+        if (!solveLeastSquares()) {
+            restart();
+            remember(g, norm);
+            return false;
+        }
+
+        double step = 0;
+        for (int i = 0; i != n; i++) {
+            double v = g[i];
+            for (int c = 0; c != columns; c++) {
+                v -= gamma[c] * dG[c][i];
+            }
+            if (Double.isNaN(v) || Double.isInfinite(v)) {
+                restart();
+                remember(g, norm);
+                return false;
+            }
+            double d = (v - g[i]) * weight[i];
+            step += d * d;
+            out[i] = v;
+        }
+        if (Math.sqrt(step) > MAX_STEP_RATIO * norm) {
+            restart();
+            remember(g, norm);
+            return false;
+        }
+        acceleratedSteps++;
+        return true;
+    }
+
+    private void allocate(int count) {
+        n = count;
+        weight = new double[n];
+        prevF = new double[n];
+        prevG = new double[n];
+        f = new double[n];
+        dF = new double[depth][n];
+        dG = new double[depth][n];
+        normal = new double[depth][depth];
+        rhs = new double[depth];
+        gamma = new double[depth];
+        reset();
+    }
+
+    private void restart() {
+        restarts++;
+        reset();
+    }
+
+    private void remember(double g[], double norm) {
+        System.arraycopy(f, 0, prevF, 0, n);
+        System.arraycopy(g, 0, prevG, 0, n);
+        prevNorm = norm;
+        havePrev = true;
+    }
+
+    // Solve the weighted normal equations (dF^T W^2 dF) gamma = dF^T W^2 f
+    // by Gaussian elimination with partial pivoting.
+    private boolean solveLeastSquares() {
+        int m = columns;
+        double trace = 0;
+        for (int a = 0; a != m; a++) {
+            for (int b = a; b != m; b++) {
+                double s = 0;
+                for (int i = 0; i != n; i++) {
+                    double w = weight[i] * weight[i];
+                    s += dF[a][i] * dF[b][i] * w;
+                }
+                normal[a][b] = normal[b][a] = s;
+            }
+            double s = 0;
+            for (int i = 0; i != n; i++) {
+                s += dF[a][i] * f[i] * weight[i] * weight[i];
+            }
+            rhs[a] = s;
+            trace += normal[a][a];
+        }
+        if (!(trace > 0)) {
+            return false;
+        }
+        double reg = REGULARIZATION * trace;
+        for (int a = 0; a != m; a++) {
+            normal[a][a] += reg;
+        }
+
+        for (int col = 0; col != m; col++) {
+            int pivot = col;
+            for (int r = col + 1; r != m; r++) {
+                if (Math.abs(normal[r][col]) > Math.abs(normal[pivot][col])) {
+                    pivot = r;
+                }
+            }
+            if (Math.abs(normal[pivot][col]) <= reg * 1e-3) {
+                return false;
+            }
+            if (pivot != col) {
+                double t[] = normal[pivot];
+                normal[pivot] = normal[col];
+                normal[col] = t;
+                double tr = rhs[pivot];
+                rhs[pivot] = rhs[col];
+                rhs[col] = tr;
+            }
+            for (int r = col + 1; r != m; r++) {
+                double factor = normal[r][col] / normal[col][col];
+                for (int c = col; c != m; c++) {
+                    normal[r][c] -= factor * normal[col][c];
+                }
+                rhs[r] -= factor * rhs[col];
+            }
+        }
+        for (int r = m - 1; r >= 0; r--) {
+            double s = rhs[r];
+            for (int c = r + 1; c != m; c++) {
+                s -= normal[r][c] * gamma[c];
+            }
+            gamma[r] = s / normal[r][r];
+        }
+        return true;
+    }
+}
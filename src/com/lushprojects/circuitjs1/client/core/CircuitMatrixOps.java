@@ -14,21 +14,45 @@ public final class CircuitMatrixOps {
     public static int luFactor(double[][] a, int n, int[] ipvt) {
         int badRow = LUSolver.factor(a, n, ipvt);
         if (badRow >= 0) {
-            CirSim.console("didn't avoid zero at row " + badRow);
-            CirSim.console("  Non-zero entries in column " + badRow + ":");
-            for (int dbg = 0; dbg < n; dbg++) {
-                if (a[dbg][badRow] != 0.0) {
-                    CirSim.console("    row " + dbg + ": " + a[dbg][badRow]);
-                }
+            logZeroPivot(a, n, badRow);
+        }
+        return badRow;
+    }
+
+    // Factors the working matrix of sms.
+    public static int luFactor(SolverMatrixState sms) {
+        sms.lowRankUpdate = null;
+        return luFactor(sms.circuitMatrix, sms.circuitMatrixSize, sms.circuitPermute);
+    }
+
+    // Logs the non-zero entries in the row and column of a pivot that could
+    // not be avoided.
+    private static void logZeroPivot(double[][] a, int n, int badRow) {
+        CirSim.console("didn't avoid zero at row " + badRow);
+        CirSim.console("  Non-zero entries in column " + badRow + ":");
+        for (int dbg = 0; dbg < n; dbg++) {
+            if (a[dbg][badRow] != 0.0) {
+                CirSim.console("    row " + dbg + ": " + a[dbg][badRow]);
             }
-            CirSim.console("  Non-zero entries in row " + badRow + ":");
-            for (int dbg = 0; dbg < n; dbg++) {
-                if (a[badRow][dbg] != 0.0) {
-                    CirSim.console("    col " + dbg + ": " + a[badRow][dbg]);
-                }
+        }
+        CirSim.console("  Non-zero entries in row " + badRow + ":");
+        for (int dbg = 0; dbg < n; dbg++) {
+            if (a[badRow][dbg] != 0.0) {
+                CirSim.console("    col " + dbg + ": " + a[badRow][dbg]);
             }
         }
-        return badRow;
+    }
+
+    public static void luSolve(SolverMatrixState sms, double[] b) {
+        luSolveBase(sms, b);
+        if (sms.lowRankUpdate != null) {
+            sms.lowRankUpdate.correct(b);
+        }
+    }
+
+    // Solve with the factors in the working matrix, ignoring any low-rank update.
+    static void luSolveBase(SolverMatrixState sms, double[] b) {
+        LUSolver.solve(sms.circuitMatrix, sms.circuitMatrixSize, sms.circuitPermute, b);
     }
 
     // Solves the set of n linear equations using a LU factorization
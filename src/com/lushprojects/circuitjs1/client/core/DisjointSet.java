@@ -0,0 +1,83 @@
+/*
+    Copyright (C) Paul Falstad and Iain Sharp
+
+    This file is part of CircuitJS1.
+*/
+
+package com.lushprojects.circuitjs1.client.core;
+
+/**
+ * Union-find over dense int ids with path halving and union by size.
+ *
+ * Used by circuit analysis to merge wire-connected posts into nodes: each
+ * union and find is effectively constant time, so grouping W wires costs
+ * O(W) instead of relabelling every existing post on each merge.
+ * Ids are handed out by {@link #add()} and the storage grows as needed.
+ */
+public final class DisjointSet {
+
+    private int[] parent;
+    private int[] size;
+    private int count;
+
+    public DisjointSet() {
+        this(16);
+    }
+
+    public DisjointSet(int capacity) {
+        parent = new int[Math.max(capacity, 1)];
+        size = new int[parent.length];
+    }
+
+    /** Add a new singleton set and return its id. */
+    public int add() {
+        if (count == parent.length) {
+            int[] np = new int[parent.length * 2];
+            int[] ns = new int[np.length];
+            System.arraycopy(parent, 0, np, 0, count);
+            System.arraycopy(size, 0, ns, 0, count);
+            parent = np;
+            size = ns;
+        }
+        parent[count] = count;
+        size[count] = 1;
+        return count++;
+    }
+
+    /** Number of ids added so far. */
+    public int size() {
+        return count;
+    }
+
+    /** Representative id of the set containing x. */
+    public int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    /**
+     * Merge the sets containing a and b.
+     * @return false if they were already in the same set
+     */
+    public boolean union(int a, int b) {
+        int ra = find(a);
+        int rb = find(b);
+        if (ra == rb)
+            return false;
+        if (size[ra] < size[rb]) {
+            int t = ra;
+            ra = rb;
+            rb = t;
+        }
+        parent[rb] = ra;
+        size[ra] += size[rb];
+        return true;
+    }
+
+    public boolean connected(int a, int b) {
+        return find(a) == find(b);
+    }
+}
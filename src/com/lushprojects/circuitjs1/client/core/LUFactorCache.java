@@ -0,0 +1,243 @@
+/*
+    Copyright (C) Paul Falstad and Iain Sharp
+
+    This file is part of CircuitJS1.
+*/
+
+package com.lushprojects.circuitjs1.client.core;
+
+import java.util.ArrayList;
+
+/**
+ * Recent LU factorizations of the linear circuit matrix.
+ *
+ * A linear circuit is refactored whenever it is restamped: each timestep
+ * change, each re-analysis and each slider edit. Going back to an earlier
+ * timestep or slider value produces the same matrix again. Entries are keyed
+ * by the stamped matrix itself (origMatrix) rather than by version counters,
+ * which only ever grow and so would never match a value seen before.
+ *
+ * On a lookup the cache either
+ * <ul>
+ * <li>finds the same matrix and copies its factors and pivots into the
+ *     working matrix, or</li>
+ * <li>finds one of the same size that differs in at most {@link #MAX_RANK}
+ *     rows (a component value or slider edit, which restamps only the rows
+ *     of its nodes) and installs a {@link LowRankUpdate} on top of its
+ *     factors, or</li>
+ * <li>factors normally and remembers the result.</li>
+ * </ul>
+ * "Same" allows last-bit differences: a slider edit is applied as a stamp
+ * delta, so dragging back leaves rounding noise in the entries it touched.
+ * Low-rank updates are only tried from {@link #LOW_RANK_MIN_SIZE} rows up,
+ * where they are cheaper than a factorization, and are checked against a
+ * known solution before use; otherwise the matrix is refactored. Switch
+ * toggles usually change the simplified matrix size and so are only ever
+ * exact hits.
+ */
+public final class LUFactorCache {
+
+    static final int MAX_ENTRIES = 4;
+    // about 32MB of doubles; each entry holds the matrix and its factors
+    static final int MAX_DOUBLES = 1 << 22;
+    static final int MAX_RANK = 4;
+    static final int LOW_RANK_MIN_SIZE = 32;
+    private static final double CHECK_TOLERANCE = 1e-9;
+    private static final double SAME_TOLERANCE = 1e-13;
+
+    private static final class Entry {
+        final int n;
+        final double orig[];  // row-major copy of origMatrix
+        final double lu[];    // row-major factors as left by luFactor
+        final int permute[];
+
+        Entry(int n) {
+            this.n = n;
+            orig = new double[n * n];
+            lu = new double[n * n];
+            permute = new int[n];
+        }
+    }
+
+    // least recently used first
+    private final ArrayList<Entry> entries = new ArrayList<Entry>();
+    private int hits;
+    private int lowRankHits;
+    private int misses;
+
+    // scratch: rows changed against the entry being compared / the low-rank base
+    private final int rows[] = new int[MAX_RANK + 1];
+    private final int baseRows[] = new int[MAX_RANK];
+
+    public void clear() {
+        entries.clear();
+    }
+
+    public int getHitCount() {
+        return hits;
+    }
+
+    public int getLowRankHitCount() {
+        return lowRankHits;
+    }
+
+    public int getMissCount() {
+        return misses;
+    }
+
+    /**
+     * Factor the working matrix of a linear circuit, which must have just
+     * been restored from origMatrix.
+     *
+     * @return -1 on success, or the problematic row index (as from luFactor)
+     */
+    public int factor(SolverMatrixState sms) {
+        sms.lowRankUpdate = null;
+        int n = sms.circuitMatrixSize;
+        double orig[][] = sms.origMatrix;
+
+        Entry lowRankBase = null;
+        int lowRankCount = 0;
+        for (int e = entries.size() - 1; e >= 0; e--) {
+            Entry entry = entries.get(e);
+            if (entry.n != n) {
+                continue;
+            }
+            int limit = (lowRankBase == null && n >= LOW_RANK_MIN_SIZE) ? MAX_RANK : 0;
+            int count = changedRows(entry, orig, n, limit);
+            if (count == 0) {
+                touch(e);
+                copyToWorking(sms, entry);
+                hits++;
+                return -1;
+            }
+            if (count <= limit) {
+                lowRankBase = entry;
+                lowRankCount = count;
+                System.arraycopy(rows, 0, baseRows, 0, count);
+            }
+        }
+
+        if (lowRankBase != null && tryLowRank(sms, lowRankBase, lowRankCount)) {
+            touch(entries.indexOf(lowRankBase));
+            lowRankHits++;
+            return -1;
+        }
+
+        misses++;
+        int badRow = CircuitMatrixOps.luFactor(sms);
+        if (badRow < 0) {
+            store(sms);
+        }
+        return badRow;
+    }
+
+    /**
+     * Number of rows where orig differs from the entry, stopping once it
+     * exceeds limit; the first ones are left in {@link #rows}.
+     */
+    private int changedRows(Entry entry, double orig[][], int n, int limit) {
+        int count = 0;
+        for (int i = 0; i != n; i++) {
+            double row[] = orig[i];
+            int base = i * n;
+            for (int j = 0; j != n; j++) {
+                if (differs(row[j], entry.orig[base + j])) {
+                    rows[count++] = i;
+                    if (count > limit) {
+                        return count;
+                    }
+                    break;
+                }
+            }
+        }
+        return count;
+    }
+
+    private static boolean differs(double a, double b) {
+        return a != b && !(Math.abs(a - b) <= SAME_TOLERANCE * Math.max(Math.abs(a), Math.abs(b)));
+    }
+
+    private boolean tryLowRank(SolverMatrixState sms, Entry base, int k) {
+        int n = base.n;
+        double diff[][] = new double[k][n];
+        for (int s = 0; s != k; s++) {
+            int r = baseRows[s];
+            double row[] = sms.origMatrix[r];
+            for (int j = 0; j != n; j++) {
+                diff[s][j] = row[j] - base.orig[r * n + j];
+            }
+        }
+        copyToWorking(sms, base);
+        LowRankUpdate update = LowRankUpdate.build(sms, baseRows, diff, k);
+        if (update != null) {
+            sms.lowRankUpdate = update;
+            if (checkSolution(sms)) {
+                return true;
+            }
+            sms.lowRankUpdate = null;
+        }
+        // working matrix holds the base factors; start over from the stamped matrix
+        sms.restoreMatrixFromOrig();
+        return false;
+    }
+
+    // Solve A' x = A' * ones and see that x comes back as ones.
+    private static boolean checkSolution(SolverMatrixState sms) {
+        int n = sms.circuitMatrixSize;
+        double b[] = new double[n];
+        for (int i = 0; i != n; i++) {
+            double row[] = sms.origMatrix[i];
+            double sum = 0;
+            for (int j = 0; j != n; j++) {
+                sum += row[j];
+            }
+            b[i] = sum;
+        }
+        CircuitMatrixOps.luSolve(sms, b);
+        for (int i = 0; i != n; i++) {
+            // also rejects NaN
+            if (!(Math.abs(b[i] - 1) <= CHECK_TOLERANCE)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    private void store(SolverMatrixState sms) {
+        int n = sms.circuitMatrixSize;
+        if (2 * n * n > MAX_DOUBLES) {
+            return;
+        }
+        Entry entry = new Entry(n);
+        for (int i = 0; i != n; i++) {
+            System.arraycopy(sms.origMatrix[i], 0, entry.orig, i * n, n);
+        }
+        for (int i = 0; i != n; i++) {
+            System.arraycopy(sms.circuitMatrix[i], 0, entry.lu, i * n, n);
+        }
+        System.arraycopy(sms.circuitPermute, 0, entry.permute, 0, n);
+        entries.add(entry);
+
+        int total = 0;
+        for (int e = 0; e != entries.size(); e++) {
+            total += 2 * entries.get(e).n * entries.get(e).n;
+        }
+        while (entries.size() > MAX_ENTRIES || total > MAX_DOUBLES) {
+            Entry old = entries.remove(0);
+            total -= 2 * old.n * old.n;
+        }
+    }
+
+    private static void copyToWorking(SolverMatrixState sms, Entry entry) {
+        int n = entry.n;
+        for (int i = 0; i != n; i++) {
+            System.arraycopy(entry.lu, i * n, sms.circuitMatrix[i], 0, n);
+        }
+        System.arraycopy(entry.permute, 0, sms.circuitPermute, 0, n);
+    }
+
+    private void touch(int index) {
+        entries.add(entries.remove(index));
+    }
+}
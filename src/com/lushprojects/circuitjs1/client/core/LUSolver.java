@@ -40,6 +40,11 @@ public final class LUSolver {
             }
         }
 
+        NumericKernels kernels = NumericKernels.get();
+        if (kernels.isAccelerated()) {
+            return factorRightLooking(a, n, ipvt, kernels);
+        }
+
         for (j = 0; j != n; j++) {
             for (i = 0; i != j; i++) {
                 double q = a[i][j];
@@ -91,6 +96,55 @@ public final class LUSolver {
         return -1;
     }
 
+    /**
+     * Same factorization as the Crout loop above, but eliminating whole rows
+     * after each pivot so the inner loop runs along contiguous row storage
+     * (Crout walks a[k][j] down a column, which SIMD cannot load). Pivot
+     * choice and the LU layout are identical; only the summation order
+     * differs, so it is used only when accelerated kernels are installed.
+     */
+    private static int factorRightLooking(double[][] a, int n, int[] ipvt, NumericKernels kernels) {
+        for (int j = 0; j != n; j++) {
+            double largest = 0;
+            int largestRow = -1;
+            for (int i = j; i != n; i++) {
+                double x = Math.abs(a[i][j]);
+                if (x >= largest) {
+                    largest = x;
+                    largestRow = i;
+                }
+            }
+
+            if (j != largestRow) {
+                if (largestRow == -1) {
+                    return j;
+                }
+                double[] tmp = a[largestRow];
+                a[largestRow] = a[j];
+                a[j] = tmp;
+            }
+
+            ipvt[j] = largestRow;
+
+            double[] pivotRow = a[j];
+            if (pivotRow[j] == 0.0) {
+                return j;
+            }
+
+            double mult = 1.0 / pivotRow[j];
+            for (int i = j + 1; i != n; i++) {
+                double[] row = a[i];
+                double l = row[j] * mult;
+                row[j] = l;
+                if (l != 0) {
+                    kernels.subtractScaled(row, j + 1, l, pivotRow, j + 1, n - j - 1);
+                }
+            }
+        }
+
+        return -1;
+    }
+
     /**
      * Solve linear system using LU decomposition produced by {@link #factor(double[][], int, int[])}.
      *
@@ -100,6 +154,7 @@ public final class LUSolver {
      * @param b right-side vector, overwritten with solution
      */
     public static void solve(double[][] a, int n, int[] ipvt, double[] b) {
+        NumericKernels kernels = NumericKernels.get();
         int i;
 
         for (i = 0; i != n; i++) {
@@ -116,23 +171,14 @@ public final class LUSolver {
         int bi = i++;
         for (; i < n; i++) {
             int row = ipvt[i];
-            int j;
             double tot = b[row];
 
             b[row] = b[i];
-            for (j = bi; j < i; j++) {
-                tot -= a[i][j] * b[j];
-            }
-            b[i] = tot;
+            b[i] = kernels.dotSubtract(tot, a[i], bi, b, bi, i - bi);
         }
 
         for (i = n - 1; i >= 0; i--) {
-            double tot = b[i];
-
-            int j;
-            for (j = i + 1; j != n; j++) {
-                tot -= a[i][j] * b[j];
-            }
+            double tot = kernels.dotSubtract(b[i], a[i], i + 1, b, i + 1, n - i - 1);
             b[i] = tot / a[i][i];
         }
     }
@@ -0,0 +1,100 @@
+/*
+    Copyright (C) Paul Falstad and Iain Sharp
+
+    This file is part of CircuitJS1.
+*/
+
+package com.lushprojects.circuitjs1.client.core;
+
+/**
+ * Sherman-Morrison-Woodbury correction for a matrix that differs from an
+ * already factored one in a few rows.
+ *
+ * With A' = A + U D, where U holds the unit vectors of the k changed rows
+ * and D (k x n) the row differences:
+ *
+ * $$ A'^{-1} b = y - Z C^{-1} D y, \quad y = A^{-1} b, \quad Z = A^{-1} U, \quad C = I + D Z $$
+ *
+ * so each solve is one solve with the factors of A plus O(nk) work. Built by
+ * {@link LUFactorCache}; {@link CircuitMatrixOps#luSolve(SolverMatrixState, double[])}
+ * applies it after the base solve.
+ */
+public final class LowRankUpdate {
+
+    private final int n;
+    private final int k;
+    private final double diff[][];    // k x n, rows of A' - A
+    private final double z[][];       // k x n, columns of A^{-1} U stored as rows
+    private final double cap[][];     // k x k, LU of C
+    private final int capPermute[];
+    private final double w[];
+
+    private LowRankUpdate(int n, int k) {
+        this.n = n;
+        this.k = k;
+        diff = new double[k][];
+        z = new double[k][n];
+        cap = new double[k][k];
+        capPermute = new int[k];
+        w = new double[k];
+    }
+
+    /**
+     * Build the correction with the base factors already in {@code sms}.
+     *
+     * @param rows    indices of the changed rows
+     * @param diff    row differences A' - A, one per entry of rows
+     * @return null if the capacitance matrix is singular
+     */
+    static LowRankUpdate build(SolverMatrixState sms, int rows[], double diff[][], int k) {
+        int n = sms.circuitMatrixSize;
+        LowRankUpdate u = new LowRankUpdate(n, k);
+        for (int s = 0; s != k; s++) {
+            u.diff[s] = diff[s];
+            u.z[s][rows[s]] = 1;
+            CircuitMatrixOps.luSolveBase(sms, u.z[s]);
+        }
+        for (int s = 0; s != k; s++) {
+            for (int t = 0; t != k; t++) {
+                double dot = s == t ? 1 : 0;
+                double ds[] = u.diff[s];
+                double zt[] = u.z[t];
+                for (int j = 0; j != n; j++) {
+                    dot += ds[j] * zt[j];
+                }
+                u.cap[s][t] = dot;
+            }
+        }
+        if (LUSolver.factor(u.cap, k, u.capPermute) >= 0) {
+            return null;
+        }
+        return u;
+    }
+
+    public int getRank() {
+        return k;
+    }
+
+    /** Turn y = A^{-1} b into A'^{-1} b in place. */
+    void correct(double y[]) {
+        for (int s = 0; s != k; s++) {
+            double ds[] = diff[s];
+            double dot = 0;
+            for (int j = 0; j != n; j++) {
+                dot += ds[j] * y[j];
+            }
+            w[s] = dot;
+        }
+        LUSolver.solve(cap, k, capPermute, w);
+        for (int s = 0; s != k; s++) {
+            double ws = w[s];
+            if (ws == 0) {
+                continue;
+            }
+            double zs[] = z[s];
+            for (int j = 0; j != n; j++) {
+                y[j] -= zs[j] * ws;
+            }
+        }
+    }
+}
@@ -5,10 +5,23 @@ import com.lushprojects.circuitjs1.client.CircuitElm;
 import com.lushprojects.circuitjs1.client.core.CircuitNode;
 import com.lushprojects.circuitjs1.client.core.RowInfo;
 
+import java.util.Arrays;
+
 public class MatrixStamper {
     private final CirSim sim;
     private int cachedNodeListSize;
 
+    // Delta recording for parameter-only edits: while recording, stamps are
+    // accumulated here (mapped to simplified rows/columns, column -1 = right side)
+    // instead of being written to the circuit matrix.
+    private boolean recording;
+    private double recordSign;
+    private boolean recordInvalid;
+    private int recordCount;
+    private int[] recordRow = new int[16];
+    private int[] recordCol = new int[16];
+    private double[] recordValue = new double[16];
+
     public MatrixStamper(CirSim sim) {
         this.sim = sim;
     }
@@ -93,6 +106,10 @@ public class MatrixStamper {
             CirSim.debugger();
         }
         if (i > 0 && j > 0) {
+            if (recording) {
+                recordMatrix(i, j, x);
+                return;
+            }
             if (sim.getSolverMatrixState().circuitNeedsMap) {
                 i = sim.getSolverMatrixState().circuitRowInfo[i - 1].mapRow;
                 RowInfo ri = sim.getSolverMatrixState().circuitRowInfo[j - 1];
@@ -111,6 +128,14 @@ public class MatrixStamper {
 
     public void stampRightSide(int i, double x) {
         if (i > 0) {
+            if (recording) {
+                RowInfo rri = sim.getSolverMatrixState().circuitRowInfo[i - 1];
+                if (rri.mapRow < 0)
+                    recordInvalid = true;
+                else
+                    addRecord(rri.mapRow, -1, x);
+                return;
+            }
             if (sim.getSolverMatrixState().circuitNeedsMap) {
                 i = sim.getSolverMatrixState().circuitRowInfo[i - 1].mapRow;
             } else
@@ -120,16 +145,94 @@ public class MatrixStamper {
     }
 
     public void stampRightSide(int i) {
-        if (i > 0)
+        // row flags were fixed by the full stamp; a recorded restamp must not change them
+        if (i > 0 && !recording)
             sim.getSolverMatrixState().circuitRowInfo[i - 1].rsChanges = true;
     }
 
     public void stampNonLinear(int i) {
-        if (i > 0) {
+        if (i > 0 && !recording) {
             sim.getSolverMatrixState().circuitRowInfo[i - 1].lsChanges = true;
         }
     }
 
+    /**
+     * Start recording the stamp difference caused by a parameter-only edit.
+     * Stamps made until {@link #recordNewStamp()} are the element's old stamp and
+     * are subtracted; stamps made after it are added. Only valid once the circuit
+     * has been stamped and simplified.
+     */
+    public void beginDeltaRecording() {
+        recording = true;
+        recordSign = -1;
+        recordInvalid = false;
+        recordCount = 0;
+    }
+
+    /** Switch from recording the old stamp to recording the new one. */
+    public void recordNewStamp() {
+        recordSign = 1;
+    }
+
+    /**
+     * Stop recording and add the net stamp difference to the given (simplified)
+     * matrix and right side. Returns -1 without touching them if any stamp hit a
+     * row removed by simplifyMatrix(), otherwise the number of matrix entries
+     * that changed (right side changes are applied but not counted).
+     */
+    public int endDeltaRecording(double[][] matrix, double[] rightSide) {
+        recording = false;
+        if (recordInvalid)
+            return -1;
+        int changed = 0;
+        for (int k = 0; k != recordCount; k++) {
+            double v = recordValue[k];
+            if (v == 0)
+                continue;
+            if (recordCol[k] < 0) {
+                rightSide[recordRow[k]] += v;
+            } else {
+                matrix[recordRow[k]][recordCol[k]] += v;
+                changed++;
+            }
+        }
+        return changed;
+    }
+
+    private void recordMatrix(int i, int j, double x) {
+        SolverMatrixState sms = sim.getSolverMatrixState();
+        int row = sms.circuitRowInfo[i - 1].mapRow;
+        if (row < 0) {
+            recordInvalid = true;
+            return;
+        }
+        RowInfo ri = sms.circuitRowInfo[j - 1];
+        if (ri.type == RowInfo.ROW_CONST)
+            addRecord(row, -1, -x * ri.value);
+        else
+            addRecord(row, ri.mapCol, x);
+    }
+
+    // old and new stamps of the same entry are merged so an unchanged entry nets to exactly zero
+    private void addRecord(int row, int col, double x) {
+        x *= recordSign;
+        for (int k = 0; k != recordCount; k++) {
+            if (recordRow[k] == row && recordCol[k] == col) {
+                recordValue[k] += x;
+                return;
+            }
+        }
+        if (recordCount == recordRow.length) {
+            recordRow = Arrays.copyOf(recordRow, recordCount * 2);
+            recordCol = Arrays.copyOf(recordCol, recordCount * 2);
+            recordValue = Arrays.copyOf(recordValue, recordCount * 2);
+        }
+        recordRow[recordCount] = row;
+        recordCol[recordCount] = col;
+        recordValue[recordCount] = x;
+        recordCount++;
+    }
+
     public String getMatrixRowInfo(int row) {
         int nodeCount = sim.getCircuitAnalyzer().getNodeList().size();
 
@@ -0,0 +1,121 @@
+/*
+    Copyright (C) Paul Falstad and Iain Sharp
+
+    This file is part of CircuitJS1.
+*/
+
+package com.lushprojects.circuitjs1.client.core;
+
+/**
+ * Inner loops shared by the solver and the history/lookup code.
+ *
+ * This class is the scalar implementation and is what the browser always
+ * uses. The JVM runner can install a SIMD subclass built on the Vector API
+ * (see runner/VectorKernelSupport); that one lives outside src/ because it
+ * needs JDK 17 and an incubator module. The scalar methods keep the exact
+ * operation order of the loops they replaced, so results only change when
+ * an accelerated implementation is installed.
+ */
+public class NumericKernels {
+
+    private static final NumericKernels SCALAR = new NumericKernels();
+    private static NumericKernels current = SCALAR;
+
+    protected NumericKernels() {
+    }
+
+    public static NumericKernels get() {
+        return current;
+    }
+
+    /** Install an implementation; null restores the scalar one. */
+    public static void install(NumericKernels kernels) {
+        current = kernels == null ? SCALAR : kernels;
+    }
+
+    /**
+     * True if this implementation reorders arithmetic (SIMD lanes), so callers
+     * may switch to loop shapes that only pay off when vectorized.
+     */
+    public boolean isAccelerated() {
+        return false;
+    }
+
+    public String getName() {
+        return "scalar";
+    }
+
+    /** Returns {@code init - sum(a[aOff+k] * b[bOff+k])} for k below len. */
+    public double dotSubtract(double init, double[] a, int aOff, double[] b, int bOff, int len) {
+        for (int k = 0; k < len; k++) {
+            init -= a[aOff + k] * b[bOff + k];
+        }
+        return init;
+    }
+
+    /** {@code y[yOff+k] -= alpha * x[xOff+k]} for k below len. */
+    public void subtractScaled(double[] y, int yOff, double alpha, double[] x, int xOff, int len) {
+        for (int k = 0; k < len; k++) {
+            y[yOff + k] -= alpha * x[xOff + k];
+        }
+    }
+
+    /**
+     * Halve a min/max envelope in place: {@code min[i] = min(min[2i], min[2i+1])}
+     * and likewise for max. An odd last sample is carried over. Returns the new size.
+     */
+    public int pairwiseMinMax(double[] min, double[] max, int size) {
+        int half = size / 2;
+        for (int i = 0; i < half; i++) {
+            min[i] = Math.min(min[2 * i], min[2 * i + 1]);
+            max[i] = Math.max(max[2 * i], max[2 * i + 1]);
+        }
+        if ((size & 1) != 0) {
+            min[half] = min[size - 1];
+            max[half] = max[size - 1];
+            half++;
+        }
+        return half;
+    }
+
+    /**
+     * Piecewise-linear lookup of {@code count} points against breakpoints
+     * {@code xs}/{@code ys} (n of them, ascending x), with the same segment
+     * choice and end handling as a single lookup.
+     */
+    public void interpolate(double[] xs, double[] ys, int n, double[] x, double[] out, int count, boolean clamp) {
+        for (int i = 0; i < count; i++) {
+            out[i] = interpolateOne(xs, ys, n, x[i], clamp);
+        }
+    }
+
+    /**
+     * Single lookup, used for each {@code lookup()} in an expression: the
+     * first segment whose right end is above x, extended past the ends
+     * unless clamped.
+     */
+    public static double interpolateOne(double[] xs, double[] ys, int n, double x, boolean clamp) {
+        if (n == 1) {
+            return ys[0];
+        }
+        if (x < xs[0]) {
+            return clamp ? ys[0] : linear(x, xs[0], ys[0], xs[1], ys[1]);
+        }
+        int i = 1;
+        while (i < n && !(x < xs[i])) {
+            i++;
+        }
+        if (i < n) {
+            return linear(x, xs[i - 1], ys[i - 1], xs[i], ys[i]);
+        }
+        return clamp ? ys[n - 1] : linear(x, xs[n - 2], ys[n - 2], xs[n - 1], ys[n - 1]);
+    }
+
+    protected static double linear(double x, double x0, double y0, double x1, double y1) {
+        double dx = x1 - x0;
+        if (Math.abs(dx) < 1e-12) {
+            return y0;
+        }
+        return y0 + (x - x0) * (y1 - y0) / dx;
+    }
+}
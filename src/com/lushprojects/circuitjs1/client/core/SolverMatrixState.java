@@ -19,4 +19,18 @@ public final class SolverMatrixState {
     public boolean circuitNeedsMap;
     public int circuitMatrixSize;
     public int circuitMatrixFullSize;
+
+    // Set when the working matrix holds the factors of a cached matrix that
+    // differs from this one in a few rows; luSolve applies the correction.
+    // Cleared by every fresh factorization.
+    public LowRankUpdate lowRankUpdate;
+    public final LUFactorCache factorCache = new LUFactorCache();
+
+    /** Reset the working matrix to the stamped linear part before a subiteration. */
+    public void restoreMatrixFromOrig() {
+        int n = circuitMatrixSize;
+        for (int i = 0; i != n; i++) {
+            System.arraycopy(origMatrix[i], 0, circuitMatrix[i], 0, n);
+        }
+    }
 }
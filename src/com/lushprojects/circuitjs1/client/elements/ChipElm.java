@@ -43,7 +43,7 @@ public abstract class ChipElm extends CircuitElm {
 	    highVoltage = 5;
 	    noDiagonal = true;
 	    setupPins();
-	    setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+	    setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
 	}
 	public ChipElm(int xa, int ya, int xb, int yb, int f,
 		       StringTokenizer st) {
@@ -124,7 +124,7 @@ public abstract class ChipElm extends CircuitElm {
 		if (!hasVertical && sizeX > 2)
 		    availSpace = cspc*2.5+cspc*(sizeX-3);
 		while (true) {
-		    int sw=(int)g.context.measureText(p.text).getWidth();
+		    int sw=(int)g.measureText(p.text);
 		    // scale font down if it's too big
 		    if (sw > availSpace && fsz > 1) {
 			fsz -= 1;
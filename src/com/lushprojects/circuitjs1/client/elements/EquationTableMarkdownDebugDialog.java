@@ -206,7 +206,11 @@ public class EquationTableMarkdownDebugDialog {
     }
     
     public void refresh() {
-        textArea.setText(generateMarkdownContent());
+        // leave the text area alone when nothing changed so scroll and selection survive
+        String markdown = generateMarkdownContent();
+        if (!markdown.equals(textArea.getText())) {
+            textArea.setText(markdown);
+        }
     }
     
     /**
@@ -340,6 +344,9 @@ public class EquationTableMarkdownDebugDialog {
             md.append("| EqnTable MNA Mode (global) | ").append(sim.isEquationTableMnaMode()).append(" |\n");
             md.append("| EqnTable Newton Jacobian (global) | ").append(sim.equationTableNewtonJacobianEnabled).append(" |\n");
             md.append("| EqnTable Broyden Jacobian (global) | ").append(sim.equationTableBroydenJacobianEnabled).append(" |\n");
+            if (sim.equationTableNewtonJacobianEnabled && sourceTable != null) {
+                md.append("| Jacobian FD Coloring | ").append(sourceTable.getNewtonJacobianColoringSummary()).append(" |\n");
+            }
         } else {
             md.append("*(Simulator not available)*\n");
         }
@@ -195,6 +195,18 @@ public class Expr {
 	    : ComputedValues.getLaggedValue(name);
 	}
 
+    // Bumped once per timestep attempt; step-invariant subtree caches older than this are stale.
+    private static int timestepEpoch = 0;
+
+    /**
+     * Start a new timestep for step-invariant caching (see {@link #markStepInvariants()}).
+     * Called by the simulation loop before the subiterations of each timestep, including
+     * retries at the same time with a smaller timestep.
+     */
+    public static void beginTimestep() {
+	timestepEpoch++;
+    }
+
     /** Clear the unresolved references list (call at start of each timestep) */
     public static void clearUnresolvedReferences() {
 	unresolvedReferences.clear();
@@ -343,6 +355,90 @@ public class Expr {
 	}
     }
     
+    /**
+     * Tag subtrees whose value cannot change between subiterations of one timestep.
+     *
+     * A subtree is step-invariant when it only depends on literals, {@code t},
+     * {@code timestep}, {@code last(X)} (previous converged values) and lookup tables,
+     * combined with pure functions. Same-period node/variable references and the
+     * per-subiteration slots (a..h, lastoutput) are not invariant, and neither are
+     * the stateful operators (integrate, diff, lag, smooth, delay), which record
+     * their input on every evaluation. Parameters are treated as same-period
+     * references because equation tables compute them during the step.
+     *
+     * The root of each maximal invariant subtree (other than a bare leaf) caches its
+     * value on first evaluation in a timestep and reuses it for the remaining
+     * subiterations, so e.g. {@code lookup(Demand, t) * last(Y)} is computed once
+     * per step instead of once per subiteration. Called by the parser.
+     */
+    void markStepInvariants() {
+	if (markStepInvariantsInternal() && isWorthCaching())
+	    stepInvariantRoot = true;
+    }
+
+    private boolean markStepInvariantsInternal() {
+	switch (type) {
+	case E_VAL: case E_T: case E_TIMESTEP:
+	    return true;
+	case E_LAST:
+	    // reads only the lagged value of its argument's name, never evaluates it
+	    return true;
+	case E_ADD: case E_SUB: case E_MUL: case E_DIV: case E_POW:
+	case E_MOD: case E_UMINUS: case E_NOT:
+	case E_OR: case E_AND:
+	case E_EQUALS: case E_NEQ: case E_LEQ: case E_GEQ:
+	case E_LESS: case E_GREATER:
+	case E_SIN: case E_COS: case E_TAN:
+	case E_ASIN: case E_ACOS: case E_ATAN:
+	case E_SINH: case E_COSH: case E_TANH:
+	case E_ABS: case E_EXP: case E_LOG: case E_SQRT:
+	case E_FLOOR: case E_CEIL:
+	case E_MIN: case E_MAX: case E_CLAMP:
+	case E_PWR: case E_PWRS:
+	case E_STEP: case E_SELECT:
+	case E_PWL: case E_PWLX:
+	case E_TERNARY:
+	case E_TRIANGLE: case E_SAWTOOTH:
+	case E_LOOKUP:
+	    return markChildren(true);
+	default:
+	    markChildren(false);
+	    return false;
+	}
+    }
+
+    // Returns true if every child is invariant. When this node can't be cached as a
+    // whole (or all children aren't invariant), invariant children become cache roots.
+    private boolean markChildren(boolean pureNode) {
+	if (children == null)
+	    return pureNode;
+	boolean[] childInvariant = new boolean[children.size()];
+	boolean all = pureNode;
+	for (int i = 0; i < children.size(); i++) {
+	    Expr child = children.get(i);
+	    childInvariant[i] = child != null && child.markStepInvariantsInternal();
+	    all &= childInvariant[i];
+	}
+	if (!all) {
+	    for (int i = 0; i < children.size(); i++) {
+		Expr child = children.get(i);
+		if (childInvariant[i] && child.isWorthCaching())
+		    child.stepInvariantRoot = true;
+	    }
+	}
+	return all;
+    }
+
+    // Leaves are as cheap to evaluate as a cache check; last() does map lookups.
+    private boolean isWorthCaching() {
+	return type == E_LAST || (children != null && children.size() > 0);
+    }
+
+    /** True if this node caches its value across the subiterations of a timestep. */
+    boolean isStepInvariantRoot() {
+	return stepInvariantRoot;
+    }
+
     /**
      * Walk this expression tree, converting E_NODE_REF nodes to E_GSLOT where the name
      * has a pre-assigned slot in the circuit-global array.  Also re-resolves E_GSLOT
@@ -730,6 +826,25 @@ public class Expr {
 	}
 
     public double eval(ExprState es, EvaluationContext context) {
+	// t=0 is skipped: initial values (X_init fallbacks of last()) are still being
+	// computed during the first solve. Display/converged evaluations bypass the cache.
+	if (stepInvariantRoot && es != null && context == CURRENT_CONTEXT && es.t != 0) {
+	    int convergedVersion = ComputedValues.getConvergedValuesVersion();
+	    if (invariantState == es && invariantEpoch == timestepEpoch && invariantT == es.t
+		    && invariantConvergedVersion == convergedVersion)
+		return invariantValue;
+	    double v = evalNode(es, context);
+	    invariantState = es;
+	    invariantEpoch = timestepEpoch;
+	    invariantConvergedVersion = convergedVersion;
+	    invariantT = es.t;
+	    invariantValue = v;
+	    return v;
+	}
+	return evalNode(es, context);
+    }
+
+    private double evalNode(ExprState es, EvaluationContext context) {
 	Expr left = null;
 	Expr right = null;
 	if (children != null && children.size() > 0) {
@@ -1226,6 +1341,15 @@ public class Expr {
     private int lagIndex = -1; // Buffer index for E_LAG expressions, assigned at parse time
 	int smoothIndex = -1; // State index for E_SMOOTH expressions, assigned at parse time
 
+    // Step-invariant subtree cache (see markStepInvariants); valid for one ExprState,
+    // timestep epoch, converged-values version and time.
+    private boolean stepInvariantRoot;
+    private ExprState invariantState;
+    private int invariantEpoch;
+    private int invariantConvergedVersion;
+    private double invariantT;
+    private double invariantValue;
+
     // Cached resolution strings for E_LAST and E_LAG — populated once in
     // cacheResolutionKeys() so eval() avoids repeated HashMap lookups, string
     // concatenation, and getFlowComputedKeyForName() StringBuilder allocations.
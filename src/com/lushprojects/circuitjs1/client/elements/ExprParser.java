@@ -118,6 +118,8 @@ public class ExprParser {
 	Expr e = parse();
 	if (token.length() > 0)
 	    setError("unexpected token: " + token);
+	if (e != null)
+	    e.markStepInvariants();
 	return e;
     }
 
@@ -1249,9 +1249,9 @@ public class SFCSankeyRenderer {
         
         // Draw tooltip background with modern styling
         g.setColor("#1E293B");  // Slate-800 dark background
-        g.context.fillRect(tooltipX, tooltipY, tooltipWidth, tooltipHeight);
+        g.fillRect(tooltipX, tooltipY, tooltipWidth, tooltipHeight);
         g.setColor("#475569");  // Slate-600 border
-        g.context.strokeRect(tooltipX, tooltipY, tooltipWidth, tooltipHeight);
+        g.strokeRect(tooltipX, tooltipY, tooltipWidth, tooltipHeight);
         
         // Draw tooltip text
         g.setColor("#F8FAFC");  // Slate-50 text (light on dark)
@@ -1295,15 +1295,15 @@ public class SFCSankeyRenderer {
             double t = 1.0 - (double) i / barHeight;  // 1 at top, 0 at bottom
             int gray = (int) (220 - t * 150);  // Light gray at bottom, darker at top
             g.setColor("rgb(" + gray + "," + gray + "," + (gray + 20) + ")");
-            g.context.fillRect(barX, barY + i, barWidth, 1);
+            g.fillRect(barX, barY + i, barWidth, 1);
         }
         
         // Draw border
         g.setColor("#666666");
-        g.context.strokeRect(barX, barY, barWidth, barHeight);
+        g.strokeRect(barX, barY, barWidth, barHeight);
         
         // Draw tick marks and labels
-        g.context.setFont("9px sans-serif");
+        g.setFontName("9px sans-serif");
         int numTicks = 5;
         for (int i = 0; i <= numTicks; i++) {
             double t = (double) i / numTicks;
@@ -1312,7 +1312,7 @@ public class SFCSankeyRenderer {
             
             // Tick mark
             g.setColor("#333333");
-            g.context.fillRect(barX + barWidth, tickY, 3, 1);
+            g.fillRect(barX + barWidth, tickY, 3, 1);
             
             // Value text
             String valueText = CircuitElm.getUnitText(value, "$");
@@ -1326,17 +1326,17 @@ public class SFCSankeyRenderer {
             
             // Draw arrow pointing to current level
             g.setColor("#EF4444");  // Red-500
-            g.context.beginPath();
-            g.context.moveTo(barX - 3, currentY);
-            g.context.lineTo(barX - 8, currentY - 4);
-            g.context.lineTo(barX - 8, currentY + 4);
-            g.context.closePath();
-            g.context.fill();
+            g.beginPath();
+            g.moveTo(barX - 3, currentY);
+            g.lineTo(barX - 8, currentY - 4);
+            g.lineTo(barX - 8, currentY + 4);
+            g.closePath();
+            g.fill();
         }
         
         // Draw scale mode label at bottom
         g.setColor("#666666");
-        g.context.setFont("8px sans-serif");
+        g.setFontName("8px sans-serif");
         g.drawString(scaleMode, barX, barY + barHeight + 12);
     }
 
@@ -1347,23 +1347,23 @@ public class SFCSankeyRenderer {
         // Draw highlight glow if hovered
         if (highlighted) {
             g.setColor("rgba(251, 191, 36, 0.4)");  // Amber-400 glow
-            g.context.fillRect(node.x - 3, node.y - 3, node.width + 6, node.height + 6);
+            g.fillRect(node.x - 3, node.y - 3, node.width + 6, node.height + 6);
         }
         
         // Draw node rectangle
         g.setColor(node.color);
-        g.context.fillRect(node.x, node.y, node.width, node.height);
+        g.fillRect(node.x, node.y, node.width, node.height);
         
         // Draw border (thicker if highlighted)
         if (highlighted) {
             g.setColor("#F59E0B");  // Amber-500 border when highlighted
-            g.context.setLineWidth(2);
+            g.setLineWidth(2);
         } else {
             g.setColor("#475569");  // Slate-600 border
-            g.context.setLineWidth(1);
+            g.setLineWidth(1);
         }
-        g.context.strokeRect(node.x, node.y, node.width, node.height);
-        g.context.setLineWidth(1);  // Reset
+        g.strokeRect(node.x, node.y, node.width, node.height);
+        g.setLineWidth(1);  // Reset
         
         // Draw label
         g.setColor("#333333");
@@ -1402,34 +1402,34 @@ public class SFCSankeyRenderer {
         }
         
         // Draw filled bezier band (tapered from source to target)
-        g.context.beginPath();
+        g.beginPath();
         
         // Top edge of band - from source top to target top
-        g.context.moveTo(x1, y1 - halfBandSource);
-        g.context.bezierCurveTo(
+        g.moveTo(x1, y1 - halfBandSource);
+        g.bezierCurveTo(
             x1 + cpOffset, y1 - halfBandSource,
             x2 - cpOffset, y2 - halfBandTarget,
             x2, y2 - halfBandTarget
         );
         
         // Right edge (down at target)
-        g.context.lineTo(x2, y2 + halfBandTarget);
+        g.lineTo(x2, y2 + halfBandTarget);
         
         // Bottom edge of band (reverse direction) - from target bottom to source bottom
-        g.context.bezierCurveTo(
+        g.bezierCurveTo(
             x2 - cpOffset, y2 + halfBandTarget,
             x1 + cpOffset, y1 + halfBandSource,
             x1, y1 + halfBandSource
         );
         
         // Left edge (up at source) - implicit close
-        g.context.closePath();
-        g.context.fill();
+        g.closePath();
+        g.fill();
         
         // Draw border if highlighted
         if (highlighted) {
             g.setColor("#F59E0B");  // Amber-500
-            g.context.stroke();
+            g.stroke();
         }
         
         // Draw flow value if enabled
@@ -1450,14 +1450,14 @@ public class SFCSankeyRenderer {
         String valueText = CircuitElm.getUnitText(link.value, "$");
         
         // Draw background for readability
-        g.context.setFont("9px sans-serif");
-        double textWidth = g.context.measureText(valueText).getWidth();
+        g.setFontName("9px sans-serif");
+        double textWidth = g.measureText(valueText);
         int padding = 2;
         int bgWidth = (int) textWidth + padding * 2;
         int bgHeight = 12;
         
         g.setColor("rgba(255, 255, 255, 0.85)");
-        g.context.fillRect(valueX - bgWidth / 2, valueY - bgHeight / 2, bgWidth, bgHeight);
+        g.fillRect(valueX - bgWidth / 2, valueY - bgHeight / 2, bgWidth, bgHeight);
         
         // Draw value text
         g.setColor("#333333");
@@ -1472,14 +1472,14 @@ public class SFCSankeyRenderer {
         String valueText = CircuitElm.getUnitText(value, "$");
         
         // Draw background for readability
-        g.context.setFont("9px sans-serif");
-        double textWidth = g.context.measureText(valueText).getWidth();
+        g.setFontName("9px sans-serif");
+        double textWidth = g.measureText(valueText);
         int padding = 2;
         int bgWidth = (int) textWidth + padding * 2;
         int bgHeight = 12;
         
         g.setColor("rgba(255, 255, 255, 0.85)");
-        g.context.fillRect(valueX - bgWidth / 2, valueY - bgHeight / 2, bgWidth, bgHeight);
+        g.fillRect(valueX - bgWidth / 2, valueY - bgHeight / 2, bgWidth, bgHeight);
         
         // Draw value text
         g.setColor("#333333");
@@ -1526,7 +1526,7 @@ public class SFCSankeyRenderer {
         
         // Draw as a path with rounded corners:
         // Start at source → go right a bit → curve up/down → horizontal across top/bottom → curve down/up → to target
-        g.context.beginPath();
+        g.beginPath();
         
         // Extension distances scale with column gap
         int extensionRight = Math.max(5, columnGap / 8);
@@ -1534,86 +1534,86 @@ public class SFCSankeyRenderer {
         
         // Top edge of the band (source uses halfBandSource, mid uses halfBandMid, target uses halfBandTarget)
         // Start from source, right edge
-        g.context.moveTo(x1, y1 - halfBandSource);
+        g.moveTo(x1, y1 - halfBandSource);
         
         // Extend right
-        g.context.lineTo(x1 + extensionRight, y1 - halfBandSource);
+        g.lineTo(x1 + extensionRight, y1 - halfBandSource);
         
         // Curve to vertical direction (up if routeTop, down if routeBottom)
         if (link.routeTop) {
             // Curve up-left
-            g.context.quadraticCurveTo(x1 + extensionRight + cornerRadius, y1 - halfBandSource, 
+            g.quadraticCurveTo(x1 + extensionRight + cornerRadius, y1 - halfBandSource, 
                                         x1 + extensionRight + cornerRadius, y1 - halfBandSource - cornerRadius);
             // Vertical up to route level
-            g.context.lineTo(x1 + extensionRight + cornerRadius, routeY + cornerRadius - halfBandMid);
+            g.lineTo(x1 + extensionRight + cornerRadius, routeY + cornerRadius - halfBandMid);
             // Curve to horizontal
-            g.context.quadraticCurveTo(x1 + extensionRight + cornerRadius, routeY - halfBandMid,
+            g.quadraticCurveTo(x1 + extensionRight + cornerRadius, routeY - halfBandMid,
                                         x1 + extensionRight, routeY - halfBandMid);
             // Horizontal across the top
-            g.context.lineTo(x2 - extensionLeft, routeY - halfBandMid);
+            g.lineTo(x2 - extensionLeft, routeY - halfBandMid);
             // Curve down
-            g.context.quadraticCurveTo(x2 - extensionLeft - cornerRadius, routeY - halfBandMid,
+            g.quadraticCurveTo(x2 - extensionLeft - cornerRadius, routeY - halfBandMid,
                                         x2 - extensionLeft - cornerRadius, routeY + cornerRadius - halfBandMid);
             // Vertical down to target level
-            g.context.lineTo(x2 - extensionLeft - cornerRadius, y2 - halfBandTarget - cornerRadius);
+            g.lineTo(x2 - extensionLeft - cornerRadius, y2 - halfBandTarget - cornerRadius);
             // Curve to horizontal toward target
-            g.context.quadraticCurveTo(x2 - extensionLeft - cornerRadius, y2 - halfBandTarget,
+            g.quadraticCurveTo(x2 - extensionLeft - cornerRadius, y2 - halfBandTarget,
                                         x2 - extensionLeft, y2 - halfBandTarget);
         } else {
             // Route via bottom - mirror the logic
-            g.context.quadraticCurveTo(x1 + extensionRight + cornerRadius, y1 - halfBandSource,
+            g.quadraticCurveTo(x1 + extensionRight + cornerRadius, y1 - halfBandSource,
                                         x1 + extensionRight + cornerRadius, y1 - halfBandSource + cornerRadius);
-            g.context.lineTo(x1 + extensionRight + cornerRadius, routeY - cornerRadius - halfBandMid);
-            g.context.quadraticCurveTo(x1 + extensionRight + cornerRadius, routeY - halfBandMid,
+            g.lineTo(x1 + extensionRight + cornerRadius, routeY - cornerRadius - halfBandMid);
+            g.quadraticCurveTo(x1 + extensionRight + cornerRadius, routeY - halfBandMid,
                                         x1 + extensionRight, routeY - halfBandMid);
-            g.context.lineTo(x2 - extensionLeft, routeY - halfBandMid);
-            g.context.quadraticCurveTo(x2 - extensionLeft - cornerRadius, routeY - halfBandMid,
+            g.lineTo(x2 - extensionLeft, routeY - halfBandMid);
+            g.quadraticCurveTo(x2 - extensionLeft - cornerRadius, routeY - halfBandMid,
                                         x2 - extensionLeft - cornerRadius, routeY - cornerRadius - halfBandMid);
-            g.context.lineTo(x2 - extensionLeft - cornerRadius, y2 - halfBandTarget + cornerRadius);
-            g.context.quadraticCurveTo(x2 - extensionLeft - cornerRadius, y2 - halfBandTarget,
+            g.lineTo(x2 - extensionLeft - cornerRadius, y2 - halfBandTarget + cornerRadius);
+            g.quadraticCurveTo(x2 - extensionLeft - cornerRadius, y2 - halfBandTarget,
                                         x2 - extensionLeft, y2 - halfBandTarget);
         }
         
         // End at target
-        g.context.lineTo(x2, y2 - halfBandTarget);
+        g.lineTo(x2, y2 - halfBandTarget);
         
         // Bottom edge of target (down)
-        g.context.lineTo(x2, y2 + halfBandTarget);
+        g.lineTo(x2, y2 + halfBandTarget);
         
         // Now trace back the bottom edge of the band (reverse direction)
-        g.context.lineTo(x2 - extensionLeft, y2 + halfBandTarget);
+        g.lineTo(x2 - extensionLeft, y2 + halfBandTarget);
         
         if (link.routeTop) {
-            g.context.quadraticCurveTo(x2 - extensionLeft - cornerRadius, y2 + halfBandTarget,
+            g.quadraticCurveTo(x2 - extensionLeft - cornerRadius, y2 + halfBandTarget,
                                         x2 - extensionLeft - cornerRadius, y2 + halfBandTarget - cornerRadius);
-            g.context.lineTo(x2 - extensionLeft - cornerRadius, routeY + cornerRadius + halfBandMid);
-            g.context.quadraticCurveTo(x2 - extensionLeft - cornerRadius, routeY + halfBandMid,
+            g.lineTo(x2 - extensionLeft - cornerRadius, routeY + cornerRadius + halfBandMid);
+            g.quadraticCurveTo(x2 - extensionLeft - cornerRadius, routeY + halfBandMid,
                                         x2 - extensionLeft, routeY + halfBandMid);
-            g.context.lineTo(x1 + extensionRight, routeY + halfBandMid);
-            g.context.quadraticCurveTo(x1 + extensionRight + cornerRadius, routeY + halfBandMid,
+            g.lineTo(x1 + extensionRight, routeY + halfBandMid);
+            g.quadraticCurveTo(x1 + extensionRight + cornerRadius, routeY + halfBandMid,
                                         x1 + extensionRight + cornerRadius, routeY + cornerRadius + halfBandMid);
-            g.context.lineTo(x1 + extensionRight + cornerRadius, y1 + halfBandSource - cornerRadius);
-            g.context.quadraticCurveTo(x1 + extensionRight + cornerRadius, y1 + halfBandSource,
+            g.lineTo(x1 + extensionRight + cornerRadius, y1 + halfBandSource - cornerRadius);
+            g.quadraticCurveTo(x1 + extensionRight + cornerRadius, y1 + halfBandSource,
                                         x1 + extensionRight, y1 + halfBandSource);
         } else {
-            g.context.quadraticCurveTo(x2 - extensionLeft - cornerRadius, y2 + halfBandTarget,
+            g.quadraticCurveTo(x2 - extensionLeft - cornerRadius, y2 + halfBandTarget,
                                         x2 - extensionLeft - cornerRadius, y2 + halfBandTarget + cornerRadius);
-            g.context.lineTo(x2 - extensionLeft - cornerRadius, routeY - cornerRadius + halfBandMid);
-            g.context.quadraticCurveTo(x2 - extensionLeft - cornerRadius, routeY + halfBandMid,
+            g.lineTo(x2 - extensionLeft - cornerRadius, routeY - cornerRadius + halfBandMid);
+            g.quadraticCurveTo(x2 - extensionLeft - cornerRadius, routeY + halfBandMid,
                                         x2 - extensionLeft, routeY + halfBandMid);
-            g.context.lineTo(x1 + extensionRight, routeY + halfBandMid);
-            g.context.quadraticCurveTo(x1 + extensionRight + cornerRadius, routeY + halfBandMid,
+            g.lineTo(x1 + extensionRight, routeY + halfBandMid);
+            g.quadraticCurveTo(x1 + extensionRight + cornerRadius, routeY + halfBandMid,
                                         x1 + extensionRight + cornerRadius, routeY - cornerRadius + halfBandMid);
-            g.context.lineTo(x1 + extensionRight + cornerRadius, y1 + halfBandSource + cornerRadius);
-            g.context.quadraticCurveTo(x1 + extensionRight + cornerRadius, y1 + halfBandSource,
+            g.lineTo(x1 + extensionRight + cornerRadius, y1 + halfBandSource + cornerRadius);
+            g.quadraticCurveTo(x1 + extensionRight + cornerRadius, y1 + halfBandSource,
                                         x1 + extensionRight, y1 + halfBandSource);
         }
         
         // Back to source start
-        g.context.lineTo(x1, y1 + halfBandSource);
+        g.lineTo(x1, y1 + halfBandSource);
         
-        g.context.closePath();
-        g.context.fill();
+        g.closePath();
+        g.fill();
         
         // Draw a small arrow to indicate direction (optional enhancement)
         drawCircularLinkArrow(g, link, x2, y2);
@@ -1633,15 +1633,15 @@ public class SFCSankeyRenderer {
         int arrowSize = 6;
         
         // Arrow pointing left (toward target)
-        g.context.beginPath();
-        g.context.moveTo(tipX, tipY);  // Arrow tip
-        g.context.lineTo(tipX + arrowSize, tipY - arrowSize);
-        g.context.lineTo(tipX + arrowSize, tipY + arrowSize);
-        g.context.closePath();
+        g.beginPath();
+        g.moveTo(tipX, tipY);  // Arrow tip
+        g.lineTo(tipX + arrowSize, tipY - arrowSize);
+        g.lineTo(tipX + arrowSize, tipY + arrowSize);
+        g.closePath();
         
         // Use a darker version of the link color
         g.setColor(link.color.replace("0.6", "0.9"));
-        g.context.fill();
+        g.fill();
     }
     
     // ========== Helper Methods ==========
@@ -658,17 +658,17 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
         int drawX = getFrameLeft() + (getFrameWidth() - renderedWidth) / 2;
         int drawY = getFrameTop() + (getFrameHeight() - renderedHeight) / 2;
         
-        g.context.translate(drawX, drawY);
-        g.context.scale(fitScale, fitScale);
+        g.translate(drawX, drawY);
+        g.scale(fitScale, fitScale);
     }
     
     /**
      * Fills diagram background with appropriate color for print/screen mode.
      */
     private void drawBackground(Graphics g) {
-        String bg = sim.printableCheckItem.getState() ? "#FFFFFF" : bgColor;
-        g.context.setFillStyle(bg);
-        g.context.fillRect(0, 0, diagramWidth, diagramHeight);
+        String bg = sim.isPrintableEnabledForExport() ? "#FFFFFF" : bgColor;
+        g.setFillColor(bg);
+        g.fillRect(0, 0, diagramWidth, diagramHeight);
     }
     
     /**
@@ -1237,14 +1237,14 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
 
         g.save();
         g.setColor(arrowColor);
-        g.context.setLineWidth(strokeWidth);
-        g.context.setLineCap(Context2d.LineCap.BUTT);
+        g.setLineWidth(strokeWidth);
+        g.setLineCap(Context2d.LineCap.BUTT);
         if (msg.dashed) {
             drawDashedLine(g, x1, arrowY, lineEndX, arrowY, strokeWidth);
         } else {
             g.drawLine(x1, arrowY, lineEndX, arrowY);
         }
-        g.context.setLineWidth(1);
+        g.setLineWidth(1);
         g.restore();
     }
     
@@ -1269,13 +1269,13 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
         int arrowHalfHeight = getArrowHalfHeight(strokeWidth);
         int baseX = tipX - (arrowLength * direction);
         
-        g.context.setFillStyle(color);
-        g.context.beginPath();
-        g.context.moveTo(tipX, tipY);
-        g.context.lineTo(baseX, tipY - arrowHalfHeight);
-        g.context.lineTo(baseX, tipY + arrowHalfHeight);
-        g.context.closePath();
-        g.context.fill();
+        g.setFillColor(color);
+        g.beginPath();
+        g.moveTo(tipX, tipY);
+        g.lineTo(baseX, tipY - arrowHalfHeight);
+        g.lineTo(baseX, tipY + arrowHalfHeight);
+        g.closePath();
+        g.fill();
     }
 
     private int getArrowLength(double strokeWidth) {
@@ -1302,8 +1302,8 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
         int halfHeight = height / 2;
         
         // Draw background bar
-        g.context.setFillStyle(dividerBgColor);
-        g.context.fillRect(left, y - halfHeight, right - left, height);
+        g.setFillColor(dividerBgColor);
+        g.fillRect(left, y - halfHeight, right - left, height);
         
         // Draw border lines (top and bottom)
         g.setColor(dividerColor);
@@ -1313,7 +1313,7 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
         // Draw centered label
         if (divider.label != null) {
             g.setColor("#000000");
-            int textWidth = (int) g.context.measureText(divider.label).getWidth();
+            int textWidth = (int) g.measureText(divider.label);
             int textX = (left + right - textWidth) / 2;
             g.drawString(divider.label, textX, y + 5);
         }
@@ -1345,7 +1345,7 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
         g.setColor("#000000");
         int textY = y + 17;
         for (String line : note.lines) {
-            int textWidth = (int) g.context.measureText(line).getWidth();
+            int textWidth = (int) g.measureText(line);
             g.drawString(line, noteX + (noteWidth - textWidth) / 2, textY);
             textY += 15;
         }
@@ -1356,15 +1356,15 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
         int foldSize = 10;
         
         // Fill background
-        g.context.setFillStyle(noteBgColor);
-        g.context.beginPath();
-        g.context.moveTo(x, y);
-        g.context.lineTo(x + width - foldSize, y);
-        g.context.lineTo(x + width, y + foldSize);
-        g.context.lineTo(x + width, y + height);
-        g.context.lineTo(x, y + height);
-        g.context.closePath();
-        g.context.fill();
+        g.setFillColor(noteBgColor);
+        g.beginPath();
+        g.moveTo(x, y);
+        g.lineTo(x + width - foldSize, y);
+        g.lineTo(x + width, y + foldSize);
+        g.lineTo(x + width, y + height);
+        g.lineTo(x, y + height);
+        g.closePath();
+        g.fill();
         
         // Draw border
         g.setColor(lineColor);
@@ -1429,14 +1429,14 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
         int radius = 8;
         
         // Head (filled circle with border)
-        g.context.setFillStyle(participantBgColor);
-        g.context.beginPath();
-        g.context.arc(cx, topY + radius, radius, 0, 2 * Math.PI);
-        g.context.fill();
+        g.setFillColor(participantBgColor);
+        g.beginPath();
+        g.arc(cx, topY + radius, radius, 0, 2 * Math.PI);
+        g.fill();
         g.setColor(lineColor);
-        g.context.beginPath();
-        g.context.arc(cx, topY + radius, radius, 0, 2 * Math.PI);
-        g.context.stroke();
+        g.beginPath();
+        g.arc(cx, topY + radius, radius, 0, 2 * Math.PI);
+        g.stroke();
         
         // Body (vertical line)
         int bodyTop = topY + radius * 2;
@@ -1466,8 +1466,8 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
      * Draws a rounded rectangle participant box with an optional footer value.
      */
     private void drawParticipantBox(Graphics g, Participant p, int topY, String footerValue, boolean isFooter) {
-        int textWidth = (int) g.context.measureText(p.name).getWidth();
-        int valueWidth = (footerValue != null) ? (int) g.context.measureText(footerValue).getWidth() : 0;
+        int textWidth = (int) g.measureText(p.name);
+        int valueWidth = (footerValue != null) ? (int) g.measureText(footerValue) : 0;
         int boxWidth = Math.max(textWidth, valueWidth) + 14;
         int boxHeight = (isFooter && footerValue != null) ? FOOTER_VALUE_BOX_HEIGHT : 30;
         int boxX = p.x - boxWidth / 2;
@@ -1487,22 +1487,22 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
      * Draws a filled rounded rectangle with border.
      */
     private void drawRoundedRect(Graphics g, int x, int y, int w, int h, int r) {
-        g.context.setFillStyle(participantBgColor);
-        g.context.beginPath();
-        g.context.moveTo(x + r, y);
-        g.context.lineTo(x + w - r, y);
-        g.context.quadraticCurveTo(x + w, y, x + w, y + r);
-        g.context.lineTo(x + w, y + h - r);
-        g.context.quadraticCurveTo(x + w, y + h, x + w - r, y + h);
-        g.context.lineTo(x + r, y + h);
-        g.context.quadraticCurveTo(x, y + h, x, y + h - r);
-        g.context.lineTo(x, y + r);
-        g.context.quadraticCurveTo(x, y, x + r, y);
-        g.context.closePath();
-        g.context.fill();
+        g.setFillColor(participantBgColor);
+        g.beginPath();
+        g.moveTo(x + r, y);
+        g.lineTo(x + w - r, y);
+        g.quadraticCurveTo(x + w, y, x + w, y + r);
+        g.lineTo(x + w, y + h - r);
+        g.quadraticCurveTo(x + w, y + h, x + w - r, y + h);
+        g.lineTo(x + r, y + h);
+        g.quadraticCurveTo(x, y + h, x, y + h - r);
+        g.lineTo(x, y + r);
+        g.quadraticCurveTo(x, y, x + r, y);
+        g.closePath();
+        g.fill();
         
         g.setColor(lineColor);
-        g.context.stroke();
+        g.stroke();
     }
 
     // ══════════════════════════════════════════════════════════════════════════
@@ -1534,7 +1534,7 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
      */
     private void drawCenteredMaskedString(Graphics g, String text, int centerX, int baselineY) {
         if (text == null || text.isEmpty()) return;
-        int textWidth = (int) g.context.measureText(text).getWidth();
+        int textWidth = (int) g.measureText(text);
         drawMaskedString(g, text, centerX - textWidth / 2, baselineY);
     }
 
@@ -1544,11 +1544,11 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
     private void drawMaskedString(Graphics g, String text, int textX, int baselineY) {
         if (text == null || text.isEmpty()) return;
         
-        int textWidth = (int) g.context.measureText(text).getWidth();
+        int textWidth = (int) g.measureText(text);
         
         // Draw background mask
-        g.context.setFillStyle(bgColor);
-        g.context.fillRect(textX - 3, baselineY - 12, textWidth + 6, 16);
+        g.setFillColor(bgColor);
+        g.fillRect(textX - 3, baselineY - 12, textWidth + 6, 16);
         
         // Draw text
         g.setColor("#000000");
@@ -1559,7 +1559,7 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
      * Draws text centered horizontally at the given position.
      */
     private void drawCenteredString(Graphics g, String text, int centerX, int baselineY) {
-        int textWidth = (int) g.context.measureText(text).getWidth();
+        int textWidth = (int) g.measureText(text);
         g.drawString(text, centerX - textWidth / 2, baselineY);
     }
     
@@ -1588,7 +1588,7 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
         // Draw dash segments
         double curX = x1;
         double curY = y1;
-        g.context.setLineWidth(strokeWidth);
+        g.setLineWidth(strokeWidth);
         
         for (int i = 0; i < numDashes; i++) {
             g.drawLine((int) curX, (int) curY, 
@@ -1597,7 +1597,7 @@ public class SequenceDiagramElm extends GraphicElm implements DiagramRenderer {
             curY += yDash + yGap;
         }
         
-        g.context.setLineWidth(1);
+        g.setLineWidth(1);
     }
     
     // ══════════════════════════════════════════════════════════════════════════
@@ -131,7 +131,7 @@ public class TextElm extends GraphicElm {
 	int maxw = -1;
 	for (i = 0; i != lines.size(); i++) {
 //	    int w = fm.stringWidth((String) (lines.elementAt(i)));
-		int w= (int)g.context.measureText((String) (lines.elementAt(i))).getWidth();
+		int w= (int)g.measureText((String) (lines.elementAt(i)));
 	    if (w > maxw)
 		maxw = w;
 	}
@@ -155,7 +155,7 @@ public class TextElm extends GraphicElm {
 		// Draw before text in normal color
 		if (before.length() > 0) {
 		    g.drawString(before, curx, cury);
-		    curx += (int)g.context.measureText(before).getWidth();
+		    curx += (int)g.measureText(before);
 		}
 		
 		// Draw link text in blue with underline
@@ -165,7 +165,7 @@ public class TextElm extends GraphicElm {
 		    g.setColor("#4488FF");
 		}
 		g.drawString(linkText, curx, cury);
-		int linkWidth = (int)g.context.measureText(linkText).getWidth();
+		int linkWidth = (int)g.measureText(linkText);
 		g.drawLine(curx, cury + 2, curx + linkWidth, cury + 2); // underline
 		curx += linkWidth;
 		
@@ -177,14 +177,14 @@ public class TextElm extends GraphicElm {
 		}
 		if (after.length() > 0) {
 		    g.drawString(after, curx, cury);
-		    curx += (int)g.context.measureText(after).getWidth();
+		    curx += (int)g.measureText(after);
 		}
 		
 		int sw = curx - x;
 		adjustBbox(x, cury-g.currentFontSize, x+sw, cury+3);
 	    } else {
 		// Normal text, no link
-		int sw=(int)g.context.measureText(s).getWidth();
+		int sw=(int)g.measureText(s);
 		g.drawString(s, x, cury);
 		if ((flags & FLAG_BAR) != 0) {
 		    int by = cury-g.currentFontSize;
@@ -211,7 +211,7 @@ public class TextElm extends GraphicElm {
 	
 	int maxw = 0;
 	for (int i = 0; i != lines.size(); i++) {
-	    int w = (int)g.context.measureText((String) (lines.elementAt(i))).getWidth();
+	    int w = (int)g.measureText((String) (lines.elementAt(i)));
 	    if (w > maxw)
 		maxw = w;
 	}
@@ -220,12 +220,12 @@ public class TextElm extends GraphicElm {
 	int padding = 4;
 	
 	// Determine background color based on canvas mode
-	boolean isWhiteBackground = sim.printableCheckItem.getState();
+	boolean isWhiteBackground = sim.isPrintableEnabledForExport();
 	String bgColor = isWhiteBackground ? "rgba(0, 0, 0, 0.3)" : "rgba(255, 255, 255, 0.3)";
 	
 	// Draw semi-transparent background rectangle
-	g.context.setFillStyle(bgColor);
-	g.context.fillRect(x - padding, y - g.currentFontSize - padding, 
+	g.setFillColor(bgColor);
+	g.fillRect(x - padding, y - g.currentFontSize - padding, 
 	                   maxw + 2 * padding, totalHeight + 2 * padding);
 	
 	g.restore();
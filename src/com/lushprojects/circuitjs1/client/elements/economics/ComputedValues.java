@@ -96,6 +96,12 @@ public class ComputedValues {
     // in MNA expression evaluation (name -> registration ref count).
     private static HashMap<String, Integer> parameterNameRefCounts;
 
+    // Bumped whenever the set of parameter names may have changed.
+    private static int parameterNamesVersion;
+
+    // Bumped whenever converged (and therefore lagged) values change.
+    private static int convergedValuesVersion;
+
     // Track pre-registered computed names so lookups/slot builders can discover
     // names even before first runtime value write (name -> registration ref count).
     private static HashMap<String, Integer> registeredComputedNameRefCounts;
@@ -211,6 +217,7 @@ public class ComputedValues {
         ensureInitialized();
         Integer count = parameterNameRefCounts.get(name);
         parameterNameRefCounts.put(name, Integer.valueOf((count == null) ? 1 : (count.intValue() + 1)));
+        if (count == null) parameterNamesVersion++;
     }
 
     /**
@@ -223,6 +230,7 @@ public class ComputedValues {
         int next = count.intValue() - 1;
         if (next <= 0) {
             parameterNameRefCounts.remove(name);
+            parameterNamesVersion++;
         } else {
             parameterNameRefCounts.put(name, Integer.valueOf(next));
         }
@@ -237,6 +245,21 @@ public class ComputedValues {
         return count != null && count.intValue() > 0;
     }
 
+    /**
+     * Version counter for the parameter-name set, for callers that cache it.
+     */
+    public static int getParameterNamesVersion() {
+        return parameterNamesVersion;
+    }
+
+    /**
+     * Version counter for converged/lagged values, for callers that cache values
+     * derived from last().
+     */
+    public static int getConvergedValuesVersion() {
+        return convergedValuesVersion;
+    }
+
     /**
      * Get all registered parameter names.
      */
@@ -449,6 +472,19 @@ public class ComputedValues {
         return pendingValues.get(name);
     }
     
+    /**
+     * Live view of the pending buffer, for subiteration accelerators that adjust
+     * the values in place (via Map.Entry.setValue) before they are committed.
+     * Callers must not add or remove entries.
+     *
+     * @return The pending entries, or null when double-buffering is off
+     */
+    public static Set<Map.Entry<String, Double>> getPendingEntries() {
+        if (!doubleBufferingEnabled) return null;
+        ensureInitialized();
+        return pendingValues.entrySet();
+    }
+    
     /**
      * Commit pending values to current values.
      * Called by CirSim AFTER all elements complete their doStep() calls.
@@ -695,6 +731,7 @@ public class ComputedValues {
                 convergedValues.put(entry.getKey(), value);
             }
         }
+        convergedValuesVersion++;
     }
     
     /**
@@ -770,6 +807,8 @@ public class ComputedValues {
         if (parameterNameRefCounts != null) {
             parameterNameRefCounts.clear();
         }
+        parameterNamesVersion++;
+        convergedValuesVersion++;
         if (registeredComputedNameRefCounts != null) {
             registeredComputedNameRefCounts.clear();
         }
@@ -807,6 +846,8 @@ public class ComputedValues {
         if (parameterNameRefCounts != null) {
             parameterNameRefCounts.clear();
         }
+        parameterNamesVersion++;
+        convergedValuesVersion++;
         if (registeredComputedNameRefCounts != null) {
             registeredComputedNameRefCounts.clear();
         }
@@ -316,6 +316,7 @@ public class CurrentTransactionsMatrixElm extends TableElm {
      * Populate table from stock info list
      */
     private void populateFromStockInfoList(ArrayList<StockInfo> stockInfoList) {
+        bumpContentVersion();
         columns = new ArrayList<TableColumn>();
         
         for (int i = 0; i < stockInfoList.size(); i++) {
@@ -981,7 +982,8 @@ public class CurrentTransactionsMatrixElm extends TableElm {
      * In normal mode: copies specific stock column equations.
      */
     private void populateCellEquationsFromMasters() {
-        
+        // cells are rewritten from the masters, so cached exports and markdown are stale
+        bumpContentVersion();
         for (int row = 0; row < rows; row++) {
             String flowName = rowDescriptions[row];
             
@@ -1042,6 +1044,7 @@ public class CurrentTransactionsMatrixElm extends TableElm {
     @Override
     public void toggleCollapsedMode() {
         super.toggleCollapsedMode();
+        bumpContentVersion();
         
         if (!collapsedMode) {
             ArrayList<StockInfo> stockInfoList = buildStockInfoListFromColumns();
@@ -237,6 +237,80 @@ public final class EquationDependencyGraph {
         return idx == null ? -1 : idx.intValue();
     }
 
+    /**
+     * Curtis–Powell–Reid column coloring of a sparse Jacobian pattern.
+     *
+     * <p>{@code rowColumns[r]} lists the input columns ({@code 0..columnCount-1}) that
+     * equation row {@code r} references in the same period. Two columns share a color only
+     * when no row references both, so all columns of one color can be perturbed in a single
+     * pass and every row still sees at most one perturbed input. Columns are colored greedily
+     * in order of decreasing row count, which keeps the color count close to the widest row.</p>
+     *
+     * @param rowColumns    Referenced columns per row (no duplicates within a row).
+     * @param columnCount   Number of distinct columns.
+     * @param colorByColumn Receives the color of each column; length at least {@code columnCount}.
+     * @return Number of colors used.
+     */
+    public static int colorStructurallyIndependentColumns(int[][] rowColumns, int columnCount, int[] colorByColumn) {
+        final int[] degree = new int[columnCount];
+        for (int r = 0; r < rowColumns.length; r++) {
+            for (int k = 0; k < rowColumns[r].length; k++) {
+                degree[rowColumns[r][k]]++;
+            }
+        }
+
+        // column -> rows adjacency in compressed form
+        int[] rowStart = new int[columnCount + 1];
+        for (int c = 0; c < columnCount; c++) {
+            rowStart[c + 1] = rowStart[c] + degree[c];
+        }
+        int[] fill = Arrays.copyOf(rowStart, columnCount);
+        int[] rowsOfColumn = new int[rowStart[columnCount]];
+        for (int r = 0; r < rowColumns.length; r++) {
+            for (int k = 0; k < rowColumns[r].length; k++) {
+                rowsOfColumn[fill[rowColumns[r][k]]++] = r;
+            }
+        }
+
+        Integer[] order = new Integer[columnCount];
+        for (int c = 0; c < columnCount; c++) {
+            order[c] = Integer.valueOf(c);
+            colorByColumn[c] = -1;
+        }
+        Arrays.sort(order, new Comparator<Integer>() {
+            @Override
+            public int compare(Integer a, Integer b) {
+                int d = degree[b.intValue()] - degree[a.intValue()];
+                return d != 0 ? d : a.intValue() - b.intValue();
+            }
+        });
+
+        // forbidden[color] == c+1 marks a color already used by a neighbor of column c
+        int[] forbidden = new int[columnCount + 1];
+        int colorCount = 0;
+        for (int i = 0; i < columnCount; i++) {
+            int c = order[i].intValue();
+            for (int k = rowStart[c]; k < rowStart[c + 1]; k++) {
+                int[] cols = rowColumns[rowsOfColumn[k]];
+                for (int j = 0; j < cols.length; j++) {
+                    int color = colorByColumn[cols[j]];
+                    if (color >= 0) {
+                        forbidden[color] = c + 1;
+                    }
+                }
+            }
+            int color = 0;
+            while (forbidden[color] == c + 1) {
+                color++;
+            }
+            colorByColumn[c] = color;
+            if (color + 1 > colorCount) {
+                colorCount = color + 1;
+            }
+        }
+        return colorCount;
+    }
+
     private void populateFromDefinitions(List<Definition> definitions, boolean includeHistoricalRefs) {
         nodes.clear();
         nodeIsStock.clear();
@@ -82,7 +82,7 @@ public class EquationElm extends CircuitElm {
             parameters[i] = 0.5;
             showPercentage[i] = false;
         }
-        setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+        setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
         parseEquation();
         initState();
     }
@@ -522,6 +522,12 @@ public class EquationElm extends CircuitElm {
         }
     }
     
+    // Parameters are read in doStep() only; stamp() doesn't depend on them
+    public boolean isParameterOnlyEdit(int n) {
+        int paramIndex = n - 3;
+        return paramIndex >= 0 && paramIndex < numParameters;
+    }
+    
     @Override
     protected void getInfo(String arr[]) {
         arr[0] = "Equation";
@@ -57,7 +57,7 @@ import com.google.gwt.event.dom.client.MouseWheelHandler;
  * @see EquationTableRenderer Rendering logic
  * @see EquationTableEditDialog Edit UI
  */
-public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
+public class EquationTableElm extends CircuitElm implements MouseWheelHandler, SolverLog.Source {
     
     //=============================================================================
     // CONSTANTS
@@ -75,6 +75,12 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
     /** Maximum number of equation rows supported */
     public static final int MAX_ROWS = 256;
 
+    /**
+     * Edit item of row 0's numeric value (mouse wheel); row r is ROW_VALUE_EDIT + r.
+     * Past the dialog's fields, so the edit dialog never reaches it.
+     */
+    public static final int ROW_VALUE_EDIT = 1000;
+
     /** Default legacy-flow shunt resistance retained for serialized compatibility data. */
     private static final double DEFAULT_FLOW_SHUNT_RESISTANCE = 1;
 
@@ -359,7 +365,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
             // MNA mode: stamp to matrix
             if (isMnaMode() && rows[row].rowVoltSource >= 0) {
                 int vn = voltSource + rows[row].rowVoltSource + sim.getCircuitAnalyzer().getNodeList().size();
-                if (!stampVoltageModeNewtonJacobian(row, state, equationValue, vn)) {
+                if (!queueVoltageModeNewtonJacobian(row, state, equationValue, vn)) {
                     if ("not attempted".equals(rows[row].lastNewtonJacobianStatus)) {
                         rows[row].lastNewtonJacobianStatus = "fallback: direct rhs";
                     }
@@ -418,7 +424,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
     //=============================================================================
     
     /** Debug flag - set to true to enable detailed console output for troubleshooting */
-    private static boolean DEBUG = false;
+    private static final boolean DEBUG = false;
     
     //=============================================================================
     // INSTANCE STATE - Core Data
@@ -507,8 +513,12 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
     /** True when effective trace input/output sets must be recomputed. */
     private boolean effectiveTraceDirty = true;
     
-    /** Details about the convergence failure */
-    private String convergenceFailureInfo = null;
+    /**
+     * Values of the last convergence failure of {@link #failedConvergenceRow}. Kept as
+     * numbers in the subiteration loop and only formatted for display, by
+     * {@link #getConvergenceFailureInfo} or when a solver event is read.
+     */
+    private double failureDiff, failureLimit, failureLastValue, failureNewValue;
     
     //=============================================================================
     // INSTANCE STATE - MNA Node Tracking
@@ -574,7 +584,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
         rows[1].equation = "0";
         
         refreshCachedNameFlags();
-        setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+        setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
         parseAllEquations();
         allocNodes();
         
@@ -786,6 +796,23 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
         nameRegistriesDirty = false;
     }
 
+    /**
+     * Bring every table's parameter/computed name registries up to date in one
+     * pass. Used by the circuit-load pipeline after construction so names are
+     * registered once per load rather than lazily from each stamp().
+     */
+    public static void registerNamesForLoad(java.util.Vector<CircuitElm> elmList) {
+        if (elmList == null) {
+            return;
+        }
+        for (int i = 0; i < elmList.size(); i++) {
+            CircuitElm ce = elmList.get(i);
+            if (ce instanceof EquationTableElm) {
+                ((EquationTableElm) ce).ensureNameRegistriesUpToDate();
+            }
+        }
+    }
+
     /**
      * Synchronize PARAM_MODE output names with the global parameter-name registry.
      * This allows Expr node references in MNA mode to resolve PARAM names from
@@ -1450,20 +1477,27 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
         }
     }
 
+    /** VOLTAGE_MODE rows queued for Newton Jacobian stamping in the current doStep(). */
+    private final java.util.ArrayList<EquationTableJacobianHelper.PendingRow> pendingNewtonRows =
+            new java.util.ArrayList<EquationTableJacobianHelper.PendingRow>();
+    private final EquationTableJacobianHelper.ColoringCache newtonColoring = new EquationTableJacobianHelper.ColoringCache();
+
     /**
      * Phase 1 Newton Jacobian stamping for VOLTAGE_MODE MNA rows.
      *
      * Linearizes Vout = f(x) into: Vout - sum(df/dx_i * x_i) = f(x0) - sum(df/dx_i * x0_i)
      * and stamps the off-diagonal Jacobian entries on the voltage-source equation row.
+     * Eligible rows are queued here and stamped together by {@link #stampQueuedNewtonJacobians}
+     * at the end of doStep(), so finite differences can share perturbation passes.
      *
      * Scope guardrails for Phase 1:
      * - VOLTAGE_MODE rows only
      * - MNA/labeled-node dependencies only
      * - expressions with stateful historical operators are excluded
      *
-     * @return true if Jacobian stamping was applied; false to use direct RHS stamping fallback.
+     * @return true if the row was queued; false to use direct RHS stamping fallback.
      */
-    private boolean stampVoltageModeNewtonJacobian(int row, ExprState state, double equationValue, int vn) {
+    private boolean queueVoltageModeNewtonJacobian(int row, ExprState state, double equationValue, int vn) {
         EquationRow rowData = rows[row];
         String ineligibleReason = EquationTableJacobianHelper.getVoltageModeIneligibilityReason(this, rowData);
         if (ineligibleReason != null) {
@@ -1473,35 +1507,59 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
 
         java.util.LinkedHashSet<String> refs = new java.util.LinkedHashSet<String>();
         rowData.compiledExpr.collectSamePeriodRefs(refs);
-        java.util.LinkedHashSet<String> skippedParamRefs = EquationTableJacobianHelper.collectSkippedParameterRefs(refs);
-        String skippedParamsSuffix = EquationTableJacobianHelper.formatSkippedParameterRefs(skippedParamRefs);
         if (refs.isEmpty()) {
             rowData.lastNewtonJacobianStatus = "no same-period refs";
             return false;
         }
 
-        EquationTableJacobianHelper.JacobianComputation jacobian = EquationTableJacobianHelper.prepareSingleNodeJacobian(
-                rowData, rowData.compiledExpr, state, refs, equationValue);
-        int stamped = EquationTableJacobianHelper.stampPreparedSingleNodeJacobian(jacobian, vn, -1.0);
-        if (stamped == 0) {
-            if (jacobian.sawMnaRefCount == 0) {
-                rowData.lastNewtonJacobianStatus = "no mna refs" + skippedParamsSuffix;
-            } else if (jacobian.invalidDerivativeCount > 0) {
-                rowData.lastNewtonJacobianStatus = "mna refs but invalid derivatives" + skippedParamsSuffix;
+        pendingNewtonRows.add(new EquationTableJacobianHelper.PendingRow(
+                row, rowData, rowData.compiledExpr, state, refs, equationValue, vn));
+        return true;
+    }
+
+    /**
+     * Prepare and stamp the Jacobians of all rows queued during this doStep().
+     * Rows that end up with no usable derivatives fall back to direct RHS stamping.
+     */
+    private void stampQueuedNewtonJacobians() {
+        if (pendingNewtonRows.isEmpty()) {
+            return;
+        }
+        EquationTableJacobianHelper.prepareJacobians(pendingNewtonRows, newtonColoring);
+        for (int i = 0; i < pendingNewtonRows.size(); i++) {
+            EquationTableJacobianHelper.PendingRow pending = pendingNewtonRows.get(i);
+            EquationRow rowData = pending.rowData;
+            EquationTableJacobianHelper.JacobianComputation jacobian = pending.jacobian;
+            String skippedParamsSuffix = EquationTableJacobianHelper.formatSkippedParameterRefs(
+                    EquationTableJacobianHelper.collectSkippedParameterRefs(pending.refs));
+            int stamped = EquationTableJacobianHelper.stampPreparedSingleNodeJacobian(jacobian, pending.nodeNumber, -1.0);
+            if (stamped == 0) {
+                if (jacobian.sawMnaRefCount == 0) {
+                    rowData.lastNewtonJacobianStatus = "no mna refs" + skippedParamsSuffix;
+                } else if (jacobian.invalidDerivativeCount > 0) {
+                    rowData.lastNewtonJacobianStatus = "mna refs but invalid derivatives" + skippedParamsSuffix;
+                } else {
+                    rowData.lastNewtonJacobianStatus = "mna refs but no usable derivatives" + skippedParamsSuffix;
+                }
+                sim.stampRightSide(pending.nodeNumber, pending.fVal);
+                continue;
+            }
+
+            rowData.lastNewtonJacobianApplied = true;
+            String appliedPrefix = EquationTableJacobianHelper.formatAppliedJacobianPrefix(jacobian.method, false);
+            int refCount = pending.refs.size();
+            if (EquationTableJacobianHelper.hasHistoricalRefSyntax(rowData.equation)) {
+                rowData.lastNewtonJacobianStatus = appliedPrefix + " (refs=" + refCount + "; hist ok)" + skippedParamsSuffix;
             } else {
-                rowData.lastNewtonJacobianStatus = "mna refs but no usable derivatives" + skippedParamsSuffix;
+                rowData.lastNewtonJacobianStatus = appliedPrefix + " (refs=" + refCount + ")" + skippedParamsSuffix;
             }
-            return false;
         }
+        pendingNewtonRows.clear();
+    }
 
-        rowData.lastNewtonJacobianApplied = true;
-        String appliedPrefix = EquationTableJacobianHelper.formatAppliedJacobianPrefix(jacobian.method, false);
-        if (EquationTableJacobianHelper.hasHistoricalRefSyntax(rowData.equation)) {
-            rowData.lastNewtonJacobianStatus = appliedPrefix + " (refs=" + refs.size() + "; hist ok)" + skippedParamsSuffix;
-        } else {
-            rowData.lastNewtonJacobianStatus = appliedPrefix + " (refs=" + refs.size() + ")" + skippedParamsSuffix;
-        }
-        return true;
+    /** Columns and colors of the most recent finite-difference Jacobian, e.g. "6 nodes / 2 colors". */
+    public String getNewtonJacobianColoringSummary() {
+        return newtonColoring.getColumnCount() + " nodes / " + newtonColoring.getColorCount() + " colors";
     }
 
     /**
@@ -1958,6 +2016,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
             CirSim.console("[EquationTableElm." + tableName + "] doStep() at t=" + sim.getTime() + " mnaMode=" + isMnaMode());
         }
         
+        pendingNewtonRows.clear();
         for (int row = 0; row < rowCount; row++) {
             if (handleInitialValueRowAtT0(row)) {
                 continue;
@@ -1966,6 +2025,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
             // Normal timestep: evaluate via mode handler
             getHandler(rows[row].outputMode).evaluate(row);
         }
+        stampQueuedNewtonJacobians();
 
         // Individual handlers (VoltageModeHandler, FlowModeHandler, ParamModeHandler)
         // always call registerOutputValue/registerFlowValue at the end of evaluate().
@@ -2114,12 +2174,14 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
                 sim.getSubIterations())) {
             sim.setConverged(false);
             failedConvergenceRow = row;
-            convergenceFailureInfo = buildConvergenceFailureInfo(row, diff, convergeLimit, equationValue);
+            failureDiff = diff;
+            failureLimit = convergeLimit;
+            failureLastValue = rows[row].lastOutputValue;
+            failureNewValue = equationValue;
             logConvergenceFailureIfThresholdExceeded();
         } else if (failedConvergenceRow == row) {
             // This row converged now, clear the failure
             failedConvergenceRow = -1;
-            convergenceFailureInfo = null;
         }
     }
 
@@ -2138,35 +2200,46 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
     }
 
     /**
-     * Build a human-readable description of a convergence failure for debug display.
+     * Build a human-readable description of the current convergence failure for debug display.
      *
      * Shows the output name, the difference between old and new values, the convergence
      * limit, and both old and new values in short-unit form.
      *
-     * @param row           Row that failed to converge.
-     * @param diff          Absolute difference between the new and previous values.
-     * @param convergeLimit Convergence threshold that was exceeded.
-     * @param equationValue New (not-yet-converged) computed value.
-     * @return Formatted diagnostics string stored in {@link #convergenceFailureInfo}.
+     * @return Formatted diagnostics, or {@code null} when no row is failing.
      */
-    private String buildConvergenceFailureInfo(int row, double diff, double convergeLimit, double equationValue) {
-        return rows[row].outputName + ": diff=" + getShortUnitText(diff, "")
-            + ", limit=" + getShortUnitText(convergeLimit, "")
-            + ", last=" + getShortUnitText(rows[row].lastOutputValue, "")
-            + ", new=" + getShortUnitText(equationValue, "");
+    private String getConvergenceFailureInfo() {
+        int row = failedConvergenceRow;
+        if (row < 0 || row >= rowCount) {
+            return null;
+        }
+        return rows[row].outputName + ": diff=" + getShortUnitText(failureDiff, "")
+            + ", limit=" + getShortUnitText(failureLimit, "")
+            + ", last=" + getShortUnitText(failureLastValue, "")
+            + ", new=" + getShortUnitText(failureNewValue, "");
     }
 
     /**
-     * Log the current convergence failure to the browser console if the subiteration count
-     * has exceeded {@link CirSim#convergenceCheckThreshold}.
+     * Log the current convergence failure if the subiteration count has exceeded
+     * {@link CirSim#convergenceCheckThreshold}.
      *
      * The threshold prevents log spam during normal solving; messages only appear when
-     * the solver is genuinely struggling (too many iterations).
+     * the solver is genuinely struggling (too many iterations). Only the row index and
+     * values are recorded; the table and row names are looked up when the event is read.
      */
     private void logConvergenceFailureIfThresholdExceeded() {
         if (sim.getSubIterations() > sim.convergenceCheckThreshold) {
-            CirSim.console("[" + tableName + "] t=" + sim.getTime() + " dt=" + sim.getTimeStep()
-                    + " Convergence failure: " + convergenceFailureInfo);
+            SolverLog.log(SolverLog.INFO,
+                    "Equation table convergence failure at t={} dt={}: {@}: diff={}, limit={}, last={}, new={}",
+                    this, failedConvergenceRow, sim.getTime(), sim.getTimeStep(),
+                    failureDiff, failureLimit, failureLastValue, failureNewValue);
+        }
+    }
+
+    /** Names this table and, for a valid row index, the row's output in solver events. */
+    public void appendLogDescription(StringBuilder sb, int row) {
+        sb.append('[').append(tableName).append(']');
+        if (row >= 0 && row < rowCount) {
+            sb.append(' ').append(rows[row].outputName);
         }
     }
     
@@ -2341,6 +2414,11 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
      * Get edit field information for the properties dialog.
      */
     public EditInfo getEditInfo(int n) {
+        if (n >= ROW_VALUE_EDIT) {
+            int row = n - ROW_VALUE_EDIT;
+            Double value = row < rowCount ? parseNumericEquation(rows[row].equation.trim()) : null;
+            return value == null ? null : new EditInfo(rows[row].outputName, value.doubleValue());
+        }
         if (n == 0) {
             return EditInfo.createCheckbox("Small", (flags & FLAG_SMALL) != 0);
         }
@@ -2350,10 +2428,28 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
         return null;
     }
     
+    // A row that stays a plain number stamps the same structure, so the
+    // wheel edit can patch the matrix instead of re-analyzing.
+    @Override
+    public boolean isParameterOnlyEdit(int n) {
+        int row = n - ROW_VALUE_EDIT;
+        return row >= 0 && row < rowCount && !isCommentRow(row)
+                && parseNumericEquation(rows[row].equation.trim()) != null;
+    }
+
     /**
-     * Set a field value from the edit dialog.
+     * Set a field value from the edit dialog, or a row's numeric value.
      */
     public void setEditValue(int n, EditInfo ei) {
+        bumpContentVersion();
+        if (n >= ROW_VALUE_EDIT) {
+            int row = n - ROW_VALUE_EDIT;
+            if (row < rowCount) {
+                rows[row].equation = formatNumericValue(ei.value);
+                parseEquation(row);
+            }
+            return;
+        }
         if (n == 0) {
             flags = ei.changeFlag(flags, FLAG_SMALL);
             boolean small = (flags & FLAG_SMALL) != 0;
@@ -2380,7 +2476,8 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
         arr[0] = "Equation Table: " + tableName + (isMnaMode() ? " (Electrical)" : " (Computed)");
         
         // Show convergence failure info if applicable
-        if (nonConverged && convergenceFailureInfo != null) {
+        String convergenceFailureInfo = nonConverged ? getConvergenceFailureInfo() : null;
+        if (convergenceFailureInfo != null) {
             arr[1] = "⚠ Convergence failure: " + convergenceFailureInfo;
             // Still show row info after convergence warning
             if (hoveredRow >= 0 && hoveredRow < rowCount) {
@@ -2619,7 +2716,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
     public String getTableName() { return tableName; }
     
     /** Set the table name */
-    public void setTableName(String name) { tableName = name; }
+    public void setTableName(String name) { tableName = name; bumpContentVersion(); }
 
     /** Get render color for uppercase nominal/money variables. */
     public Color getNominalVariableColor() { return nominalVariableColor; }
@@ -2950,6 +3047,11 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
         return effectiveTraceDirection;
     }
 
+    /** Recompute the effective trace now; invalidates the renderer's content cache if it changed. */
+    public void refreshEffectiveTrace() {
+        ensureEffectiveTrace();
+    }
+
     /** True if the displayed token belongs to the active trace root or its related rows. */
     public boolean shouldBoldTraceToken(String token) {
         ensureEffectiveTrace();
@@ -3117,6 +3219,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
     
     /** Set the number of active rows (1 to MAX_ROWS) */
     public void setRowCount(int count) { 
+        bumpContentVersion();
         if (count >= 1 && count <= MAX_ROWS) {
             rowCount = count;
             clampFirstVisibleRow();
@@ -3124,6 +3227,11 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
         }
     }
     
+    /** Runtime state of a row, for the Jacobian helper's tests. */
+    EquationRow getEquationRow(int row) {
+        return rows[row];
+    }
+
     /** Get output name for a row (source node only, for internal use) */
     public String getOutputName(int row) {
         return (row >= 0 && row < MAX_ROWS) ? rows[row].outputName : "";
@@ -3190,6 +3298,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
      * Otherwise, only the source name is set (target is not changed).
      */
     public void setOutputName(int row, String name) {
+        bumpContentVersion();
         if (row >= 0 && row < MAX_ROWS) {
             if (isCommentRowName(name)) {
                 String trimmed = name == null ? "" : name.trim();
@@ -3263,6 +3372,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
     
     /** Set equation for a row */
     public void setEquation(int row, String eq) {
+        bumpContentVersion();
         if (row >= 0 && row < MAX_ROWS) {
             rows[row].equation = eq;
         }
@@ -3275,6 +3385,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
     
     /** Set initial equation for a row */
     public void setInitialEquation(int row, String eq) {
+        bumpContentVersion();
         if (row >= 0 && row < MAX_ROWS) {
             rows[row].initialEquation = eq;
         }
@@ -3332,6 +3443,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
 
     /** Set output mode for a row */
     public void setOutputMode(int row, RowOutputMode mode) {
+        bumpContentVersion();
         if (row >= 0 && row < MAX_ROWS) {
             rows[row].outputMode = mode;
             markNameRegistriesDirty();
@@ -3345,6 +3457,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
     
     /** Set target node name for a row */
     public void setTargetNodeName(int row, String name) {
+        bumpContentVersion();
         if (row >= 0 && row < MAX_ROWS) {
             rows[row].targetNodeName = (name != null && !name.isEmpty()) ? name : null;
             markNameRegistriesDirty();
@@ -3363,6 +3476,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
 
     /** Set FLOW shunt resistance for a row. */
     public void setFlowShuntResistance(int row, double shuntR) {
+        bumpContentVersion();
         if (row >= 0 && row < MAX_ROWS) {
             rows[row].shuntResistance = (shuntR > 0) ? shuntR : DEFAULT_FLOW_SHUNT_RESISTANCE;
         }
@@ -3375,6 +3489,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
     
     /** Set whether a row uses backward Euler (true) or trapezoidal (false) */
     public void setUseBackwardEuler(int row, boolean backwardEuler) {
+        bumpContentVersion();
         if (row >= 0 && row < MAX_ROWS) {
             rows[row].useBackwardEuler = backwardEuler;
         }
@@ -3382,6 +3497,7 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
     
     /** Public method for dialog to trigger equation reparse */
     public void parseAllEquationsPublic() {
+        bumpContentVersion();
         parseAllEquations();
     }
 
@@ -3463,10 +3579,11 @@ public class EquationTableElm extends CircuitElm implements MouseWheelHandler {
         int direction = (delta > 0) ? -1 : 1;  // scroll down = decrease, scroll up = increase
         double newValue = currentValue + direction * scale;
         
-        // Update equation string
-        rows[hoveredRow].equation = formatNumericValue(newValue);
-        parseEquation(hoveredRow);
-        sim.needAnalyze();
+        EditInfo ei = new EditInfo(rows[hoveredRow].outputName, newValue);
+        if (sim.getCircuitAnalyzer().applyParameterEdit(this, ROW_VALUE_EDIT + hoveredRow, ei))
+            sim.repaint();
+        else
+            sim.needAnalyze();
     }
 
     private int getMaxVisibleRows() {
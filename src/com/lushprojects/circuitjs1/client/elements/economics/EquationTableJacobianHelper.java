@@ -47,10 +47,16 @@ import java.util.LinkedHashSet;
  * </ul>
  * When ineligible, the caller falls back to direct right-hand-side stamping.
  *
+ * <h3>Batching</h3>
+ * A table queues its eligible rows during {@code doStep()} and prepares them together via
+ * {@link #prepareJacobians}; finite differences then perturb structurally independent
+ * labeled nodes in the same pass (Curtis–Powell–Reid coloring, see
+ * {@link EquationDependencyGraph#colorStructurallyIndependentColumns}).
+ *
  * <h3>Thread Safety</h3>
- * All methods are stateless utilities; the class has no instance state and cannot be constructed.
+ * All methods are static utilities; the only state is the caller-owned {@link ColoringCache}.
  *
- * @see EquationTableElm#stampVoltageModeNewtonJacobian
+ * @see EquationTableElm#stampQueuedNewtonJacobians
  */
 final class EquationTableJacobianHelper {
     private EquationTableJacobianHelper() {}
@@ -84,23 +90,125 @@ final class EquationTableJacobianHelper {
         }
     }
 
-    private static final class FiniteDifferenceResult {
-        final String[] refNames;
-        final int[] labeledNodes;
-        final double[] baseValues;
-        final double[] derivatives;
-        final int invalidDerivativeCount;
+    /**
+     * One equation row queued for table-level Jacobian preparation. The caller
+     * evaluates the row first ({@code fVal}), then hands all queued rows to
+     * {@link #prepareJacobians} so finite differences can share perturbations.
+     */
+    static final class PendingRow {
+        final int row;
+        final EquationTableElm.EquationRow rowData;
+        final Expr expr;
+        final ExprState state;
+        final LinkedHashSet<String> refs;
+        final double fVal;
+        final int nodeNumber;
+        JacobianComputation jacobian;
+
+        // resolved MNA references and finite-difference scratch
+        String[] refNames;
+        int[] labeledNodes;
+        double[] baseValues;
+        int sawMnaRefCount;
+        int[] columns;
+        double[] fdDerivatives;
+        boolean useBroyden;
+        boolean cacheCompatible;
+
+        PendingRow(int row, EquationTableElm.EquationRow rowData, Expr expr, ExprState state,
+                LinkedHashSet<String> refs, double fVal, int nodeNumber) {
+            this.row = row;
+            this.rowData = rowData;
+            this.expr = expr;
+            this.state = state;
+            this.refs = refs;
+            this.fVal = fVal;
+            this.nodeNumber = nodeNumber;
+        }
+    }
 
-        FiniteDifferenceResult(String[] refNames,
-                int[] labeledNodes,
-                double[] baseValues,
-                double[] derivatives,
-                int invalidDerivativeCount) {
-            this.refNames = refNames;
-            this.labeledNodes = labeledNodes;
-            this.baseValues = baseValues;
-            this.derivatives = derivatives;
-            this.invalidDerivativeCount = invalidDerivativeCount;
+    /**
+     * Column coloring reused across subiterations while the sparsity pattern
+     * (which queued row references which labeled node) stays the same.
+     * Owned by the caller, typically one per equation table.
+     */
+    static final class ColoringCache {
+        private int[][] rowColumns = new int[0][];
+        private int columnCount;
+        private int[] colorByColumn = new int[0];
+        private int colorCount;
+        // per color: columns, and (row, position) entries whose derivative it yields
+        private int[] colorColumnStart = new int[1];
+        private int[] colorColumns = new int[0];
+        private int[] colorEntryStart = new int[1];
+        private int[] entryRow = new int[0];
+        private int[] entryPos = new int[0];
+        private int[] columnByNode = new int[0];
+        private int lastEvaluationCount;
+
+        int getColorCount() {
+            return colorCount;
+        }
+
+        int getColumnCount() {
+            return columnCount;
+        }
+
+        /** Perturbed expression evaluations used by the most recent preparation. */
+        int getLastEvaluationCount() {
+            return lastEvaluationCount;
+        }
+
+        private boolean matches(int[][] rows, int columns) {
+            if (columns != columnCount || rows.length != rowColumns.length) {
+                return false;
+            }
+            for (int r = 0; r < rows.length; r++) {
+                if (!java.util.Arrays.equals(rows[r], rowColumns[r])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        private void rebuild(int[][] rows, int columns) {
+            rowColumns = rows;
+            columnCount = columns;
+            colorByColumn = new int[columns];
+            colorCount = EquationDependencyGraph.colorStructurallyIndependentColumns(rows, columns, colorByColumn);
+
+            colorColumnStart = new int[colorCount + 1];
+            for (int c = 0; c < columns; c++) {
+                colorColumnStart[colorByColumn[c] + 1]++;
+            }
+            int nnz = 0;
+            colorEntryStart = new int[colorCount + 1];
+            for (int r = 0; r < rows.length; r++) {
+                for (int p = 0; p < rows[r].length; p++) {
+                    colorEntryStart[colorByColumn[rows[r][p]] + 1]++;
+                    nnz++;
+                }
+            }
+            for (int k = 0; k < colorCount; k++) {
+                colorColumnStart[k + 1] += colorColumnStart[k];
+                colorEntryStart[k + 1] += colorEntryStart[k];
+            }
+
+            colorColumns = new int[columns];
+            int[] fill = java.util.Arrays.copyOf(colorColumnStart, colorCount);
+            for (int c = 0; c < columns; c++) {
+                colorColumns[fill[colorByColumn[c]]++] = c;
+            }
+            entryRow = new int[nnz];
+            entryPos = new int[nnz];
+            fill = java.util.Arrays.copyOf(colorEntryStart, colorCount);
+            for (int r = 0; r < rows.length; r++) {
+                for (int p = 0; p < rows[r].length; p++) {
+                    int at = fill[colorByColumn[rows[r][p]]]++;
+                    entryRow[at] = r;
+                    entryPos[at] = p;
+                }
+            }
         }
     }
 
@@ -275,17 +383,64 @@ final class EquationTableJacobianHelper {
             ExprState state,
             LinkedHashSet<String> refs,
             double fVal) {
+        ArrayList<PendingRow> single = new ArrayList<PendingRow>(1);
+        single.add(new PendingRow(-1, rowData, expr, state, refs, fVal, 0));
+        prepareJacobians(single, new ColoringCache());
+        return single.get(0).jacobian;
+    }
+
+    /**
+     * Prepare Jacobians for all rows queued by one table in the current subiteration.
+     *
+     * Rows whose Broyden cache is still usable are updated in place. The remaining rows
+     * share one Curtis–Powell–Reid finite-difference sweep: labeled nodes that no queued
+     * row references together are perturbed in the same pass, so node writes and restores
+     * drop from one per (row, reference) pair to one per column, and the number of passes
+     * equals the color count rather than the total reference count. Each row is evaluated
+     * only in passes that perturb one of its own references.
+     *
+     * On return every row's {@link PendingRow#jacobian} is set.
+     */
+    static void prepareJacobians(ArrayList<PendingRow> rows, ColoringCache cache) {
         CirSim sim = CirSim.getInstance();
-        if (sim == null) {
-            return new JacobianComputation(new String[0], new int[0], new double[0], new double[0], fVal, 0, 0, "sim unavailable");
+        ArrayList<PendingRow> fdRows = null;
+        for (int i = 0; i < rows.size(); i++) {
+            PendingRow p = rows.get(i);
+            if (sim == null) {
+                p.jacobian = new JacobianComputation(new String[0], new int[0], new double[0], new double[0], p.fVal, 0, 0, "sim unavailable");
+                continue;
+            }
+            resolveMnaReferences(sim, p);
+            if (p.refNames.length == 0) {
+                p.jacobian = new JacobianComputation(new String[0], new int[0], new double[0], new double[0], p.fVal, p.sawMnaRefCount, 0, "no mna refs");
+                continue;
+            }
+            if (!tryBroydenUpdate(sim, p)) {
+                if (fdRows == null) {
+                    fdRows = new ArrayList<PendingRow>();
+                }
+                fdRows.add(p);
+            }
+        }
+        cache.lastEvaluationCount = 0;
+        if (fdRows != null) {
+            computeColoredFiniteDifferences(sim, fdRows, cache);
         }
+    }
 
-        ArrayList<String> refNames = new ArrayList<String>();
-        ArrayList<Integer> labeledNodes = new ArrayList<Integer>();
-        ArrayList<Double> baseValues = new ArrayList<Double>();
+    /**
+     * Resolve same-period refs to labeled MNA nodes. Names aliasing a node that the
+     * row already references are merged into one column.
+     */
+    private static void resolveMnaReferences(CirSim sim, PendingRow p) {
+        int capacity = p.refs.size();
+        String[] names = new String[capacity];
+        int[] nodes = new int[capacity];
+        double[] bases = new double[capacity];
+        int size = 0;
         int sawMnaRefs = 0;
 
-        for (String refName : refs) {
+        for (String refName : p.refs) {
             if (refName == null || refName.isEmpty() || ComputedValues.isParameterName(refName)) {
                 continue;
             }
@@ -295,65 +450,64 @@ final class EquationTableJacobianHelper {
                 continue;
             }
             sawMnaRefs++;
-            refNames.add(refName);
-            labeledNodes.add(Integer.valueOf(labeledNode.intValue()));
-            baseValues.add(Double.valueOf(sim.resolveSlotValueForUi(refName)));
-        }
-
-        if (refNames.isEmpty()) {
-            return new JacobianComputation(new String[0], new int[0], new double[0], new double[0], fVal, sawMnaRefs, 0, "no mna refs");
+            int node = labeledNode.intValue();
+            boolean seen = false;
+            for (int q = 0; q < size && !seen; q++) {
+                seen = nodes[q] == node;
+            }
+            if (seen) {
+                continue;
+            }
+            names[size] = refName;
+            nodes[size] = node;
+            bases[size] = sim.resolveSlotValueForUi(refName);
+            size++;
         }
 
-        String[] refNameArray = toStringArray(refNames);
-        int[] nodeArray = toIntArray(labeledNodes);
-        double[] baseArray = toDoubleArray(baseValues);
+        p.refNames = size == capacity ? names : java.util.Arrays.copyOf(names, size);
+        p.labeledNodes = size == capacity ? nodes : java.util.Arrays.copyOf(nodes, size);
+        p.baseValues = size == capacity ? bases : java.util.Arrays.copyOf(bases, size);
+        p.sawMnaRefCount = sawMnaRefs;
+    }
 
-        boolean useBroyden = sim.equationTableBroydenJacobianEnabled
+    /** Apply a Broyden update from the row's cache; false when a finite-difference refresh is needed. */
+    private static boolean tryBroydenUpdate(CirSim sim, PendingRow p) {
+        EquationTableElm.EquationRow rowData = p.rowData;
+        p.useBroyden = sim.equationTableBroydenJacobianEnabled
                 && sim.equationTableNewtonJacobianEnabled
                 && rowData != null;
-        boolean cacheCompatible = useBroyden
+        p.cacheCompatible = p.useBroyden
                 && EquationTableBroydenHelper.hasCompatibleCache(rowData.broydenRefNames,
                         rowData.broydenApproxDerivatives,
                         rowData.broydenLastRefValues,
-                        refNameArray);
-
-        double[] derivatives = null;
-        int invalidCount = 0;
-        String method = "finite-difference";
+                        p.refNames);
 
-        if (useBroyden && cacheCompatible
-                && rowData.broydenIterationsSinceRefresh < EquationTableBroydenHelper.DEFAULT_REFRESH_INTERVAL) {
-            derivatives = copyDoubleArray(rowData.broydenApproxDerivatives);
-            EquationTableBroydenHelper.UpdateResult updateResult = EquationTableBroydenHelper.applyGoodBroydenUpdate(
-                    derivatives,
-                    rowData.broydenLastRefValues,
-                    rowData.broydenLastFunctionValue,
-                    baseArray,
-                    fVal);
-            if (!updateResult.cacheCompatible || !allFinite(derivatives)) {
-                derivatives = null;
-            } else {
-                method = updateResult.updated ? "broyden-update" : "broyden-reuse";
-            }
+        if (!p.cacheCompatible
+                || rowData.broydenIterationsSinceRefresh >= EquationTableBroydenHelper.DEFAULT_REFRESH_INTERVAL) {
+            return false;
         }
-
-        if (derivatives == null) {
-            FiniteDifferenceResult fd = computeFiniteDifferenceDerivatives(sim, expr, state, refNameArray, nodeArray, baseArray, fVal);
-            refNameArray = fd.refNames;
-            nodeArray = fd.labeledNodes;
-            baseArray = fd.baseValues;
-            derivatives = fd.derivatives;
-            invalidCount = fd.invalidDerivativeCount;
-            if (useBroyden && derivatives.length > 0) {
-                method = cacheCompatible ? "broyden-refresh" : "broyden-seed";
-            }
+        double[] derivatives = copyDoubleArray(rowData.broydenApproxDerivatives);
+        EquationTableBroydenHelper.UpdateResult updateResult = EquationTableBroydenHelper.applyGoodBroydenUpdate(
+                derivatives,
+                rowData.broydenLastRefValues,
+                rowData.broydenLastFunctionValue,
+                p.baseValues,
+                p.fVal);
+        if (!updateResult.cacheCompatible || !allFinite(derivatives)) {
+            return false;
         }
+        finishRow(p, p.refNames, p.labeledNodes, p.baseValues, derivatives, 0,
+                updateResult.updated ? "broyden-update" : "broyden-reuse");
+        return true;
+    }
 
-        if (useBroyden) {
-            cacheBroydenState(rowData, refNameArray, baseArray, fVal, derivatives, method);
+    private static void finishRow(PendingRow p, String[] refNames, int[] labeledNodes, double[] baseValues,
+            double[] derivatives, int invalidCount, String method) {
+        if (p.useBroyden) {
+            cacheBroydenState(p.rowData, refNames, baseValues, p.fVal, derivatives, method);
         }
-
-        return new JacobianComputation(refNameArray, nodeArray, baseArray, derivatives, fVal, sawMnaRefs, invalidCount, method);
+        p.jacobian = new JacobianComputation(refNames, labeledNodes, baseValues, derivatives, p.fVal,
+                p.sawMnaRefCount, invalidCount, method);
     }
 
     static int stampPreparedSingleNodeJacobian(JacobianComputation jacobian, int nodeNumber, double matrixSign) {
@@ -389,8 +543,8 @@ final class EquationTableJacobianHelper {
      * the number of Newton subiterations required for convergence.
      *
      * <p>The reference value is temporarily perturbed in both {@code sim.getSolverMatrixState().nodeVoltages[]}
-     * and {@code sim.circuitVariables[]} via {@link #perturbReferenceValue}, then
-     * restored via {@link #restoreReferenceValue} after each evaluation.
+     * and {@code sim.circuitVariables[]} via {@link #perturbColumn}, then
+     * restored via {@link #restoreColumn} after each evaluation.
      *
      * <p>Entries are skipped when the perturbed evaluation produces NaN/Infinity;
      * {@code stats[2]} counts such invalid derivatives.
@@ -418,57 +572,126 @@ final class EquationTableJacobianHelper {
         return stampPreparedSingleNodeJacobian(jacobian, nodeNumber, matrixSign);
     }
 
-    private static FiniteDifferenceResult computeFiniteDifferenceDerivatives(CirSim sim,
-            Expr expr,
-            ExprState state,
-            String[] refNames,
-            int[] labeledNodes,
-            double[] baseValues,
-            double fVal) {
-        ArrayList<String> validRefNames = new ArrayList<String>();
-        ArrayList<Integer> validNodes = new ArrayList<Integer>();
-        ArrayList<Double> validBaseValues = new ArrayList<Double>();
-        ArrayList<Double> validDerivatives = new ArrayList<Double>();
-        int invalidCount = 0;
-
-        for (int i = 0; i < refNames.length; i++) {
-            double baseValue = baseValues[i];
-            double dv = Math.abs(baseValue) * 1e-6;
-            if (dv < 1e-6) {
-                dv = 1e-6;
+    /**
+     * Colored finite differences: {@code df_r/dv_j ≈ (f_r(v₀ + dv_j e_j) − f_r(v₀)) / dv_j}
+     * with {@code dv_j = max(|v₀_j| * 1e-6, 1e-6)}, every column of one color perturbed at once.
+     */
+    private static void computeColoredFiniteDifferences(CirSim sim, ArrayList<PendingRow> rows, ColoringCache cache) {
+        // Number columns by labeled node in order of first reference.
+        int maxNode = 0;
+        for (int i = 0; i < rows.size(); i++) {
+            int[] nodes = rows.get(i).labeledNodes;
+            for (int k = 0; k < nodes.length; k++) {
+                if (nodes[k] > maxNode) {
+                    maxNode = nodes[k];
+                }
+            }
+        }
+        if (cache.columnByNode.length <= maxNode) {
+            cache.columnByNode = new int[maxNode + 1];
+        }
+        int[] columnByNode = cache.columnByNode;
+        int columnCount = 0;
+        int[][] rowColumns = new int[rows.size()][];
+        for (int i = 0; i < rows.size(); i++) {
+            PendingRow p = rows.get(i);
+            p.columns = new int[p.labeledNodes.length];
+            for (int k = 0; k < p.labeledNodes.length; k++) {
+                int node = p.labeledNodes[k];
+                if (columnByNode[node] == 0) {
+                    columnByNode[node] = ++columnCount;
+                }
+                p.columns[k] = columnByNode[node] - 1;
+            }
+            rowColumns[i] = p.columns;
+        }
+
+        int[] columnNode = new int[columnCount];
+        double[] columnBase = new double[columnCount];
+        double[] columnStep = new double[columnCount];
+        int[][] columnSlots = new int[columnCount][];
+        for (int i = 0; i < rows.size(); i++) {
+            PendingRow p = rows.get(i);
+            p.fdDerivatives = new double[p.columns.length];
+            for (int k = 0; k < p.columns.length; k++) {
+                int c = p.columns[k];
+                if (columnSlots[c] == null) {
+                    columnNode[c] = p.labeledNodes[k];
+                    columnBase[c] = p.baseValues[k];
+                    double dv = Math.abs(columnBase[c]) * 1e-6;
+                    columnStep[c] = dv < 1e-6 ? 1e-6 : dv;
+                    columnSlots[c] = new int[0];
+                }
+                columnSlots[c] = addSlot(sim, columnSlots[c], p.refNames[k]);
             }
+        }
+        for (int c = 0; c < columnCount; c++) {
+            columnByNode[columnNode[c]] = 0;
+        }
+
+        if (!cache.matches(rowColumns, columnCount)) {
+            cache.rebuild(rowColumns, columnCount);
+        }
 
-            double[] restore = perturbReferenceValue(sim, refNames[i], labeledNodes[i], baseValue + dv);
-            double perturbedValue;
+        double[] savedNode = new double[columnCount];
+        double[][] savedSlots = new double[columnCount][];
+        for (int color = 0; color < cache.colorCount; color++) {
+            int first = cache.colorColumnStart[color];
+            int last = cache.colorColumnStart[color + 1];
+            for (int k = first; k < last; k++) {
+                int c = cache.colorColumns[k];
+                savedSlots[c] = new double[columnSlots[c].length];
+                savedNode[c] = perturbColumn(sim, columnNode[c], columnSlots[c], savedSlots[c],
+                        columnBase[c] + columnStep[c]);
+            }
             try {
-                perturbedValue = expr.eval(state);
+                for (int e = cache.colorEntryStart[color]; e < cache.colorEntryStart[color + 1]; e++) {
+                    PendingRow p = rows.get(cache.entryRow[e]);
+                    int pos = cache.entryPos[e];
+                    double perturbedValue = p.expr.eval(p.state);
+                    p.fdDerivatives[pos] = (perturbedValue - p.fVal) / columnStep[p.columns[pos]];
+                    cache.lastEvaluationCount++;
+                }
             } finally {
-                restoreReferenceValue(sim, labeledNodes[i], restore);
+                for (int k = last - 1; k >= first; k--) {
+                    int c = cache.colorColumns[k];
+                    restoreColumn(sim, columnNode[c], columnSlots[c], savedSlots[c], savedNode[c]);
+                }
             }
+        }
 
-            if (Double.isNaN(perturbedValue) || Double.isInfinite(perturbedValue)) {
-                invalidCount++;
-                continue;
+        for (int i = 0; i < rows.size(); i++) {
+            PendingRow p = rows.get(i);
+            int valid = 0;
+            for (int k = 0; k < p.fdDerivatives.length; k++) {
+                double dx = p.fdDerivatives[k];
+                if (!Double.isNaN(dx) && !Double.isInfinite(dx)) {
+                    valid++;
+                }
             }
-
-            double dx = (perturbedValue - fVal) / dv;
-            if (Double.isNaN(dx) || Double.isInfinite(dx)) {
-                invalidCount++;
-                continue;
+            String[] names = new String[valid];
+            int[] nodes = new int[valid];
+            double[] bases = new double[valid];
+            double[] derivatives = new double[valid];
+            int n = 0;
+            for (int k = 0; k < p.fdDerivatives.length; k++) {
+                double dx = p.fdDerivatives[k];
+                if (Double.isNaN(dx) || Double.isInfinite(dx)) {
+                    continue;
+                }
+                names[n] = p.refNames[k];
+                nodes[n] = p.labeledNodes[k];
+                bases[n] = p.baseValues[k];
+                derivatives[n] = dx;
+                n++;
             }
-
-            validRefNames.add(refNames[i]);
-            validNodes.add(Integer.valueOf(labeledNodes[i]));
-            validBaseValues.add(Double.valueOf(baseValue));
-            validDerivatives.add(Double.valueOf(dx));
+            String method = "finite-difference";
+            if (p.useBroyden && valid > 0) {
+                method = p.cacheCompatible ? "broyden-refresh" : "broyden-seed";
+            }
+            finishRow(p, names, nodes, bases, derivatives, p.fdDerivatives.length - valid, method);
+            p.fdDerivatives = null;
         }
-
-        return new FiniteDifferenceResult(
-                toStringArray(validRefNames),
-                toIntArray(validNodes),
-                toDoubleArray(validBaseValues),
-                toDoubleArray(validDerivatives),
-                invalidCount);
     }
 
     private static void cacheBroydenState(EquationTableElm.EquationRow rowData,
@@ -504,30 +727,6 @@ final class EquationTableJacobianHelper {
         return true;
     }
 
-    private static String[] toStringArray(ArrayList<String> values) {
-        String[] out = new String[values.size()];
-        for (int i = 0; i < values.size(); i++) {
-            out[i] = values.get(i);
-        }
-        return out;
-    }
-
-    private static int[] toIntArray(ArrayList<Integer> values) {
-        int[] out = new int[values.size()];
-        for (int i = 0; i < values.size(); i++) {
-            out[i] = values.get(i).intValue();
-        }
-        return out;
-    }
-
-    private static double[] toDoubleArray(ArrayList<Double> values) {
-        double[] out = new double[values.size()];
-        for (int i = 0; i < values.size(); i++) {
-            out[i] = values.get(i).doubleValue();
-        }
-        return out;
-    }
-
     private static String[] copyStringArray(String[] values) {
         String[] out = new String[values.length];
         for (int i = 0; i < values.length; i++) {
@@ -567,73 +766,69 @@ final class EquationTableJacobianHelper {
     }
 
     /**
-     * Temporarily overwrite a reference variable's value in the simulator state.
+     * Temporarily overwrite one Jacobian column (a labeled node) in the simulator state.
      *
      * Two parallel data structures are patched:
      * <ul>
      *   <li>{@code sim.getSolverMatrixState().nodeVoltages[labeledNode - 1]} — the MNA solved-voltage array used
      *       by direct node lookups.</li>
-     *   <li>{@code sim.circuitVariables[slot]} — the fast global-slot array used by
-     *       expressions after {@code resolveGSlot()} has been called.</li>
+     *   <li>{@code sim.circuitVariables[slot]} for every reference name of the column — the fast
+     *       global-slot array used by expressions after {@code resolveGSlot()} has been called.</li>
      * </ul>
      * Both must be patched because different expression types read from different locations.
      *
-     * The original values are returned as a {@code double[3]} restore token:
-     * {@code [0]} = old nodeVoltage, {@code [1]} = old slot value,
-     * {@code [2]} = slot index (or NaN if no slot was found).
-     *
      * @param sim        Active circuit simulator.
-     * @param refName    Variable name being perturbed (needed for slot lookup).
-     * @param labeledNode MNA node number for the reference (1-based).
+     * @param labeledNode MNA node number for the column (1-based).
+     * @param slots      Slot indices of the names referring to this node (see {@link #addSlot}).
+     * @param savedSlots Receives the old slot values; same length as {@code slots}.
      * @param newValue   Perturbed value to write.
-     * @return Restore token; pass to {@link #restoreReferenceValue} after evaluation.
+     * @return Old node voltage; pass it with {@code savedSlots} to {@link #restoreColumn}.
      */
-    private static double[] perturbReferenceValue(CirSim sim, String refName, int labeledNode, double newValue) {
+    private static double perturbColumn(CirSim sim, int labeledNode, int[] slots, double[] savedSlots, double newValue) {
         double oldNodeVoltage = 0.0;
-        if (sim.getSolverMatrixState().nodeVoltages != null && labeledNode > 0 && labeledNode - 1 < sim.getSolverMatrixState().nodeVoltages.length) {
-            oldNodeVoltage = sim.getSolverMatrixState().nodeVoltages[labeledNode - 1];
-            sim.getSolverMatrixState().nodeVoltages[labeledNode - 1] = newValue;
+        double[] nodeVoltages = sim.getSolverMatrixState().nodeVoltages;
+        if (nodeVoltages != null && labeledNode > 0 && labeledNode - 1 < nodeVoltages.length) {
+            oldNodeVoltage = nodeVoltages[labeledNode - 1];
+            nodeVoltages[labeledNode - 1] = newValue;
         }
-
-        double oldSlotValue = Double.NaN;
-        double slotIndex = Double.NaN;
-        if (sim.nameToSlot != null && sim.circuitVariables != null) {
-            Integer slot = sim.nameToSlot.get(refName);
-            if (slot != null && slot.intValue() >= 0 && slot.intValue() < sim.circuitVariables.length) {
-                int s = slot.intValue();
-                oldSlotValue = sim.circuitVariables[s];
-                sim.circuitVariables[s] = newValue;
-                slotIndex = s;
-            }
+        for (int i = 0; i < slots.length; i++) {
+            savedSlots[i] = sim.circuitVariables[slots[i]];
+            sim.circuitVariables[slots[i]] = newValue;
         }
-
-        return new double[] { oldNodeVoltage, oldSlotValue, slotIndex };
+        return oldNodeVoltage;
     }
 
     /**
-     * Restore simulator state after a finite-difference perturbation.
-     *
-     * Reverses the changes made by {@link #perturbReferenceValue}, reinstating the original
+     * Restore simulator state after {@link #perturbColumn}, reinstating the original
      * values in both {@code sim.getSolverMatrixState().nodeVoltages} and {@code sim.circuitVariables}.
-     *
-     * @param sim         Active circuit simulator.
-     * @param labeledNode MNA node number that was perturbed (1-based).
-     * @param restore     Restore token returned by {@link #perturbReferenceValue}.
      */
-    private static void restoreReferenceValue(CirSim sim, int labeledNode, double[] restore) {
-        if (restore == null || restore.length < 3) {
-            return;
+    private static void restoreColumn(CirSim sim, int labeledNode, int[] slots, double[] savedSlots, double oldNodeVoltage) {
+        double[] nodeVoltages = sim.getSolverMatrixState().nodeVoltages;
+        if (nodeVoltages != null && labeledNode > 0 && labeledNode - 1 < nodeVoltages.length) {
+            nodeVoltages[labeledNode - 1] = oldNodeVoltage;
         }
-
-        if (sim.getSolverMatrixState().nodeVoltages != null && labeledNode > 0 && labeledNode - 1 < sim.getSolverMatrixState().nodeVoltages.length) {
-            sim.getSolverMatrixState().nodeVoltages[labeledNode - 1] = restore[0];
+        for (int i = slots.length - 1; i >= 0; i--) {
+            sim.circuitVariables[slots[i]] = savedSlots[i];
         }
+    }
 
-        if (!Double.isNaN(restore[2]) && sim.circuitVariables != null) {
-            int s = (int) restore[2];
-            if (s >= 0 && s < sim.circuitVariables.length && !Double.isNaN(restore[1])) {
-                sim.circuitVariables[s] = restore[1];
+    /** Append the circuitVariables slot of {@code refName} to a column's slot list, if it has one. */
+    private static int[] addSlot(CirSim sim, int[] slots, String refName) {
+        if (sim.nameToSlot == null || sim.circuitVariables == null) {
+            return slots;
+        }
+        Integer slot = sim.nameToSlot.get(refName);
+        if (slot == null || slot.intValue() < 0 || slot.intValue() >= sim.circuitVariables.length) {
+            return slots;
+        }
+        int s = slot.intValue();
+        for (int i = 0; i < slots.length; i++) {
+            if (slots[i] == s) {
+                return slots;
             }
         }
+        int[] out = java.util.Arrays.copyOf(slots, slots.length + 1);
+        out[slots.length] = s;
+        return out;
     }
 }
@@ -8,7 +8,6 @@ package com.lushprojects.circuitjs1.client.elements.economics;
 
 import com.google.gwt.canvas.client.Canvas;
 import com.google.gwt.canvas.dom.client.Context2d;
-import com.google.gwt.core.client.Duration;
 import java.util.Set;
 import com.lushprojects.circuitjs1.client.*;
 import com.lushprojects.circuitjs1.client.runner.RuntimeMode;
@@ -29,6 +28,10 @@ import com.lushprojects.circuitjs1.client.util.Locale;
  * {@code drawImage}.  Only dynamic content (row text, hover highlight, values, selection
  * border) is drawn directly to the main canvas each frame.
  *
+ * Row text and values go into a second (content) layer.  It is rebuilt fully when layout,
+ * theme, trace or adjustable-variable coloring changes; otherwise every refresh tick only
+ * redraws the rows whose value or row content changed.
+ *
  * The cache is invalidated (via {@link #invalidateCache()}) whenever the table structure
  * changes: rows added/removed, display size changed, or print mode toggled.
  *
@@ -62,6 +65,16 @@ class EquationTableRenderer {
     private Font valueFont;
     private Font valueFontBold;
     private Font perfFont = new Font("SansSerif", 0, 9);
+    // Row icon/comment/initial-value fonts depend on opsize only; built once per opsize
+    // instead of once per row per frame, together with the icon gutter width.
+    private int rowFontsOpsize = -1;
+    private Font commentFont;
+    private Font adjustableIconFont;
+    private Font modeIconFont;
+    private Font stockIconFont;
+    private Font classIconFont;
+    private Font initialValueFont;
+    private int rowIconReservedWidth = -1;
     private double renderTimeEmaMs = 0;
     private boolean hasRenderTimingSample = false;
 
@@ -93,8 +106,15 @@ class EquationTableRenderer {
     private boolean contentCachedVoltsVisible = false;
     private float contentCachedScale = -1;
     private long contentCachedTimeBucket = -1;
+    private String contentCachedTitle;
     private static final long CONTENT_CACHE_UPDATE_INTERVAL_MS = 200;
     private int cacheRebuildCount = 0;
+    // Per visible row: what was last drawn into the content layer. On a refresh tick only
+    // rows whose value or row content key changed are cleared and redrawn.
+    private double[] contentRowValues;
+    private String[] contentRowKeys;
+    private int contentRowsRedrawn = 0;
+    private java.util.Set<String> lastAdjustableVariableNames;
     
     // Dark mode colors (matches TableRenderer)
     private static final Color HEADER_BG_DARK = new Color(55, 55, 75);
@@ -168,7 +188,7 @@ class EquationTableRenderer {
     }
 
     private boolean isVoltsVisible() {
-        return CirSim.getInstance() != null && CirSim.getInstance().voltsCheckItem != null && CirSim.getInstance().voltsCheckItem.getState();
+        return CirSim.getInstance() != null && CirSim.getInstance().isVoltsEnabledForExport();
     }
 
     private void clearRowTextCaches() {
@@ -247,11 +267,13 @@ class EquationTableRenderer {
         float renderScale = getRenderScale();
         long timeBucket = System.currentTimeMillis() / CONTENT_CACHE_UPDATE_INTERVAL_MS;
 
+        String title = table.getTableName();
+
         if (!contentCacheValid || width != contentCachedWidth || height != contentCachedHeight ||
             visibleRowCount != contentCachedRowCount || firstVisibleRow != contentCachedFirstVisibleRow ||
             printable != contentCachedPrintable ||
             voltsVisible != contentCachedVoltsVisible || renderScale != contentCachedScale ||
-            timeBucket != contentCachedTimeBucket) {
+            (title == null ? contentCachedTitle != null : !title.equals(contentCachedTitle))) {
 
             if (width != contentCachedWidth || height != contentCachedHeight || renderScale != contentCachedScale) {
                 contentLayerCanvas.setCoordinateSpaceWidth((int) Math.ceil(width * renderScale));
@@ -267,8 +289,13 @@ class EquationTableRenderer {
             contentLayerCtx.translate(-tableX, -tableY);
             drawTitleRow(cacheGraphics, tableX, tableY);
             cacheGraphics.setFont(valueFont);
+            if (contentRowValues == null || contentRowValues.length < visibleRowCount) {
+                contentRowValues = new double[visibleRowCount];
+                contentRowKeys = new String[visibleRowCount];
+            }
             for (int row = firstVisibleRow; row < firstVisibleRow + visibleRowCount && row < table.getRowCount(); row++) {
                 drawDataRow(cacheGraphics, tableX, tableY, row, true, false);
+                rememberContentRow(row - firstVisibleRow, row);
             }
             contentLayerCtx.restore();
 
@@ -280,12 +307,72 @@ class EquationTableRenderer {
             contentCachedVoltsVisible = voltsVisible;
             contentCachedScale = renderScale;
             contentCachedTimeBucket = timeBucket;
+            contentCachedTitle = title;
             contentCacheValid = true;
+            contentRowsRedrawn = visibleRowCount;
+        } else if (timeBucket != contentCachedTimeBucket) {
+            contentCachedTimeBucket = timeBucket;
+            refreshDirtyContentRows(tableX, tableY, width, visibleRowCount, firstVisibleRow);
         }
 
         return true;
     }
     
+    /**
+     * Redraw only the visible rows whose displayed value or row content changed since
+     * they were last drawn into the content layer.
+     */
+    private void refreshDirtyContentRows(int tableX, int tableY, int width, int visibleRowCount, int firstVisibleRow) {
+        int rowHeight = table.getRowHeight();
+        Graphics cacheGraphics = null;
+        contentRowsRedrawn = 0;
+        for (int row = firstVisibleRow; row < firstVisibleRow + visibleRowCount && row < table.getRowCount(); row++) {
+            int slot = row - firstVisibleRow;
+            String key = buildRowContentKey(row);
+            double value = table.isCommentRow(row) ? 0 : table.getDisplayValue(row);
+            if (contentRowValues[slot] == value && key.equals(contentRowKeys[slot])) {
+                continue;
+            }
+            if (cacheGraphics == null) {
+                cacheGraphics = new Graphics(contentLayerCtx);
+            }
+            int rowY = tableY + (slot + 1) * rowHeight;
+            cacheGraphics.save();
+            contentLayerCtx.translate(-tableX, -tableY);
+            contentLayerCtx.clearRect(tableX, rowY, width, rowHeight);
+            cacheGraphics.clipRect(tableX, rowY, width, rowHeight);
+            cacheGraphics.setFont(valueFont);
+            drawDataRow(cacheGraphics, tableX, tableY, row, true, false);
+            cacheGraphics.restore();
+            contentRowValues[slot] = value;
+            contentRowKeys[slot] = key;
+            contentRowsRedrawn++;
+        }
+    }
+
+    private void rememberContentRow(int slot, int row) {
+        contentRowValues[slot] = table.isCommentRow(row) ? 0 : table.getDisplayValue(row);
+        contentRowKeys[slot] = buildRowContentKey(row);
+    }
+
+    /**
+     * Everything drawDataRow() shows for a row apart from its value.
+     */
+    private String buildRowContentKey(int row) {
+        if (table.isCommentRow(row)) {
+            return "#" + table.getCommentText(row);
+        }
+        StringBuilder sb = new StringBuilder();
+        sb.append(getCachedOutputName(row)).append('\u0001');
+        sb.append(buildDisplayEquation(row)).append('\u0001');
+        sb.append(table.isAdjustableRow(row) ? 'a' : '-');
+        sb.append(table.isStockRow(row) ? 's' : '-');
+        sb.append(table.getOutputMode(row).ordinal()).append('\u0001');
+        sb.append(table.getRowClassification(row)).append('\u0001');
+        sb.append(table.getInitialEquation(row));
+        return sb.toString();
+    }
+    
     /**
      * Draw static parts (backgrounds, grid lines, borders) to cached canvas.
      * This is only called when cache is invalid.
@@ -376,7 +463,7 @@ class EquationTableRenderer {
 
     // Helper methods for theme-aware colors
     private boolean isPrintable() {
-        return CirSim.getInstance().printableCheckItem.getState();
+        return CirSim.getInstance().isPrintableEnabledForExport();
     }
     
     private Color getHeaderBgColor() {
@@ -416,7 +503,7 @@ class EquationTableRenderer {
      * @return Color from the voltage color scale.
      */
     private Color getVoltageColor(double volts) {
-        if (!CirSim.getInstance().voltsCheckItem.getState()) {
+        if (!CirSim.getInstance().isVoltsEnabledForExport()) {
             return CircuitElm.whiteColor;
         }
         int c = (int) ((volts + CircuitElm.voltageRange) * (CircuitElm.colorScaleCount - 1) /
@@ -442,6 +529,21 @@ class EquationTableRenderer {
         valueFontBold = new Font("SansSerif", Font.BOLD, opsize == 2 ? 10 : 8);
         perfFont = new Font("SansSerif", 0, opsize == 2 ? 9 : 8);
     }
+
+    private void ensureRowFonts() {
+        int opsize = table.getOpsize();
+        if (opsize == rowFontsOpsize) {
+            return;
+        }
+        commentFont = new Font("SansSerif", Font.BOLD, opsize == 2 ? 10 : 8);
+        adjustableIconFont = new Font("SansSerif", Font.BOLD, opsize == 1 ? 12 : 16);
+        modeIconFont = new Font("SansSerif", Font.BOLD, opsize == 1 ? 9 : 11);
+        stockIconFont = new Font("SansSerif", Font.BOLD, opsize == 1 ? 11 : 13);
+        classIconFont = new Font("SansSerif", 0, opsize == 1 ? 10 : 12);  // 0 = plain (no bold)
+        initialValueFont = new Font("SansSerif", 0, opsize == 2 ? 8 : 7);
+        rowIconReservedWidth = -1;
+        rowFontsOpsize = opsize;
+    }
     
     //=============================================================================
     // MAIN DRAWING
@@ -453,7 +555,7 @@ class EquationTableRenderer {
      * Only text and hover effects are drawn each frame.
      */
     public void draw(Graphics g) {
-        double renderStartMs = Duration.currentTimeMillis();
+        double renderStartMs = System.currentTimeMillis();
         int tableX = table.x;
         int tableY = table.y;
         boolean selected = table.needsHighlight();
@@ -465,6 +567,13 @@ class EquationTableRenderer {
 
         // Compute adjustable variable names once per draw cycle
         cachedAdjustableVariableNames = table.collectAdjustableVariableNames();
+        if (!cachedAdjustableVariableNames.equals(lastAdjustableVariableNames)) {
+            lastAdjustableVariableNames = cachedAdjustableVariableNames;
+            contentCacheValid = false;
+        }
+        // Settle trace highlighting before the content cache check; rows skipped by a
+        // partial refresh would otherwise never notice a trace change.
+        table.refreshEffectiveTrace();
         
         // Try to use cached static rendering
         boolean usingCache = ensureCacheValid(tableWidth, tableHeight, visibleRowCount);
@@ -472,7 +581,7 @@ class EquationTableRenderer {
         
         if (usingCache) {
             // Blit cached background/grid to main canvas
-            g.context.drawImage(backgroundLayerCtx.getCanvas(), tableX, tableY, tableWidth, tableHeight);
+            g.drawLayer(backgroundLayerCtx, tableX, tableY, tableWidth, tableHeight);
             
             // Draw selection border on top if selected (dynamic - not cached)
             if (selected) {
@@ -509,7 +618,7 @@ class EquationTableRenderer {
         drawHoverHighlight(g, tableX, tableY);
         
         if (usingContentCache) {
-            g.context.drawImage(contentLayerCtx.getCanvas(), tableX, tableY, tableWidth, tableHeight);
+            g.drawLayer(contentLayerCtx, tableX, tableY, tableWidth, tableHeight);
         } else {
             // Draw title row text (dynamic - not cached)
             drawTitleRow(g, tableX, tableY);
@@ -526,7 +635,7 @@ class EquationTableRenderer {
         // Update bounding box
         table.setBbox(tableX, tableY, tableX + tableWidth, tableY + tableHeight);
 
-        double renderMs = Duration.currentTimeMillis() - renderStartMs;
+        double renderMs = System.currentTimeMillis() - renderStartMs;
         if (!hasRenderTimingSample) {
             renderTimeEmaMs = renderMs;
             hasRenderTimingSample = true;
@@ -542,7 +651,7 @@ class EquationTableRenderer {
         }
         String timingText = (usingCache ? "C " : "N ") +
             formatTimingMs(renderMs) + "ms (" +
-            formatTimingMs(renderTimeEmaMs) + "ms) R:" + cacheRebuildCount;
+            formatTimingMs(renderTimeEmaMs) + "ms) R:" + cacheRebuildCount + " D:" + contentRowsRedrawn;
         g.setFont(perfFont);
         g.setColor(isPrintable() ? new Color(40, 40, 40) : new Color(170, 255, 210));
         g.drawString(timingText, tableX + 26, tableY + 10);
@@ -687,7 +796,7 @@ class EquationTableRenderer {
             String rangeText = (table.getFirstVisibleRow() + 1) + "-" + table.getVisibleRowEnd() + "/" + table.getRowCount();
             g.setFont(valueFont);
             int inset = table.getContentRightInset();
-            int rangeWidth = (int) g.context.measureText(rangeText).getWidth();
+            int rangeWidth = (int) g.measureWidth(rangeText);
             g.drawString(rangeText, tableX + table.getTableWidth() - rangeWidth - inset, titleY - 2);
             g.setFont(labelFont);
         }
@@ -745,11 +854,12 @@ class EquationTableRenderer {
         int tableWidth = table.getTableWidth();
         boolean isHovered = allowHoverStyling && (row == table.getHoveredRow());
         int iconAreaStartX = tableX + cellPadding;
+        ensureRowFonts();
         int textX = iconAreaStartX + getRowIconReservedWidth(g);
 
         if (table.isCommentRow(row)) {
             String comment = table.getCommentText(row);
-            g.setFont(new Font("SansSerif", Font.BOLD, table.getOpsize() == 2 ? 10 : 8));
+            g.setFont(commentFont);
             g.setColor(getTextColor());
             g.drawString("# " + Locale.convertGreekSymbols(comment), textX,
                 rowY + rowHeight - cellPadding - 2);
@@ -778,11 +888,10 @@ class EquationTableRenderer {
         boolean isAdjustable = table.isAdjustableRow(row);
         if (isAdjustable) {
             // Use larger bold font for icon
-            int iconSize = table.getOpsize() == 1 ? 12 : 16;
-            g.setFont(new Font("SansSerif", Font.BOLD, iconSize));
+            g.setFont(adjustableIconFont);
             g.setColor(isHovered ? new Color(0, 100, 200) : new Color(0, 60, 140));  // Dark blue, darker on hover
             g.drawString("↕", iconX, rowY + rowHeight - cellPadding - 1);
-            int iconWidth = (int) g.context.measureText("↕ ").getWidth();
+            int iconWidth = (int) g.measureWidth("↕ ");
             g.setFont(valueFont);  // Restore to valueFont (what drawDataRow uses)
             iconX += iconWidth;
         }
@@ -792,11 +901,10 @@ class EquationTableRenderer {
         if (mode != RowOutputMode.VOLTAGE_MODE) {
             String modeIcon = "P";
             Color modeColor = new Color(120, 80, 180);
-            int modeIconSize = table.getOpsize() == 1 ? 9 : 11;
-            g.setFont(new Font("SansSerif", Font.BOLD, modeIconSize));
+            g.setFont(modeIconFont);
             g.setColor(modeColor);
             g.drawString(modeIcon, iconX, rowY + rowHeight - cellPadding - 1);
-            int modeIconWidth = (int) g.context.measureText(modeIcon + " ").getWidth();
+            int modeIconWidth = (int) g.measureWidth("P ");
             g.setFont(valueFont);  // Restore to valueFont
             iconX += modeIconWidth;
         }
@@ -805,11 +913,10 @@ class EquationTableRenderer {
         if (table.isStockRow(row)) {
             String stockIcon = "∫";
             Color stockColor = new Color(30, 140, 80);  // Green for stock/state equations
-            int iconSize = table.getOpsize() == 1 ? 11 : 13;
-            g.setFont(new Font("SansSerif", Font.BOLD, iconSize));
+            g.setFont(stockIconFont);
             g.setColor(stockColor);
             g.drawString(stockIcon, iconX, rowY + rowHeight - cellPadding - 1);
-            int stockIconWidth = (int) g.context.measureText(stockIcon + " ").getWidth();
+            int stockIconWidth = (int) g.measureWidth("∫ ");
             g.setFont(valueFont);  // Restore to valueFont
             iconX += stockIconWidth;
         }
@@ -819,20 +926,18 @@ class EquationTableRenderer {
         if ("cyclic".equals(classification)) {
             String classIcon = "⟳";
             Color classColor = new Color(200, 100, 0);  // Orange
-            int iconSize = table.getOpsize() == 1 ? 10 : 12;
-            g.setFont(new Font("SansSerif", 0, iconSize));  // 0 = plain (no bold)
+            g.setFont(classIconFont);
             g.setColor(classColor);
             g.drawString(classIcon, iconX, rowY + rowHeight - cellPadding - 1);
-            int classIconWidth = (int) g.context.measureText(classIcon + " ").getWidth();
+            int classIconWidth = (int) g.measureWidth("⟳ ");
             g.setFont(valueFont);  // Restore to valueFont
             iconX += classIconWidth;
         }
         
         // Draw current value on right side with voltage coloring
         double outputValue = table.getDisplayValue(row);
-        String valueText = CircuitElm.getShortUnitText(outputValue, "");
-        valueText += " V";
-        int valueWidth = (int) g.context.measureText(valueText).getWidth();
+        String valueText = CircuitElm.getCachedShortUnitText(outputValue, "") + " V";
+        int valueWidth = (int) g.measureWidth(valueText);
 
         int initWidth = getInitialIndicatorWidth(g, row);
         int textRightX = tableX + tableWidth - table.getContentRightInset() - valueWidth - initWidth - table.getCellPadding() - 2;
@@ -885,28 +990,29 @@ class EquationTableRenderer {
      * regardless of which icons are present on a particular row.
      */
     private int getRowIconReservedWidth(Graphics g) {
-        int adjustableSize = table.getOpsize() == 1 ? 12 : 16;
-        int modeIconSize = table.getOpsize() == 1 ? 9 : 11;
-        int stockIconSize = table.getOpsize() == 1 ? 11 : 13;
-        int classIconSize = table.getOpsize() == 1 ? 10 : 12;
+        ensureRowFonts();
+        if (rowIconReservedWidth >= 0) {
+            return rowIconReservedWidth;
+        }
 
-        g.setFont(new Font("SansSerif", Font.BOLD, adjustableSize));
-        int adjustableWidth = (int) g.context.measureText("↕ ").getWidth();
+        g.setFont(adjustableIconFont);
+        int adjustableWidth = (int) g.measureWidth("↕ ");
 
-        g.setFont(new Font("SansSerif", Font.BOLD, modeIconSize));
-        int flowWidth = (int) g.context.measureText("I→ ").getWidth();
-        int paramWidth = (int) g.context.measureText("P ").getWidth();
+        g.setFont(modeIconFont);
+        int flowWidth = (int) g.measureWidth("I→ ");
+        int paramWidth = (int) g.measureWidth("P ");
         int modeWidth = Math.max(flowWidth, paramWidth);
 
-        g.setFont(new Font("SansSerif", Font.BOLD, stockIconSize));
-        int stockWidth = (int) g.context.measureText("∫ ").getWidth();
+        g.setFont(stockIconFont);
+        int stockWidth = (int) g.measureWidth("∫ ");
 
-        g.setFont(new Font("SansSerif", 0, classIconSize));
-        int classWidth = (int) g.context.measureText("⟳ ").getWidth();
+        g.setFont(classIconFont);
+        int classWidth = (int) g.measureWidth("⟳ ");
 
         g.setFont(valueFont);
 
-        return adjustableWidth + modeWidth + stockWidth + classWidth + 2;
+        rowIconReservedWidth = adjustableWidth + modeWidth + stockWidth + classWidth + 2;
+        return rowIconReservedWidth;
     }
     
     /**
@@ -1074,8 +1180,8 @@ class EquationTableRenderer {
             return 0;
         }
         Font originalFont = valueFont;
-        Font smallFont = new Font("SansSerif", 0, table.getOpsize() == 2 ? 8 : 7);
-        g.setFont(smallFont);
+        ensureRowFonts();
+        g.setFont(initialValueFont);
         int width = (int) Math.ceil(g.measureWidth("[" + initEq + "]")) + table.getCellPadding();
         g.setFont(originalFont);
         return width;
@@ -1090,11 +1196,10 @@ class EquationTableRenderer {
             return;
         }
         
-        int opsize = table.getOpsize();
-        Font smallFont = new Font("SansSerif", 0, opsize == 2 ? 8 : 7);
-        g.setFont(smallFont);
+        ensureRowFonts();
+        g.setFont(initialValueFont);
         String initText = "[" + initEq + "]";
-        int initWidth = (int) g.context.measureText(initText).getWidth();
+        int initWidth = (int) g.measureWidth(initText);
         g.setColor(getTextColor());
         g.drawString(initText, tableX + table.getTableWidth() - valueWidth - initWidth - table.getContentRightInset() - table.getCellPadding(), 
                      rowY + table.getRowHeight() - table.getCellPadding() - 2);
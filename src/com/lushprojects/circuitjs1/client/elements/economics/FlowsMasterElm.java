@@ -209,7 +209,7 @@ public class FlowsMasterElm extends ChipElm {
         setBbox(tableX, tableY, tableX + tableWidth, tableY + tableHeight);
         
         // Draw background
-        Color bgColor = CirSim.getInstance().printableCheckItem.getState() ? 
+        Color bgColor = CirSim.getInstance().isPrintableEnabledForExport() ? 
             new Color(240, 240, 240) : new Color(30, 30, 30);
         g.setColor(bgColor);
         g.fillRect(tableX, tableY, tableWidth, tableHeight);
@@ -301,8 +301,8 @@ public class FlowsMasterElm extends ChipElm {
     private void drawLeftText(Graphics g, String text, int x, int y) {
         if (text == null || text.isEmpty()) return;
         g.save();
-        g.context.setTextBaseline("middle");
-        g.context.setTextAlign("left");
+        g.setTextBaseline("middle");
+        g.setTextAlign("left");
         g.drawString(text, x, y);
         g.restore();
     }
@@ -315,7 +315,7 @@ public class FlowsMasterElm extends ChipElm {
             return text;
         }
         
-        double fullWidth = g.context.measureText(text).getWidth();
+        double fullWidth = g.measureText(text);
         
         if (fullWidth <= maxWidth) {
             return text;
@@ -329,7 +329,7 @@ public class FlowsMasterElm extends ChipElm {
         while (left <= right) {
             int mid = (left + right) / 2;
             String candidate = text.substring(0, mid) + "..";
-            double candidateWidth = g.context.measureText(candidate).getWidth();
+            double candidateWidth = g.measureText(candidate);
             
             if (candidateWidth <= maxWidth) {
                 bestFit = candidate;
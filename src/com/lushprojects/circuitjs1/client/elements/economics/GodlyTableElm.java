@@ -565,12 +565,9 @@ public class GodlyTableElm extends TableElm {
                 sim.setConverged(false);
 
                 // Debug: log convergence failure details
-                if (sim.getSubIterations() > 20) {
-                    CirSim.console("GodlyTable[" + columns.get(col).getStockName() + "] col " + col + 
-                                 " sum convergence failed: diff=" + Math.abs(columnSum - lastColumnSums[col]) + 
-                                 " limit=" + convergeLimit +
-                                 " (new=" + columnSum + ", old=" + lastColumnSums[col] + 
-                                 ") at t=" + sim.getTime() + " subiter=" + sim.getSubIterations());
+                if (SolverLog.DEBUG_ENABLED && sim.getSubIterations() > 20) {
+                    SolverLog.log(SolverLog.DEBUG, "GodlyTable[{@}] col {} sum convergence failed: diff={} limit={}",
+                            column.getStockName(), col, Math.abs(columnSum - lastColumnSums[col]), convergeLimit);
                 }
             }
             lastColumnSums[col] = columnSum;
@@ -594,9 +591,9 @@ public class GodlyTableElm extends TableElm {
         }
         
         // Debug: overall convergence status for this element
-        if (wasConverged && !sim.isConverged() && sim.getSubIterations() > 20) {
-            CirSim.console("GodlyTable (" + rows + "x" + getCols() + ") at (" + x + "," + y + 
-                         ") caused convergence failure at subiter=" + sim.getSubIterations());
+        if (SolverLog.DEBUG_ENABLED && wasConverged && !sim.isConverged() && sim.getSubIterations() > 20) {
+            SolverLog.log(SolverLog.DEBUG, "{@} caused convergence failure at t={} subiter={}",
+                    this, sim.getTime(), sim.getSubIterations());
         }
     }
     
@@ -1,6 +1,6 @@
-/*    
+/*
     Copyright (C) Paul Falstad and Iain Sharp
-    
+
     This file is part of CircuitJS1.
 */
 
@@ -13,47 +13,76 @@ import com.lushprojects.circuitjs1.client.*;
 import com.lushprojects.circuitjs1.client.elements.SFCSankeyViewer;
 import com.lushprojects.circuitjs1.client.registry.HintRegistry;
 
+/**
+ * Builds {@link InfoViewerLivePacket}s for the info viewer. Names and labels
+ * go to the metadata JSON; numbers are written straight into double arrays so
+ * they are never formatted as text.
+ */
 public final class InfoViewerLiveDataSerializer {
 
     private InfoViewerLiveDataSerializer() {
     }
 
-    public static String buildLiveDataJson(CirSim sim) {
+    /** Growable double array for the packet channels. */
+    private static final class Channel {
+        double[] data = new double[64];
+        int size;
+
+        void add(double v) {
+            if (size == data.length) {
+                double[] grown = new double[data.length * 2];
+                System.arraycopy(data, 0, grown, 0, size);
+                data = grown;
+            }
+            data[size++] = v;
+        }
+
+        double[] toArray() {
+            double[] out = new double[size];
+            System.arraycopy(data, 0, out, 0, size);
+            return out;
+        }
+    }
+
+    public static InfoViewerLivePacket buildLivePacket(CirSim sim) {
         if (sim == null) {
             return null;
         }
 
-        StringBuilder sb = new StringBuilder();
-        sb.append("{\"type\":\"circuit-live\"");
-        sb.append(",\"running\":").append(sim.simIsRunning());
-        sb.append(",\"t\":").append(sim.getTime());
-        sb.append(",\"dt\":").append(sim.getTimeStep());
-        sb.append(",\"vars\":{");
+        double[] clock = { sim.getTime(), sim.getTimeStep(), sim.simIsRunning() ? 1 : 0 };
 
-        boolean first = true;
-        first = appendLiveVar(sb, "t", sim.getTime(), first);
-        first = appendLiveVar(sb, "dt", sim.getTimeStep(), first);
+        StringBuilder meta = new StringBuilder();
+        meta.append("{\"vars\":[");
+        Channel vars = new Channel();
+        appendName(meta, "t", true);
+        vars.add(sim.getTime());
+        appendName(meta, "dt", false);
+        vars.add(sim.getTimeStep());
 
         String[] names = ComputedValues.getComputedValueNames();
         for (int i = 0; i < names.length; i++) {
             String name = names[i];
-            Double value = ComputedValues.getConvergedValue(name);
-            if (value == null || value.isNaN() || value.isInfinite()) {
+            if (name == null || name.isEmpty()) {
                 continue;
             }
-            first = appendLiveVar(sb, name, value.doubleValue(), first);
+            Double value = ComputedValues.getConvergedValue(name);
+            appendName(meta, name, false);
+            vars.add(value == null ? Double.NaN : value.doubleValue());
         }
+        meta.append(']');
 
-        sb.append("}");
-        appendLiveTablesJson(sb, sim);
-        appendLiveSankeysJson(sb, sim);
-        appendLiveScopesJson(sb, sim);
-        sb.append("}\n");
-        return sb.toString();
+        Channel tables = new Channel();
+        appendLiveTables(meta, tables, sim);
+        Channel scopes = new Channel();
+        appendLiveScopes(meta, scopes, sim);
+        meta.append('}');
+
+        return new InfoViewerLivePacket(meta.toString(), clock, vars.toArray(), tables.toArray(),
+                scopes.toArray(), buildSankeysJson(sim));
     }
 
-    private static void appendLiveTablesJson(StringBuilder sb, CirSim sim) {
-        sb.append(",\"tables\":[");
+    private static void appendLiveTables(StringBuilder meta, Channel values, CirSim sim) {
+        meta.append(",\"tables\":[");
         boolean firstTable = true;
 
         if (sim.elmList != null) {
@@ -61,24 +90,24 @@ public final class InfoViewerLiveDataSerializer {
                 CircuitElm elm = sim.elmList.get(i);
                 if (elm instanceof TableElm) {
                     TableElm table = (TableElm) elm;
-                    if (!firstTable) sb.append(',');
+                    if (!firstTable) meta.append(',');
                     firstTable = false;
-                    appendSingleTableSnapshot(sb, table);
+                    appendSingleTableSnapshot(meta, values, table);
                     continue;
                 }
                 if (elm instanceof EquationTableElm) {
                     EquationTableElm eqTable = (EquationTableElm) elm;
-                    if (!firstTable) sb.append(',');
+                    if (!firstTable) meta.append(',');
                     firstTable = false;
-                    appendEquationTableSnapshot(sb, eqTable);
+                    appendEquationTableSnapshot(meta, values, eqTable);
                 }
             }
         }
 
-        sb.append(']');
+        meta.append(']');
     }
 
-    private static void appendEquationTableSnapshot(StringBuilder sb, EquationTableElm table) {
+    private static void appendEquationTableSnapshot(StringBuilder sb, Channel values, EquationTableElm table) {
         sb.append('{');
 
         String tableName = table.getTableName();
@@ -106,18 +135,9 @@ public final class InfoViewerLiveDataSerializer {
         }
         sb.append(']');
 
-        sb.append(",\"values\":[");
         for (int row = 0; row < rows; row++) {
-            if (row > 0) {
-                sb.append(',');
-            }
-            double value = table.getDisplayValue(row);
-            if (Double.isNaN(value) || Double.isInfinite(value)) {
-                value = 0.0;
-            }
-            sb.append('[').append(value).append(']');
+            values.add(finiteOrZero(table.getDisplayValue(row)));
         }
-        sb.append(']');
 
         sb.append(",\"labels\":[");
         for (int row = 0; row < rows; row++) {
@@ -149,7 +169,7 @@ public final class InfoViewerLiveDataSerializer {
         sb.append('}');
     }
 
-    private static void appendSingleTableSnapshot(StringBuilder sb, TableElm table) {
+    private static void appendSingleTableSnapshot(StringBuilder sb, Channel values, TableElm table) {
         sb.append('{');
 
         String tableName = table.getTableTitle();
@@ -189,29 +209,16 @@ public final class InfoViewerLiveDataSerializer {
         }
         sb.append(']');
 
-        sb.append(",\"values\":[");
         for (int row = 0; row < rows; row++) {
-            if (row > 0) {
-                sb.append(',');
-            }
-            sb.append('[');
             for (int col = 0; col < cols; col++) {
-                if (col > 0) {
-                    sb.append(',');
-                }
                 double value = 0.0;
                 TableColumn column = table.getColumn(col);
                 if (column != null) {
-                    value = table.getDisplayedTransactionValue(row, col);
-                    if (Double.isNaN(value) || Double.isInfinite(value)) {
-                        value = 0.0;
-                    }
+                    value = finiteOrZero(table.getDisplayedTransactionValue(row, col));
                 }
-                sb.append(value);
+                values.add(value);
             }
-            sb.append(']');
         }
-        sb.append(']');
 
         sb.append(",\"labels\":[");
         for (int row = 0; row < rows; row++) {
@@ -240,8 +247,9 @@ public final class InfoViewerLiveDataSerializer {
         sb.append('}');
     }
 
-    private static void appendLiveSankeysJson(StringBuilder sb, CirSim sim) {
-        sb.append(",\"sankeys\":[");
+    private static String buildSankeysJson(CirSim sim) {
+        StringBuilder sb = new StringBuilder();
+        sb.append('[');
         boolean first = true;
         if (sim.elmList != null) {
             for (int i = 0; i < sim.elmList.size(); i++) {
@@ -259,10 +267,11 @@ public final class InfoViewerLiveDataSerializer {
             }
         }
         sb.append(']');
+        return sb.toString();
     }
 
-    private static void appendLiveScopesJson(StringBuilder sb, CirSim sim) {
-        sb.append(",\"scopes\":[");
+    private static void appendLiveScopes(StringBuilder meta, Channel values, CirSim sim) {
+        meta.append(",\"scopes\":[");
         boolean firstScope = true;
         if (sim.scopes != null) {
             for (int i = 0; i < sim.scopeCount; i++) {
@@ -276,7 +285,7 @@ public final class InfoViewerLiveDataSerializer {
                 }
 
                 if (!firstScope) {
-                    sb.append(',');
+                    meta.append(',');
                 }
                 firstScope = false;
 
@@ -285,44 +294,37 @@ public final class InfoViewerLiveDataSerializer {
                     scopeName = "Scope " + (i + 1);
                 }
 
-                sb.append("{\"name\":\"").append(escapeJson(scopeName)).append("\"");
-                sb.append(",\"traces\":[");
+                meta.append("{\"name\":\"").append(escapeJson(scopeName)).append("\"");
+                meta.append(",\"traces\":[");
                 boolean firstTrace = true;
                 for (int p = 0; p < visiblePlotCount; p++) {
                     CircuitElm plotElm = scope.getVisiblePlotElement(p);
                     if (plotElm == null) {
                         continue;
                     }
-                    if (!firstTrace) {
-                        sb.append(',');
-                    }
-                    firstTrace = false;
-
                     String traceName = scope.getVisiblePlotText(p);
                     if (traceName == null || traceName.trim().isEmpty()) {
                         traceName = "Trace " + (p + 1);
                     }
-                    double value = scope.getVisiblePlotLastValue(p);
-                    if (Double.isNaN(value) || Double.isInfinite(value)) {
-                        value = 0.0;
-                    }
-                    sb.append("{\"name\":\"").append(escapeJson(traceName)).append("\",\"value\":").append(value).append("}");
+                    appendName(meta, traceName, firstTrace);
+                    firstTrace = false;
+                    values.add(finiteOrZero(scope.getVisiblePlotLastValue(p)));
                 }
-                sb.append("]}");
+                meta.append("]}");
             }
         }
-        sb.append(']');
+        meta.append(']');
     }
 
-    private static boolean appendLiveVar(StringBuilder sb, String name, double value, boolean first) {
-        if (name == null || name.isEmpty() || Double.isNaN(value) || Double.isInfinite(value)) {
-            return first;
-        }
+    private static void appendName(StringBuilder sb, String name, boolean first) {
         if (!first) {
             sb.append(',');
         }
-        sb.append('"').append(escapeJson(name)).append('"').append(':').append(value);
-        return false;
+        sb.append('"').append(escapeJson(name)).append('"');
+    }
+
+    private static double finiteOrZero(double value) {
+        return Double.isNaN(value) || Double.isInfinite(value) ? 0.0 : value;
     }
 
     private static String escapeJson(String text) {
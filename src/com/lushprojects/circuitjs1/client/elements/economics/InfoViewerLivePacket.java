@@ -0,0 +1,41 @@
+/*
+    Copyright (C) Paul Falstad and Iain Sharp
+
+    This file is part of CircuitJS1.
+*/
+
+package com.lushprojects.circuitjs1.client.elements.economics;
+
+/**
+ * One live update for info viewer windows, split into metadata and numbers.
+ *
+ * {@link #metaJson} holds only names and labels (variable names, table
+ * headers and cell equations, scope trace names) and is identical from one
+ * update to the next until the model changes, so the sender can skip
+ * re-sending it. The numbers go in flat channels laid out in metadata order:
+ * <ul>
+ * <li>{@link #clock}: t, dt, running (1 or 0)</li>
+ * <li>{@link #vars}: one value per entry of {@code meta.vars}, NaN if unavailable</li>
+ * <li>{@link #tables}: each table's rows x cols values, row-major, tables in order</li>
+ * <li>{@link #scopes}: each scope's trace values, scopes in order</li>
+ * </ul>
+ */
+public final class InfoViewerLivePacket {
+    public final String metaJson;
+    public final double[] clock;
+    public final double[] vars;
+    public final double[] tables;
+    public final double[] scopes;
+    /** Sankey payloads stay JSON: their link labels embed formatted values. */
+    public final String sankeysJson;
+
+    InfoViewerLivePacket(String metaJson, double[] clock, double[] vars, double[] tables,
+            double[] scopes, String sankeysJson) {
+        this.metaJson = metaJson;
+        this.clock = clock;
+        this.vars = vars;
+        this.tables = tables;
+        this.scopes = scopes;
+        this.sankeysJson = sankeysJson;
+    }
+}
@@ -13,9 +13,12 @@ import com.lushprojects.circuitjs1.client.*;
 import com.lushprojects.circuitjs1.client.registry.HintRegistry;
 
 import java.util.ArrayList;
+import java.util.HashMap;
 import java.util.HashSet;
+import java.util.Iterator;
 import java.util.LinkedHashSet;
 import java.util.List;
+import java.util.Map;
 import java.util.Set;
 import com.lushprojects.circuitjs1.client.util.Locale;
 
@@ -26,6 +29,18 @@ public final class InfoViewerTableMarkdown {
     private static final String SANKEY_COMMENT =
         "<!-- Replace 'Transaction_Flow_Matrix' with the name of a table element in your circuit -->\n\n";
 
+    private static final class CachedTable {
+        int version;
+        int hintVersion;
+        int pass;
+        String markdown;
+    }
+
+    private static final HashMap<CircuitElm, CachedTable> tableCache = new HashMap<CircuitElm, CachedTable>();
+    private static int cachePass;
+    private static int cacheHits;
+    private static int cacheMisses;
+
     private InfoViewerTableMarkdown() {
     }
 
@@ -39,6 +54,7 @@ public final class InfoViewerTableMarkdown {
             return "No circuit loaded.";
         }
 
+        cachePass++;
         StringBuilder md = new StringBuilder();
         md.append("# Circuit Tables Overview\n\n");
 
@@ -67,7 +83,7 @@ public final class InfoViewerTableMarkdown {
         if (!godlyTables.isEmpty()) {
             md.append("## Balance Sheets (Godly Tables)\n\n");
             for (GodlyTableElm table : godlyTables) {
-                md.append(formatBalanceTable(table));
+                md.append(tableMarkdown(table));
                 md.append("\n");
             }
         }
@@ -75,7 +91,7 @@ public final class InfoViewerTableMarkdown {
         if (!sfcTables.isEmpty()) {
             md.append("## SFC Transaction Matrices\n\n");
             for (SFCTableElm table : sfcTables) {
-                md.append(formatSFCTable(table));
+                md.append(tableMarkdown(table));
                 md.append("\n");
             }
         }
@@ -83,7 +99,7 @@ public final class InfoViewerTableMarkdown {
         if (!ctmTables.isEmpty()) {
             md.append("## Current Transactions Matrices\n\n");
             for (CurrentTransactionsMatrixElm matrix : ctmTables) {
-                md.append(formatTransactionMatrix(matrix));
+                md.append(tableMarkdown(matrix));
                 md.append("\n");
             }
         }
@@ -91,7 +107,7 @@ public final class InfoViewerTableMarkdown {
         if (!otherTables.isEmpty()) {
             md.append("## Other Tables\n\n");
             for (TableElm table : otherTables) {
-                md.append(formatGenericTable(table));
+                md.append(tableMarkdown(table));
                 md.append("\n");
             }
         }
@@ -99,7 +115,7 @@ public final class InfoViewerTableMarkdown {
         if (!equationTables.isEmpty()) {
             md.append("## Equation Tables\n\n");
             for (EquationTableElm table : equationTables) {
-                md.append(formatEquationTable(table));
+                md.append(tableMarkdown(table));
                 md.append("\n");
             }
         }
@@ -109,9 +125,70 @@ public final class InfoViewerTableMarkdown {
             md.append("*No tables found in the current circuit.*\n");
         }
 
+        pruneTableCache();
         return md.toString();
     }
 
+    /**
+     * Markdown for one table, reused while the table's content version and the
+     * hint registry version are unchanged. Live values are not part of this
+     * text (the viewer patches them in place), so running the simulation
+     * does not invalidate it.
+     */
+    private static String tableMarkdown(CircuitElm elm) {
+        CachedTable e = tableCache.get(elm);
+        int hintVersion = HintRegistry.getVersion();
+        if (e != null && e.version == elm.getContentVersion() && e.hintVersion == hintVersion) {
+            e.pass = cachePass;
+            cacheHits++;
+            return e.markdown;
+        }
+        cacheMisses++;
+        String markdown;
+        if (elm instanceof EquationTableElm) {
+            markdown = formatEquationTable((EquationTableElm) elm);
+        } else if (elm instanceof CurrentTransactionsMatrixElm) {
+            markdown = formatTransactionMatrix((CurrentTransactionsMatrixElm) elm);
+        } else if (elm instanceof SFCTableElm) {
+            markdown = formatSFCTable((SFCTableElm) elm);
+        } else if (elm instanceof GodlyTableElm) {
+            markdown = formatBalanceTable((GodlyTableElm) elm);
+        } else {
+            markdown = formatGenericTable((TableElm) elm);
+        }
+        if (e == null) {
+            e = new CachedTable();
+            tableCache.put(elm, e);
+        }
+        e.version = elm.getContentVersion();
+        e.hintVersion = hintVersion;
+        e.pass = cachePass;
+        e.markdown = markdown;
+        return markdown;
+    }
+
+    /** Drop tables that were not part of the last overview (deleted elements). */
+    private static void pruneTableCache() {
+        Iterator<Map.Entry<CircuitElm, CachedTable>> it = tableCache.entrySet().iterator();
+        while (it.hasNext()) {
+            if (it.next().getValue().pass != cachePass) {
+                it.remove();
+            }
+        }
+    }
+
+    static int getTableCacheHitCount() {
+        return cacheHits;
+    }
+
+    static int getTableCacheMissCount() {
+        return cacheMisses;
+    }
+
+    static int getTableCacheSize() {
+        return tableCache.size();
+    }
+
     /**
      * Generate fenced circuit blocks for each table so the info viewer can mount live table widgets.
      */
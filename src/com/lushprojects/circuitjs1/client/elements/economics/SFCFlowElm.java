@@ -401,9 +401,9 @@ public class SFCFlowElm extends CircuitElm {
         
         // Draw current source symbol (circle with stroke)
         int radius = 8;
-        g.context.beginPath();
-        g.context.arc(midPoint.x, midPoint.y, radius, 0, 2 * Math.PI);
-        g.context.stroke();
+        g.beginPath();
+        g.arc(midPoint.x, midPoint.y, radius, 0, 2 * Math.PI);
+        g.stroke();
         
         // Draw flow name above
         g.setColor(whiteColor);
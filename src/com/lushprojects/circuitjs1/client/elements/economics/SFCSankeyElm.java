@@ -213,7 +213,7 @@ public class SFCSankeyElm extends CircuitElm {
         
         // Draw background
         g.setColor("#ffffff");
-        g.context.fillRect(x, y, drawWidth, drawHeight);
+        g.fillRect(x, y, drawWidth, drawHeight);
         
         // Draw border
         if (needsHighlight()) {
@@ -221,7 +221,7 @@ public class SFCSankeyElm extends CircuitElm {
         } else {
             g.setColor("#cccccc");
         }
-        g.context.strokeRect(x, y, drawWidth, drawHeight);
+        g.strokeRect(x, y, drawWidth, drawHeight);
         
         // Draw the Sankey
         sankeyRenderer.draw(g, x, y, drawWidth, drawHeight);
@@ -240,7 +240,7 @@ public class SFCSankeyElm extends CircuitElm {
         
         // Draw background
         g.setColor("#ffffff");
-        g.context.fillRect(x, y, drawWidth, drawHeight);
+        g.fillRect(x, y, drawWidth, drawHeight);
         
         // Draw border
         if (needsHighlight()) {
@@ -248,15 +248,15 @@ public class SFCSankeyElm extends CircuitElm {
         } else {
             g.setColor("#cccccc");
         }
-        g.context.strokeRect(x, y, drawWidth, drawHeight);
+        g.strokeRect(x, y, drawWidth, drawHeight);
         
         // Draw message
         g.setColor("#888888");
-        g.context.setFont("12px sans-serif");
+        g.setFontName("12px sans-serif");
         String msg = "Sankey Diagram";
         g.drawString(msg, x + 10, y + 20);
         
-        g.context.setFont("10px sans-serif");
+        g.setFontName("10px sans-serif");
         if (sourceTableName != null && !sourceTableName.isEmpty()) {
             g.drawString("Table: " + sourceTableName, x + 10, y + 40);
             g.drawString("(not found)", x + 10, y + 55);
@@ -336,6 +336,7 @@ public class SFCSankeyElm extends CircuitElm {
     
     @Override
     public void setEditValue(int n, EditInfo ei) {
+        bumpContentVersion();
         if (n == 0) {
             sourceTableName = ei.textf.getText().trim();
             sourceTable = null;  // Force re-find
@@ -301,9 +301,9 @@ protected void startIteration() {
         int radius = 15;
         // Draw stock outline (use context.arc for stroke)
         setVoltageColor(g, volts[0]);
-        g.context.beginPath();
-        g.context.arc(x, y, radius, 0, 2 * Math.PI);
-        g.context.stroke();
+        g.beginPath();
+        g.arc(x, y, radius, 0, 2 * Math.PI);
+        g.stroke();
         
         // Draw capacitor symbol inside (showing stock nature)
         int capY = y;
@@ -659,6 +659,7 @@ public class SFCTableElm extends TableElm {
     
     @Override
     public void setEditValue(int n, EditInfo ei) {
+        bumpContentVersion();
         if (n == 0) {
             tableTitle = ei.textf.getText();
         } else if (n == 1) {
@@ -63,6 +63,9 @@ public class StockFlowRegistry {
     // Synchronization guard to prevent infinite recursion
     private static Set<TableElm> currentlySynchronizing = new HashSet<TableElm>();
 
+    // Bumped on every registration change so callers can cache stock lists
+    private static int version;
+
     private static TableElm asTableElm(StockTableView table) {
         if (table instanceof TableElm) {
             return (TableElm) table;
@@ -82,6 +85,7 @@ public class StockFlowRegistry {
         List<StockTableView> tables = stockToTables.get(stockName);
         if (!tables.contains(table)) {
             tables.add(table);
+            version++;
             invalidateCache(stockName); // Cache is now stale
         }
     }
@@ -92,6 +96,7 @@ public class StockFlowRegistry {
     public static void unregisterStock(String stockName, StockTableView table) {
         if (stockToTables.containsKey(stockName)) {
             stockToTables.get(stockName).remove(table);
+            version++;
             invalidateCache(stockName);
         }
     }
@@ -110,6 +115,9 @@ public class StockFlowRegistry {
         for (String stock : stocksToRemove) {
             invalidateCache(stock);
         }
+        if (!stocksToRemove.isEmpty()) {
+            version++;
+        }
     }
     
     /**
@@ -127,6 +135,14 @@ public class StockFlowRegistry {
         stockToTables.clear();
         mergedRowsCache.clear();
         currentlySynchronizing.clear();
+        version++;
+    }
+
+    /**
+     * Registration version, bumped whenever a stock is registered or unregistered
+     */
+    public static int getVersion() {
+        return version;
     }
     
     /**
@@ -176,21 +192,27 @@ public class StockFlowRegistry {
         for (int i = 0; i < sim.elmList.size(); i++) {
             CircuitElm elm = sim.elmList.elementAt(i);
             if (elm instanceof EquationTableElm) {
-                EquationTableElm eqn = (EquationTableElm) elm;
-                String[] names = eqn.getOutputNames();
-                for (String name : names) {
-                    if (name != null && !name.trim().isEmpty()) {
-                        String trimmed = name.trim();
-                        if (!EquationTableElm.isCommentRowName(trimmed)) {
-                            outputs.add(trimmed);
-                        }
-                    }
-                }
+                collectEquationOutputNames((EquationTableElm) elm, outputs);
             }
         }
         return outputs;
     }
     
+    /**
+     * Add one equation table's output names (excluding comment rows) to outputs
+     */
+    public static void collectEquationOutputNames(EquationTableElm eqn, Set<String> outputs) {
+        String[] names = eqn.getOutputNames();
+        for (String name : names) {
+            if (name != null && !name.trim().isEmpty()) {
+                String trimmed = name.trim();
+                if (!EquationTableElm.isCommentRowName(trimmed)) {
+                    outputs.add(trimmed);
+                }
+            }
+        }
+    }
+    
     /**
      * Extract all variable names (identifiers) from all table cell equations
      * Returns variables that appear in any cell equation across all tables
@@ -208,27 +230,31 @@ public class StockFlowRegistry {
         for (int i = 0; i < sim.elmList.size(); i++) {
             CircuitElm elm = sim.elmList.elementAt(i);
             if (elm instanceof TableElm) {
-                TableElm table = (TableElm) elm;
-                
-                // Get dimensions
-                int rows = table.getRows();
-                int cols = table.getCols();
-                
-                // Extract variables from each cell equation
-                for (int row = 0; row < rows; row++) {
-                    for (int col = 0; col < cols; col++) {
-                        String equation = table.getCellEquation(row, col);
-                        if (equation != null && !equation.trim().isEmpty()) {
-                            extractVariablesFromEquation(equation, variables);
-                        }
-                    }
-                }
+                collectCellEquationVariables((TableElm) elm, variables);
             }
         }
         
         return variables;
     }
     
+    /**
+     * Add the variable names referenced by one table's cell equations to variables
+     */
+    public static void collectCellEquationVariables(TableElm table, Set<String> variables) {
+        int rows = table.getRows();
+        int cols = table.getCols();
+        
+        // Extract variables from each cell equation
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < cols; col++) {
+                String equation = table.getCellEquation(row, col);
+                if (equation != null && !equation.trim().isEmpty()) {
+                    extractVariablesFromEquation(equation, variables);
+                }
+            }
+        }
+    }
+    
     /**
      * Extract variable names from a single equation string
      * Adds found variables to the provided set
@@ -801,6 +827,11 @@ public class StockFlowRegistry {
             }
         }
         
+        // synchronization may rewrite any of these; stale exported text must go
+        for (TableElm table : affectedTables) {
+            table.bumpContentVersion();
+        }
+
         // Log synchronization action
         if (affectedTables.size() > 1) {
             SRTlog("Synchronizing " + affectedTables.size() +
@@ -1053,6 +1084,7 @@ public class StockFlowRegistry {
                 tables.add(null);
             }
             stockToTables.put(stockName, tables);
+            version++;
         }
 
         public static void seedMergedRowsCache(String stockName, LinkedHashSet<String> rows) {
@@ -192,7 +192,7 @@ public class StockMasterElm extends ChipElm {
         setBbox(tableX, tableY, tableX + tableWidth, tableY + tableHeight);
         
         // Draw background
-        Color bgColor = CirSim.getInstance().printableCheckItem.getState() ? 
+        Color bgColor = CirSim.getInstance().isPrintableEnabledForExport() ? 
             new Color(240, 240, 240) : new Color(30, 30, 30);
         g.setColor(bgColor);
         g.fillRect(tableX, tableY, tableWidth, tableHeight);
@@ -262,7 +262,7 @@ public class StockMasterElm extends ChipElm {
      * Get voltage color for text display
      */
     private Color getTextVoltageColor(double volts) {
-        if (!CirSim.getInstance().voltsCheckItem.getState()) {
+        if (!CirSim.getInstance().isVoltsEnabledForExport()) {
             return CircuitElm.whiteColor;
         }
         int c = (int) ((volts + CircuitElm.voltageRange) * (CircuitElm.colorScaleCount - 1) /
@@ -280,8 +280,8 @@ public class StockMasterElm extends ChipElm {
     private void drawLeftText(Graphics g, String text, int x, int y) {
         if (text == null || text.isEmpty()) return;
         g.save();
-        g.context.setTextBaseline("middle");
-        g.context.setTextAlign("left");
+        g.setTextBaseline("middle");
+        g.setTextAlign("left");
         g.drawString(text, x, y);
         g.restore();
     }
@@ -294,7 +294,7 @@ public class StockMasterElm extends ChipElm {
             return text;
         }
         
-        double fullWidth = g.context.measureText(text).getWidth();
+        double fullWidth = g.measureText(text);
         
         if (fullWidth <= maxWidth) {
             return text;
@@ -308,7 +308,7 @@ public class StockMasterElm extends ChipElm {
         while (left <= right) {
             int mid = (left + right) / 2;
             String candidate = text.substring(0, mid) + "..";
-            double candidateWidth = g.context.measureText(candidate).getWidth();
+            double candidateWidth = g.measureText(candidate);
             
             if (candidateWidth <= maxWidth) {
                 bestFit = candidate;
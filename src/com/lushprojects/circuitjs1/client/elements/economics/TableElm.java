@@ -83,7 +83,7 @@ public class TableElm extends ChipElm implements TableContentView {
         initTable();
         setupPins();
         allocNodes();
-        setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+        setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
     }
 
     // File loading constructor - NEVER auto-increments
@@ -215,6 +215,7 @@ public class TableElm extends ChipElm implements TableContentView {
      */
     public void updateRowData(int newRowCount, String[] newRowDescriptions, 
                       String[][] newCellEquations) {
+        bumpContentVersion();
         rows = newRowCount;
         rowDescriptions = newRowDescriptions;
         
@@ -241,6 +242,7 @@ public class TableElm extends ChipElm implements TableContentView {
      * Simple wrapper - all logic is in StockFlowRegistry
      */
     public void synchronizeWithRelatedTables() {
+        bumpContentVersion();
         StockFlowRegistry.synchronizeRelatedTables(this);
     }
     
@@ -284,6 +286,7 @@ public class TableElm extends ChipElm implements TableContentView {
         
     // Public methods for managing equations
     public void setCellEquation(int row, int col, String equation) {
+        bumpContentVersion();
         if (isValidCell(row, col) && columns != null && col < columns.size()) {
             columns.get(col).setCellEquation(row, equation != null ? equation : "");
             compileEquation(row, col, columns.get(col).getCellEquation(row));
@@ -881,6 +884,7 @@ public class TableElm extends ChipElm implements TableContentView {
 
     @Override
     public void setEditValue(int n, EditInfo ei) {
+        bumpContentVersion();
         if (n == 0) {
             tableTitle = ei.textf.getText();
         } else if (n == 1) {
@@ -920,6 +924,7 @@ public class TableElm extends ChipElm implements TableContentView {
     
     // Resize table method for use by TableEditDialog
     public void resizeTable(int newRows, int newCols) {
+        bumpContentVersion();
         // Delegate data resizing to TableDataManager
         dataManager.resizeTable(newRows, newCols);
         
@@ -972,6 +977,7 @@ public class TableElm extends ChipElm implements TableContentView {
      * NOTE: Tables that return false from shouldRegisterStocks() skip registration
      */
     public void setColumnHeader(int col, String header) {
+        bumpContentVersion();
         if (col < 0 || col >= columns.size()) return;
         
         TableColumn column = columns.get(col);
@@ -1076,6 +1082,7 @@ public class TableElm extends ChipElm implements TableContentView {
     }
     
     public void setInitialConditionValue(int col, double value) {
+        bumpContentVersion();
         if (col >= 0 && col < columns.size()) {
             columns.get(col).setInitialValue(value);
             // Note: A_L_E initial values are calculated in TableRenderer, not stored
@@ -1093,6 +1100,7 @@ public class TableElm extends ChipElm implements TableContentView {
     }
     
     public void setColumnType(int col, ColumnType type) {
+        bumpContentVersion();
         if (col >= 0 && col < columns.size()) {
             columns.get(col).setType(type);
         }
@@ -1109,6 +1117,7 @@ public class TableElm extends ChipElm implements TableContentView {
     }
     
     public void setTableTitle(String title) {
+        bumpContentVersion();
         this.tableTitle = (title != null) ? title : "Table";
     }
     
@@ -1118,6 +1127,7 @@ public class TableElm extends ChipElm implements TableContentView {
     }
     
     public void setPriority(int priority) {
+        bumpContentVersion();
         this.priority = priority;
     }
 
@@ -1189,6 +1199,7 @@ public class TableElm extends ChipElm implements TableContentView {
     }
     
     public void setRowDescription(int row, String description) {
+        bumpContentVersion();
         if (row >= 0 && row < rows) {
             if (rowDescriptions == null || rowDescriptions.length != rows) {
                 rowDescriptions = new String[rows];
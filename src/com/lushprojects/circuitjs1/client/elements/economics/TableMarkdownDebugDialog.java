@@ -185,7 +185,11 @@ class TableMarkdownDebugDialog {
      * Refresh the markdown content
      */
     public void refresh() {
-        textArea.setText(generateMarkdownContent());
+        // leave the text area alone when nothing changed so scroll and selection survive
+        String markdown = generateMarkdownContent();
+        if (!markdown.equals(textArea.getText())) {
+            textArea.setText(markdown);
+        }
     }
     
     /**
@@ -14,7 +14,6 @@ import com.lushprojects.circuitjs1.client.util.*;
 
 import com.google.gwt.canvas.client.Canvas;
 import com.google.gwt.canvas.dom.client.Context2d;
-import com.google.gwt.core.client.Duration;
 import com.lushprojects.circuitjs1.client.elements.economics.TableColumn.ColumnType;
 
 /**
@@ -74,6 +73,29 @@ public class TableRenderer {
     private boolean skipNonDataRowGridLinesInDynamicPass = false;
     private double renderTimeEmaMs = 0;
     private boolean hasRenderTimingSample = false;
+
+    // Cell layer: data cell text lives in its own offscreen canvas, and each frame only
+    // cells whose value, equation or text color changed are cleared and redrawn. The rest
+    // is blitted, so formatting and text drawing scale with the number of changed values.
+    private Canvas cellLayerCanvas;
+    private Context2d cellLayerCtx;
+    private Graphics cellLayerGraphics;
+    private boolean cellLayerValid = false;
+    private int cellLayerWidth = 0;
+    private int cellLayerHeight = 0;
+    private float cellLayerScale = -1;
+    private int cellLayerRows = -1;
+    private int cellLayerCols = -1;
+    private int cellLayerOffsetY = -1;
+    private int cellLayerCellWidth = -1;
+    private int cellLayerMode = -1;
+    private int cellLayerFormatKey = -1;
+    private boolean cellLayerPrintable = false;
+    private String cellLayerUnits;
+    private double[] cellLayerValues;
+    private String[] cellLayerEquations;
+    private Color[] cellLayerColors;
+    private int cellsRedrawnLastFrame = 0;
     
     public TableRenderer(TableElm table) {
         this.table = table;
@@ -99,10 +121,11 @@ public class TableRenderer {
      */
     public void invalidateCache() {
         cacheValid = false;
+        cellLayerValid = false;
     }
 
     private boolean isVoltsVisible() {
-        return CirSim.getInstance() != null && CirSim.getInstance().voltsCheckItem != null && CirSim.getInstance().voltsCheckItem.getState();
+        return CirSim.getInstance() != null && CirSim.getInstance().isVoltsEnabledForExport();
     }
 
     private float getRenderScale() {
@@ -551,7 +574,7 @@ public class TableRenderer {
 
     // Helper methods for modern styling colors based on theme
     private boolean isPrintable() {
-        return CirSim.getInstance().printableCheckItem.getState();
+        return CirSim.getInstance().isPrintableEnabledForExport();
     }
     
     private Color getHeaderBgColor() {
@@ -603,7 +626,7 @@ public class TableRenderer {
         if (Math.abs(value) < 0.01) {
             value = 0.0;
         }
-        return CircuitElm.getUnitText(value, units);
+        return CircuitElm.getCachedUnitText(value, units);
     }
     
     /**
@@ -688,7 +711,7 @@ public class TableRenderer {
      * Protected to allow subclasses (CurrentTransactionsMatrixRenderer) to reuse this logic
      */
     Color getTextVoltageColor(double volts) {
-        if (!CirSim.getInstance().voltsCheckItem.getState()) {
+        if (!CirSim.getInstance().isVoltsEnabledForExport()) {
             return CircuitElm.whiteColor;
         }
         int c = (int) ((volts + CircuitElm.voltageRange) * (CircuitElm.colorScaleCount - 1) /
@@ -705,7 +728,7 @@ public class TableRenderer {
      * Uses cached canvas for static parts (backgrounds, grid lines) when available.
      */
     public void draw(Graphics g) {
-        double renderStartMs = Duration.currentTimeMillis();
+        double renderStartMs = System.currentTimeMillis();
         TableDimensions dims = calculateTableDimensions();
         
         // Refresh the renderer's numeric cache every draw so displayed values
@@ -720,7 +743,7 @@ public class TableRenderer {
         if (usingCache) {
             onCacheHit();
             // Blit cached background/grid to main canvas
-            g.context.drawImage(backgroundLayerCtx.getCanvas(), dims.tableX, dims.tableY, dims.tableWidth, dims.tableHeight);
+            g.drawLayer(backgroundLayerCtx, dims.tableX, dims.tableY, dims.tableWidth, dims.tableHeight);
             
             // Draw selection/error border on top if needed (dynamic - not cached)
             boolean selected = table.needsHighlight();
@@ -732,8 +755,11 @@ public class TableRenderer {
             drawTableBackground(g, dims);
         }
 
-        // Draw components in order (text, values - skips row backgrounds when using cache)
+        // Draw components in order (text, values - skips row backgrounds when using cache).
+        // Grid lines drawn in the dynamic pass are batched into one stroke per color.
+        g.startBatch();
         drawComponentsInOrder(g, dims, usingCache);
+        g.endBatch();
         
         // Draw border if not using cache (cache already has non-selected border)
         if (!usingCache) {
@@ -743,7 +769,7 @@ public class TableRenderer {
         // Draw pins
         drawPins(g);
 
-        double renderMs = Duration.currentTimeMillis() - renderStartMs;
+        double renderMs = System.currentTimeMillis() - renderStartMs;
         if (!hasRenderTimingSample) {
             renderTimeEmaMs = renderMs;
             hasRenderTimingSample = true;
@@ -763,7 +789,7 @@ public class TableRenderer {
         }
         String timingText = (usingCache ? "C " : "N ") +
             formatTimingMs(renderMs) + "ms (" +
-            formatTimingMs(renderTimeEmaMs) + "ms) R:" + cacheRebuildCount;
+            formatTimingMs(renderTimeEmaMs) + "ms) R:" + cacheRebuildCount + " D:" + cellsRedrawnLastFrame;
         g.setFont(PERF_FONT);
         g.setColor(isPrintable() ? new Color(40, 40, 40) : new Color(170, 255, 210));
         g.drawString(timingText, dims.tableX + 34, dims.tableY + 10);
@@ -858,7 +884,7 @@ public class TableRenderer {
             g.fillRoundRect(dims.tableX + 1, dims.tableY + 1, dims.tableWidth - 2, dims.tableHeight - 2, CORNER_RADIUS);
         } else {
             // Legacy style
-            Color bgColor = CirSim.getInstance().printableCheckItem.getState() ? 
+            Color bgColor = CirSim.getInstance().isPrintableEnabledForExport() ? 
                 new Color(230, 230, 230) : new Color(40, 40, 40);
             g.setColor(bgColor);
             g.fillRect(dims.tableX + 1, dims.tableY + 1, dims.tableWidth - 2, dims.tableHeight - 2);
@@ -1241,6 +1267,7 @@ public class TableRenderer {
      */
     public void resetCache() {
         cacheValid = false;
+        cellLayerValid = false;
     }
     
     private void drawTitle(Graphics g, int offsetY) {
@@ -1555,6 +1582,11 @@ public class TableRenderer {
         // Use the passed offsetY directly - no need to recalculate
         int baseY = offsetY;
 
+        // The cell layer is only used alongside the static cache; without it (headless,
+        // cache disabled) cells are drawn directly every frame.
+        boolean useCellLayer = skipDataRowGridLinesInDynamicPass && ensureCellLayerValid(offsetY, cellWidthPixels);
+        cellsRedrawnLastFrame = 0;
+
         for (int row = 0; row < table.rows; row++) {
             int cellY = tableY + baseY + row * (table.cellHeight + table.cellSpacing);
             
@@ -1599,39 +1631,16 @@ public class TableRenderer {
                 
                 // Check if this is an A-L-E column (computed, no equation)
                 boolean isALECol = hasALEColumn() && col == table.getCols() - 1;
-                
-                // Display equation and voltage in cell (or just voltage for A-L-E)
                 String equation = (col < table.columns.size()) ? table.columns.get(col).getCellEquation(row) : "";
                 if (isALECol) {
                     voltage = aleRowValue;
-                    // A-L-E column: ALWAYS display only the computed value (no equation)
-                    // Color blue if non-zero (indicates accounting discrepancy), otherwise use voltage color
-                    if (shouldColorComputedColumnBlue(col, voltage)) {
-                        g.setColor(Color.blue);
-                    } else {
-                        g.setColor(getTextVoltageColor(voltage));
-                    }
-                    String voltageText = formatDisplayValue(voltage, table.tableUnits);
-                    table.drawCenteredText(g, voltageText, cellX + colWidth/2, cellY + table.cellHeight/2, true);
-                } else if (equation != null && !equation.trim().isEmpty()) {
-                    // Regular cell: display based on showCellValues mode (0=Equation, 1=Equation:Value, 2=Value)
-                    g.setColor(getTextVoltageColor(voltage));
-                    String displayText;
-                    
-                    if (table.showCellValues == 2) {
-                        // Mode 2: Show just "value"
-                        displayText = formatDisplayValue(voltage, table.tableUnits);
-                    } else if (table.showCellValues == 1) {
-                        // Mode 1: Show "equation: value"
-                        String equation_truncated = truncateEquation(equation, g);
-                        String voltageText = formatDisplayValue(voltage, table.tableUnits);
-                        displayText = equation_truncated + ": " + voltageText;
-                    } else {
-                        // Mode 0 (default): Show just "equation"
-                        displayText = truncateEquation(equation, g);
-                    }
-                    
-                    table.drawCenteredText(g, displayText, cellX + colWidth/2, cellY + table.cellHeight/2, true);
+                }
+                Color textColor = getDataCellTextColor(col, voltage, isALECol);
+
+                if (useCellLayer) {
+                    updateCellLayerCell(row, col, voltage, equation, isALECol, textColor, cellX, cellY, colWidth);
+                } else {
+                    drawDataCell(g, voltage, equation, isALECol, textColor, cellX, cellY, colWidth);
                 }
             }
             
@@ -1641,6 +1650,140 @@ public class TableRenderer {
                 drawRowGridLine(g, rowY - tableY, tableX, rowDescColWidth, cellWidthPixels, false);
             }
         }
+
+        if (useCellLayer) {
+            g.drawLayer(cellLayerCtx, tableX, tableY, cellLayerWidth, cellLayerHeight);
+        }
+    }
+
+    private Color getDataCellTextColor(int col, double voltage, boolean isALECol) {
+        // A-L-E column: blue if non-zero (indicates accounting discrepancy), otherwise use voltage color
+        if (isALECol && shouldColorComputedColumnBlue(col, voltage)) {
+            return Color.blue;
+        }
+        return getTextVoltageColor(voltage);
+    }
+
+    /**
+     * Draw the text of one data cell.
+     */
+    private void drawDataCell(Graphics g, double voltage, String equation, boolean isALECol, Color textColor,
+                              int cellX, int cellY, int colWidth) {
+        if (isALECol) {
+            // A-L-E column: ALWAYS display only the computed value (no equation)
+            g.setColor(textColor);
+            String voltageText = formatDisplayValue(voltage, table.tableUnits);
+            table.drawCenteredText(g, voltageText, cellX + colWidth/2, cellY + table.cellHeight/2, true);
+        } else if (equation != null && !equation.trim().isEmpty()) {
+            // Regular cell: display based on showCellValues mode (0=Equation, 1=Equation:Value, 2=Value)
+            g.setColor(textColor);
+            String displayText;
+            
+            if (table.showCellValues == 2) {
+                // Mode 2: Show just "value"
+                displayText = formatDisplayValue(voltage, table.tableUnits);
+            } else if (table.showCellValues == 1) {
+                // Mode 1: Show "equation: value"
+                String equation_truncated = truncateEquation(equation, g);
+                String voltageText = formatDisplayValue(voltage, table.tableUnits);
+                displayText = equation_truncated + ": " + voltageText;
+            } else {
+                // Mode 0 (default): Show just "equation"
+                displayText = truncateEquation(equation, g);
+            }
+            
+            table.drawCenteredText(g, displayText, cellX + colWidth/2, cellY + table.cellHeight/2, true);
+        }
+    }
+
+    /**
+     * Make sure the cell layer matches the current table layout and display settings.
+     * Any mismatch clears the layer and marks every cell dirty.
+     */
+    private boolean ensureCellLayerValid(int offsetY, int cellWidthPixels) {
+        if (cellLayerCanvas == null) {
+            if (backgroundLayerCanvas == null) {
+                return false;
+            }
+            cellLayerCanvas = Canvas.createIfSupported();
+            if (cellLayerCanvas == null) {
+                return false;
+            }
+            cellLayerCtx = cellLayerCanvas.getContext2d();
+            cellLayerGraphics = new Graphics(cellLayerCtx);
+        }
+
+        int cols = table.getCols();
+        int formatKey = CircuitElm.getUnitTextFormatKey();
+        boolean printable = isPrintable();
+        String units = table.tableUnits;
+        if (cellLayerValid && cellLayerWidth == cachedWidth && cellLayerHeight == cachedHeight &&
+            cellLayerScale == cachedScale && cellLayerRows == table.rows && cellLayerCols == cols &&
+            cellLayerOffsetY == offsetY && cellLayerCellWidth == cellWidthPixels &&
+            cellLayerMode == table.showCellValues && cellLayerFormatKey == formatKey &&
+            cellLayerPrintable == printable && (units == null ? cellLayerUnits == null : units.equals(cellLayerUnits))) {
+            return true;
+        }
+
+        cellLayerCanvas.setCoordinateSpaceWidth((int) Math.ceil(cachedWidth * cachedScale));
+        cellLayerCanvas.setCoordinateSpaceHeight((int) Math.ceil(cachedHeight * cachedScale));
+        cellLayerCtx.setTransform(1, 0, 0, 1, 0, 0);
+        cellLayerCtx.clearRect(0, 0, cellLayerCanvas.getCoordinateSpaceWidth(), cellLayerCanvas.getCoordinateSpaceHeight());
+        cellLayerCtx.setTransform(cachedScale, 0, 0, cachedScale, 0, 0);
+
+        int cellCount = table.rows * cols;
+        if (cellLayerValues == null || cellLayerValues.length != cellCount) {
+            cellLayerValues = new double[cellCount];
+            cellLayerEquations = new String[cellCount];
+            cellLayerColors = new Color[cellCount];
+        }
+        // A null color never matches, so every cell is drawn on the next pass
+        for (int i = 0; i < cellCount; i++) {
+            cellLayerColors[i] = null;
+            cellLayerEquations[i] = null;
+        }
+
+        cellLayerWidth = cachedWidth;
+        cellLayerHeight = cachedHeight;
+        cellLayerScale = cachedScale;
+        cellLayerRows = table.rows;
+        cellLayerCols = cols;
+        cellLayerOffsetY = offsetY;
+        cellLayerCellWidth = cellWidthPixels;
+        cellLayerMode = table.showCellValues;
+        cellLayerFormatKey = formatKey;
+        cellLayerPrintable = printable;
+        cellLayerUnits = units;
+        cellLayerValid = true;
+        return true;
+    }
+
+    /**
+     * Redraw one cell into the cell layer if its value, equation or color changed.
+     */
+    private void updateCellLayerCell(int row, int col, double voltage, String equation, boolean isALECol,
+                                     Color textColor, int cellX, int cellY, int colWidth) {
+        int idx = row * cellLayerCols + col;
+        String lastEquation = cellLayerEquations[idx];
+        if (cellLayerColors[idx] == textColor && cellLayerValues[idx] == voltage &&
+            (lastEquation == equation || (lastEquation != null && lastEquation.equals(equation)))) {
+            return;
+        }
+        cellLayerValues[idx] = voltage;
+        cellLayerEquations[idx] = equation;
+        cellLayerColors[idx] = textColor;
+        cellsRedrawnLastFrame++;
+
+        // Layer pixels are table-relative; draw in circuit coordinates like the main canvas.
+        Graphics lg = cellLayerGraphics;
+        lg.save();
+        cellLayerCtx.translate(-table.getTableX(), -table.getTableY());
+        cellLayerCtx.clearRect(cellX, cellY, colWidth, table.cellHeight);
+        lg.clipRect(cellX, cellY, colWidth, table.cellHeight);
+        lg.setFont(CELL_FONT);
+        lg.setLetterSpacing(LETTER_SPACING);
+        drawDataCell(lg, voltage, equation, isALECol, textColor, cellX, cellY, colWidth);
+        lg.restore();
     }
     
     /**
@@ -1653,37 +1796,7 @@ public class TableRenderer {
      * @return Truncated text with ".." appended if truncation occurred
      */
     private String truncateText(String text, Graphics g, int maxWidth) {
-        if (text == null || text.isEmpty()) {
-            return text;
-        }
-        
-        // Measure actual width of the full text
-        double fullWidth = g.measureWidth(text);
-        
-        // If it fits, return as-is
-        if (fullWidth <= maxWidth) {
-            return text;
-        }
-        
-        // Binary search to find the optimal truncation point
-        int left = 1;
-        int right = text.length();
-        String bestFit = text.substring(0, Math.min(3, text.length())) + "..";
-        
-        while (left <= right) {
-            int mid = (left + right) / 2;
-            String candidate = text.substring(0, mid) + "..";
-            double candidateWidth = g.measureWidth(candidate);
-            
-            if (candidateWidth <= maxWidth) {
-                bestFit = candidate;
-                left = mid + 1;  // Try to fit more
-            } else {
-                right = mid - 1;  // Too wide, try shorter
-            }
-        }
-
-        return bestFit;
+        return g.truncateToWidth(text, maxWidth);
     }
     
     /**
@@ -24,7 +24,7 @@ public class ComparatorElm extends CompositeElm {
     public ComparatorElm(int xx, int yy) {
 	super(xx, yy, modelString, modelExternalNodes);
 	noDiagonal = true;
-	setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+	setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
     }
     
 
@@ -46,7 +46,7 @@ public class OpAmpElm extends CircuitElm {
 	    gbw = 1e6;
            flags = FLAG_GAIN; // need to do this before setSize()
 	    gain = 100000;
-           setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+           setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
 	}
 	public OpAmpElm(int xa, int ya, int xb, int yb, int f,
 			StringTokenizer st) {
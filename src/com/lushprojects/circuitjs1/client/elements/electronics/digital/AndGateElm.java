@@ -19,21 +19,10 @@
 
 package com.lushprojects.circuitjs1.client.elements.electronics.digital;
 
-import com.google.gwt.canvas.dom.client.Context2d;
 import com.lushprojects.circuitjs1.client.*;
 import com.lushprojects.circuitjs1.client.util.*;
 
-import jsinterop.annotations.JsMethod;
-import jsinterop.annotations.JsPackage;
-import jsinterop.annotations.JsType;
-
 public class AndGateElm extends GateElm {
-	@JsType(isNative = true, namespace = JsPackage.GLOBAL, name = "Object")
-	private interface Context2dNative {
-	    @JsMethod(name = "ellipse")
-	    void ellipse(double x, double y, double rx, double ry, double ro, double sa, double ea, boolean ccw);
-	}
-
 	public AndGateElm(int xx, int yy) { super(xx, yy); }
 	public AndGateElm(int xa, int ya, int xb, int yb, int f,
 			  StringTokenizer st) {
@@ -42,15 +31,15 @@ public class AndGateElm extends GateElm {
 	
 	String getGateText() { return "&"; }
 	
-	private void ellipse(Context2d g, double x, double y, double rx, double ry, double ro, double sa, double ea, boolean ccw) {
+	private void ellipse(Graphics g, double x, double y, double rx, double ry, double ro, double sa, double ea, boolean ccw) {
 	    if (rx >= 0 && ry >= 0)
-		((Context2dNative) (Object) g).ellipse(x, y, rx, ry, ro, sa, ea, ccw);
+		g.ellipse(x, y, rx, ry, ro, sa, ea, ccw);
 	}
 
 	void drawGatePolygon(Graphics g) {
 	    g.setLineWidth(3.0);
-	    g.context.beginPath();
-	    g.context.moveTo(gatePoly.xpoints[0], gatePoly.ypoints[0]);
+	    g.beginPath();
+	    g.moveTo(gatePoly.xpoints[0], gatePoly.ypoints[0]);
 	    double ang1 = -Math.PI/2 * sign(dx);
 	    double ang2 =  Math.PI/2 * sign(dx);
 	    boolean ccw = false;
@@ -62,10 +51,10 @@ public class AndGateElm extends GateElm {
 		rx = hs2;
 		ry = ww;
 	    }
-	    ellipse(g.context, gatePoly.xpoints[2], gatePoly.ypoints[2], rx, ry, 0, ang1, ang2, ccw);
-	    g.context.lineTo(gatePoly.xpoints[4], gatePoly.ypoints[4]);
-	    g.context.closePath();
-	    g.context.stroke();
+	    ellipse(g, gatePoly.xpoints[2], gatePoly.ypoints[2], rx, ry, 0, ang1, ang2, ccw);
+	    g.lineTo(gatePoly.xpoints[4], gatePoly.ypoints[4]);
+	    g.closePath();
+	    g.stroke();
 	    g.setLineWidth(1.0);
 	}
 	
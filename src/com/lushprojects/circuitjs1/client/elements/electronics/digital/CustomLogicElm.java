@@ -158,6 +158,39 @@ public class CustomLogicElm extends ChipElm {
     }
 
     protected void execute() {
+	CustomLogicRuleTable table = model.getRuleTable();
+	if (table == null || table.getPinSpan() > postCount || postCount > 31) {
+	    executeRules();
+	    return;
+	}
+	int j;
+	int word = 0;
+	int lastWord = 0;
+	for (j = 0; j != postCount; j++) {
+	    if (pins[j].value)
+		word |= 1 << j;
+	    if (lastValues[j])
+		lastWord |= 1 << j;
+	}
+	int rule = table.match(word, lastWord);
+	if (rule >= 0) {
+	    int out = table.getOutputBits(rule, word);
+	    int hiz = table.getHighImpedanceMask(rule);
+	    int n = table.getOutputCount(rule);
+	    for (j = 0; j != n; j++) {
+		highImpedance[j+inputCount] = (hiz & (1 << j)) != 0;
+		if ((hiz & (1 << j)) == 0)
+		    pins[j+inputCount].value = (out & (1 << j)) != 0;
+	    }
+	}
+
+	// save values for transition checking
+	for (j = 0; j != postCount; j++)
+	    lastValues[j] = pins[j].value;
+    }
+
+    // string interpreter, for rule sets CustomLogicRuleTable can't compile
+    private void executeRules() {
 	int i;
 	for (i = 0; i != model.rulesLeft.size(); i++) {
 	    // check for a match
@@ -54,14 +54,14 @@ public class DecimalDisplayElm extends ChipElm {
         g.save();
         g.setFont(new Font("SansSerif", 0, 15*csize));
         g.setColor(whiteColor);
-        g.context.setTextBaseline("middle");
+        g.setTextBaseline("middle");
         int i;
         int value = 0;
         for (i = 0; i != bitCount; i++)
             if (pins[i].value)
         	value |= 1<<i;
         String str = String.valueOf(value);
-        int w=(int)g.context.measureText(str).getWidth();
+        int w=(int)g.measureText(str);
         g.drawString(str, xl+5*csize-w/2, yl);
         g.restore();
     }
@@ -45,7 +45,7 @@ public abstract class GateElm extends CircuitElm {
 	    if (lastSchmitt)
 		flags |= FLAG_SCHMITT;
 	    
-	    setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+	    setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
 	}
 	GateElm(int xa, int ya, int xb, int yb, int f,
             StringTokenizer st) {
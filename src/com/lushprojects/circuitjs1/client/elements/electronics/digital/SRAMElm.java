@@ -27,8 +27,6 @@ import com.lushprojects.circuitjs1.client.*;
 import com.lushprojects.circuitjs1.client.io.SRAMLoadFile;
 import com.lushprojects.circuitjs1.client.util.*;
 
-import java.util.HashMap;
-
 import com.google.gwt.user.client.ui.Button;
 import com.google.gwt.user.client.ui.TextArea;
 
@@ -38,20 +36,23 @@ import com.google.gwt.user.client.ui.TextArea;
         private int internalNodes;
 	private int addressBits;
         private int dataBits;
-	private HashMap<Integer, Integer> map;
+	private static final int MAX_ADDRESS_BITS = 16;
+	private final PagedMemory memory = new PagedMemory(MAX_ADDRESS_BITS);
 	public static String contentsOverride = null;
+	// binary image read by SRAMLoadFile, applied as-is if the contents text is left unedited
+	private static int[] imageOverride = null;
+	private int[] stagedImage;
+	private String stagedImageText;
 
 	public SRAMElm(int xx, int yy) {
 	    super(xx, yy);
 	    addressBits = dataBits = 4;
-	    map = new HashMap<Integer, Integer>();
 	    setupPins();
 	}
 
 	public SRAMElm(int xa, int ya, int xb, int yb, int f,
 			    StringTokenizer st) {
 	    super(xa, ya, xb, yb, f, st);
-	    map = new HashMap<Integer, Integer>();
 	    addressBits = Integer.parseInt(st.nextToken());
 	    dataBits    = Integer.parseInt(st.nextToken());
 	    setupPins();
@@ -63,38 +64,33 @@ import com.google.gwt.user.client.ui.TextArea;
 		    if (a < 0)
 			break;
 		    int v = Integer.parseInt(st.nextToken());
-		    map.put(a, v);
+		    memory.put(a, v);
 		    while (true) {
 			v = Integer.parseInt(st.nextToken());
 			if (v < 0)
 			    break;
-			map.put(++a, v);
+			memory.put(++a, v);
 		    }
 		}
 	    } catch (Exception e) {}
 	}
 
 	protected String dump() {
-	    String s = super.dump() + " " + addressBits + " " + dataBits;
+	    StringBuilder sb = new StringBuilder(super.dump());
+	    sb.append(' ').append(addressBits).append(' ').append(dataBits);
 	    
-	    // dump contents
+	    // dump contents as runs of written words
 	    int maxI = 1<<addressBits;
-	    int i;
-	    for (i = 0; i < maxI; i++) {
-		Integer val = map.get(i);
-		if (val == null)
-		    continue;
-		s += " " + i + " " + val;
-		while (true) {
-		    val = map.get(++i);
-		    if (val == null)
-			break;
-		    s += " " + val;
-		}
-		s += " -1";
+	    int i = memory.nextWritten(0, maxI);
+	    while (i >= 0) {
+		sb.append(' ').append(i).append(' ').append(memory.get(i));
+		while (memory.isWritten(++i))
+		    sb.append(' ').append(memory.get(i));
+		sb.append(" -1");
+		i = memory.nextWritten(i, maxI);
 	    }
-	    s += " -2";
-	    return s;
+	    sb.append(" -2");
+	    return sb.toString();
 	}
 
 	protected boolean nonLinear() { return true; }
@@ -134,30 +130,18 @@ import com.google.gwt.user.client.ui.TextArea;
         	EditInfo ei = new EditInfo("Contents", 0);
         	ei.textArea = new TextArea();
         	ei.textArea.setVisibleLines(5);
-        	String s = "";
-        	if (contentsOverride != null) {
+        	String s;
+        	stagedImage = null;
+        	stagedImageText = null;
+        	if (imageOverride != null) {
+        		stagedImage = imageOverride;
+        		imageOverride = null;
+        		s = stagedImageText = formatImagePreview(stagedImage);
+        	} else if (contentsOverride != null) {
         		s = contentsOverride;
         		contentsOverride = null;
         	} else {
-        	int i;
-        	int maxI = 1<<addressBits;
-        	for (i = 0; i < maxI; i++) {
-        	    Integer val = map.get(i);
-        	    if (val == null)
-        		continue;
-    	    	    s += i + ": " + val;
-    	    	    int ct = 1;
-    	    	    while (true) {
-    	    		val = map.get(++i);
-    	    		if (val == null)
-    	    		    break;
-    	    		s += " " + val;
-    	    		if (++ct == 8)
-    	    		    break;
-    	    	    }
-    	    	    s += "\n";
-//    	    	    sim.console("got " + i + " " + s);
-    	    	}
+        		s = formatContents(memory, 0, 1<<addressBits, Integer.MAX_VALUE);
         	}
     	    	ei.textArea.setText(s);
     	    	return ei;
@@ -172,6 +156,44 @@ import com.google.gwt.user.client.ui.TextArea;
 	    return super.getChipEditInfo(n);
 	}
 	
+	/** Stage a binary image for the next contents edit (one word per byte, from address 0). */
+	public static void setImageOverride(int[] image) {
+	    imageOverride = image;
+	}
+
+	/** Edit-box text for written words in [start, end): "addr: v v v ..." with 8 words per line. */
+	private static String formatContents(PagedMemory mem, int start, int end, int maxLines) {
+	    StringBuilder sb = new StringBuilder();
+	    int lines = 0;
+	    int i = mem.nextWritten(start, end);
+	    while (i >= 0 && lines < maxLines) {
+		sb.append(i).append(": ").append(mem.get(i));
+		int ct = 1;
+		while (++i < end && ct < 8 && mem.isWritten(i)) {
+		    sb.append(' ').append(mem.get(i));
+		    ct++;
+		}
+		sb.append('\n');
+		lines++;
+		i = mem.nextWritten(i, end);
+	    }
+	    return sb.toString();
+	}
+
+	// large images are previewed rather than listed; the staged array is
+	// applied directly unless the text is edited
+	private static final int IMAGE_PREVIEW_LINES = 64;
+
+	private static String formatImagePreview(int[] image) {
+	    PagedMemory preview = new PagedMemory(MAX_ADDRESS_BITS);
+	    int n = Math.min(image.length, IMAGE_PREVIEW_LINES * 8);
+	    preview.load(0, image, 0, n);
+	    String s = formatContents(preview, 0, n, IMAGE_PREVIEW_LINES);
+	    if (n < image.length)
+		s = "# " + image.length + " words loaded from file; first " + n + " shown\n" + s;
+	    return s;
+	}
+
 	private int parseNumber(String str) {
 	    if (str.startsWith("0x"))
 		return Integer.parseInt(str.substring(2), 16);
@@ -193,9 +215,17 @@ import com.google.gwt.user.client.ui.TextArea;
 	    }
 	    if (n == 2) {
 		String s = ei.textArea.getText();
+		int[] image = stagedImage;
+		boolean unedited = image != null && s.equals(stagedImageText);
+		stagedImage = null;
+		stagedImageText = null;
+		memory.clear();
+		if (unedited) {
+		    memory.load(0, image, 0, Math.min(image.length, memory.getCapacity()));
+		    return;
+		}
 		String lines[] = s.split("\n");
 		int i;
-		map.clear();
 		for (i = 0; i != lines.length; i++) {
 		    try {
 			String line = lines[i];
@@ -205,7 +235,7 @@ import com.google.gwt.user.client.ui.TextArea;
 			int j;
 			for (j = 0; j != vals.length; j++) {
 			    int val = parseNumber(vals[j]);
-			    map.put(addr++, val);
+			    memory.put(addr++, val);
 			}
 		    } catch (Exception e) {}
 		}
@@ -237,8 +267,7 @@ import com.google.gwt.user.client.ui.TextArea;
 		address |= (volts[addressNodes+i] > getThreshold()) ? 1<<(addressBits-1-i) : 0;
 	    }
 	    
-	    Integer dataObj = map.get(address);
-	    int data = (dataObj == null) ? 0 : dataObj;
+	    int data = memory.get(address);
 	    for (i = 0; i != dataBits; i++) {
 		Pin p = pins[i+dataNodes];
 		sim.updateVoltageSource(0, nodes[internalNodes+i], p.voltSource, (data & (1<<(dataBits-1-i))) == 0 ? 0 : 5);
@@ -260,7 +289,7 @@ import com.google.gwt.user.client.ui.TextArea;
 	    for (i = 0; i != dataBits; i++) {
 		data |= (volts[dataNodes+i] > getThreshold()) ? 1<<(dataBits-1-i) : 0;
 	    }
-	    map.put(address, data);	    
+	    memory.put(address, data);
 	}
 	protected int getDumpType() { return 413; }
     }
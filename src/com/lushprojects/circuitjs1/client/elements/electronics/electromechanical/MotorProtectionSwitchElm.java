@@ -119,8 +119,8 @@ public class MotorProtectionSwitchElm extends CircuitElm {
 	    int i;
 	    int hs=6;
 	    setBbox(posts[0], posts[5], hs);
-	    g.context.save();
-	    g.context.translate(x, y);
+	    g.save();
+	    g.translate(x, y);
 	    int spx = 48;
 	    g.setLineDash(4, 4);
 	    int squareX = -spx-12;
@@ -142,13 +142,13 @@ public class MotorProtectionSwitchElm extends CircuitElm {
 		    drawThickLine(g, i*spx-4, 32, i*spx+4, 32);
 		int sw = blown ? 16 : 0;
 		drawThickLine(g, i*spx-sw, 32, i*spx, 64);
-		g.context.setLineCap(LineCap.BUTT);
+		g.setLineCap(LineCap.BUTT);
 		drawThickLine(g, i*spx, 64, i*spx, 80);
 		g.drawLine(i*spx-4, 16-4, i*spx+4, 16+4); 
 		g.drawLine(i*spx+4, 16-4, i*spx-4, 16+4); 
 		setVoltageColor(g, volts[i*2+1]);
 		drawThickLine(g, i*spx, 176, i*spx, 192);
-		g.context.setLineCap(LineCap.ROUND);
+		g.setLineCap(LineCap.ROUND);
 		g.setColor(getTempColor(g, i));
 		g.drawLine(i*spx, 80, i*spx, 96);
 		int q = 12;
@@ -157,9 +157,9 @@ public class MotorProtectionSwitchElm extends CircuitElm {
 		g.drawLine(i*spx-q, 112, i*spx, 112);
 		g.drawLine(i*spx, 112, i*spx, 128);
 		g.setColor(Color.lightGray);
-		g.context.setFont("italic 30px serif");
-		g.context.setTextBaseline("middle");
-		g.context.setTextAlign("center");
+		g.setFontName("italic 30px serif");
+		g.setTextBaseline("middle");
+		g.setTextAlign("center");
 		g.drawString("I >", i*spx, 80+48+48/2);
 	    }
 	    g.setColor(Color.lightGray);
@@ -174,10 +174,10 @@ public class MotorProtectionSwitchElm extends CircuitElm {
 		g.drawLine(squareX, squareY+12*i, squareX+24, squareY+12*i);
 	    g.drawLine(squareX-spx/2, squareY+12, squareX, squareY+12);
 	    g.drawLine(squareX-spx/2, squareY, squareX-spx/2, squareY+24);
-	    g.context.setFont("normal 12px sans-serif");
+	    g.setFontName("normal 12px sans-serif");
 	    g.setColor(Color.white);
 	    g.drawString(label, 120, squareY+12);
-	    g.context.restore();
+	    g.restore();
 	    if (!blown) {
 		for (i = 0; i != 3; i++) {
 		    curcounts[i] = updateDotCount(currents[i], curcounts[i]);
@@ -162,7 +162,7 @@ public class RelayCoilElm extends CircuitElm {
 	    g.drawString(label, outline[2].x+10, (y+y2)/2+4);
 	else {
             g.save();
-            g.context.setTextAlign("center");
+            g.setTextAlign("center");
 	    g.drawString(label, (x+x2)/2, outline[1].y+15);
 	    g.restore();
 	}
@@ -122,7 +122,7 @@ public class SwitchElm extends CircuitElm {
 		g.drawString(label, x+10, (y < y2 ? lead1 : lead2).y-5);
 	    else {
 		g.save();
-		g.context.setTextAlign("center");
+		g.setTextAlign("center");
 		g.drawString(label, (x+x2)/2, (x2 > x) ? y+15 : y-15);
 		g.restore();
 	    }
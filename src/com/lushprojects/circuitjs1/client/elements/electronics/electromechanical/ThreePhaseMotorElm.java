@@ -313,7 +313,7 @@ protected void startIteration() {
 		g.drawString("UVW".substring(i, i+1) + "2", posts[i*2+1].x+d1, posts[i*2+1].y-2);		
 	    }
 	} else {
-	    g.context.setTextAlign("center");
+	    g.setTextAlign("center");
 	    for (i = 0; i != 3; i++) {
 		int d1 = 11;
 		int d2 = 7; 
@@ -183,7 +183,7 @@ public class AmmeterElm extends CircuitElm {
                  plusPoint.y += 4;
              if (y > y2)
                  plusPoint.y += 3;
-            int w = (int)g.context.measureText("+").getWidth();
+            int w = (int)g.measureText("+");
             g.drawString("+", plusPoint.x-w/2, plusPoint.y);
 	    width = circleSize;
         }
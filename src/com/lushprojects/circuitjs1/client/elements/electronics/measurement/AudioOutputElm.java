@@ -3,6 +3,7 @@ package com.lushprojects.circuitjs1.client.elements.electronics.measurement;
 import com.lushprojects.circuitjs1.client.ui.EditInfo;
 
 import com.lushprojects.circuitjs1.client.ui.Choice;
+import com.lushprojects.circuitjs1.client.ui.Checkbox;
 
 import com.lushprojects.circuitjs1.client.*;
 import com.lushprojects.circuitjs1.client.util.*;
@@ -16,6 +17,7 @@ import com.google.gwt.user.client.Window;
 import com.google.gwt.user.client.ui.Anchor;
 import com.google.gwt.user.client.ui.Button;
 import com.lushprojects.circuitjs1.client.core.SimulationContext;
+import com.lushprojects.circuitjs1.client.runner.RuntimeMode;
 import com.lushprojects.circuitjs1.client.util.Locale;
 import jsinterop.annotations.JsMethod;
 import jsinterop.annotations.JsPackage;
@@ -52,6 +54,11 @@ public class AudioOutputElm extends CircuitElm {
 		@JsMethod native void setInt16(int byteOffset, int value, boolean littleEndian);
 	}
 
+	@JsType(isNative = true, namespace = JsPackage.GLOBAL, name = "Int16Array")
+	private static class Int16ArrayLike {
+		Int16ArrayLike(Object source) {}
+	}
+
 	@JsType(isNative = true, namespace = JsPackage.GLOBAL, name = "BlobPropertyBag")
 	private static class BlobPropertyBagLike {
 		BlobPropertyBagLike() {}
@@ -78,15 +85,17 @@ public class AudioOutputElm extends CircuitElm {
 	@JsMethod(namespace = JsPackage.GLOBAL, name = "URL.revokeObjectURL")
 	private static native void revokeObjectURL(String url);
 
-    private int dataCount;
-    private int dataPtr;
-    private double[] data;
-    private boolean dataFull;
+    private static final int FLAG_INTERPOLATE = 1;
+
+    // samples are resampled to the audio rate and PCM-encoded chunk by chunk
+    // as they arrive, so play() only has to assemble the blob
+    private PcmChunkBuffer buffer;
+    private AudioResampler resampler;
+    private PcmChunkBuffer.ChunkListener streamListener;
     private Button button;
     private int samplingRate;
     private int labelNum;
     private double duration;
-    private double sampleStep;
     private double dataStart;
     public static int lastSamplingRate = 8000;
     public static boolean okToChangeTimeStep;
@@ -136,11 +145,8 @@ public class AudioOutputElm extends CircuitElm {
 	protected int getDumpType() { return 211; }
 	protected int getPostCount() { return 1; }
 	protected void reset() {
-	    dataPtr = 0;
-	    dataFull = false;
-	    dataSampleCount = 0;
-	    nextDataSample = 0;
-	    dataSample = 0;
+	    buffer.reset();
+	    resampler.reset(getSimulationContext().getTime());
 	}
 	protected void setPoints() {
 	    super.setPoints();
@@ -154,9 +160,10 @@ public class AudioOutputElm extends CircuitElm {
 	    if (labelNum > 1)
 		s = "Audio " + labelNum;
 	    g.setFont(f);
-	    int textWidth = (int)g.context.measureText(s).getWidth();
+	    int textWidth = (int)g.measureText(s);
 	    g.setColor(Color.darkGray);
-	    int pct = (dataFull) ? textWidth : textWidth*dataPtr/dataCount;
+	    int cap = buffer.getCapacity();
+	    int pct = (cap == 0) ? 0 : textWidth*Math.min(buffer.getSampleCount(), cap)/cap;
 	    g.fillRect(x2-textWidth/2, y2-10, pct, 20);
 	    g.setColor(selected ? selectColor : whiteColor);
 	    interpPoint(point1, point2, lead1, 1-(textWidth/2.+8)/dn);
@@ -174,42 +181,41 @@ public class AudioOutputElm extends CircuitElm {
 	    SimulationContext context = getSimulationContext();
 	    arr[0] = "audio output";
 	    arr[1] = "V = " + getVoltageText(volts[0]);
-	    int ct = (dataFull ? dataCount : dataPtr);
-	    double dur = sampleStep * ct;
-	    arr[2] = "start = " + getUnitText(dataFull ? context.getTime()-duration : dataStart, "s");
+	    int ct = buffer.getSampleCount();
+	    boolean full = buffer.isFull();
+	    double dur = resampler.getSampleStep() * ct;
+	    arr[2] = "start = " + getUnitText(full ? context.getTime()-duration : dataStart, "s");
 	    arr[3] = "dur = " + getUnitText(dur, "s");
-	    arr[4] = "samples = " + ct + (dataFull ? "" : "/" + dataCount);
+	    arr[4] = "samples = " + ct + (full ? "" : "/" + buffer.getCapacity());
 	}
 	
-	private int dataSampleCount = 0;
-	private double nextDataSample = 0;
-	private double dataSample;
-	
 	protected void stepFinished() {
-	    SimulationContext context = getSimulationContext();
-	    dataSample += volts[0];
-	    dataSampleCount++;
-	    if (context.getTime() >= nextDataSample) {
-		nextDataSample += sampleStep;
-		data[dataPtr++] = dataSample/dataSampleCount;
-		dataSampleCount = 0;
-		dataSample = 0;
-		if (dataPtr >= dataCount) {
-		    dataPtr = 0;
-		    dataFull = true;
-		}
-	    }
+	    resampler.addSample(getSimulationContext().getTime(), volts[0], buffer);
 	}
 	
 	private void setDataCount() {
 	    SimulationContext context = getSimulationContext();
-	    dataCount = (int) (samplingRate * duration);
-	    data = new double[dataCount];
+	    buffer = new PcmChunkBuffer((int) (samplingRate * duration), PcmChunkBuffer.DEFAULT_CHUNK_SIZE);
+	    buffer.setChunkListener(streamListener);
+	    resampler = new AudioResampler(samplingRate, hasFlag(FLAG_INTERPOLATE));
 	    dataStart = context.getTime();
-	    dataPtr = 0;
-	    dataFull = false;
-	    sampleStep = 1./samplingRate;
-	    nextDataSample = context.getTime()+sampleStep;
+	    resampler.reset(dataStart);
+	}
+	
+	public int getSamplingRate() { return samplingRate; }
+	
+	/**
+	 * Receive the raw samples of every chunk as it fills, beyond the retained duration.
+	 * Used by the headless runner to stream audio to a WAV file.
+	 */
+	public void setStreamListener(PcmChunkBuffer.ChunkListener listener) {
+	    streamListener = listener;
+	    buffer.setChunkListener(listener);
+	}
+	
+	/** Hand the last partial chunk to the stream listener at the end of a run. */
+	public void finishStream() {
+	    buffer.finish();
 	}
 	
 	private int[] samplingRateChoices = { 8000, 11025, 16000, 22050, 44100, 48000 };
@@ -230,7 +236,12 @@ public class AudioOutputElm extends CircuitElm {
 		}
 		return ei;
 	    }
-            if (n == 2) {
+	    if (n == 2) {
+		EditInfo ei = new EditInfo("", 0, -1, -1);
+		ei.checkbox = new Checkbox("Interpolate Samples", hasFlag(FLAG_INTERPOLATE));
+		return ei;
+	    }
+            if (n == 3) {
                 EditInfo ei = new EditInfo("", 0, -1, -1);
                 String url=getLastBlob();
                 if (url == null)
@@ -260,6 +271,10 @@ public class AudioOutputElm extends CircuitElm {
 		    setTimeStep();
 		}
 	    }
+	    if (n == 2) {
+		flags = ei.checkbox.getState() ? (flags | FLAG_INTERPOLATE) : (flags & ~FLAG_INTERPOLATE);
+		resampler.setInterpolate(hasFlag(FLAG_INTERPOLATE));
+	    }
 	}
 	
 	private void setTimeStep() {
@@ -278,7 +293,7 @@ public class AudioOutputElm extends CircuitElm {
 	    */
 	    
 //	    int frac = (int)Math.round(Math.max(sampleStep*33000, 1));
-	    double target = sampleStep/8;
+	    double target = resampler.getSampleStep()/8;
 	    if (sim.getMaxTimeStep() != target) {
                 if (okToChangeTimeStep || Window.confirm(Locale.LS("Adjust timestep for best audio quality and performance?"))) {
                     sim.setMaxTimeStep(target);
@@ -288,6 +303,8 @@ public class AudioOutputElm extends CircuitElm {
 	}
 	
         private void createButton() {
+            if (RuntimeMode.isNonInteractiveRuntime())
+        	return;
             String label = "&#9654; " + Locale.LS("Play Audio");
             if (labelNum > 1)
         	label += " " + labelNum;
@@ -301,7 +318,8 @@ public class AudioOutputElm extends CircuitElm {
             
         }
         protected void delete() {
-			sim.getUiPanelManager().removeWidgetFromVerticalPanel(button);
+			if (button != null)
+				sim.getUiPanelManager().removeWidgetFromVerticalPanel(button);
             super.delete();
         }
         
@@ -310,10 +328,14 @@ public class AudioOutputElm extends CircuitElm {
 			view.setUint8(offset + i, s.charAt(i));
 	}
 
-	private static String createWavBlobUrl(int[] samples, int sampleRate) {
-		int dataSize = samples.length * 2;
-		ArrayBufferLike wav = new ArrayBufferLike(44 + dataSize);
-		DataViewLike view = new DataViewLike(wav);
+	// the header goes through a DataView; the PCM chunks are handed to the
+	// Blob as typed arrays, one native copy per chunk
+	private static String createWavBlobUrl(short[][] parts, int sampleRate) {
+		int dataSize = 0;
+		for (short[] part : parts)
+			dataSize += part.length * 2;
+		ArrayBufferLike header = new ArrayBufferLike(44);
+		DataViewLike view = new DataViewLike(header);
 
 		writeAscii(view, 0, "RIFF");
 		view.setUint32(4, 36 + dataSize, true);
@@ -329,16 +351,15 @@ public class AudioOutputElm extends CircuitElm {
 		writeAscii(view, 36, "data");
 		view.setUint32(40, dataSize, true);
 
-		int p = 44;
-		for (int sample : samples) {
-			int clamped = Math.max(-32768, Math.min(32767, sample));
-			view.setInt16(p, clamped, true);
-			p += 2;
-		}
+		// Int16Array is platform-endian; every browser we run on is little-endian like WAV
+		Object[] blobParts = new Object[parts.length + 1];
+		blobParts[0] = header;
+		for (int i = 0; i != parts.length; i++)
+			blobParts[i + 1] = new Int16ArrayLike(parts[i]);
 
 		BlobPropertyBagLike options = new BlobPropertyBagLike();
 		options.setType("audio/wav");
-		BlobLike blob = new BlobLike(new Object[] { wav }, options);
+		BlobLike blob = new BlobLike(blobParts, options);
 		return createObjectURL(blob);
 	}
 
@@ -373,40 +394,11 @@ public class AudioOutputElm extends CircuitElm {
 		}
         
         private void play() {
-            int i;
-            int ct = dataPtr;
-            int base = 0;
-            if (dataFull) {
-        	ct = dataCount;
-        	base = dataPtr;
-            }
-            if (ct * sampleStep < .05) {
+            if (buffer.getSampleCount() * resampler.getSampleStep() < .05) {
         	Window.alert(Locale.LS("Audio data is not ready yet.  Increase simulation speed to make data ready sooner."));
         	return;
             }
-            
-            // rescale data to maximize
-            double max = -1e8;
-            double min =  1e8;
-            for (i = 0; i != ct; i++) {
-        	if (data[i] > max) max = data[i];
-        	if (data[i] < min) min = data[i];
-            }
-            
-            double adj = -(max+min)/2;
-            double mult = (.25*32766)/(max+adj);
-            
-            // fade in over 1/20 sec
-	    int fadeLen = samplingRate/20;
-	    int fadeOut = ct-fadeLen;
-	    
-	    double fadeMult = mult/fadeLen;
-	    int[] samples = new int[ct];
-            for (i = 0; i != ct; i++) {
-		double fade = (i < fadeLen) ? i*fadeMult : (i > fadeOut) ? (ct-i)*fadeMult : mult;
-        	int s = (int)((data[(i+base)%dataCount]+adj)*fade);
-		samples[i] = s;
-            }
-	    playWavBlobUrl(createWavBlobUrl(samples, samplingRate));
+            // fade in and out over 1/20 sec
+	    playWavBlobUrl(createWavBlobUrl(buffer.snapshot(samplingRate/20), samplingRate));
         }
 }
@@ -35,7 +35,7 @@ public class OhmMeterElm extends CurrentElm {
 
 	    setBbox(point1, point2, cr);
 	    doDots(g);
-	    if (sim.showValuesCheckItem.getState() && current != 0) {
+	    if (sim.isShowValuesEnabledForExport() && current != 0) {
 		String s = getShortUnitText(getVoltageDiff()/current, Locale.ohmString);
 		if (dx == 0 || dy == 0)
 		    drawValues(g, s, cr);
@@ -124,13 +124,13 @@ public class TestPointElm extends CircuitElm {
     }
     
     void drawText(Graphics g, String str, String str2, Point pt1, Point pt2) {
-        int w1 = (int)g.context.measureText(str).getWidth();
-        int w2 = (int)g.context.measureText(str2).getWidth();
+        int w1 = (int)g.measureText(str);
+        int w2 = (int)g.measureText(str2);
         final int spacing = 14;
         int wmax = max(w1, w2);
         int h=(int)g.currentFontSize;
         g.save();
-        g.context.setTextBaseline("middle");
+        g.setTextBaseline("middle");
         int x = pt2.x, y = pt2.y;
         if (pt1.y != pt2.y) {
             x -= wmax/2;
@@ -150,10 +150,10 @@ public class TestPointElm extends CircuitElm {
     }
     
     private void drawValue(Graphics g, String str, Point pt1, Point pt2) {
-        int w = (int)g.context.measureText(str).getWidth();
+        int w = (int)g.measureText(str);
         int h = (int)g.currentFontSize;
         g.save();
-        g.context.setTextBaseline("middle");
+        g.setTextBaseline("middle");
         int x = pt2.x, y = pt2.y;
         if (pt1.y != pt2.y) {
             x -= w/2;
@@ -179,7 +179,7 @@ public class TestPointElm extends CircuitElm {
         //depending upon flags show voltage or TP
         
         String s = label;
-        interpPoint(point1, point2, lead1, 1-((int)g.context.measureText("TP").getWidth()/2+8)/dn);
+        interpPoint(point1, point2, lead1, 1-((int)g.measureText("TP")/2+8)/dn);
         setBbox(point1, lead1, 0);
         
         //draw selected value
@@ -149,13 +149,13 @@ public class WattmeterElm extends CircuitElm {
 	// adjust font size to fit
 	while (true) {
 	    g.setFont(new Font("SansSerif", 0, fsize));
-	    w=(int)g.context.measureText(str).getWidth();
+	    w=(int)g.measureText(str);
 	    if (w < maxTextLen)
 		break;
 	    fsize--;
 	}
 	g.setColor(whiteColor);
-	g.context.setTextBaseline("middle");
+	g.setTextBaseline("middle");
 	g.drawString(str, center.x-w/2, center.y);
 	g.restore();
     }
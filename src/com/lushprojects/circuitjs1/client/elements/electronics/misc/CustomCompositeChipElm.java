@@ -88,8 +88,8 @@ import com.lushprojects.circuitjs1.client.util.*;
 	    if (label == null)
 		return;
 	    g.save();
-	    g.context.setTextBaseline("middle");
-	    g.context.setTextAlign("center");
+	    g.setTextBaseline("middle");
+	    g.setTextAlign("center");
 	    g.drawString(label, x, y);
 	    g.restore();
 	}
@@ -37,7 +37,7 @@ public class CustomCompositeElm extends CompositeElm {
 	modelName = (xx == 0 && yy == 0) ? "default" : lastModelName;
 		
 	flags |= FLAG_ESCAPE;
-	if (sim.smallGridCheckItem.getState())
+	if (sim.isSmallGridEnabledForExport())
 	    flags |= FLAG_SMALL;
 	updateModels();
     }
@@ -46,7 +46,7 @@ public class CustomCompositeElm extends CompositeElm {
 	super(xx, yy);
 	modelName = name;
 	flags |= FLAG_ESCAPE;
-	if (sim.smallGridCheckItem.getState())
+	if (sim.isSmallGridEnabledForExport())
 	    flags |= FLAG_SMALL;
 	updateModels();
     }
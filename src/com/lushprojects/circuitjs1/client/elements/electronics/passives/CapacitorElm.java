@@ -103,7 +103,7 @@ public class CapacitorElm extends CircuitElm {
 	    drawThickLine(g, point1, lead1);
 	    setPowerColor(g, false);
 	    drawThickLine(g, plate1[0], plate1[1]);
-	    if (sim.powerCheckItem.getState())
+	    if (sim.isPowerEnabledForExport())
 		g.setColor(Color.gray);
 
 	    // draw second lead and plate
@@ -124,7 +124,7 @@ public class CapacitorElm extends CircuitElm {
 		drawDots(g, point2, lead2, -curcount);
 	    }
 	    drawPosts(g);
-	    if (sim.showValuesCheckItem.getState()) {
+	    if (sim.isShowValuesEnabledForExport()) {
 		String s = getShortUnitText(capacitance, "F");
 		drawValues(g, s, hs);
 	    }
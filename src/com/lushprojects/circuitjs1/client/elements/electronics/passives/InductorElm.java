@@ -65,7 +65,7 @@ public class InductorElm extends CircuitElm {
 	    draw2Leads(g);
 	    setPowerColor(g, false);
 	    drawCoil(g, 8, lead1, lead2, v1, v2);
-	    if (sim.showValuesCheckItem.getState()) {
+	    if (sim.isShowValuesEnabledForExport()) {
 		String s = getShortUnitText(inductance, "H");
 		drawValues(g, s, hs);
 	    }
@@ -46,7 +46,7 @@ public class PolarCapacitorElm extends CapacitorElm {
 	    super.draw(g);
             g.setColor(whiteColor);
             g.setFont(unitsFont);
-            int w = (int)g.context.measureText("+").getWidth();;
+            int w = (int)g.measureText("+");;
             g.drawString("+", plusPoint.x-w/2, plusPoint.y);
 	}
 	protected void getInfo(String arr[]) {
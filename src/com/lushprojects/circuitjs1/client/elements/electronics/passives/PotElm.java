@@ -220,7 +220,7 @@ public class PotElm extends CircuitElm implements Command, MouseWheelHandler {
 	}
 	drawPosts(g);
 
-	if (sim.showValuesCheckItem.getState() && resistance1 > 0 && (flags & FLAG_SHOW_VALUES) != 0) {
+	if (sim.isShowValuesEnabledForExport() && resistance1 > 0 && (flags & FLAG_SHOW_VALUES) != 0) {
 	    // check for vertical pot with 3rd terminal on left
 	    boolean reverseY = (post3.x < lead1.x && lead1.x == lead2.x);
 	    // check for horizontal pot with 3rd terminal on top
@@ -235,7 +235,7 @@ public class PotElm extends CircuitElm implements Command, MouseWheelHandler {
 	    g.setColor(whiteColor);
 	    int ya = (int)g.currentFontSize/2;
 	    int w;
-	    w = (int)g.context.measureText(s1).getWidth();
+	    w = (int)g.measureText(s1);
 	    
 	    // vertical?
 	    if (lead1.x == lead2.x)
@@ -243,7 +243,7 @@ public class PotElm extends CircuitElm implements Command, MouseWheelHandler {
 	    else
 		g.drawString(s1, Math.min(arrow1.x, arrow2.x)-2-w, !reverseX ? arrowPoint.y+4+ya : arrowPoint.y-4);
 	    
-	    w = (int)g.context.measureText(s2).getWidth();
+	    w = (int)g.measureText(s2);
 	    if (lead1.x == lead2.x)
 		g.drawString(s2, !reverseY ? arrowPoint.x+2 : arrowPoint.x-2-w, Math.min(arrow1.y, arrow2.y)-3);
 	    else
@@ -257,7 +257,7 @@ public class PotElm extends CircuitElm implements Command, MouseWheelHandler {
 	    return;
 	g.setFont(unitsFont);
 	//FontMetrics fm = g.getFontMetrics();
-	int w = (int)g.context.measureText(s).getWidth();
+	int w = (int)g.measureText(s);
 	g.setColor(whiteColor);
 	int ya = (int)g.currentFontSize/2;
 	int xc = pt.x;
@@ -21,7 +21,6 @@ package com.lushprojects.circuitjs1.client.elements.electronics.passives;
 
 import com.lushprojects.circuitjs1.client.ui.EditInfo;
 
-import com.google.gwt.canvas.dom.client.CanvasGradient;
 import com.lushprojects.circuitjs1.client.*;
 import com.lushprojects.circuitjs1.client.util.*;
 import com.lushprojects.circuitjs1.client.util.Locale;
@@ -61,33 +60,30 @@ public class ResistorElm extends CircuitElm {
 	    
 	    //   double segf = 1./segments;
 	    double len = distance(lead1, lead2);
-	    g.context.save();
-	    g.context.setLineWidth(3.0);
-	    g.context.transform(((double)(lead2.x-lead1.x))/len, ((double)(lead2.y-lead1.y))/len, -((double)(lead2.y-lead1.y))/len,((double)(lead2.x-lead1.x))/len,lead1.x,lead1.y);
-	    if (sim.voltsCheckItem.getState() ) {
-		CanvasGradient grad = g.context.createLinearGradient(0,0,len,0);
-		grad.addColorStop(0, getVoltageColor(g,v1).getHexValue());
-		grad.addColorStop(1.0, getVoltageColor(g,v2).getHexValue());
-		g.context.setStrokeStyle(grad);
-	    } else
+	    g.save();
+	    g.setLineWidth(3.0);
+	    g.transform(((double)(lead2.x-lead1.x))/len, ((double)(lead2.y-lead1.y))/len, -((double)(lead2.y-lead1.y))/len,((double)(lead2.x-lead1.x))/len,lead1.x,lead1.y);
+	    if (sim.isVoltsEnabledForExport() )
+		g.setStrokeGradient(0, 0, len, 0, getVoltageColor(g,v1), getVoltageColor(g,v2));
+	    else
 		setPowerColor(g, true);
 	    if (dn < 30)
 		hs = 2;
 	    if (!sim.isEuroResistorForUi()) {
-		g.context.beginPath();
-		g.context.moveTo(0,0);
+		g.beginPath();
+		g.moveTo(0,0);
 		for (i=0;i<4;i++){
-		    g.context.lineTo((1+4*i)*len/16, hs);
-		    g.context.lineTo((3+4*i)*len/16, -hs);
+		    g.lineTo((1+4*i)*len/16, hs);
+		    g.lineTo((3+4*i)*len/16, -hs);
 		}
-		g.context.lineTo(len, 0);
-		g.context.stroke();
+		g.lineTo(len, 0);
+		g.stroke();
 
 	    } else {
-		g.context.strokeRect(0, -hs, len, 2.0*hs);
+		g.strokeRect(0, -hs, len, 2.0*hs);
 	    }
-	    g.context.restore();
-	    if (sim.showValuesCheckItem.getState()) {
+	    g.restore();
+	    if (sim.isShowValuesEnabledForExport()) {
 		String s = getShortUnitText(resistance, "");
 		drawValues(g, s, hs+2);
 	    }
@@ -120,6 +116,7 @@ public class ResistorElm extends CircuitElm {
 	public void setEditValue(int n, EditInfo ei) {
 	    resistance = (ei.value <= 0) ? 1e-9 : ei.value;
 	}
+	public boolean isParameterOnlyEdit(int n) { return n == 0; }
 	protected int getShortcut() { return 'r'; }
 	public double getResistance() { return resistance; }
 	public void setResistance(double r) { resistance = r; }
@@ -136,7 +136,7 @@ public class MosfetElm extends CircuitElm {
 		int segments = 6;
 		int i;
 		setPowerColor(g, true);
-		boolean power = sim.powerCheckItem.getState();
+		boolean power = sim.isPowerEnabledForExport();
 		double segf = 1./segments;
 		boolean enhancement = vt > 0 && showBulk();
 		for (i = 0; i != segments; i++) {
@@ -143,7 +143,7 @@ private double gmin;
 	    g.fillPolygon(arrowPoly);
 	    // draw base
 	    setVoltageColor(g, volts[0]);
-	    if (sim.powerCheckItem.getState())
+	    if (sim.isPowerEnabledForExport())
 		g.setColor(Color.gray);
 	    drawThickLine(g, point1, base);
 	    // draw dots
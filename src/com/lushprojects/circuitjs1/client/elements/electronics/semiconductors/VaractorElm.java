@@ -73,7 +73,7 @@ public class VaractorElm extends DiodeElm {
 	setVoltageColor(g, volts[0]);
 	setPowerColor(g, false);
 	drawThickLine(g, plate1[0], plate1[1]);
-	if (sim.powerCheckItem.getState())
+	if (sim.isPowerEnabledForExport())
 	    g.setColor(Color.gray);
 
 	// draw second plate
@@ -70,7 +70,7 @@ import com.lushprojects.circuitjs1.client.util.*;
 	    g.fillPolygon(arrow);
 	    setBbox(point1, point2, cr);
 	    doDots(g);
-	    if (sim.showValuesCheckItem.getState() && current != 0) {
+	    if (sim.isShowValuesEnabledForExport() && current != 0) {
 		String s = getShortUnitText(current, "A");
 		if (dx == 0 || dy == 0)
 		    drawValues(g, s, cr);
@@ -93,6 +93,9 @@ public class LabeledNodeElm extends CircuitElm {
     
     // Cache for reverse lookup: node number -> label name
     private static HashMap<Integer, String> nodeToLabelCache;
+
+    // Bumped whenever labelList changes
+    private static int labelVersion;
     
     public boolean isInternal() { return (flags & FLAG_INTERNAL) != 0; }
     private boolean showLabelNodes() { return (flags & FLAG_SHOW_ALL_NODES) != 0; }
@@ -129,8 +132,13 @@ public class LabeledNodeElm extends CircuitElm {
         return cachedSortedNodes;
     }
     
+    public static int getLabelVersion() {
+        return labelVersion;
+    }
+
     // Call this whenever labelList is modified to invalidate cache
     private static void invalidateCache() {
+        labelVersion++;
         cachedSortedNodes = null;
         lastKnownSize = -1;
         nodeToLabelCache = null; // Invalidate reverse lookup cache too
@@ -28,7 +28,7 @@ public class AdderElm extends CircuitElm {
         super(xx, yy);
         noDiagonal = true;
         inputCount = 2;
-        setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+        setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
     }
     
     public AdderElm(int xa, int ya, int xb, int yb, int f, StringTokenizer st) {
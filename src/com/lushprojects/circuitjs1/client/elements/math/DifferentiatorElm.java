@@ -50,7 +50,7 @@ public class DifferentiatorElm extends CircuitElm {
         parseExpr();
         lastVolts = new double[1];
         exprState = new ExprState(1);
-        setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+        setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
     }
     
     public DifferentiatorElm(int xa, int ya, int xb, int yb, int f, StringTokenizer st) {
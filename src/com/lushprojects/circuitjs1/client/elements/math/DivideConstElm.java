@@ -46,7 +46,7 @@ public class DivideConstElm extends CircuitElm {
         noDiagonal = true;
         divisor = 1.0;
         elmName = "";
-        setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+        setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
     }
     
     public DivideConstElm(int xa, int ya, int xb, int yb, int f, StringTokenizer st) {
@@ -227,8 +227,6 @@ public class DivideConstElm extends CircuitElm {
         }
         if (n == 1) {
             divisor = ei.value;
-            // Trigger re-analysis since divisor affects the circuit matrix
-            sim.analyzeFlag = true;
         }
         if (n == 2) {
             flags = ei.changeFlag(flags, FLAG_SHOWPERCENT);
@@ -245,6 +243,9 @@ public class DivideConstElm extends CircuitElm {
         }
     }
     
+    // Divisor only scales the VCVS coefficient, so slider moves can patch the matrix
+    public boolean isParameterOnlyEdit(int n) { return n == 1; }
+
     // Override to provide custom slider text formatting
     public String getSliderUnitText(int n, EditInfo ei, double value) {
         // For the divisor parameter (n==1), format based on percentage flag
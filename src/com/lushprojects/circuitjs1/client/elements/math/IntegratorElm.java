@@ -52,7 +52,7 @@ public class IntegratorElm extends CircuitElm {
         // Default: use input pin for initial value
         flags |= FLAG_USE_INIT_INPUT;
         inputCount = 2; // Two inputs: 0=integrate, 1=initial value
-        setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+        setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
         lastVolts = new double[inputCount];
         initIntegration();
     }
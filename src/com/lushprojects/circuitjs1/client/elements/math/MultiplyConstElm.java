@@ -46,7 +46,7 @@ public class MultiplyConstElm extends CircuitElm {
         noDiagonal = true;
         gain = 1.0;
         elmName = "";
-        setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+        setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
     }
     
     public MultiplyConstElm(int xa, int ya, int xb, int yb, int f, StringTokenizer st) {
@@ -225,8 +225,6 @@ public class MultiplyConstElm extends CircuitElm {
         }
         if (n == 1) {
             gain = ei.value;
-            // Trigger re-analysis since gain affects the circuit matrix
-            sim.analyzeFlag = true;
         }
         if (n == 2) {
             flags = ei.changeFlag(flags, FLAG_SHOWPERCENT);
@@ -243,6 +241,9 @@ public class MultiplyConstElm extends CircuitElm {
         }
     }
     
+    // Gain only scales the VCVS coefficient, so slider moves can patch the matrix
+    public boolean isParameterOnlyEdit(int n) { return n == 1; }
+
     // Override to provide custom slider text formatting
     public String getSliderUnitText(int n, EditInfo ei, double value) {
         // For the gain parameter (n==1), format based on percentage flag
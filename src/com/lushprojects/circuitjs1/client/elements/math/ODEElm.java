@@ -86,7 +86,7 @@ public class ODEElm extends CircuitElm {
             parameters[i] = 0.5;
             showPercentage[i] = false;
         }
-        setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+        setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
         parseEquation();
         initIntegration();
     }
@@ -41,7 +41,7 @@ public class SubtracterElm extends CircuitElm {
         super(xx, yy);
         noDiagonal = true;
         inputCount = 2;
-        setSize(sim.smallGridCheckItem.getState() ? 1 : 2);
+        setSize(sim.isSmallGridEnabledForExport() ? 1 : 2);
     }
     
     public SubtracterElm(int xa, int ya, int xb, int yb, int f, StringTokenizer st) {
@@ -119,7 +119,7 @@ public class ActionTimeElm extends CircuitElm {
         
         // Apply gray filter if disabled
         if (!enabled) {
-            g.context.setGlobalAlpha(0.5);
+            g.setGlobalAlpha(0.5);
         }
         
         // Calculate box dimensions
@@ -172,14 +172,14 @@ public class ActionTimeElm extends CircuitElm {
         g.setFont(f);
         g.setColor(Color.white);
         String headerTitle = (title == null || title.isEmpty()) ? "Action Schedule" : title;
-        int textWidth = (int)g.context.measureText(headerTitle).getWidth();
+        int textWidth = (int)g.measureText(headerTitle);
         g.drawString(headerTitle, cx - textWidth/2, cy - height/2 + 18);
         
         // Draw current time
         f = new Font("SansSerif", 0, 11);
         g.setFont(f);
         String timeText = "t=" + getUnitText(getSimulationContext().getTime(), "s");
-        textWidth = (int)g.context.measureText(timeText).getWidth();
+        textWidth = (int)g.measureText(timeText);
         g.drawString(timeText, cx - width/2 + 10, cy - height/2 + headerHeight + 5);
         
         // Draw actions
@@ -187,12 +187,12 @@ public class ActionTimeElm extends CircuitElm {
             g.setColor(Color.gray);
             g.setFont(new Font("SansSerif", 0, 11));
             String msg = "No actions scheduled";
-            textWidth = (int)g.context.measureText(msg).getWidth();
+            textWidth = (int)g.measureText(msg);
             g.drawString(msg, cx - textWidth/2, cy);
             
             // Draw hint to double-click
             msg = "(Double-click to add)";
-            textWidth = (int)g.context.measureText(msg).getWidth();
+            textWidth = (int)g.measureText(msg);
             g.drawString(msg, cx - textWidth/2, cy + 15);
         } else {
             int yPos = cy - height/2 + headerHeight + 15;
@@ -296,7 +296,7 @@ public class ActionTimeElm extends CircuitElm {
                 g.setColor(Color.gray);
                 g.setFont(new Font("SansSerif", 0, 10));
                 String moreText = "...and " + (actions.size() - maxDisplay) + " more";
-                textWidth = (int)g.context.measureText(moreText).getWidth();
+                textWidth = (int)g.measureText(moreText);
                 g.drawString(moreText, cx - textWidth/2, yPos);
             }
         }
@@ -305,7 +305,7 @@ public class ActionTimeElm extends CircuitElm {
         // g.setColor(Color.gray);
         // g.setFont(new Font("SansSerif", 0, 9));
         // String hint = "Double-click to manage";
-        // textWidth = (int)g.context.measureText(hint).getWidth();
+        // textWidth = (int)g.measureText(hint);
         // g.drawString(hint, cx - textWidth/2, cy + height/2 - 8);
         
         // Set bounding box
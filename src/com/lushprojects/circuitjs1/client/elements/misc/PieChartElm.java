@@ -201,10 +201,10 @@ public class PieChartElm extends GraphicElm {
         }
         
         // Draw background circle
-        g.setColor(sim.printableCheckItem.getState() ? Color.white : Color.darkGray);
-        g.context.beginPath();
-        g.context.arc(center.x, center.y, radius, 0, 2 * Math.PI);
-        g.context.fill();
+        g.setColor(sim.isPrintableEnabledForExport() ? Color.white : Color.darkGray);
+        g.beginPath();
+        g.arc(center.x, center.y, radius, 0, 2 * Math.PI);
+        g.fill();
         
         // Draw pie slices and labels
         if (total > 0) {
@@ -221,19 +221,19 @@ public class PieChartElm extends GraphicElm {
                 
                 // Draw slice
                 g.setColor(nodeColors[i]);
-                g.context.beginPath();
-                g.context.moveTo(center.x, center.y);
-                g.context.arc(center.x, center.y, radius, startAngle, endAngle);
-                g.context.closePath();
-                g.context.fill();
+                g.beginPath();
+                g.moveTo(center.x, center.y);
+                g.arc(center.x, center.y, radius, startAngle, endAngle);
+                g.closePath();
+                g.fill();
                 
                 // Draw slice border
-                g.setColor(sim.printableCheckItem.getState() ? Color.black : Color.white);
-                g.context.beginPath();
-                g.context.moveTo(center.x, center.y);
-                g.context.arc(center.x, center.y, radius, startAngle, endAngle);
-                g.context.closePath();
-                g.context.stroke();
+                g.setColor(sim.isPrintableEnabledForExport() ? Color.black : Color.white);
+                g.beginPath();
+                g.moveTo(center.x, center.y);
+                g.arc(center.x, center.y, radius, startAngle, endAngle);
+                g.closePath();
+                g.stroke();
                 
                 // Draw label if slice is large enough (at least 5% of pie)
                 if (sliceAngle > 0.1 * Math.PI) {
@@ -254,19 +254,19 @@ public class PieChartElm extends GraphicElm {
             }
         } else {
             // No data - draw empty circle
-            g.setColor(sim.printableCheckItem.getState() ? Color.lightGray : Color.gray);
-            g.context.beginPath();
-            g.context.arc(center.x, center.y, radius, 0, 2 * Math.PI);
-            g.context.stroke();
+            g.setColor(sim.isPrintableEnabledForExport() ? Color.lightGray : Color.gray);
+            g.beginPath();
+            g.arc(center.x, center.y, radius, 0, 2 * Math.PI);
+            g.stroke();
         }
         
         // Draw outer border
         g.setColor(needsHighlight() ? selectColor : 
-                  (sim.printableCheckItem.getState() ? Color.black : Color.white));
+                  (sim.isPrintableEnabledForExport() ? Color.black : Color.white));
         g.setLineWidth(needsHighlight() ? 3.0 : 1.0);
-        g.context.beginPath();
-        g.context.arc(center.x, center.y, radius, 0, 2 * Math.PI);
-        g.context.stroke();
+        g.beginPath();
+        g.arc(center.x, center.y, radius, 0, 2 * Math.PI);
+        g.stroke();
         g.setLineWidth(1.0);
     }
     
@@ -19,6 +19,7 @@
 
 package com.lushprojects.circuitjs1.client.elements.misc;
 
+import com.lushprojects.circuitjs1.client.runner.RuntimeMode;
 import com.lushprojects.circuitjs1.client.scope.Scope;
 
 import com.lushprojects.circuitjs1.client.*;
@@ -142,25 +143,52 @@ public class ScopeElm extends CircuitElm {
     @Override
     protected void draw(Graphics g) {
 	g.setColor(needsHighlight() ? selectColor : whiteColor);
-	g.context.save();
+	g.save();
 	
-	// Apply inverse transform for proper rendering
-	// Note: setTransform() doesn't work in the version of canvas2svg we are using
-	double[] transform = sim.getTransformForUiElement();
-	g.context.scale(1 / transform[0], 1 / transform[3]);
-	g.context.translate(-transform[4], -transform[5]);
-
-	if (sim.isExportingImage()) {
-	    drawForExport(g);
+	if (RuntimeMode.isNonInteractiveRuntime()) {
+	    drawOffscreen(g);
 	} else {
-	    drawNormal(g);
+	    // Apply inverse transform for proper rendering
+	    // Note: setTransform() doesn't work in the version of canvas2svg we are using
+	    double[] transform = sim.getTransformForUiElement();
+	    g.scale(1 / transform[0], 1 / transform[3]);
+	    g.translate(-transform[4], -transform[5]);
+
+	    if (sim.isExportingImage()) {
+		drawForExport(g);
+	    } else {
+		drawNormal(g);
+	    }
 	}
 	
-	g.context.restore();
+	g.restore();
 	setBbox(point1, point2, 0);
 	drawPosts(g);
     }
     
+    /**
+     * Draws the scope element into an offscreen image (JVM runner): the box
+     * and the scope's grid and traces, scaled to the element in circuit
+     * coordinates. The caller's Graphics already holds the export transform.
+     * @param g Graphics context
+     */
+    private void drawOffscreen(Graphics g) {
+	int x1 = min(x, x2);
+	int y1 = min(y, y2);
+	int w = max(x, x2) - x1;
+	int h = max(y, y2) - y1;
+	setBackgroundColor(g);
+	g.fillRect(x1, y1, w, h);
+	
+	Rectangle scopeRect = elmScope.getRectForEmbedded();
+	if (scopeRect.width <= 0 || scopeRect.height <= 0)
+	    return;
+	g.translate(x1, y1);
+	g.scale((double) w / scopeRect.width, (double) h / scopeRect.height);
+	g.clipRect(0, 0, scopeRect.width, scopeRect.height);
+	elmScope.drawPlotAreaForExport(g);
+    }
+    
     /**
      * Draws the scope element during normal rendering.
      * @param g Graphics context
@@ -211,28 +239,24 @@ public class ScopeElm extends CircuitElm {
 	
 	// Draw shadow box (scaled)
 	int shadowOffset = (int)(4 * Math.min(scaleX, scaleY));
-	g.context.save();
-	g.context.setShadowBlur(8 * Math.min(scaleX, scaleY));
-	g.context.setShadowOffsetX(shadowOffset);
-	g.context.setShadowOffsetY(shadowOffset);
-	
-	setShadowColor(g);
+	g.save();
+	g.setShadow(getShadowColor(), 8 * Math.min(scaleX, scaleY), shadowOffset, shadowOffset);
 	setBackgroundColor(g);
 	
 	// Draw a background rectangle for the shadow (scaled size)
 	g.fillRect(i1, j1, i2 - i1, j2 - j1);
-	g.context.restore();
+	g.restore();
 	
 	// Apply transform: translate to scope origin, scale, then translate back
-	g.context.save();
-	g.context.translate(i1, j1);
-	g.context.scale(scaleX, scaleY);
-	g.context.translate(-i1, -j1);
+	g.save();
+	g.translate(i1, j1);
+	g.scale(scaleX, scaleY);
+	g.translate(-i1, -j1);
 	
 	elmScope.setPositionForEmbedded(-1);
 	elmScope.drawForEmbedded(g);
 	
-	g.context.restore();
+	g.restore();
 	
 	// Restore the original rectangle after drawing
 	scopeRect.x = savedX;
@@ -247,29 +271,24 @@ public class ScopeElm extends CircuitElm {
 	final int SHADOW_OFFSET = 4;
 	final int SHADOW_BLUR = 8;
 	
-	g.context.save();
-	g.context.setShadowBlur(SHADOW_BLUR);
-	g.context.setShadowOffsetX(SHADOW_OFFSET);
-	g.context.setShadowOffsetY(SHADOW_OFFSET);
-	
-	setShadowColor(g);
+	g.save();
+	g.setShadow(getShadowColor(), SHADOW_BLUR, SHADOW_OFFSET, SHADOW_OFFSET);
 	setBackgroundColor(g);
 	
 	// Draw a background rectangle for the shadow
 	Rectangle scopeRect = elmScope.getRectForEmbedded();
 	g.fillRect(scopeRect.x, scopeRect.y, scopeRect.width, scopeRect.height);
-	g.context.restore();
+	g.restore();
     }
     
     /**
-     * Sets the shadow color based on print mode.
-     * @param g Graphics context
+     * Gets the shadow color based on print mode.
      */
-    private void setShadowColor(Graphics g) {
-	if (sim.printableCheckItem.getState()) {
-	    g.context.setShadowColor("rgba(0, 0, 0, 0.4)");  // Dark shadow for white background
+    private String getShadowColor() {
+	if (sim.isPrintableEnabledForExport()) {
+	    return "rgba(0, 0, 0, 0.4)";  // Dark shadow for white background
 	} else {
-	    g.context.setShadowColor("rgba(255, 255, 255, 0.3)");  // Light shadow for black background
+	    return "rgba(255, 255, 255, 0.3)";  // Light shadow for black background
 	}
     }
     
@@ -278,7 +297,7 @@ public class ScopeElm extends CircuitElm {
      * @param g Graphics context
      */
     private void setBackgroundColor(Graphics g) {
-	if (sim.printableCheckItem.getState()) {
+	if (sim.isPrintableEnabledForExport()) {
 	    g.setColor(new Color(238, 238, 238));  // Light gray (#eee) - same as docked scopes
 	} else {
 	    g.setColor(new Color(32, 32, 32));  // Dark gray instead of pure black
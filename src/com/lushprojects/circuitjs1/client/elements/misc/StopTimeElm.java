@@ -149,7 +149,7 @@ public class StopTimeElm extends CircuitElm {
         Font f = new Font("SansSerif", Font.BOLD, 16);
         g.setFont(f);
         g.setColor(Color.white);
-        int textWidth = (int)g.context.measureText(signText).getWidth();
+        int textWidth = (int)g.measureText(signText);
         g.drawString(signText, cx - textWidth/2, cy + 4);
         
         // Draw time above the sign
@@ -157,7 +157,7 @@ public class StopTimeElm extends CircuitElm {
         g.setFont(f);
         g.setColor(selected ? selectColor : whiteColor);
         String timeText = "stop = " + getUnitText(stopTime, "s");
-        textWidth = (int)g.context.measureText(timeText).getWidth();
+        textWidth = (int)g.measureText(timeText);
         int textY = cy - size - 5;
         g.drawString(timeText, cx - textWidth/2, textY);
         
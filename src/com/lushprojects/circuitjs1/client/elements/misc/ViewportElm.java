@@ -63,7 +63,7 @@ public class ViewportElm extends BoxElm {
         // Draw a blue dashed rectangle to distinguish from regular boxes
         // Use 30% alpha for a fainter outline (unless highlighted)
         if (!needsHighlight()) {
-            g.context.setGlobalAlpha(0.3);
+            g.setGlobalAlpha(0.3);
         }
         g.setColor(needsHighlight() ? selectColor : viewportColor);
         setBbox(x, y, x2, y2);
@@ -93,7 +93,7 @@ public class ViewportElm extends BoxElm {
         
         // Restore full opacity
         if (!needsHighlight()) {
-            g.context.setGlobalAlpha(1.0);
+            g.setGlobalAlpha(1.0);
         }
     }
 
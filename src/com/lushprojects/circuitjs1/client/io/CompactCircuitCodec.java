@@ -0,0 +1,496 @@
+package com.lushprojects.circuitjs1.client.io;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+
+/**
+ * Compact binary encoding of the text circuit dump.
+ *
+ * <p>The text format produced by {@code CircuitIOService.dumpCircuit()} is kept
+ * as the canonical form; this codec only re-encodes it so that internal copies
+ * (undo stack, clipboard storage) and shared URLs are smaller and cheaper to
+ * move around. Round-tripping is exact: {@code decode(encode(s)).equals(s)}
+ * for any string.
+ *
+ * <p>Layout (all integers are unsigned LEB128 varints):
+ * <pre>
+ *   'C' 'J' 'B' version flags [rawLength]  body
+ *   body   = stringCount string* lineCount line*
+ *   string = charCount char*            (UTF-16 code units)
+ *   line   = tokenCount tokenHeader*    (tokens are the line split on ' ')
+ *   tokenHeader = index &lt;&lt; 2 | 0    string-table reference
+ *               = value &lt;&lt; 2 | 1    non-negative integer literal
+ *               = (-value-1) &lt;&lt; 2 | 2  negative integer literal
+ * </pre>
+ * Repeated names, equations and numbers therefore cost one small varint each.
+ * When {@link #FLAG_COMPRESSED} is set the body is additionally packed with a
+ * small LZ77 coder (pure Java, so it runs under GWT as well as on the JVM).
+ */
+public final class CompactCircuitCodec {
+
+    /** Prefix marking a base64url-encoded compact dump in string storage. */
+    public static final String STORAGE_PREFIX = "cjb1:";
+
+    static final int FLAG_COMPRESSED = 1;
+
+    private static final int VERSION = 1;
+    private static final int HEADER_LENGTH = 5;
+
+    private static final int KIND_STRING = 0;
+    private static final int KIND_INT = 1;
+    private static final int KIND_NEG_INT = 2;
+    // Integer literals up to 8 digits keep (value << 2) inside a positive int.
+    private static final int MAX_INT_DIGITS = 8;
+
+    private static final int MIN_MATCH = 4;
+    private static final int MAX_OFFSET = 65535;
+    private static final int HASH_BITS = 14;
+    private static final int HASH_MASK = (1 << HASH_BITS) - 1;
+
+    private static final char[] BASE64URL =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_".toCharArray();
+
+    private CompactCircuitCodec() {
+    }
+
+    // =========================================================================
+    // Public API
+    // =========================================================================
+
+    public static byte[] encode(String dump, boolean compress) {
+        ByteWriter body = new ByteWriter(dump.length() / 2 + 16);
+        encodeBody(dump, body);
+
+        ByteWriter out = new ByteWriter(body.size() + 16);
+        out.writeByte('C');
+        out.writeByte('J');
+        out.writeByte('B');
+        out.writeByte(VERSION);
+        if (compress) {
+            out.writeByte(FLAG_COMPRESSED);
+            out.writeVarint(body.size());
+            lzCompress(body.buffer(), body.size(), out);
+        } else {
+            out.writeByte(0);
+            out.writeBytes(body.buffer(), 0, body.size());
+        }
+        return out.toByteArray();
+    }
+
+    /**
+     * Decode bytes produced by {@link #encode(String, boolean)}.
+     *
+     * @throws IllegalArgumentException if the data is not a valid compact dump
+     */
+    public static String decode(byte[] data) {
+        if (!isCompact(data))
+            throw new IllegalArgumentException("not a compact circuit dump");
+        if (data[3] != VERSION)
+            throw new IllegalArgumentException("unsupported compact dump version " + data[3]);
+        int flags = data[4];
+        ByteReader header = new ByteReader(data, HEADER_LENGTH, data.length);
+        byte[] body;
+        int bodyLength;
+        if ((flags & FLAG_COMPRESSED) != 0) {
+            bodyLength = header.readVarint();
+            body = lzDecompress(data, header.position(), data.length, bodyLength);
+        } else {
+            body = data;
+            bodyLength = data.length;
+        }
+        int bodyStart = (flags & FLAG_COMPRESSED) != 0 ? 0 : HEADER_LENGTH;
+        return decodeBody(new ByteReader(body, bodyStart, bodyLength));
+    }
+
+    public static boolean isCompact(byte[] data) {
+        return data != null && data.length >= HEADER_LENGTH
+            && data[0] == 'C' && data[1] == 'J' && data[2] == 'B';
+    }
+
+    /** Compressed compact encoding as URL-safe base64 (no padding). */
+    public static String encodeToBase64Url(String dump) {
+        return toBase64Url(encode(dump, true));
+    }
+
+    public static String decodeFromBase64Url(String text) {
+        return decode(fromBase64Url(text));
+    }
+
+    /** Encode for string-only storage such as localStorage. */
+    public static String encodeForStorage(String dump) {
+        if (dump == null)
+            return null;
+        return STORAGE_PREFIX + encodeToBase64Url(dump);
+    }
+
+    /**
+     * Decode a value written by {@link #encodeForStorage(String)}. Plain text
+     * dumps (anything without the prefix) are returned unchanged.
+     */
+    public static String decodeFromStorage(String stored) {
+        if (!isStorageEncoded(stored))
+            return stored;
+        return decodeFromBase64Url(stored.substring(STORAGE_PREFIX.length()));
+    }
+
+    public static boolean isStorageEncoded(String stored) {
+        return stored != null && stored.startsWith(STORAGE_PREFIX);
+    }
+
+    // =========================================================================
+    // Token body
+    // =========================================================================
+
+    private static void encodeBody(String dump, ByteWriter out) {
+        HashMap<String, Integer> stringIndex = new HashMap<String, Integer>();
+        ArrayList<String> strings = new ArrayList<String>();
+        ByteWriter lines = new ByteWriter(dump.length() / 2 + 16);
+
+        int lineCount = 0;
+        int len = dump.length();
+        int lineStart = 0;
+        while (true) {
+            int lineEnd = dump.indexOf('\n', lineStart);
+            if (lineEnd < 0)
+                lineEnd = len;
+            encodeLine(dump, lineStart, lineEnd, lines, stringIndex, strings);
+            lineCount++;
+            if (lineEnd >= len)
+                break;
+            lineStart = lineEnd + 1;
+        }
+
+        out.writeVarint(strings.size());
+        for (int i = 0; i < strings.size(); i++) {
+            String s = strings.get(i);
+            out.writeVarint(s.length());
+            for (int c = 0; c < s.length(); c++)
+                out.writeVarint(s.charAt(c));
+        }
+        out.writeVarint(lineCount);
+        out.writeBytes(lines.buffer(), 0, lines.size());
+    }
+
+    private static void encodeLine(String dump, int start, int end, ByteWriter out,
+                                   HashMap<String, Integer> stringIndex, ArrayList<String> strings) {
+        if (start == end) {
+            out.writeVarint(0);
+            return;
+        }
+        int tokenCount = 1;
+        for (int i = start; i < end; i++)
+            if (dump.charAt(i) == ' ')
+                tokenCount++;
+        out.writeVarint(tokenCount);
+
+        int tokStart = start;
+        for (int i = start; i <= end; i++) {
+            if (i < end && dump.charAt(i) != ' ')
+                continue;
+            String tok = dump.substring(tokStart, i);
+            int value = parseCompactInt(tok);
+            if (value >= 0) {
+                out.writeVarint((value << 2) | KIND_INT);
+            } else if (value != Integer.MIN_VALUE) {
+                out.writeVarint(((-value - 1) << 2) | KIND_NEG_INT);
+            } else {
+                Integer idx = stringIndex.get(tok);
+                if (idx == null) {
+                    idx = Integer.valueOf(strings.size());
+                    stringIndex.put(tok, idx);
+                    strings.add(tok);
+                }
+                out.writeVarint((idx.intValue() << 2) | KIND_STRING);
+            }
+            tokStart = i + 1;
+        }
+    }
+
+    /**
+     * Parse a token that can be stored as an integer literal without changing its
+     * text form (no sign on zero, no leading zeros, at most 8 digits).
+     * Returns Integer.MIN_VALUE if the token must go to the string table.
+     */
+    private static int parseCompactInt(String tok) {
+        int n = tok.length();
+        boolean neg = n > 0 && tok.charAt(0) == '-';
+        int digitStart = neg ? 1 : 0;
+        int digits = n - digitStart;
+        if (digits < 1 || digits > MAX_INT_DIGITS)
+            return Integer.MIN_VALUE;
+        if (tok.charAt(digitStart) == '0' && (digits > 1 || neg))
+            return Integer.MIN_VALUE;
+        int v = 0;
+        for (int i = digitStart; i < n; i++) {
+            char c = tok.charAt(i);
+            if (c < '0' || c > '9')
+                return Integer.MIN_VALUE;
+            v = v * 10 + (c - '0');
+        }
+        return neg ? -v : v;
+    }
+
+    private static String decodeBody(ByteReader in) {
+        int stringCount = in.readVarint();
+        String[] strings = new String[stringCount];
+        StringBuilder sb = new StringBuilder();
+        for (int i = 0; i < stringCount; i++) {
+            int chars = in.readVarint();
+            sb.setLength(0);
+            for (int c = 0; c < chars; c++)
+                sb.append((char) in.readVarint());
+            strings[i] = sb.toString();
+        }
+
+        int lineCount = in.readVarint();
+        StringBuilder out = new StringBuilder();
+        for (int line = 0; line < lineCount; line++) {
+            if (line > 0)
+                out.append('\n');
+            int tokenCount = in.readVarint();
+            for (int t = 0; t < tokenCount; t++) {
+                if (t > 0)
+                    out.append(' ');
+                int header = in.readVarint();
+                int payload = header >>> 2;
+                switch (header & 3) {
+                case KIND_INT:
+                    out.append(payload);
+                    break;
+                case KIND_NEG_INT:
+                    out.append(-payload - 1);
+                    break;
+                case KIND_STRING:
+                    if (payload >= stringCount)
+                        throw new IllegalArgumentException("bad string index " + payload);
+                    out.append(strings[payload]);
+                    break;
+                default:
+                    throw new IllegalArgumentException("bad token kind");
+                }
+            }
+        }
+        return out.toString();
+    }
+
+    // =========================================================================
+    // LZ77 packing
+    // =========================================================================
+
+    /**
+     * Sequence format: literalCount literals [offset matchLength-MIN_MATCH]...
+     * The stream always ends with a literal run (possibly empty).
+     */
+    static void lzCompress(byte[] in, int len, ByteWriter out) {
+        // Stores position+1 so the zero-initialized table means "empty".
+        int[] table = new int[1 << HASH_BITS];
+        int anchor = 0;
+        int i = 0;
+        while (i + MIN_MATCH <= len) {
+            int h = hash4(in, i);
+            int candidate = table[h] - 1;
+            table[h] = i + 1;
+            if (candidate >= 0 && i - candidate <= MAX_OFFSET
+                    && in[candidate] == in[i] && in[candidate + 1] == in[i + 1]
+                    && in[candidate + 2] == in[i + 2] && in[candidate + 3] == in[i + 3]) {
+                int m = MIN_MATCH;
+                while (i + m < len && in[candidate + m] == in[i + m])
+                    m++;
+                out.writeVarint(i - anchor);
+                out.writeBytes(in, anchor, i - anchor);
+                out.writeVarint(i - candidate);
+                out.writeVarint(m - MIN_MATCH);
+                i += m;
+                anchor = i;
+            } else {
+                i++;
+            }
+        }
+        out.writeVarint(len - anchor);
+        out.writeBytes(in, anchor, len - anchor);
+    }
+
+    static byte[] lzDecompress(byte[] data, int start, int end, int rawLength) {
+        byte[] out = new byte[rawLength];
+        ByteReader in = new ByteReader(data, start, end);
+        int op = 0;
+        while (true) {
+            int literals = in.readVarint();
+            if (literals > rawLength - op)
+                throw new IllegalArgumentException("literal run overflows output");
+            in.readBytes(out, op, literals);
+            op += literals;
+            if (in.atEnd())
+                break;
+            int offset = in.readVarint();
+            int matchLength = in.readVarint() + MIN_MATCH;
+            if (offset <= 0 || offset > op || matchLength > rawLength - op)
+                throw new IllegalArgumentException("bad back-reference");
+            for (int k = 0; k < matchLength; k++, op++)
+                out[op] = out[op - offset];
+        }
+        if (op != rawLength)
+            throw new IllegalArgumentException("compressed body length mismatch");
+        return out;
+    }
+
+    private static int hash4(byte[] b, int i) {
+        int v = (b[i] & 0xff) | ((b[i + 1] & 0xff) << 8) | ((b[i + 2] & 0xff) << 16) | ((b[i + 3] & 0xff) << 24);
+        return (v ^ (v >>> 11) ^ (v >>> 21)) & HASH_MASK;
+    }
+
+    // =========================================================================
+    // base64url
+    // =========================================================================
+
+    static String toBase64Url(byte[] data) {
+        StringBuilder sb = new StringBuilder((data.length * 4 + 2) / 3);
+        int i = 0;
+        for (; i + 2 < data.length; i += 3) {
+            int v = ((data[i] & 0xff) << 16) | ((data[i + 1] & 0xff) << 8) | (data[i + 2] & 0xff);
+            sb.append(BASE64URL[(v >>> 18) & 63]).append(BASE64URL[(v >>> 12) & 63])
+              .append(BASE64URL[(v >>> 6) & 63]).append(BASE64URL[v & 63]);
+        }
+        int rem = data.length - i;
+        if (rem == 1) {
+            int v = (data[i] & 0xff) << 16;
+            sb.append(BASE64URL[(v >>> 18) & 63]).append(BASE64URL[(v >>> 12) & 63]);
+        } else if (rem == 2) {
+            int v = ((data[i] & 0xff) << 16) | ((data[i + 1] & 0xff) << 8);
+            sb.append(BASE64URL[(v >>> 18) & 63]).append(BASE64URL[(v >>> 12) & 63])
+              .append(BASE64URL[(v >>> 6) & 63]);
+        }
+        return sb.toString();
+    }
+
+    static byte[] fromBase64Url(String text) {
+        int n = text.length();
+        while (n > 0 && text.charAt(n - 1) == '=')
+            n--;
+        if (n % 4 == 1)
+            throw new IllegalArgumentException("bad base64url length");
+        byte[] out = new byte[n * 3 / 4];
+        int op = 0;
+        int acc = 0;
+        int bits = 0;
+        for (int i = 0; i < n; i++) {
+            acc = (acc << 6) | base64Value(text.charAt(i));
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                out[op++] = (byte) (acc >>> bits);
+                acc &= (1 << bits) - 1;
+            }
+        }
+        return out;
+    }
+
+    private static int base64Value(char c) {
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+        if (c >= '0' && c <= '9') return c - '0' + 52;
+        // Accept the standard alphabet too, for values pasted from other tools.
+        if (c == '-' || c == '+') return 62;
+        if (c == '_' || c == '/') return 63;
+        throw new IllegalArgumentException("bad base64url character '" + c + "'");
+    }
+
+    // =========================================================================
+    // Byte buffers
+    // =========================================================================
+
+    static final class ByteWriter {
+        private byte[] buf;
+        private int size;
+
+        ByteWriter(int capacity) {
+            buf = new byte[Math.max(16, capacity)];
+        }
+
+        private void ensure(int extra) {
+            if (size + extra <= buf.length)
+                return;
+            int cap = Math.max(buf.length * 2, size + extra);
+            byte[] nb = new byte[cap];
+            System.arraycopy(buf, 0, nb, 0, size);
+            buf = nb;
+        }
+
+        void writeByte(int b) {
+            ensure(1);
+            buf[size++] = (byte) b;
+        }
+
+        void writeBytes(byte[] src, int off, int len) {
+            ensure(len);
+            System.arraycopy(src, off, buf, size, len);
+            size += len;
+        }
+
+        void writeVarint(int v) {
+            ensure(5);
+            while ((v & ~0x7f) != 0) {
+                buf[size++] = (byte) ((v & 0x7f) | 0x80);
+                v >>>= 7;
+            }
+            buf[size++] = (byte) v;
+        }
+
+        byte[] buffer() {
+            return buf;
+        }
+
+        int size() {
+            return size;
+        }
+
+        byte[] toByteArray() {
+            byte[] out = new byte[size];
+            System.arraycopy(buf, 0, out, 0, size);
+            return out;
+        }
+    }
+
+    static final class ByteReader {
+        private final byte[] buf;
+        private final int end;
+        private int pos;
+
+        ByteReader(byte[] buf, int start, int end) {
+            this.buf = buf;
+            this.pos = start;
+            this.end = end;
+        }
+
+        int position() {
+            return pos;
+        }
+
+        boolean atEnd() {
+            return pos >= end;
+        }
+
+        int readVarint() {
+            int result = 0;
+            int shift = 0;
+            while (true) {
+                if (pos >= end)
+                    throw new IllegalArgumentException("truncated compact dump");
+                int b = buf[pos++] & 0xff;
+                result |= (b & 0x7f) << shift;
+                if ((b & 0x80) == 0)
+                    return result;
+                shift += 7;
+                if (shift > 28)
+                    throw new IllegalArgumentException("varint too long");
+            }
+        }
+
+        void readBytes(byte[] dst, int off, int len) {
+            if (len > end - pos)
+                throw new IllegalArgumentException("truncated compact dump");
+            System.arraycopy(buf, pos, dst, off, len);
+            pos += len;
+        }
+    }
+}
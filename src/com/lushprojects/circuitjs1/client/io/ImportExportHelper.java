@@ -1,5 +1,6 @@
 package com.lushprojects.circuitjs1.client.io;
 
+import com.google.gwt.user.client.Command;
 import com.lushprojects.circuitjs1.client.CirSim;
 import com.lushprojects.circuitjs1.client.CircuitElm;
 import com.lushprojects.circuitjs1.client.util.StringTokenizer;
@@ -33,6 +34,24 @@ public class ImportExportHelper {
         }
     }
 
+    /**
+     * Interactive variant of {@link #importCircuitFromText}: a large paste is
+     * built over several frames with a progress display instead of freezing
+     * the page. Script callers keep the synchronous form.
+     */
+    public void importCircuitFromTextIncremental(String circuitText, boolean subcircuitsOnly) {
+        int flags = subcircuitsOnly
+                ? (sim.getImportSubcircuitsFlagForImportExport() | sim.getImportRetainFlagForImportExport())
+                : 0;
+        if (circuitText != null) {
+            sim.readCircuitFromImportHelperIncremental(circuitText, flags, new Command() {
+                public void execute() {
+                    sim.setAllowSaveFromImportHelper(false);
+                }
+            });
+        }
+    }
+
     public void importCircuitFromCTZ(String ctzData, boolean subcircuitsOnly) {
         if (ctzData != null && !ctzData.isEmpty()) {
             String circuitText = sim.decompressForImportHelper(ctzData);
@@ -65,6 +84,7 @@ public class ImportExportHelper {
         dump += "% equationTableMnaMode " + (sim.isEquationTableMnaModeForExport() ? "true" : "false") + "\n";
         dump += "% equationTableNewtonJacobianEnabled " + (sim.isEquationTableNewtonJacobianEnabledForExport() ? "true" : "false") + "\n";
         dump += "% equationTableBroydenJacobianEnabled " + (sim.isEquationTableBroydenJacobianEnabledForExport() ? "true" : "false") + "\n";
+        dump += "% equationTableAndersonAccelerationEnabled " + (sim.isEquationTableAndersonAccelerationEnabledForExport() ? "true" : "false") + "\n";
         dump += "% equationTableConvergenceTolerance " + sim.getEquationTableConvergenceToleranceForExport() + "\n";
         dump += "% sfcrLookupClampDefault " + (sim.isSfcrLookupClampDefaultForExport() ? "true" : "false") + "\n";
         dump += "% convergenceCheckThreshold " + sim.getConvergenceCheckThresholdForExport() + "\n";
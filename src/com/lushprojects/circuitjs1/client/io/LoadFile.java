@@ -20,6 +20,7 @@
 package com.lushprojects.circuitjs1.client.io;
 
 
+import com.google.gwt.user.client.Command;
 import com.google.gwt.user.client.ui.FileUpload;
 import com.google.gwt.event.dom.client.ChangeEvent;
 import com.google.gwt.event.dom.client.ChangeHandler;
@@ -96,15 +97,18 @@ public class LoadFile extends FileUpload implements  ChangeHandler {
 	    return window != null && window.getFile() != null && window.getFileReader() != null;
 	}
 	
-	static public void doLoadCallback(String s, String t) {
+	static public void doLoadCallback(String s, final String t) {
 		CirSim.console("Loading local file: " + t);
 		sim.pushUndoForUi();
-		sim.readCircuitFromModel(s);
-		sim.createNewLoadFileInputForIo();
-		sim.setCircuitTitleForIo(t);
-		sim.getSFCRDocumentManager().setCurrentCircuitFile("local: " + t);
-		ExportAsLocalFileDialog.setLastFileName(t);
-		sim.setUnsavedChangesForIo(false);
+		sim.readCircuitFromModelIncremental(s, new Command() {
+			public void execute() {
+				sim.createNewLoadFileInputForIo();
+				sim.setCircuitTitleForIo(t);
+				sim.getSFCRDocumentManager().setCurrentCircuitFile("local: " + t);
+				ExportAsLocalFileDialog.setLastFileName(t);
+				sim.setUnsavedChangesForIo(false);
+			}
+		});
 	}
 	
 	public LoadFile(CirSim s) {
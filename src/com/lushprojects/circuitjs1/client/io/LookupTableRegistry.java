@@ -1,10 +1,16 @@
 package com.lushprojects.circuitjs1.client.io;
 
+import com.lushprojects.circuitjs1.client.core.NumericKernels;
+
 import java.util.ArrayList;
 import java.util.HashMap;
 
 /**
  * Runtime registry for SFCR lookup tables used by Expr.lookup(...).
+ *
+ * Registered tables keep their breakpoints as plain arrays, so a lookup
+ * from the expression evaluator does no unboxing and goes through the same
+ * {@link NumericKernels} interpolation as a batched {@link #evaluateAll}.
  */
 public final class LookupTableRegistry {
 
@@ -14,19 +20,25 @@ public final class LookupTableRegistry {
         public String resolvedScope;
     }
 
-    private static HashMap<String, LookupDefinition> globalTables;
-    private static HashMap<String, HashMap<String, LookupDefinition>> scopedTables;
-    private static HashMap<String, LookupDefinition> defaultByName;
+    /** A registered copy of a definition with its breakpoints unboxed. */
+    private static final class StoredLookup extends LookupDefinition {
+        double[] xArray;
+        double[] yArray;
+    }
+
+    private static HashMap<String, StoredLookup> globalTables;
+    private static HashMap<String, HashMap<String, StoredLookup>> scopedTables;
+    private static HashMap<String, StoredLookup> defaultByName;
 
     private static void ensureInitialized() {
         if (globalTables == null) {
-            globalTables = new HashMap<String, LookupDefinition>();
+            globalTables = new HashMap<String, StoredLookup>();
         }
         if (scopedTables == null) {
-            scopedTables = new HashMap<String, HashMap<String, LookupDefinition>>();
+            scopedTables = new HashMap<String, HashMap<String, StoredLookup>>();
         }
         if (defaultByName == null) {
-            defaultByName = new HashMap<String, LookupDefinition>();
+            defaultByName = new HashMap<String, StoredLookup>();
         }
     }
 
@@ -50,17 +62,17 @@ public final class LookupTableRegistry {
 
         String normalizedName = SFCRUtil.normalizeVariableName(def.name);
         if (def.scope == null || def.scope.isEmpty()) {
-            LookupDefinition stored = copyDefinition(def, normalizedName, null);
+            StoredLookup stored = copyDefinition(def, normalizedName, null);
             globalTables.put(normalizedName, stored);
             defaultByName.put(normalizedName, stored);
         } else {
             String normalizedScope = SFCRUtil.sanitizeName(def.scope);
-            HashMap<String, LookupDefinition> byScope = scopedTables.get(normalizedScope);
+            HashMap<String, StoredLookup> byScope = scopedTables.get(normalizedScope);
             if (byScope == null) {
-                byScope = new HashMap<String, LookupDefinition>();
+                byScope = new HashMap<String, StoredLookup>();
                 scopedTables.put(normalizedScope, byScope);
             }
-            LookupDefinition stored = copyDefinition(def, normalizedName, normalizedScope);
+            StoredLookup stored = copyDefinition(def, normalizedName, normalizedScope);
             byScope.put(normalizedName, stored);
             // Only become default if there is no global/default for that bare name.
             if (!defaultByName.containsKey(normalizedName) && !globalTables.containsKey(normalizedName)) {
@@ -89,11 +101,27 @@ public final class LookupTableRegistry {
     }
 
     public static double evaluate(String lookupName, double x, boolean clamp) {
-        LookupDefinition table = getTable(lookupName);
-        if (table == null || table.xs.isEmpty()) {
+        StoredLookup table = getTable(lookupName);
+        if (table == null) {
             return 0.0;
         }
-        return interpolate(table, x, clamp);
+        return NumericKernels.interpolateOne(table.xArray, table.yArray, table.xArray.length, x, clamp);
+    }
+
+    /**
+     * Evaluate a lookup at {@code count} points in one call (out[i] for x[i]),
+     * giving the same values as {@link #evaluate} but through
+     * {@link NumericKernels} so the JVM runner can vectorize it.
+     */
+    public static void evaluateAll(String lookupName, double[] x, double[] out, int count, boolean clamp) {
+        StoredLookup table = getTable(lookupName);
+        if (table == null) {
+            for (int i = 0; i < count; i++) {
+                out[i] = 0.0;
+            }
+            return;
+        }
+        NumericKernels.get().interpolate(table.xArray, table.yArray, table.xArray.length, x, out, count, clamp);
     }
 
     public static LookupTableSnapshot getSnapshot(String scopeName, String tableName) {
@@ -112,7 +140,7 @@ public final class LookupTableRegistry {
 
         if (scopeName != null && !scopeName.isEmpty()) {
             String normalizedScope = SFCRUtil.sanitizeName(scopeName);
-            HashMap<String, LookupDefinition> byScope = scopedTables.get(normalizedScope);
+            HashMap<String, StoredLookup> byScope = scopedTables.get(normalizedScope);
             if (byScope != null) {
                 table = byScope.get(normalizedName);
                 if (table != null) {
@@ -140,7 +168,7 @@ public final class LookupTableRegistry {
         return snapshot;
     }
 
-    private static LookupDefinition getTable(String lookupName) {
+    private static StoredLookup getTable(String lookupName) {
         if (lookupName == null) {
             return null;
         }
@@ -155,9 +183,9 @@ public final class LookupTableRegistry {
         if (scopeSep > 0 && scopeSep < raw.length() - 1) {
             String scope = SFCRUtil.sanitizeName(raw.substring(0, scopeSep));
             String name = SFCRUtil.normalizeVariableName(raw.substring(scopeSep + 1));
-            HashMap<String, LookupDefinition> byScope = scopedTables.get(scope);
+            HashMap<String, StoredLookup> byScope = scopedTables.get(scope);
             if (byScope != null) {
-                LookupDefinition scoped = byScope.get(name);
+                StoredLookup scoped = byScope.get(name);
                 if (scoped != null) {
                     return scoped;
                 }
@@ -167,7 +195,7 @@ public final class LookupTableRegistry {
         }
 
         String normalized = SFCRUtil.normalizeVariableName(raw);
-        LookupDefinition global = globalTables.get(normalized);
+        StoredLookup global = globalTables.get(normalized);
         if (global != null) {
             return global;
         }
@@ -185,7 +213,7 @@ public final class LookupTableRegistry {
         for (LookupDefinition table : globalTables.values()) {
             appendDumpLine(sb, table, null);
         }
-        for (java.util.Map.Entry<String, HashMap<String, LookupDefinition>> entry : scopedTables.entrySet()) {
+        for (java.util.Map.Entry<String, HashMap<String, StoredLookup>> entry : scopedTables.entrySet()) {
             String scope = entry.getKey();
             for (LookupDefinition table : entry.getValue().values()) {
                 appendDumpLine(sb, table, scope);
@@ -209,62 +237,20 @@ public final class LookupTableRegistry {
         sb.append("\n");
     }
 
-    private static LookupDefinition copyDefinition(LookupDefinition src, String normalizedName, String normalizedScope) {
-        LookupDefinition copy = new LookupDefinition();
+    private static StoredLookup copyDefinition(LookupDefinition src, String normalizedName, String normalizedScope) {
+        StoredLookup copy = new StoredLookup();
         copy.name = normalizedName;
         copy.scope = normalizedScope;
-        for (int i = 0; i < src.xs.size(); i++) {
+        int n = src.xs.size();
+        copy.xArray = new double[n];
+        copy.yArray = new double[n];
+        for (int i = 0; i < n; i++) {
             copy.xs.add(src.xs.get(i));
             copy.ys.add(src.ys.get(i));
+            copy.xArray[i] = src.xs.get(i).doubleValue();
+            copy.yArray[i] = src.ys.get(i).doubleValue();
         }
         copy.comments.addAll(src.comments);
         return copy;
     }
-
-    private static double interpolate(LookupDefinition table, double x, boolean clamp) {
-        int n = table.xs.size();
-        if (n == 1) {
-            return table.ys.get(0).doubleValue();
-        }
-
-        double x0 = table.xs.get(0).doubleValue();
-        double y0 = table.ys.get(0).doubleValue();
-        double x1 = table.xs.get(1).doubleValue();
-        double y1 = table.ys.get(1).doubleValue();
-
-        if (x < x0) {
-            if (clamp) {
-                return y0;
-            }
-            return linearInterpolate(x, x0, y0, x1, y1);
-        }
-
-        int i = 2;
-        while (true) {
-            if (x < x1) {
-                return linearInterpolate(x, x0, y0, x1, y1);
-            }
-            if (i >= n) {
-                break;
-            }
-            x0 = x1;
-            y0 = y1;
-            x1 = table.xs.get(i).doubleValue();
-            y1 = table.ys.get(i).doubleValue();
-            i++;
-        }
-
-        if (clamp) {
-            return y1;
-        }
-        return linearInterpolate(x, x0, y0, x1, y1);
-    }
-
-    private static double linearInterpolate(double x, double x0, double y0, double x1, double y1) {
-        double dx = x1 - x0;
-        if (Math.abs(dx) < 1e-12) {
-            return y0;
-        }
-        return y0 + (x - x0) * (y1 - y0) / dx;
-    }
 }
@@ -2,10 +2,12 @@ package com.lushprojects.circuitjs1.client.io;
 
 
 import com.google.gwt.user.client.ui.MenuItem;
+import com.lushprojects.circuitjs1.client.io.sfcr.SFCRExportCache;
 import com.lushprojects.circuitjs1.client.runner.RuntimeMode;
 
 public final class SFCRDocumentManager {
     private final SFCRDocumentState state = new SFCRDocumentState();
+    private final SFCRExportCache exportCache = new SFCRExportCache();
     private MenuItem fileModelInfoMenuItem;
     private MenuItem helpModelInfoMenuItem;
 
@@ -13,6 +15,11 @@ public final class SFCRDocumentManager {
         return state;
     }
 
+    /** Exported SFCR blocks reused across exports of this document. */
+    public SFCRExportCache getExportCache() {
+        return exportCache;
+    }
+
     public void bindModelInfoMenuItems(MenuItem fileItem, MenuItem helpItem) {
         fileModelInfoMenuItem = fileItem;
         helpModelInfoMenuItem = helpItem;
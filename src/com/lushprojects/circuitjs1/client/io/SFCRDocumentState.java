@@ -9,15 +9,23 @@ public class SFCRDocumentState {
     private String modelInfoContent;
     private String modelInfoSourceText;
     private String currentCircuitFile;
+    private int blockCommentsVersion;
 
     public void clearBlockComments() {
         blockComments.clear();
+        blockCommentsVersion++;
+    }
+
+    /** Change counter for the block comments, for validating cached exports. */
+    public int getBlockCommentsVersion() {
+        return blockCommentsVersion;
     }
 
     public void setBlockComments(String key, Vector<String> comments) {
         if (key == null || key.length() == 0) {
             return;
         }
+        blockCommentsVersion++;
         if (comments == null || comments.size() == 0) {
             blockComments.remove(key);
             return;
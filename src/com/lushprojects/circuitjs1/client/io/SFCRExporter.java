@@ -13,10 +13,12 @@ import com.lushprojects.circuitjs1.client.elements.economics.SFCSankeyElm;
 import com.lushprojects.circuitjs1.client.elements.economics.SFCTableElm;
 import com.lushprojects.circuitjs1.client.elements.misc.ActionTimeElm;
 
+import java.io.IOException;
 import java.util.ArrayList;
 
 import com.lushprojects.circuitjs1.client.CircuitElm;
 import com.lushprojects.circuitjs1.client.CirSim;
+import com.lushprojects.circuitjs1.client.io.sfcr.SFCRBlankLineNormalizer;
 import com.lushprojects.circuitjs1.client.io.sfcr.SFCRBlockExportHandlerRegistry;
 import com.lushprojects.circuitjs1.client.io.sfcr.SFCRExportContext;
 import com.lushprojects.circuitjs1.client.io.sfcr.SFCRTemplateMerger;
@@ -84,40 +86,70 @@ public class SFCRExporter {
 
     /** Export the current circuit in SFCR format. */
     public String export() {
+        StringBuilder sb = new StringBuilder();
+        try {
+            export(sb);
+        } catch (IOException e) {
+            // StringBuilder does not throw
+        }
+        return sb.toString();
+    }
+
+    /**
+     * Export the current circuit in SFCR format, writing each block to out as
+     * it is produced (blank lines are normalized on the way through), so large
+     * documents are not copied as a whole. Table and Sankey blocks whose
+     * element has not changed since the previous export are reused from the
+     * document's export cache.
+     */
+    public void export(Appendable out) throws IOException {
         SFCRExportContext ctx = new SFCRExportContext(sim, exportSyntax);
         ctx.clearScopeElmsExportedAsBlocks();
         categorizeElements(ctx);
         ctx.resetLookupExportState();
+        ctx.beginBlockCache();
+        try {
+            exportTo(new SFCRBlankLineNormalizer(out), ctx);
+        } finally {
+            ctx.endBlockCache();
+        }
+    }
 
+    private void exportTo(SFCRBlankLineNormalizer out, SFCRExportContext ctx) throws IOException {
         if (sim != null && sim.getSFCRDocumentManager().getModelInfoSourceText() != null
                 && !sim.getSFCRDocumentManager().getModelInfoSourceText().trim().isEmpty()) {
             ctx.seedLookupNamesFromTemplate(sim.getSFCRDocumentManager().getModelInfoSourceText());
             String merged = SFCRTemplateMerger.export(
                     sim.getSFCRDocumentManager().getModelInfoSourceText(), ctx);
             if (merged != null && !merged.trim().isEmpty()) {
-                return SFCRTemplateMerger.normalizeBlankLinesOutsideFences(merged);
+                out.append(merged);
+                out.finish();
+                return;
             }
         }
 
-        StringBuilder sb = new StringBuilder();
-        sb.append("# CircuitJS1 SFCR Export\n");
-        sb.append("# Generated from circuit simulation\n");
-        sb.append("\n");
+        out.append("# CircuitJS1 SFCR Export\n");
+        out.append("# Generated from circuit simulation\n");
+        out.append("\n");
 
+        // every block written ends in a newline (see SFCRExportContext.appendExportBlock)
         for (SFCRBlockExportHandler handler : SFCRBlockExportHandlerRegistry.getOrderedHandlers()) {
-            ctx.appendExportBlock(sb, handler.export(ctx));
+            String block = handler.export(ctx);
+            if (block == null || block.isEmpty()) {
+                continue;
+            }
+            out.append(block);
+            if (!block.endsWith("\n")) {
+                out.append('\n');
+            }
         }
 
         String inlineDocs = SFCRTemplateMerger.exportInlineDocumentation(sim);
         if (!inlineDocs.isEmpty()) {
-            if (sb.length() > 0 && sb.charAt(sb.length() - 1) != '\n') {
-                sb.append("\n");
-            }
-            sb.append("\n");
-            sb.append(inlineDocs);
+            out.append("\n");
+            out.append(inlineDocs);
         }
-
-        return SFCRTemplateMerger.normalizeBlankLinesOutsideFences(sb.toString());
+        out.finish();
     }
 
     // =========================================================================
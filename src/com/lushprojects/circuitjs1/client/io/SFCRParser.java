@@ -116,6 +116,14 @@ public class SFCRParser {
     /** Context holding all mutable parse state. Populated after {@link #parse(String)}. */
     private SFCRParseContext ctx;
 
+    /** Cursor state of a resumable parse ({@link #beginParse} .. {@link #finishParse}). */
+    private String[] parseLines;
+    private int parseIndex;
+    private Vector<String> pendingBlockComments;
+    private boolean inFence;
+    private boolean pendingCommentsConsumedInFence;
+    private boolean parseFailed;
+
     // =========================================================================
     // GWT-independent helpers (usable from plain-Java unit tests)
     // =========================================================================
@@ -411,6 +419,24 @@ public class SFCRParser {
 
     /** Parse SFCR-format text and create circuit elements. */
     public boolean parse(String text) {
+        if (!beginParse(text)) {
+            return false;
+        }
+        while (parseNextBlock()) {
+        }
+        return finishParse();
+    }
+
+    /**
+     * First stage of a resumable parse: normalize the text, reset registries and
+     * pre-scan @init/@lookup settings. Element construction happens in
+     * {@link #parseNextBlock()} so a caller can spread a large file over several
+     * frames; {@link #parse(String)} runs all stages back to back.
+     */
+    public boolean beginParse(String text) {
+        parseLines = null;
+        parseIndex = 0;
+        parseFailed = false;
         if (text == null || text.trim().isEmpty()) {
             return false;
         }
@@ -433,112 +459,53 @@ public class SFCRParser {
             String[] lines = normalizedText.split("\n");
             preScanInitLookupSettings(lines, ctx);
             preScanLookupTables(lines, ctx);
-            int i = 0;
-            Vector<String> pendingBlockComments = new Vector<String>();
-            boolean inFence = false;
-            boolean pendingCommentsConsumedInFence = false;
-            
-            while (i < lines.length) {
-                String line = lines[i].trim();
-                
-                // Skip empty lines (preserve pending comments across blank separators)
-                if (line.isEmpty()) {
-                    i++;
-                    continue;
-                }
-
-                if (line.startsWith("@startuml")) {
-                    if (inFence) pendingCommentsConsumedInFence = true;
-                    storePendingBlockComments(SFCRBlockCommentRegistry.TYPE_PLANTUML, "", pendingBlockComments);
-                    i = parseInlinePlantUmlBlock(lines, i, ctx);
-                    continue;
-                }
-
-                // Track markdown fences so pending headings/comments can attach to
-                // structural constructs inside fenced blocks (e.g. ```{r} ... sfcr_set ... ```).
-                if (line.startsWith("```")) {
-                    if (!inFence) {
-                        inFence = true;
-                        pendingCommentsConsumedInFence = false;
-                    } else {
-                        inFence = false;
-                        if (!pendingCommentsConsumedInFence) {
-                            pendingBlockComments.clear();
-                        }
-                    }
-                    i++;
-                    continue;
-                }
+            parseLines = lines;
+            pendingBlockComments = new Vector<String>();
+            inFence = false;
+            pendingCommentsConsumedInFence = false;
+            return true;
+        } catch (Exception e) {
+            CirSim.console("SFCRParser error: " + e.getMessage());
+            parseFailed = true;
+            return false;
+        }
+    }
 
-                // Track full-line comments/markdown so they can be attached to the next element block
-                if (line.startsWith("#")) {
-                    pendingBlockComments.add(lines[i]);
-                    i++;
-                    continue;
-                }
-                
-                // Preserve metadata comments (% prefix – no-op for now)
-                if (line.startsWith("%")) {
-                    i++;
-                    continue;
-                }
-                
-                // Parse block markers (R-style already normalized to block format)
-                if (line.startsWith("@")) {
-                    String directive = extractDirective(line);
-                    if ("@end".equals(directive)) {
-                        i++;
-                        continue;
-                    }
+    /**
+     * Parse the next line or block of a parse started with {@link #beginParse}.
+     * @return true while input remains
+     */
+    public boolean parseNextBlock() {
+        if (parseLines == null || parseFailed || parseIndex >= parseLines.length) {
+            return false;
+        }
+        try {
+            parseStep();
+        } catch (Exception e) {
+            CirSim.console("SFCRParser error: " + e.getMessage());
+            parseFailed = true;
+            return false;
+        }
+        return parseIndex < parseLines.length;
+    }
 
-                    boolean consumedPendingComments = false;
-                    if ("@matrix".equals(directive)) {
-                        if (inFence) pendingCommentsConsumedInFence = true;
-                        ctx.storePendingMatrixBlockComments(
-                            ctx.parseBlockHeader(line, "@matrix").name, pendingBlockComments);
-                        consumedPendingComments = true;
-                    } else if ("@equations".equals(directive) || "@parameters".equals(directive)) {
-                        if (inFence) pendingCommentsConsumedInFence = true;
-                        ctx.storePendingEquationsBlockComments(
-                            ctx.parseBlockHeader(line, directive).name, pendingBlockComments);
-                        consumedPendingComments = true;
-                    } else if ("@sankey".equals(directive)) {
-                        if (inFence) pendingCommentsConsumedInFence = true;
-                        storePendingBlockComments(SFCRBlockCommentRegistry.TYPE_SANKEY, "", pendingBlockComments);
-                        consumedPendingComments = true;
-                    } else if ("@startuml".equals(directive)) {
-                        if (inFence) pendingCommentsConsumedInFence = true;
-                        storePendingBlockComments(SFCRBlockCommentRegistry.TYPE_PLANTUML, "", pendingBlockComments);
-                        consumedPendingComments = true;
-                    } else if ("@scope".equals(directive) && ctx.looksLikeScopeBlock(lines, i)) {
-                        if (inFence) pendingCommentsConsumedInFence = true;
-                        storePendingBlockComments(SFCRBlockCommentRegistry.TYPE_SCOPE,
-                            extractScopeBlockName(line), pendingBlockComments);
-                        consumedPendingComments = true;
-                    }
+    /** Index of the next unparsed line, for progress reporting. */
+    public int getParseLineIndex() {
+        return parseLines == null ? 0 : Math.min(parseIndex, parseLines.length);
+    }
 
-                    if (!consumedPendingComments) {
-                        pendingBlockComments.clear();
-                    }
+    /** Total number of normalized lines in the current parse. */
+    public int getParseLineCount() {
+        return parseLines == null ? 0 : parseLines.length;
+    }
 
-                    SFCRBlockParseHandler handler = SFCRBlockParseHandlerRegistry.getHandler(directive);
-                    ParseResult result;
-                    if (handler != null) {
-                        result = handler.parse(lines, i, ctx);
-                    } else {
-                        result = unknownBlockParseHandler.parse(lines, i, ctx);
-                    }
-                    i = result.getNextIndex();
-                } else {
-                    // Preserve non-block inline markdown context (headings/prose) so it
-                    // can round-trip and remain associated with the next structural block.
-                    if (!inFence) {
-                        pendingBlockComments.add(lines[i]);
-                    }
-                    i++;
-                }
-            }
-            
+    /** Final stage: apply @init settings and register hints. */
+    public boolean finishParse() {
+        if (parseLines == null || parseFailed) {
+            return false;
+        }
+        parseLines = null;
+        try {
             // Apply init settings first (timestep, units, etc.)
             applyInitSettings();
             
@@ -555,6 +522,107 @@ public class SFCRParser {
         }
     }
 
+    private void parseStep() {
+        String line = parseLines[parseIndex].trim();
+
+        // Skip empty lines (preserve pending comments across blank separators)
+        if (line.isEmpty()) {
+            parseIndex++;
+            return;
+        }
+
+        if (line.startsWith("@startuml")) {
+            if (inFence) pendingCommentsConsumedInFence = true;
+            storePendingBlockComments(SFCRBlockCommentRegistry.TYPE_PLANTUML, "", pendingBlockComments);
+            parseIndex = parseInlinePlantUmlBlock(parseLines, parseIndex, ctx);
+            return;
+        }
+
+        // Track markdown fences so pending headings/comments can attach to
+        // structural constructs inside fenced blocks (e.g. ```{r} ... sfcr_set ... ```).
+        if (line.startsWith("```")) {
+            if (!inFence) {
+                inFence = true;
+                pendingCommentsConsumedInFence = false;
+            } else {
+                inFence = false;
+                if (!pendingCommentsConsumedInFence) {
+                    pendingBlockComments.clear();
+                }
+            }
+            parseIndex++;
+            return;
+        }
+
+        // Track full-line comments/markdown so they can be attached to the next element block
+        if (line.startsWith("#")) {
+            pendingBlockComments.add(parseLines[parseIndex]);
+            parseIndex++;
+            return;
+        }
+
+        // Preserve metadata comments (% prefix – no-op for now)
+        if (line.startsWith("%")) {
+            parseIndex++;
+            return;
+        }
+
+        // Parse block markers (R-style already normalized to block format)
+        if (line.startsWith("@")) {
+            String directive = extractDirective(line);
+            if ("@end".equals(directive)) {
+                parseIndex++;
+                return;
+            }
+
+            boolean consumedPendingComments = false;
+            if ("@matrix".equals(directive)) {
+                if (inFence) pendingCommentsConsumedInFence = true;
+                ctx.storePendingMatrixBlockComments(
+                    ctx.parseBlockHeader(line, "@matrix").name, pendingBlockComments);
+                consumedPendingComments = true;
+            } else if ("@equations".equals(directive) || "@parameters".equals(directive)) {
+                if (inFence) pendingCommentsConsumedInFence = true;
+                ctx.storePendingEquationsBlockComments(
+                    ctx.parseBlockHeader(line, directive).name, pendingBlockComments);
+                consumedPendingComments = true;
+            } else if ("@sankey".equals(directive)) {
+                if (inFence) pendingCommentsConsumedInFence = true;
+                storePendingBlockComments(SFCRBlockCommentRegistry.TYPE_SANKEY, "", pendingBlockComments);
+                consumedPendingComments = true;
+            } else if ("@startuml".equals(directive)) {
+                if (inFence) pendingCommentsConsumedInFence = true;
+                storePendingBlockComments(SFCRBlockCommentRegistry.TYPE_PLANTUML, "", pendingBlockComments);
+                consumedPendingComments = true;
+            } else if ("@scope".equals(directive) && ctx.looksLikeScopeBlock(parseLines, parseIndex)) {
+                if (inFence) pendingCommentsConsumedInFence = true;
+                storePendingBlockComments(SFCRBlockCommentRegistry.TYPE_SCOPE,
+                    extractScopeBlockName(line), pendingBlockComments);
+                consumedPendingComments = true;
+            }
+
+            if (!consumedPendingComments) {
+                pendingBlockComments.clear();
+            }
+
+            SFCRBlockParseHandler handler = SFCRBlockParseHandlerRegistry.getHandler(directive);
+            ParseResult result;
+            if (handler != null) {
+                result = handler.parse(parseLines, parseIndex, ctx);
+            } else {
+                result = unknownBlockParseHandler.parse(parseLines, parseIndex, ctx);
+            }
+            parseIndex = result.getNextIndex();
+        } else {
+            // Preserve non-block inline markdown context (headings/prose) so it
+            // can round-trip and remain associated with the next structural block.
+            if (!inFence) {
+                pendingBlockComments.add(parseLines[parseIndex]);
+            }
+            parseIndex++;
+        }
+    }
+
     public ArrayList<ParseWarning> getParseWarnings() {
         return ctx != null ? new ArrayList<ParseWarning>(ctx.getWarnings()) : new ArrayList<ParseWarning>();
     }
@@ -755,6 +823,11 @@ public class SFCRParser {
                     case "EqnTable Broyden Update":
                         sim.equationTableBroydenJacobianEnabled = parseBoolean(value, sim.equationTableBroydenJacobianEnabled);
                         break;
+                    case "equationTableAndersonAccelerationEnabled":
+                    case "eqnTableAndersonAcceleration":
+                    case "EqnTable Anderson Acceleration":
+                        sim.equationTableAndersonAccelerationEnabled = parseBoolean(value, sim.equationTableAndersonAccelerationEnabled);
+                        break;
                     case "equationTableTolerance":
                     case "equationTableConvergenceTolerance":
                         {
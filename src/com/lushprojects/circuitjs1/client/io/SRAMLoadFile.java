@@ -109,15 +109,22 @@ public class SRAMLoadFile extends EditDialogLoadFile {
 				doLoadCallback("0:");
 				return;
 			}
+			// one word per byte, handed to SRAMElm as an array instead of text
 			DataViewLike bytes = new DataViewLike(buffer);
-			StringBuilder text = new StringBuilder("0:");
-			for (int index = 0; index < buffer.getByteLength(); index++)
-				text.append(" ").append(bytes.getUint8(index));
-			doLoadCallback(text.toString());
+			int[] image = new int[buffer.getByteLength()];
+			for (int index = 0; index < image.length; index++)
+				image[index] = bytes.getUint8(index);
+			doLoadImageCallback(image);
 		});
 		reader.readAsArrayBuffer(file);
 	}
 	
+	private static void doLoadImageCallback(int[] image) {
+		SRAMElm.setImageOverride(image);
+		CirSimDialogCoordinator.getEditDialog().resetDialog();
+		SRAMElm.setImageOverride(null);
+	}
+
 	private static void doLoadCallback(String data) {
 		SRAMElm.contentsOverride = data;
 		CirSimDialogCoordinator.getEditDialog().resetDialog();
@@ -0,0 +1,100 @@
+package com.lushprojects.circuitjs1.client.io.sfcr;
+
+import java.io.IOException;
+
+/**
+ * Streaming form of {@link SFCRTemplateMerger#normalizeBlankLinesOutsideFences}:
+ * collapses runs of blank lines outside ``` fences to one and keeps at most
+ * two trailing newlines, writing through to another Appendable line by line.
+ *
+ * Newlines are held back until more text arrives so trailing ones can be
+ * trimmed in {@link #finish}, which must be called once at the end.
+ */
+public final class SFCRBlankLineNormalizer implements Appendable {
+
+    private static final String FENCE_START = "```";
+
+    private final Appendable out;
+    private final StringBuilder line = new StringBuilder();
+    private boolean inFence;
+    private int blankRun;
+    private int heldNewlines;
+    private boolean wroteAnything;
+
+    public SFCRBlankLineNormalizer(Appendable out) {
+        this.out = out;
+    }
+
+    @Override
+    public Appendable append(CharSequence csq) throws IOException {
+        String s = String.valueOf(csq);
+        return append(s, 0, s.length());
+    }
+
+    @Override
+    public Appendable append(CharSequence csq, int start, int end) throws IOException {
+        String s = String.valueOf(csq);
+        int from = start;
+        while (from < end) {
+            int nl = s.indexOf('\n', from);
+            if (nl < 0 || nl >= end) {
+                line.append(s, from, end);
+                break;
+            }
+            line.append(s, from, nl);
+            endLine();
+            from = nl + 1;
+        }
+        wroteAnything |= end > start;
+        return this;
+    }
+
+    @Override
+    public Appendable append(char c) throws IOException {
+        wroteAnything = true;
+        if (c == '\n') {
+            endLine();
+        } else {
+            line.append(c);
+        }
+        return this;
+    }
+
+    /** Flush the last line and the (trimmed) trailing newlines. */
+    public void finish() throws IOException {
+        if (!wroteAnything) {
+            return;
+        }
+        endLine();
+        int trailing = heldNewlines > 2 ? 2 : heldNewlines;
+        for (int i = 0; i < trailing; i++) {
+            out.append('\n');
+        }
+        heldNewlines = 0;
+    }
+
+    private void endLine() throws IOException {
+        String text = line.toString();
+        line.setLength(0);
+        String trimmed = text.trim();
+        if (trimmed.startsWith(FENCE_START)) {
+            inFence = !inFence;
+            blankRun = 0;
+        } else if (!inFence && trimmed.isEmpty()) {
+            blankRun++;
+            if (blankRun == 1) {
+                heldNewlines++;
+            }
+            return;
+        } else {
+            blankRun = 0;
+        }
+        if (!text.isEmpty()) {
+            for (; heldNewlines > 0; heldNewlines--) {
+                out.append('\n');
+            }
+            out.append(text);
+        }
+        heldNewlines++;
+    }
+}
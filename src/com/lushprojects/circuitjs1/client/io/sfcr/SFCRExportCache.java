@@ -0,0 +1,110 @@
+package com.lushprojects.circuitjs1.client.io.sfcr;
+
+import com.lushprojects.circuitjs1.client.CircuitElm;
+import com.lushprojects.circuitjs1.client.io.SFCRExporter;
+
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.Map;
+
+/**
+ * Per-element cache of exported SFCR blocks, owned by the document manager so
+ * it lives across exports.
+ *
+ * An entry is reused only while everything the block text depends on is
+ * unchanged: the element's content version (bumped by its editors), its
+ * position and flags, the export syntax, and the hint and block-comment
+ * versions. Export code only stores blocks that depend on nothing else (for
+ * example, equation blocks that register lookups are always regenerated).
+ * Entries for elements not seen during an export are dropped at its end.
+ */
+public final class SFCRExportCache {
+
+    private static final class Entry {
+        int version;
+        int x, y, x2, y2, flags;
+        SFCRExporter.ExportSyntax syntax;
+        int hintVersion;
+        int commentVersion;
+        int pass;
+        String block;
+    }
+
+    private final HashMap<CircuitElm, Entry> entries = new HashMap<CircuitElm, Entry>();
+    private int pass;
+    private int hintVersion;
+    private int commentVersion;
+    private int hits;
+    private int misses;
+
+    /** Start an export with the given environment versions. */
+    public void beginExport(int hintVersion, int commentVersion) {
+        pass++;
+        this.hintVersion = hintVersion;
+        this.commentVersion = commentVersion;
+    }
+
+    /** Drop entries for elements that were not exported in this pass. */
+    public void endExport() {
+        Iterator<Map.Entry<CircuitElm, Entry>> it = entries.entrySet().iterator();
+        while (it.hasNext()) {
+            if (it.next().getValue().pass != pass) {
+                it.remove();
+            }
+        }
+    }
+
+    /** Cached block for elm, or null if absent or stale. */
+    public String get(CircuitElm elm, SFCRExporter.ExportSyntax syntax) {
+        Entry e = entries.get(elm);
+        if (e == null || e.version != elm.getContentVersion() || e.syntax != syntax
+                || e.x != elm.x || e.y != elm.y || e.x2 != elm.x2 || e.y2 != elm.y2 || e.flags != elm.flags
+                || e.hintVersion != hintVersion || e.commentVersion != commentVersion) {
+            misses++;
+            return null;
+        }
+        e.pass = pass;
+        hits++;
+        return e.block;
+    }
+
+    public void put(CircuitElm elm, SFCRExporter.ExportSyntax syntax, String block) {
+        Entry e = entries.get(elm);
+        if (e == null) {
+            e = new Entry();
+            entries.put(elm, e);
+        }
+        e.version = elm.getContentVersion();
+        e.x = elm.x;
+        e.y = elm.y;
+        e.x2 = elm.x2;
+        e.y2 = elm.y2;
+        e.flags = elm.flags;
+        e.syntax = syntax;
+        e.hintVersion = hintVersion;
+        e.commentVersion = commentVersion;
+        e.pass = pass;
+        e.block = block;
+    }
+
+    /** Forget elm's block, e.g. once it has become uncacheable. */
+    public void remove(CircuitElm elm) {
+        entries.remove(elm);
+    }
+
+    public void clear() {
+        entries.clear();
+    }
+
+    public int size() {
+        return entries.size();
+    }
+
+    public int getHitCount() {
+        return hits;
+    }
+
+    public int getMissCount() {
+        return misses;
+    }
+}
@@ -61,6 +61,7 @@ public class SFCRExportContext {
     private HashSet<CircuitElm> scopeElmsExportedAsBlocks = new HashSet<CircuitElm>();
     private final LookupExportManager lookupManager = new LookupExportManager();
     private List<String> equationBlocks = new ArrayList<String>();
+    private final SFCRExportCache blockCache;
 
     // =========================================================================
     // Constructor
@@ -69,6 +70,9 @@ public class SFCRExportContext {
     public SFCRExportContext(CirSim sim, SFCRExporter.ExportSyntax syntax) {
         this.sim = sim;
         this.exportSyntax = syntax;
+        this.blockCache = (sim != null && sim.getSFCRDocumentManager() != null)
+            ? sim.getSFCRDocumentManager().getExportCache()
+            : null;
     }
 
 
@@ -248,7 +252,6 @@ public class SFCRExportContext {
         if (block == null || block.isEmpty()) {
             return;
         }
-        System.out.println("DEBUG appendExportBlock: block contains ```=" + block.contains("```") + ", block length=" + block.length());
         if (sb.length() > 0 && sb.charAt(sb.length() - 1) != '\n') {
             sb.append("\n");
         }
@@ -256,17 +259,47 @@ public class SFCRExportContext {
         if (!block.endsWith("\n")) {
             sb.append("\n");
         }
-        System.out.println("DEBUG appendExportBlock: sb now contains " + countOccurrences(sb.toString(), "```") + " occurrences of ```");
     }
-    
-    private static int countOccurrences(String text, String sub) {
-        int count = 0;
-        int idx = 0;
-        while ((idx = text.indexOf(sub, idx)) != -1) {
-            count++;
-            idx += sub.length();
+
+    // =========================================================================
+    // Per-element block cache (see SFCRExportCache)
+    // =========================================================================
+
+    /** Called by the exporter around each export. */
+    public void beginBlockCache() {
+        if (blockCache != null) {
+            blockCache.beginExport(HintRegistry.getVersion(), sim.getSFCRDocumentState().getBlockCommentsVersion());
+        }
+    }
+
+    public void endBlockCache() {
+        if (blockCache != null) {
+            blockCache.endExport();
+        }
+    }
+
+    /** Block exported for elm by an earlier export, or null if it must be regenerated. */
+    public String getCachedBlock(CircuitElm elm) {
+        return (blockCache != null) ? blockCache.get(elm, exportSyntax) : null;
+    }
+
+    /** Remember elm's block; only for blocks that depend on nothing but elm itself. */
+    public void putCachedBlock(CircuitElm elm, String block) {
+        if (blockCache != null) {
+            blockCache.put(elm, exportSyntax, block);
+        }
+    }
+
+    /**
+     * Cache a table block unless exporting it registered lookups: those
+     * blocks feed the shared @lookup state and must be regenerated each time.
+     */
+    private void putCachedTableBlock(CircuitElm elm, String block, int lookupCallsBefore) {
+        if (lookupManager.getLookupCallCount() == lookupCallsBefore) {
+            putCachedBlock(elm, block);
+        } else if (blockCache != null) {
+            blockCache.remove(elm);
         }
-        return count;
     }
 
     // =========================================================================
@@ -400,21 +433,42 @@ public class SFCRExportContext {
     // =========================================================================
 
     public String exportEquationTable(EquationTableElm eqTable) {
-        return (exportSyntax == SFCRExporter.ExportSyntax.R_STYLE)
+        String block = getCachedBlock(eqTable);
+        if (block != null) {
+            return block;
+        }
+        int lookupCalls = lookupManager.getLookupCallCount();
+        block = (exportSyntax == SFCRExporter.ExportSyntax.R_STYLE)
             ? exportEquationTableRStyle(eqTable)
             : exportEquationTableBlock(eqTable);
+        putCachedTableBlock(eqTable, block, lookupCalls);
+        return block;
     }
 
     public String exportGodlyTable(GodlyTableElm godlyTable) {
-        return (exportSyntax == SFCRExporter.ExportSyntax.R_STYLE)
+        String block = getCachedBlock(godlyTable);
+        if (block != null) {
+            return block;
+        }
+        int lookupCalls = lookupManager.getLookupCallCount();
+        block = (exportSyntax == SFCRExporter.ExportSyntax.R_STYLE)
             ? exportGodlyTableRStyle(godlyTable)
             : exportGodlyTableBlock(godlyTable);
+        putCachedTableBlock(godlyTable, block, lookupCalls);
+        return block;
     }
 
     public String exportMatrixTable(SFCTableElm sfcTable) {
-        return (exportSyntax == SFCRExporter.ExportSyntax.R_STYLE)
+        String block = getCachedBlock(sfcTable);
+        if (block != null) {
+            return block;
+        }
+        int lookupCalls = lookupManager.getLookupCallCount();
+        block = (exportSyntax == SFCRExporter.ExportSyntax.R_STYLE)
             ? exportSFCTableRStyle(sfcTable)
             : exportSFCTableBlock(sfcTable);
+        putCachedTableBlock(sfcTable, block, lookupCalls);
+        return block;
     }
 
     // =========================================================================
@@ -992,10 +1046,13 @@ public class SFCRExportContext {
     private final class LookupExportManager {
 
         private ArrayList<LookupDefinition> specs = new ArrayList<LookupDefinition>();
+        // lookup() calls seen by rewriteExpression; never reset
+        private int lookupCallCount;
         private HashMap<String, LookupDefinition> bySignature = new HashMap<String, LookupDefinition>();
         private HashMap<String, ArrayList<String>> commentsByNameScope = new HashMap<String, ArrayList<String>>();
 
         ArrayList<LookupDefinition> getSpecs() { return specs; }
+        int getLookupCallCount() { return lookupCallCount; }
         void setSpecs(ArrayList<LookupDefinition> s) { specs = (s != null) ? s : new ArrayList<LookupDefinition>(); }
 
         HashMap<String, LookupDefinition> getBySignature() { return bySignature; }
@@ -1119,6 +1176,7 @@ public class SFCRExportContext {
                 if (fn < 0) {
                     break;
                 }
+                lookupCallCount++;
                 int open = expr.indexOf('(', fn);
                 if (open < 0) {
                     break;
@@ -10,6 +10,7 @@ import com.lushprojects.circuitjs1.client.CirSim;
 import com.lushprojects.circuitjs1.client.io.SFCRUtil;
 import com.lushprojects.circuitjs1.client.io.sfcr.handlers.SFCRBlockExportHandler;
 
+import java.io.IOException;
 import java.util.ArrayList;
 
 /**
@@ -254,41 +255,15 @@ public final class SFCRTemplateMerger {
         if (text == null || text.isEmpty()) {
             return "";
         }
-
-        String[] lines = text.split("\\n", -1);
-        StringBuilder out = new StringBuilder();
-        boolean inFence = false;
-        int blankRun = 0;
-
-        for (int i = 0; i < lines.length; i++) {
-            String line = lines[i];
-            String trimmed = line.trim();
-
-            if (trimmed.startsWith(FENCE_START)) {
-                inFence = !inFence;
-                blankRun = 0;
-                out.append(line).append("\n");
-                continue;
-            }
-
-            if (!inFence && trimmed.isEmpty()) {
-                blankRun++;
-                if (blankRun > 1) {
-                    continue;
-                }
-                out.append("\n");
-                continue;
-            }
-
-            blankRun = 0;
-            out.append(line).append("\n");
+        StringBuilder out = new StringBuilder(text.length());
+        SFCRBlankLineNormalizer normalizer = new SFCRBlankLineNormalizer(out);
+        try {
+            normalizer.append(text);
+            normalizer.finish();
+        } catch (IOException e) {
+            // StringBuilder does not throw
         }
-
-        String normalized = out.toString();
-        while (normalized.endsWith("\n\n\n")) {
-            normalized = normalized.substring(0, normalized.length() - 1);
-        }
-        return normalized;
+        return out.toString();
     }
 
     /**
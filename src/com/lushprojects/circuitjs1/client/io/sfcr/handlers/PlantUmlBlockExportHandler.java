@@ -23,7 +23,6 @@ public class PlantUmlBlockExportHandler implements SFCRBlockExportHandler {
         for (SequenceDiagramElm diagram : ctx.getSequenceDiagrams()) {
             ctx.appendExportBlock(sb, exportOne(ctx, diagram));
         }
-        System.out.println("DEBUG PlantUmlBlockExportHandler.export(): result=[[" + sb.toString().replace("\n", "\\n") + "]]");
         return sb.toString();
     }
 
@@ -32,15 +31,11 @@ public class PlantUmlBlockExportHandler implements SFCRBlockExportHandler {
         ctx.appendLeadingBlockComments(sb, "plantuml", "");
         sb.append("```{r}\n");
         String rewritten = rewriteStartUml(diagram.getPlantUmlSource(), diagram);
-        System.out.println("DEBUG exportOne: rewritten length=" + rewritten.length());
-        System.out.println("DEBUG exportOne: rewritten contains ```=" + rewritten.contains("```"));
-        System.out.println("DEBUG exportOne: rewritten=[[" + rewritten.replace("\n", "\\n") + "]]");
         sb.append(rewritten);
         if (sb.length() > 0 && sb.charAt(sb.length() - 1) != '\n') {
             sb.append("\n");
         }
         sb.append("```\n");
-        System.out.println("DEBUG exportOne: final sb=[[" + sb.toString().replace("\n", "\\n") + "]]");
         return sb.toString();
     }
 
@@ -23,7 +23,12 @@ public class SankeyBlockExportHandler implements SFCRBlockExportHandler {
     public String exportBlocks(SFCRExportContext ctx) {
         StringBuilder sb = new StringBuilder();
         for (SFCSankeyElm sankey : ctx.getSankeyDiagrams()) {
-            ctx.appendExportBlock(sb, exportOne(ctx, sankey));
+            String block = ctx.getCachedBlock(sankey);
+            if (block == null) {
+                block = exportOne(ctx, sankey);
+                ctx.putCachedBlock(sankey, block);
+            }
+            ctx.appendExportBlock(sb, block);
         }
         return sb.toString();
     }
@@ -31,6 +31,8 @@ public class HintRegistry {
     private static Map<String, String> hints = new HashMap<String, String>();
     // Secondary index for normalized-name lookups (Greek and script variants)
     private static Map<String, String> normalizedHints = new HashMap<String, String>();
+    // bumped on every change so cached exports that embed hints can be validated
+    private static int version;
     
     /**
      * Set a hint for a variable name
@@ -40,6 +42,7 @@ public class HintRegistry {
             return;
         }
         String key = name.trim();
+        version++;
         if (hint == null) {
             hints.remove(key);
             rebuildNormalizedIndex();
@@ -84,6 +87,7 @@ public class HintRegistry {
      */
     public static void removeHint(String name) {
         if (name == null || name.trim().isEmpty()) return;
+        version++;
         hints.remove(name.trim());
         rebuildNormalizedIndex();
     }
@@ -92,10 +96,16 @@ public class HintRegistry {
      * Clear all hints (called when loading new circuit)
      */
     public static void clear() {
+        version++;
         hints.clear();
         normalizedHints.clear();
     }
     
+    /** Change counter; differs whenever any hint was set, removed or cleared since it was read. */
+    public static int getVersion() {
+        return version;
+    }
+
     /**
      * Get all hint names
      */
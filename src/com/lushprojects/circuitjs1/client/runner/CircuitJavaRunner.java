@@ -1,17 +1,25 @@
 package com.lushprojects.circuitjs1.client.runner;
 
 
+import java.io.File;
 import java.io.FileWriter;
+import java.io.IOException;
 import java.io.OutputStreamWriter;
 import java.io.PrintWriter;
 import java.nio.charset.StandardCharsets;
 import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
 import java.util.Locale;
 import com.lushprojects.circuitjs1.client.CirSim;
+import com.lushprojects.circuitjs1.client.CircuitElm;
 import com.lushprojects.circuitjs1.client.SimulationExportCore;
+import com.lushprojects.circuitjs1.client.SolverLog;
 import com.lushprojects.circuitjs1.client.elements.economics.ComputedValues;
+import com.lushprojects.circuitjs1.client.elements.electronics.measurement.AudioOutputElm;
 
 /**
  * Command-line interface for running CircuitJS1 simulations on the JVM / terminal, i.e. no GWT, not in the browser.
@@ -32,7 +40,24 @@ import com.lushprojects.circuitjs1.client.elements.economics.ComputedValues;
  *   <li><b>steps</b> (optional): Number of simulation steps to run (default: 1000)</li>
  *   <li><b>format</b> (optional): Output format - "csv" or "world2" (default: csv)</li>
  *   <li><b>html</b> (optional): Output path for an HTML report. World2 format generates table + plots</li>
+ *   <li><b>audio</b> (optional): Output path for a WAV file per Audio Output element, streamed to disk
+ *       as the run progresses. Further elements write to the same name with -2, -3, ... appended</li>
+ *   <li><b>schematic</b> (optional): Output path for a PNG of the circuit schematic</li>
+ *   <li><b>scopes</b> (optional): Output path for a PNG with one panel per scope</li>
+ *   <li><b>imageTimes</b> (optional): Comma-separated simulation times (seconds) at which to write the
+ *       images, each to the image path with -t&lt;time&gt; appended. If omitted, images are written once
+ *       at the end of the run</li>
  * </ul>
+ *
+ * <p>Images are drawn with {@link Java2DGraphics} (no browser needed) in printable colours with
+ * values shown; {@code java.awt.headless} is set unless already configured.
+ *
+ * <p>Solver diagnostics go to stderr at INFO level; pass {@code -Dcircuitjs.solverLog=debug}
+ * (or warn, error, off) to change it. See {@link SolverLog}.
+ *
+ * <p>Pass {@code -Dcircuitjs.vector=true} (with {@code --add-modules jdk.incubator.vector} and the
+ * vector classes on the classpath, as {@code runCircuitJava -Pvector=true} does) to run the LU,
+ * history downsampling and batched lookup loops through SIMD kernels. See {@link VectorKernelSupport}.
  * 
  * <h2>Output Formats</h2>
  * <ul>
@@ -65,12 +90,17 @@ public class CircuitJavaRunner {
      */
     public static void main(String[] args) throws Exception {
         if (args.length < 1) {
-                System.err.println("Usage: CircuitJavaRunner <circuit.txt> [output.csv] [steps=1000] [format=csv|tsv|world2] [output.html]");
+                System.err.println("Usage: CircuitJavaRunner <circuit.txt> [output.csv] [steps=1000] [format=csv|tsv|world2] [output.html] [audio.wav] [schematic.png] [scopes.png] [imageTimes=t1,t2,...]");
             System.exit(1);
         }
 
         RuntimeMode.setNonInteractiveRuntime(true);
         ComputedValues.resetForTesting();
+        SolverLog.setConsoleLevel(SolverLog.parseLevel(System.getProperty("circuitjs.solverLog"), SolverLog.INFO));
+        String kernelNote = VectorKernelSupport.installIfRequested();
+        if (kernelNote != null) {
+            System.err.println("CircuitJavaRunner: " + kernelNote);
+        }
 
         String circuitPath = args[0];
         String outputPath = args.length > 1 && args[1] != null && !args[1].trim().isEmpty() ? args[1] : null;
@@ -79,6 +109,10 @@ public class CircuitJavaRunner {
             ? args[3].trim().toLowerCase(Locale.ROOT)
             : "csv";
         String htmlPath = args.length > 4 && args[4] != null && !args[4].trim().isEmpty() ? args[4] : null;
+        String audioPath = args.length > 5 && args[5] != null && !args[5].trim().isEmpty() ? args[5] : null;
+        String schematicPath = args.length > 6 && args[6] != null && !args[6].trim().isEmpty() ? args[6] : null;
+        String scopesPath = args.length > 7 && args[7] != null && !args[7].trim().isEmpty() ? args[7] : null;
+        String imageTimes = args.length > 8 && args[8] != null && !args[8].trim().isEmpty() ? args[8] : null;
 
         Path circuitFilePath = Paths.get(circuitPath);
         String circuitText = new String(Files.readAllBytes(circuitFilePath), StandardCharsets.UTF_8);
@@ -106,7 +140,37 @@ public class CircuitJavaRunner {
         runRequest.htmlPath = htmlPath;
         runRequest.steps = steps;
         runRequest.format = format;
-        SimulationExportCore.RunResult runResult = SimulationExportCore.run(sim, runRequest, System.err::println);
+        ImageSchedule images = null;
+        if (schematicPath != null || scopesPath != null) {
+            if (System.getProperty("java.awt.headless") == null) {
+                System.setProperty("java.awt.headless", "true");
+            }
+            sim.setHeadlessDrawOptions(true, true);
+            HeadlessImageWriter.prepareScopes(sim);
+            images = new ImageSchedule(sim, schematicPath, scopesPath, imageTimes);
+            runRequest.stepObserver = images;
+        }
+        List<AudioOutputElm> audioElms = new ArrayList<AudioOutputElm>();
+        List<WavFileWriter> audioWriters = new ArrayList<WavFileWriter>();
+        if (audioPath != null) {
+            openAudioWriters(sim, audioPath, audioElms, audioWriters);
+        }
+        SimulationExportCore.RunResult runResult;
+        try {
+            runResult = SimulationExportCore.run(sim, runRequest, System.err::println);
+        } finally {
+            for (int i = 0; i < audioElms.size(); i++) {
+                audioElms.get(i).finishStream();
+                audioElms.get(i).setStreamListener(null);
+                audioWriters.get(i).close();
+            }
+        }
+        for (WavFileWriter writer : audioWriters) {
+            System.err.println("CircuitJavaRunner: wrote " + writer.getSampleCount() + " audio samples");
+        }
+        if (images != null) {
+            images.finish();
+        }
 
         PrintWriter out = outputPath != null
                 ? new PrintWriter(new FileWriter(outputPath))
@@ -126,4 +190,102 @@ public class CircuitJavaRunner {
             }
         }
     }
+
+    private static void openAudioWriters(CirSim sim, String audioPath,
+            List<AudioOutputElm> elms, List<WavFileWriter> writers) throws Exception {
+        for (CircuitElm ce : sim.elmList) {
+            if (!(ce instanceof AudioOutputElm)) {
+                continue;
+            }
+            AudioOutputElm audio = (AudioOutputElm) ce;
+            String path = elms.isEmpty() ? audioPath : suffixedPath(audioPath, "-" + (elms.size() + 1));
+            WavFileWriter writer = new WavFileWriter(path, audio.getSamplingRate());
+            audio.setStreamListener(writer);
+            elms.add(audio);
+            writers.add(writer);
+            System.err.println("CircuitJavaRunner: streaming audio to " + path);
+        }
+        if (elms.isEmpty()) {
+            System.err.println("CircuitJavaRunner: no Audio Output element; audio path ignored");
+        }
+    }
+
+    /** Insert {@code suffix} before the file extension, e.g. out.wav -> out-2.wav. */
+    static String suffixedPath(String path, String suffix) {
+        int dot = path.lastIndexOf('.');
+        int slash = Math.max(path.lastIndexOf('/'), path.lastIndexOf(File.separatorChar));
+        return dot > slash + 1 ? path.substring(0, dot) + suffix + path.substring(dot) : path + suffix;
+    }
+
+    /** Writes the requested images when the run passes each chosen time, or once at the end. */
+    private static final class ImageSchedule implements SimulationExportCore.StepObserver {
+        private final CirSim sim;
+        private final String schematicPath;
+        private final String scopesPath;
+        private final String[] timeLabels;
+        private final double[] times;
+        private int next;
+
+        ImageSchedule(CirSim sim, String schematicPath, String scopesPath, String imageTimes) {
+            this.sim = sim;
+            this.schematicPath = schematicPath;
+            this.scopesPath = scopesPath;
+            timeLabels = imageTimes == null ? new String[0] : imageTimes.trim().split("\\s*,\\s*");
+            times = new double[timeLabels.length];
+            for (int i = 0; i < times.length; i++) {
+                times[i] = Double.parseDouble(timeLabels[i]);
+            }
+            Arrays.sort(times);
+            // labels follow the sorted order so file names match the time written
+            for (int i = 0; i < times.length; i++) {
+                timeLabels[i] = formatTime(times[i]);
+            }
+        }
+
+        @Override
+        public void stepFinished(int step, double time) {
+            while (next < times.length && time >= times[next]) {
+                write("-t" + timeLabels[next]);
+                next++;
+            }
+        }
+
+        void finish() {
+            if (times.length == 0) {
+                write("");
+                return;
+            }
+            for (; next < times.length; next++) {
+                System.err.println("CircuitJavaRunner: run ended before t=" + timeLabels[next] + "; no images for it");
+            }
+        }
+
+        private void write(String suffix) {
+            try {
+                if (schematicPath != null) {
+                    String path = suffixedPath(schematicPath, suffix);
+                    if (HeadlessImageWriter.writeSchematic(sim, new File(path))) {
+                        System.err.println("CircuitJavaRunner: wrote schematic to " + path);
+                    } else {
+                        System.err.println("CircuitJavaRunner: no elements; schematic image skipped");
+                    }
+                }
+                if (scopesPath != null) {
+                    String path = suffixedPath(scopesPath, suffix);
+                    if (HeadlessImageWriter.writeScopes(sim, new File(path))) {
+                        System.err.println("CircuitJavaRunner: wrote scopes to " + path);
+                    } else {
+                        System.err.println("CircuitJavaRunner: no scopes; scope image skipped");
+                    }
+                }
+            } catch (IOException e) {
+                System.err.println("CircuitJavaRunner: failed to write image: " + e.getMessage());
+            }
+        }
+
+        private static String formatTime(double t) {
+            String s = Double.toString(t);
+            return s.endsWith(".0") ? s.substring(0, s.length() - 2) : s;
+        }
+    }
 }
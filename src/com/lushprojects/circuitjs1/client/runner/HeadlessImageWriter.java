@@ -0,0 +1,149 @@
+package com.lushprojects.circuitjs1.client.runner;
+
+import java.io.File;
+import java.io.IOException;
+import java.util.Locale;
+
+import com.lushprojects.circuitjs1.client.CirSim;
+import com.lushprojects.circuitjs1.client.scope.Scope;
+import com.lushprojects.circuitjs1.client.scope.ScopeTraceSnapshot;
+import com.lushprojects.circuitjs1.client.scope.XYPlotRaster;
+import com.lushprojects.circuitjs1.client.util.Color;
+import com.lushprojects.circuitjs1.client.util.Font;
+import com.lushprojects.circuitjs1.client.util.Rectangle;
+
+/**
+ * Writes schematic and scope PNGs from {@link CircuitJavaRunner} through
+ * {@link Java2DGraphics}.
+ *
+ * <p>The schematic goes through the normal element draw() code. Scope grids
+ * and traces go through {@link Scope#drawPlotAreaForExport}, the same
+ * renderer as the browser scope minus its interactive chrome (settings wheel,
+ * cursor); 2D/XY scopes use their {@link XYPlotRaster}.
+ *
+ * <p>Excluded from GWT compilation (see circuitjs1.gwt.xml).
+ */
+final class HeadlessImageWriter {
+    static final int PLOT_WIDTH = 720;
+    static final int PLOT_HEIGHT = 200;
+    private static final int LEFT_MARGIN = 70;
+    private static final int RIGHT_MARGIN = 10;
+    private static final int TOP_MARGIN = 22;
+    private static final int BOTTOM_MARGIN = 20;
+    private static final int PANEL_WIDTH = LEFT_MARGIN + PLOT_WIDTH + RIGHT_MARGIN;
+    private static final int PANEL_HEIGHT = TOP_MARGIN + PLOT_HEIGHT + BOTTOM_MARGIN;
+    // same margins and 2x scale as the browser "Export as image" PNG
+    private static final int SCHEMATIC_WMARGIN = 140;
+    private static final int SCHEMATIC_HMARGIN = 100;
+    private static final double SCHEMATIC_SCALE = 2;
+
+    private HeadlessImageWriter() {
+    }
+
+    /** Give every scope a plot-sized rect so it keeps one sample per image column. */
+    static void prepareScopes(CirSim sim) {
+        for (int i = 0; i < sim.scopeCount; i++) {
+            sim.scopes[i].setRectForEmbedded(new Rectangle(0, 0, PLOT_WIDTH, PLOT_HEIGHT));
+        }
+    }
+
+    /** Returns false if there is nothing to draw. */
+    static boolean writeSchematic(CirSim sim, File file) throws IOException {
+        Rectangle bounds = sim.getCircuitBoundsForExport();
+        if (bounds == null) {
+            return false;
+        }
+        int w = (int) Math.ceil((bounds.width + SCHEMATIC_WMARGIN) * SCHEMATIC_SCALE);
+        int h = (int) Math.ceil((bounds.height + SCHEMATIC_HMARGIN) * SCHEMATIC_SCALE);
+        Java2DGraphics g = new Java2DGraphics(w, h);
+        try {
+            g.setColor(sim.isPrintableEnabledForExport() ? Color.white : Color.black);
+            g.fillRect(0, 0, w, h);
+            g.scale(SCHEMATIC_SCALE, SCHEMATIC_SCALE);
+            g.translate(-(bounds.x - SCHEMATIC_WMARGIN / 2), -(bounds.y - SCHEMATIC_HMARGIN / 2));
+            sim.drawSchematicOffscreen(g);
+            g.writePng(file);
+            return true;
+        } finally {
+            g.dispose();
+        }
+    }
+
+    /** One panel per scope, stacked vertically. Returns false if there are no scopes. */
+    static boolean writeScopes(CirSim sim, File file) throws IOException {
+        if (sim.scopeCount == 0) {
+            return false;
+        }
+        boolean printable = sim.isPrintableEnabledForExport();
+        Java2DGraphics g = new Java2DGraphics(PANEL_WIDTH, PANEL_HEIGHT * sim.scopeCount);
+        try {
+            g.setColor(printable ? Color.white : Color.black);
+            g.fillRect(0, 0, PANEL_WIDTH, PANEL_HEIGHT * sim.scopeCount);
+            g.setFont(new Font("SansSerif", 0, 11));
+            for (int i = 0; i < sim.scopeCount; i++) {
+                g.save();
+                g.translate(0, i * PANEL_HEIGHT);
+                drawScopePanel(g, sim.scopes[i], i, printable);
+                g.restore();
+            }
+            g.writePng(file);
+            return true;
+        } finally {
+            g.dispose();
+        }
+    }
+
+    private static void drawScopePanel(Java2DGraphics g, Scope scope, int index, boolean printable) {
+        Color fg = printable ? Color.black : Color.white;
+        String title = scope.getScopeMenuName();
+        g.setColor(fg);
+        g.drawString(title == null || title.trim().isEmpty() ? "Scope " + (index + 1) : title, 4, 14);
+        g.setColor(printable ? "#808080" : "#A0A0A0");
+        g.drawRect(LEFT_MARGIN, TOP_MARGIN, PLOT_WIDTH, PLOT_HEIGHT);
+
+        if (scope.isPlot2dEnabled()) {
+            XYPlotRaster raster = scope.getXYRaster();
+            int[] argb = raster.toArgb(printable ? 0xffffff : 0x000000, printable ? 0x000000 : 0xffffff);
+            g.drawArgb(argb, raster.getWidth(), raster.getHeight(), LEFT_MARGIN, TOP_MARGIN);
+            return;
+        }
+
+        // grid and traces come from the same renderer as the browser scope
+        g.save();
+        g.translate(LEFT_MARGIN, TOP_MARGIN);
+        g.clipRect(0, 0, PLOT_WIDTH + 1, PLOT_HEIGHT + 1);
+        scope.drawPlotAreaForExport(g);
+        g.restore();
+
+        ScopeTraceSnapshot[] traces = scope.snapshotTracesForViewer(scope.isDrawFromZeroEnabledForUi());
+        double t0 = Double.POSITIVE_INFINITY, t1 = Double.NEGATIVE_INFINITY;
+        for (ScopeTraceSnapshot trace : traces) {
+            if (trace.size() > 0) {
+                t0 = Math.min(t0, trace.time[0]);
+                t1 = Math.max(t1, trace.time[trace.size() - 1]);
+            }
+        }
+        g.setColor(fg);
+        g.setFont(new Font("SansSerif", 0, 11));
+        if (t1 > t0) {
+            g.setTextAlign("right");
+            g.drawString(format(t1) + "s", LEFT_MARGIN + PLOT_WIDTH, TOP_MARGIN + PLOT_HEIGHT + 15);
+            g.setTextAlign("left");
+            g.drawString(format(t0) + "s", LEFT_MARGIN, TOP_MARGIN + PLOT_HEIGHT + 15);
+        }
+
+        int legendX = PANEL_WIDTH / 3;
+        for (ScopeTraceSnapshot trace : traces) {
+            if (trace.name == null || trace.name.isEmpty()) {
+                continue;
+            }
+            g.setColor(trace.color != null ? trace.color : fg.getHexValue());
+            g.drawString(trace.name, legendX, 14);
+            legendX += (int) g.measureWidth(trace.name) + 12;
+        }
+    }
+
+    private static String format(double v) {
+        return String.format(Locale.ROOT, "%.4g", v);
+    }
+}
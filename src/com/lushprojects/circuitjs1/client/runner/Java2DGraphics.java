@@ -0,0 +1,561 @@
+package com.lushprojects.circuitjs1.client.runner;
+
+import java.awt.AlphaComposite;
+import java.awt.BasicStroke;
+import java.awt.Composite;
+import java.awt.Font;
+import java.awt.FontMetrics;
+import java.awt.GradientPaint;
+import java.awt.Graphics2D;
+import java.awt.Paint;
+import java.awt.RenderingHints;
+import java.awt.Shape;
+import java.awt.geom.AffineTransform;
+import java.awt.geom.Arc2D;
+import java.awt.geom.Ellipse2D;
+import java.awt.geom.Line2D;
+import java.awt.geom.Path2D;
+import java.awt.geom.Rectangle2D;
+import java.awt.geom.RoundRectangle2D;
+import java.awt.image.BufferedImage;
+import java.io.File;
+import java.io.IOException;
+import java.util.ArrayDeque;
+import java.util.Locale;
+import javax.imageio.ImageIO;
+
+import com.google.gwt.canvas.dom.client.Context2d;
+import com.lushprojects.circuitjs1.client.util.Color;
+import com.lushprojects.circuitjs1.client.util.Graphics;
+import com.lushprojects.circuitjs1.client.util.Polygon;
+
+/**
+ * {@link Graphics} backend that draws into a Java2D {@link BufferedImage}, so
+ * schematics and scopes can be rendered on the JVM without a browser.
+ *
+ * <p>Only the primitives of {@link Graphics} are supported; {@link Graphics#context}
+ * is null. Canvas semantics are followed where they differ from Java2D:
+ * CSS colour and font strings, text align/baseline, separate stroke and fill
+ * styles, arc angles, and save/restore of the whole drawing state.
+ *
+ * <p>Excluded from GWT compilation (see circuitjs1.gwt.xml).
+ */
+public class Java2DGraphics extends Graphics {
+
+    private static final class State {
+        AffineTransform transform;
+        Shape clip;
+        java.awt.Color color;
+        Paint strokePaint;
+        Composite composite;
+        BasicStroke stroke;
+        String textAlign;
+        String textBaseline;
+        String fontName;
+        int fontSize;
+    }
+
+    private final BufferedImage image;
+    private final Graphics2D g2;
+    private final ArrayDeque<State> saved = new ArrayDeque<State>();
+    // stroke style when it differs from the fill colour (gradients, setFillColor)
+    private Paint strokePaint;
+    private Path2D.Double path = new Path2D.Double();
+    private float lineWidth = 1;
+    private int lineCap = BasicStroke.CAP_BUTT;
+    private float[] dash;
+    private String textAlign = "start";
+    private String textBaseline = "alphabetic";
+    private String fontName;
+
+    public Java2DGraphics(int width, int height) {
+        image = new BufferedImage(Math.max(width, 1), Math.max(height, 1), BufferedImage.TYPE_INT_ARGB);
+        g2 = image.createGraphics();
+        g2.setRenderingHint(RenderingHints.KEY_ANTIALIASING, RenderingHints.VALUE_ANTIALIAS_ON);
+        g2.setRenderingHint(RenderingHints.KEY_TEXT_ANTIALIASING, RenderingHints.VALUE_TEXT_ANTIALIAS_ON);
+        g2.setRenderingHint(RenderingHints.KEY_STROKE_CONTROL, RenderingHints.VALUE_STROKE_PURE);
+        g2.setColor(java.awt.Color.black);
+        setFontName("10px sans-serif");
+        updateStroke();
+    }
+
+    public BufferedImage getImage() {
+        return image;
+    }
+
+    public void writePng(File file) throws IOException {
+        if (!ImageIO.write(image, "png", file)) {
+            throw new IOException("no PNG writer available");
+        }
+    }
+
+    /** Copy ARGB pixels (row-major, {@code width} per row) at (x, y) in the current transform. */
+    public void drawArgb(int[] argb, int width, int height, int x, int y) {
+        if (width <= 0 || height <= 0) {
+            return;
+        }
+        BufferedImage pixels = new BufferedImage(width, height, BufferedImage.TYPE_INT_ARGB);
+        pixels.setRGB(0, 0, width, height, argb, 0, width);
+        g2.drawImage(pixels, x, y, null);
+    }
+
+    public void dispose() {
+        g2.dispose();
+    }
+
+    @Override
+    public void setColor(Color color) {
+        if (color != null) {
+            setColor(color.getHexValue());
+        }
+    }
+
+    @Override
+    public void setColor(String color) {
+        java.awt.Color c = parseCssColor(color);
+        if (c != null) {
+            g2.setColor(c);
+            strokePaint = null;
+        }
+    }
+
+    @Override
+    public void setFillColor(String color) {
+        java.awt.Color c = parseCssColor(color);
+        if (c != null) {
+            if (strokePaint == null) {
+                strokePaint = g2.getColor();
+            }
+            g2.setColor(c);
+        }
+    }
+
+    @Override
+    public void setStrokeGradient(double x1, double y1, double x2, double y2, Color from, Color to) {
+        java.awt.Color c1 = parseCssColor(from.getHexValue());
+        java.awt.Color c2 = parseCssColor(to.getHexValue());
+        if (c1 != null && c2 != null) {
+            strokePaint = new GradientPaint((float) x1, (float) y1, c1, (float) x2, (float) y2, c2);
+        }
+    }
+
+    @Override
+    public void clipRect(int x, int y, int width, int height) {
+        g2.clip(new Rectangle2D.Double(x, y, width, height));
+    }
+
+    @Override
+    public void save() {
+        State s = new State();
+        s.transform = g2.getTransform();
+        s.clip = g2.getClip();
+        s.color = g2.getColor();
+        s.strokePaint = strokePaint;
+        s.composite = g2.getComposite();
+        s.stroke = (BasicStroke) g2.getStroke();
+        s.textAlign = textAlign;
+        s.textBaseline = textBaseline;
+        s.fontName = fontName;
+        s.fontSize = currentFontSize;
+        saved.push(s);
+    }
+
+    @Override
+    public void restore() {
+        State s = saved.poll();
+        if (s == null) {
+            return;
+        }
+        g2.setTransform(s.transform);
+        g2.setClip(s.clip);
+        g2.setColor(s.color);
+        strokePaint = s.strokePaint;
+        g2.setComposite(s.composite);
+        g2.setStroke(s.stroke);
+        lineWidth = s.stroke.getLineWidth();
+        lineCap = s.stroke.getEndCap();
+        dash = s.stroke.getDashArray();
+        textAlign = s.textAlign;
+        textBaseline = s.textBaseline;
+        setFontName(s.fontName);
+        currentFontSize = s.fontSize;
+    }
+
+    @Override
+    public void fillRect(int x, int y, int width, int height) {
+        g2.fill(new Rectangle2D.Double(x, y, width, height));
+    }
+
+    @Override
+    public void fillRect(double x, double y, double width, double height) {
+        g2.fill(new Rectangle2D.Double(x, y, width, height));
+    }
+
+    @Override
+    public void drawRect(int x, int y, int width, int height) {
+        strokeShape(new Rectangle2D.Double(x, y, width, height));
+    }
+
+    @Override
+    public void strokeRect(double x, double y, double width, double height) {
+        strokeShape(new Rectangle2D.Double(x, y, width, height));
+    }
+
+    @Override
+    public void fillOval(int x, int y, int width, int height) {
+        // same geometry as the canvas version: a circle of diameter width
+        int r = width / 2;
+        g2.fill(new Ellipse2D.Double(x, y, 2 * r, 2 * r));
+    }
+
+    @Override
+    public void drawCircle(double cx, double cy, double radius) {
+        strokeShape(new Ellipse2D.Double(cx - radius, cy - radius, 2 * radius, 2 * radius));
+    }
+
+    @Override
+    public void drawLine(int x1, int y1, int x2, int y2) {
+        strokeShape(new Line2D.Double(x1, y1, x2, y2));
+    }
+
+    @Override
+    public void drawPolyline(int[] xpoints, int[] ypoints, int n) {
+        // the canvas version closes the path too
+        strokeShape(new java.awt.Polygon(xpoints, ypoints, n));
+    }
+
+    @Override
+    public void fillPolygon(Polygon p) {
+        g2.fillPolygon(p.xpoints, p.ypoints, p.npoints);
+    }
+
+    @Override
+    public void fillRoundRect(int x, int y, int width, int height, int radius) {
+        g2.fill(new RoundRectangle2D.Double(x, y, width, height, 2 * radius, 2 * radius));
+    }
+
+    @Override
+    public void drawRoundRect(int x, int y, int width, int height, int radius) {
+        strokeShape(new RoundRectangle2D.Double(x, y, width, height, 2 * radius, 2 * radius));
+    }
+
+    @Override
+    public void drawLock(int x, int y) {
+        // edit lock indicator is UI state, not part of an exported image
+    }
+
+    @Override
+    public void setLineWidth(double width) {
+        lineWidth = (float) width;
+        updateStroke();
+    }
+
+    @Override
+    public void setLineCap(Context2d.LineCap cap) {
+        if (cap == Context2d.LineCap.ROUND) {
+            lineCap = BasicStroke.CAP_ROUND;
+        } else if (cap == Context2d.LineCap.SQUARE) {
+            lineCap = BasicStroke.CAP_SQUARE;
+        } else {
+            lineCap = BasicStroke.CAP_BUTT;
+        }
+        updateStroke();
+    }
+
+    @Override
+    public void setLineDash(int a, int b) {
+        dash = a == 0 ? null : new float[] { a, b };
+        updateStroke();
+    }
+
+    @Override
+    public void setLetterSpacing(String spacing) {
+    }
+
+    @Override
+    public void setShadow(String color, double blur, double offsetX, double offsetY) {
+        // no blur in Java2D; exported images go without drop shadows
+    }
+
+    @Override
+    public void translate(double x, double y) {
+        g2.translate(x, y);
+    }
+
+    @Override
+    public void scale(double x, double y) {
+        g2.scale(x, y);
+    }
+
+    @Override
+    public void transform(double a, double b, double c, double d, double e, double f) {
+        g2.transform(new AffineTransform(a, b, c, d, e, f));
+    }
+
+    @Override
+    public void setGlobalAlpha(double alpha) {
+        g2.setComposite(AlphaComposite.getInstance(AlphaComposite.SRC_OVER,
+                (float) Math.max(0, Math.min(1, alpha))));
+    }
+
+    @Override
+    public void beginPath() {
+        path = new Path2D.Double();
+    }
+
+    @Override
+    public void moveTo(double x, double y) {
+        path.moveTo(x, y);
+    }
+
+    @Override
+    public void lineTo(double x, double y) {
+        if (startSubpath(x, y)) {
+            path.lineTo(x, y);
+        }
+    }
+
+    @Override
+    public void quadraticCurveTo(double cpx, double cpy, double x, double y) {
+        startSubpath(cpx, cpy);
+        path.quadTo(cpx, cpy, x, y);
+    }
+
+    @Override
+    public void bezierCurveTo(double cp1x, double cp1y, double cp2x, double cp2y, double x, double y) {
+        startSubpath(cp1x, cp1y);
+        path.curveTo(cp1x, cp1y, cp2x, cp2y, x, y);
+    }
+
+    @Override
+    public void arc(double cx, double cy, double radius, double startAngle, double endAngle) {
+        arc(cx, cy, radius, startAngle, endAngle, false);
+    }
+
+    @Override
+    public void arc(double cx, double cy, double radius, double startAngle, double endAngle,
+            boolean anticlockwise) {
+        ellipse(cx, cy, radius, radius, 0, startAngle, endAngle, anticlockwise);
+    }
+
+    @Override
+    public void ellipse(double cx, double cy, double rx, double ry, double rotation,
+            double startAngle, double endAngle, boolean anticlockwise) {
+        // canvas angles run clockwise on screen, Arc2D angles counterclockwise;
+        // both are parametric on an ellipse
+        double sweep = anticlockwise ? startAngle - endAngle : endAngle - startAngle;
+        if (sweep >= 2 * Math.PI) {
+            sweep = 2 * Math.PI;
+        } else {
+            sweep %= 2 * Math.PI;
+            if (sweep < 0) {
+                sweep += 2 * Math.PI;
+            }
+        }
+        double extent = Math.toDegrees(sweep);
+        Shape arc = new Arc2D.Double(cx - rx, cy - ry, 2 * rx, 2 * ry,
+                -Math.toDegrees(startAngle), anticlockwise ? extent : -extent, Arc2D.OPEN);
+        if (rotation != 0) {
+            arc = AffineTransform.getRotateInstance(rotation, cx, cy).createTransformedShape(arc);
+        }
+        // like canvas, joins the current point to the start of the arc
+        path.append(arc, path.getCurrentPoint() != null);
+    }
+
+    @Override
+    public void closePath() {
+        if (path.getCurrentPoint() != null) {
+            path.closePath();
+        }
+    }
+
+    @Override
+    public void stroke() {
+        strokeShape(path);
+    }
+
+    @Override
+    public void fill() {
+        g2.fill(path);
+    }
+
+    @Override
+    public String getTextAlign() {
+        return textAlign;
+    }
+
+    @Override
+    public String getTextBaseline() {
+        return textBaseline;
+    }
+
+    @Override
+    public void setTextAlign(String align) {
+        if (align != null) {
+            textAlign = align;
+        }
+    }
+
+    @Override
+    public void setTextBaseline(String baseline) {
+        if (baseline != null) {
+            textBaseline = baseline;
+        }
+    }
+
+    @Override
+    protected void fillText(String text, double x, double y) {
+        if ("center".equals(textAlign)) {
+            x -= measureText(text) / 2;
+        } else if ("right".equals(textAlign) || "end".equals(textAlign)) {
+            x -= measureText(text);
+        }
+        FontMetrics fm = g2.getFontMetrics();
+        if ("middle".equals(textBaseline)) {
+            y += (fm.getAscent() - fm.getDescent()) / 2.0;
+        } else if ("top".equals(textBaseline) || "hanging".equals(textBaseline)) {
+            y += fm.getAscent();
+        } else if ("bottom".equals(textBaseline) || "ideographic".equals(textBaseline)) {
+            y -= fm.getDescent();
+        }
+        g2.drawString(text, (float) x, (float) y);
+    }
+
+    @Override
+    public double measureText(String text) {
+        return g2.getFont().getStringBounds(text, g2.getFontRenderContext()).getWidth();
+    }
+
+    @Override
+    public void setFontName(String name) {
+        if (name == null || name.equals(fontName)) {
+            return;
+        }
+        fontName = name;
+        g2.setFont(parseCssFont(name));
+    }
+
+    @Override
+    protected String getFontName() {
+        return fontName;
+    }
+
+    // canvas lineTo/curveTo with no current point start a subpath there
+    private boolean startSubpath(double x, double y) {
+        if (path.getCurrentPoint() != null) {
+            return true;
+        }
+        path.moveTo(x, y);
+        return false;
+    }
+
+    private void strokeShape(Shape shape) {
+        if (strokePaint == null) {
+            g2.draw(shape);
+            return;
+        }
+        Paint fill = g2.getPaint();
+        g2.setPaint(strokePaint);
+        g2.draw(shape);
+        g2.setPaint(fill);
+    }
+
+    private void updateStroke() {
+        g2.setStroke(new BasicStroke(lineWidth, lineCap, BasicStroke.JOIN_MITER, 10, dash, 0));
+    }
+
+    /** Parse the subset of CSS fonts the renderers use, e.g. "bold 12px sans-serif". */
+    static Font parseCssFont(String css) {
+        int style = Font.PLAIN;
+        double size = 10;
+        String family = "sans-serif";
+        String[] parts = css.trim().split("\\s+");
+        for (int i = 0; i < parts.length; i++) {
+            String p = parts[i].toLowerCase(Locale.ROOT);
+            if (p.equals("bold") || p.equals("bolder") || p.equals("600") || p.equals("700")) {
+                style |= Font.BOLD;
+            } else if (p.equals("italic") || p.equals("oblique")) {
+                style |= Font.ITALIC;
+            } else if (p.endsWith("px")) {
+                try {
+                    size = Double.parseDouble(p.substring(0, p.length() - 2));
+                } catch (NumberFormatException e) {
+                    // keep the default size
+                }
+                StringBuilder rest = new StringBuilder();
+                for (int j = i + 1; j < parts.length; j++) {
+                    rest.append(j > i + 1 ? " " : "").append(parts[j]);
+                }
+                if (rest.length() > 0) {
+                    family = rest.toString();
+                }
+                break;
+            }
+        }
+        String first = family.split(",")[0].replace("\"", "").replace("'", "").trim().toLowerCase(Locale.ROOT);
+        String awtFamily = Font.SANS_SERIF;
+        if (first.contains("mono") || first.equals("courier") || first.equals("courier new")) {
+            awtFamily = Font.MONOSPACED;
+        } else if (first.equals("serif") || first.contains("times")) {
+            awtFamily = Font.SERIF;
+        }
+        return new Font(awtFamily, style, 1).deriveFont((float) size);
+    }
+
+    /** Parse #rgb, #rrggbb, rgb(), rgba() and a few names; null if not understood. */
+    static java.awt.Color parseCssColor(String css) {
+        if (css == null) {
+            return null;
+        }
+        String c = css.trim().toLowerCase(Locale.ROOT);
+        try {
+            if (c.startsWith("#")) {
+                if (c.length() == 4) {
+                    int r = Integer.parseInt(c.substring(1, 2), 16) * 17;
+                    int g = Integer.parseInt(c.substring(2, 3), 16) * 17;
+                    int b = Integer.parseInt(c.substring(3, 4), 16) * 17;
+                    return new java.awt.Color(r, g, b);
+                }
+                if (c.length() == 7) {
+                    return new java.awt.Color(Integer.parseInt(c.substring(1), 16));
+                }
+                return null;
+            }
+            if (c.startsWith("rgb")) {
+                int open = c.indexOf('(');
+                int close = c.indexOf(')');
+                if (open < 0 || close < open) {
+                    return null;
+                }
+                String[] v = c.substring(open + 1, close).split(",");
+                int r = clamp255(Double.parseDouble(v[0].trim()));
+                int g = clamp255(Double.parseDouble(v[1].trim()));
+                int b = clamp255(Double.parseDouble(v[2].trim()));
+                int a = v.length > 3 ? clamp255(Double.parseDouble(v[3].trim()) * 255) : 255;
+                return new java.awt.Color(r, g, b, a);
+            }
+        } catch (RuntimeException e) {
+            return null;
+        }
+        switch (c) {
+        case "white": return java.awt.Color.white;
+        case "black": return java.awt.Color.black;
+        case "red": return java.awt.Color.red;
+        case "green": return new java.awt.Color(0, 128, 0);
+        case "blue": return java.awt.Color.blue;
+        case "yellow": return java.awt.Color.yellow;
+        case "orange": return new java.awt.Color(255, 165, 0);
+        case "cyan": return java.awt.Color.cyan;
+        case "magenta": return java.awt.Color.magenta;
+        case "gray": case "grey": return new java.awt.Color(128, 128, 128);
+        case "lightgray": case "lightgrey": return new java.awt.Color(211, 211, 211);
+        case "darkgray": case "darkgrey": return new java.awt.Color(169, 169, 169);
+        case "transparent": return new java.awt.Color(0, 0, 0, 0);
+        default: return null;
+        }
+    }
+
+    private static int clamp255(double v) {
+        return (int) Math.max(0, Math.min(255, Math.round(v)));
+    }
+}
@@ -0,0 +1,44 @@
+package com.lushprojects.circuitjs1.client.runner;
+
+import com.lushprojects.circuitjs1.client.core.NumericKernels;
+
+/**
+ * Installs the Vector API {@link NumericKernels} for {@link CircuitJavaRunner}
+ * when {@code -Dcircuitjs.vector=true} is given.
+ *
+ * <p>The implementation is built from src-jvm-vector/ only on JDK 17+ and
+ * needs {@code --add-modules jdk.incubator.vector} at run time. It is loaded
+ * by name, so a runner built or started without either keeps the scalar
+ * kernels. Off by default: SIMD sums round differently from the browser.
+ *
+ * <p>Excluded from GWT compilation (see circuitjs1.gwt.xml).
+ */
+final class VectorKernelSupport {
+    static final String PROPERTY = "circuitjs.vector";
+    private static final String MODULE = "jdk.incubator.vector";
+    private static final String IMPLEMENTATION = "com.lushprojects.circuitjs1.vector.VectorApiKernels";
+
+    private VectorKernelSupport() {
+    }
+
+    /** Returns a line for the run log, or null if vector kernels were not requested. */
+    static String installIfRequested() {
+        String value = System.getProperty(PROPERTY);
+        if (value == null || !(value.equalsIgnoreCase("true") || value.equals("1") || value.equalsIgnoreCase("on"))) {
+            return null;
+        }
+        if (!ModuleLayer.boot().findModule(MODULE).isPresent()) {
+            return "vector kernels need --add-modules " + MODULE + "; using scalar kernels";
+        }
+        try {
+            NumericKernels kernels = (NumericKernels) Class.forName(IMPLEMENTATION)
+                .getDeclaredConstructor().newInstance();
+            NumericKernels.install(kernels);
+            return "using " + kernels.getName() + " kernels";
+        } catch (Throwable e) {
+            // not built (JDK < 17) or the species could not be set up on this CPU
+            NumericKernels.install(null);
+            return "vector kernels unavailable (" + e + "); using scalar kernels";
+        }
+    }
+}
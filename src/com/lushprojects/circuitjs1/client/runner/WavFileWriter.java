@@ -0,0 +1,120 @@
+package com.lushprojects.circuitjs1.client.runner;
+
+import java.io.BufferedOutputStream;
+import java.io.Closeable;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.io.RandomAccessFile;
+import java.io.UncheckedIOException;
+
+import com.lushprojects.circuitjs1.client.util.PcmChunkBuffer;
+
+/**
+ * Writes a mono 32-bit IEEE float WAV file from audio streamed a chunk at a
+ * time.
+ *
+ * Each chunk goes straight to the output file as it arrives, so closing
+ * costs no more than one chunk and no temporary space is needed. Float
+ * samples keep the element's raw values, so no level has to be chosen
+ * before the whole run is seen and the gain never changes mid-file;
+ * normalize in an audio editor if the signal is outside [-1, 1]. The size
+ * fields are written as zero and patched on close.
+ * JVM-only (excluded from GWT compilation, see circuitjs1.gwt.xml).
+ */
+public final class WavFileWriter implements PcmChunkBuffer.ChunkListener, Closeable {
+
+    // RIFF header, 18-byte fmt chunk, fact chunk, data chunk header
+    private static final int HEADER_SIZE = 58;
+    private static final int RIFF_SIZE_OFFSET = 4;
+    private static final int FACT_SAMPLES_OFFSET = 46;
+    private static final int DATA_SIZE_OFFSET = 54;
+    private static final int BYTES_PER_SAMPLE = 4;
+    private static final long MAX_SAMPLES = (0xFFFFFFFFL - (HEADER_SIZE - 8)) / BYTES_PER_SAMPLE;
+
+    private final String path;
+    private final OutputStream out;
+    private final int sampleRate;
+    private byte buf[] = new byte[0];
+    private long sampleCount;
+
+    public WavFileWriter(String path, int sampleRate) throws IOException {
+        this.path = path;
+        this.sampleRate = sampleRate;
+        out = new BufferedOutputStream(new FileOutputStream(path));
+        out.write(header(0, 0));
+    }
+
+    public long getSampleCount() {
+        return sampleCount;
+    }
+
+    public long getDataSize() {
+        return sampleCount * BYTES_PER_SAMPLE;
+    }
+
+    public void chunkFilled(double samples[], int length) {
+        if (sampleCount + length > MAX_SAMPLES)
+            return;
+        if (buf.length < length * BYTES_PER_SAMPLE)
+            buf = new byte[length * BYTES_PER_SAMPLE];
+        for (int i = 0; i != length; i++)
+            putInt(buf, i * BYTES_PER_SAMPLE, Float.floatToIntBits((float) samples[i]));
+        try {
+            out.write(buf, 0, length * BYTES_PER_SAMPLE);
+        } catch (IOException e) {
+            throw new UncheckedIOException(e);
+        }
+        sampleCount += length;
+    }
+
+    public void close() throws IOException {
+        out.close();
+        byte h[] = header(sampleCount, getDataSize());
+        try (RandomAccessFile file = new RandomAccessFile(path, "rw")) {
+            file.seek(RIFF_SIZE_OFFSET);
+            file.write(h, RIFF_SIZE_OFFSET, 4);
+            file.seek(FACT_SAMPLES_OFFSET);
+            file.write(h, FACT_SAMPLES_OFFSET, 4);
+            file.seek(DATA_SIZE_OFFSET);
+            file.write(h, DATA_SIZE_OFFSET, 4);
+        }
+    }
+
+    private byte[] header(long samples, long dataBytes) {
+        byte h[] = new byte[HEADER_SIZE];
+        putAscii(h, 0, "RIFF");
+        putInt(h, RIFF_SIZE_OFFSET, HEADER_SIZE - 8 + dataBytes);
+        putAscii(h, 8, "WAVE");
+        putAscii(h, 12, "fmt ");
+        putInt(h, 16, 18);
+        putShort(h, 20, 3);             // IEEE float
+        putShort(h, 22, 1);             // mono
+        putInt(h, 24, sampleRate);
+        putInt(h, 28, (long) sampleRate * BYTES_PER_SAMPLE); // byte rate
+        putShort(h, 32, BYTES_PER_SAMPLE); // block align
+        putShort(h, 34, 32);            // bits per sample
+        putShort(h, 36, 0);             // no extension
+        putAscii(h, 38, "fact");
+        putInt(h, 42, 4);
+        putInt(h, FACT_SAMPLES_OFFSET, samples);
+        putAscii(h, 50, "data");
+        putInt(h, DATA_SIZE_OFFSET, dataBytes);
+        return h;
+    }
+
+    private static void putAscii(byte h[], int off, String s) {
+        for (int i = 0; i != s.length(); i++)
+            h[off + i] = (byte) s.charAt(i);
+    }
+
+    private static void putInt(byte h[], int off, long v) {
+        for (int i = 0; i != 4; i++)
+            h[off + i] = (byte) (v >> (8 * i));
+    }
+
+    private static void putShort(byte h[], int off, int v) {
+        h[off] = (byte) v;
+        h[off + 1] = (byte) (v >> 8);
+    }
+}
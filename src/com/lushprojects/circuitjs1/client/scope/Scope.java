@@ -39,6 +39,7 @@ import java.util.Vector;
 
 import com.google.gwt.canvas.client.Canvas;
 import com.google.gwt.canvas.dom.client.Context2d;
+import com.google.gwt.canvas.dom.client.ImageData;
 
 /**
  * Scope class - displays time-series waveforms and XY plots of circuit values.
@@ -147,6 +148,9 @@ public class Scope {
     CirSim sim;
     Canvas imageCanvas; // Canvas for 2D plots
     private Context2d imageContext;
+    private final XYPlotRaster xyRaster = new XYPlotRaster(0, 0); // 2D plot persistence buffer
+    private ImageData xyImageData; // blit target for xyRaster
+    private boolean xyBlitPrintable;
     double scopeTimeStep; // Check if sim timestep has changed
     double[] scale; // Max value to scale the display - indexed by UNITS_*
     private boolean[] reduceRange;
@@ -700,8 +704,8 @@ public class Scope {
 	    imageCanvas.setHeight(rect.height + "PX");
 	    imageCanvas.setCoordinateSpaceWidth(rect.width);
 	    imageCanvas.setCoordinateSpaceHeight(rect.height);
-	    clear2dView();
 	}
+	clear2dView();
     }
     
     public void setRect(Rectangle r) {
@@ -891,7 +895,7 @@ public class Scope {
 	ScopeDisplayConfig config = getDisplayConfig();
 
 	// For 2d plots we draw here rather than in the drawing routine
-    	if (config.is2DMode() && imageContext!=null && plots.size()>=2) {
+    	if (config.is2DMode() && plots.size()>=2) {
     	    double v = plots.get(0).lastValue;
     	    double yval = plots.get(1).lastValue;
     	    Scope2DController.TimeStepResult point = Scope2DController.computeTimeStepPoint(
@@ -959,29 +963,26 @@ public class Scope {
      * @param y2 New Y coordinate
      */
     private void drawTo(int x2, int y2) {
-    	int[] updated = Scope2DController.drawTraceSegment(
-    	        imageContext,
-    	        sim.printableCheckItem.getState(),
-    	        runtimeState.drawOx,
-    	        runtimeState.drawOy,
-    	        x2,
-    	        y2);
-    	runtimeState.drawOx = updated[0];
-    	runtimeState.drawOy = updated[1];
+    	xyRaster.lineTo(x2, y2);
+    	runtimeState.drawOx = xyRaster.getPenX();
+    	runtimeState.drawOy = xyRaster.getPenY();
     }
 	
     /**
      * Clears the 2D view canvas.
      */
     void clear2dView() {
-    	if (imageContext != null) {
-    		// Set background color based on print mode
-    		String bgColor = sim.printableCheckItem.getState() ? "#eee" : "#202020";
-    		imageContext.setFillStyle(bgColor);
-    		imageContext.fillRect(0, 0, rect.width - 1, rect.height - 1);
-    	}
+    	if (xyRaster.getWidth() != rect.width || xyRaster.getHeight() != rect.height)
+    		xyRaster.resize(rect.width, rect.height);
+    	else
+    		xyRaster.clear();
     	runtimeState.drawOx = runtimeState.drawOy = -1;
     }
+
+    /** Persistence buffer behind 2D plots, also filled in headless runs. */
+    public XYPlotRaster getXYRaster() {
+    	return xyRaster;
+    }
 	
     /*
     void adjustScale(double x) {
@@ -1211,12 +1212,13 @@ public class Scope {
     	g.context.translate(rect.x, rect.y);
     	g.clipRect(0, 0, rect.width, rect.height);
     	
-    	runtimeState.alphaCounter = Scope2DController.fade2dCanvas(
-    	        imageContext,
-    	        runtimeState.alphaCounter,
-    	        sim.printableCheckItem.getState(),
-    	        rect.width,
-    	        rect.height);
+    	boolean printable = sim.printableCheckItem.getState();
+    	if (printable != xyBlitPrintable) {
+    		xyBlitPrintable = printable;
+    		xyRaster.invalidate();
+    	}
+    	xyRaster.frame();
+    	xyImageData = Scope2DController.blitRaster(imageContext, xyImageData, xyRaster, printable);
     	
     	g.context.drawImage(imageContext.getCanvas(), 0.0, 0.0);
 //    	g.drawImage(image, r.x, r.y, null);
@@ -1605,6 +1607,48 @@ public class Scope {
         g.context.save();
         g.context.translate(frame.plotLeft, frame.plotTop);
         g.clipRect(0, 0, frame.plotWidth, frame.plotHeight);
+        renderPlotArea(g, frame);
+        g.context.restore();
+
+        ScopeAxisRenderer.render(this, g, frame);
+        ScopeOverlayRenderer.renderInScope(this, g, frame);
+    	
+    	g.restore();
+    	
+    	ScopeOverlayRenderer.renderCursor(this, g, frame);
+    	
+		if (plots.get(0).samplesCaptured > 5 && !config.manualScale) {
+    	    for (int i = 0; i != UNITS_COUNT; i++)
+    		if (scale[i] > 1e-4 && reduceRange[i])
+    		    scale[i] /= 2;
+    	}
+    	
+    	if ( (properties != null ) && properties.isShowing() )
+    	    properties.refreshDraw();
+
+    }
+
+    /**
+     * Grid and waveforms only, with (0, 0) at the top left of the scope rect;
+     * for offscreen images, which leave out the axes, settings wheel and
+     * cursor of draw(). 2D scopes draw nothing here; see getXYRaster().
+     */
+    public void drawPlotAreaForExport(Graphics g) {
+	if (plots.size() == 0)
+	    return;
+	ScopeFrameContext frame = buildFrameContext();
+	if (frame.displayConfig.is2DMode())
+	    return;
+	g.save();
+	g.translate(frame.plotLeft, frame.plotTop);
+	g.clipRect(0, 0, frame.plotWidth, frame.plotHeight);
+	renderPlotArea(g, frame);
+	g.restore();
+    }
+
+    // Everything inside the plot area, in plot-local coordinates.
+    private void renderPlotArea(Graphics g, ScopeFrameContext frame) {
+	ScopeDisplayConfig config = frame.displayConfig;
 
         // Render order contract:
         // 1. Grid (background)
@@ -1651,25 +1695,6 @@ public class Scope {
     	    calcMaxAndMin(visiblePlots.firstElement().units, frame, historyIndexRange);
     	
         ScopeWaveformRenderer.render(this, g, frame, allPlotsSameUnits, sel);
-
-        g.context.restore();
-
-        ScopeAxisRenderer.render(this, g, frame);
-        ScopeOverlayRenderer.renderInScope(this, g, frame);
-    	
-    	g.restore();
-    	
-    	ScopeOverlayRenderer.renderCursor(this, g, frame);
-    	
-		if (plots.get(0).samplesCaptured > 5 && !config.manualScale) {
-    	    for (i = 0; i != UNITS_COUNT; i++)
-    		if (scale[i] > 1e-4 && reduceRange[i])
-    		    scale[i] /= 2;
-    	}
-    	
-    	if ( (properties != null ) && properties.isShowing() )
-    	    properties.refreshDraw();
-
     }
 
     public void drawForEmbedded(Graphics g) {
@@ -2843,6 +2868,24 @@ public class Scope {
         return useHistory ? exportHistoryAsJSON() : exportCircularBufferAsJSON();
     }
 
+    /**
+     * Full-resolution copy of each visible plot for the external viewer,
+     * which downsamples windows of it on demand.
+     */
+    public ScopeTraceSnapshot[] snapshotTracesForViewer(boolean useHistory) {
+        if (useHistory) {
+            return ScopeDataExporter.snapshotHistory(
+                    this, visiblePlots, drawFromZero, model.getHistorySize(), model.getHistorySampleInterval());
+        }
+        return ScopeDataExporter.snapshotCircularBuffer(visiblePlots, rect, scopePointCount, sim, speed);
+    }
+
+    /** JSON metadata matching {@link #exportDataAsJSON} without the sample arrays. */
+    public String exportTraceSummaryAsJSON(boolean useHistory, ScopeTraceSnapshot[] traces) {
+        return ScopeDataExporter.exportTraceSummaryAsJSON(useHistory, traces, sim, speed,
+                startTime, model.getHistorySize(), model.getHistorySampleInterval());
+    }
+
     public CirSim getSimForDialogs() {
         return sim;
     }
@@ -2,7 +2,9 @@ package com.lushprojects.circuitjs1.client.scope;
 
 import com.lushprojects.circuitjs1.client.*;
 
+import com.google.gwt.canvas.dom.client.CanvasPixelArray;
 import com.google.gwt.canvas.dom.client.Context2d;
+import com.google.gwt.canvas.dom.client.ImageData;
 import com.lushprojects.circuitjs1.client.elements.electronics.measurement.OutputElm;
 import com.lushprojects.circuitjs1.client.elements.electronics.measurement.ProbeElm;
 import java.util.Vector;
@@ -73,28 +75,45 @@ final class Scope2DController {
         return ((double) minDimension / 2) / ((double) manDivisions / 2 + 0.05);
     }
 
-    static int[] drawTraceSegment(Context2d imageContext, boolean printable, int drawOx, int drawOy, int x2, int y2) {
-        if (drawOx == -1) {
-            return new int[] {x2, y2};
+    /**
+     * Copy the raster's dirty region into {@code imageData} (allocating it when
+     * the size changed) and put it on the 2D canvas. Returns the ImageData to
+     * keep for the next frame.
+     */
+    static ImageData blitRaster(Context2d imageContext, ImageData imageData, XYPlotRaster raster, boolean printable) {
+        int w = raster.getWidth();
+        int h = raster.getHeight();
+        if (w == 0 || h == 0) {
+            return imageData;
+        }
+        if (imageData == null || imageData.getWidth() != w || imageData.getHeight() != h) {
+            imageData = imageContext.createImageData(w, h);
+            raster.invalidate();
+        }
+        if (!raster.isDirty()) {
+            return imageData;
         }
-        imageContext.setStrokeStyle(printable ? "#000000" : "#ffffff");
-        imageContext.beginPath();
-        imageContext.moveTo(drawOx, drawOy);
-        imageContext.lineTo(x2, y2);
-        imageContext.stroke();
-        return new int[] {x2, y2};
-    }
 
-    static int fade2dCanvas(Context2d imageContext, int alphaCounter, boolean printable, int width, int height) {
-        int next = alphaCounter + 1;
-        if (next > 2) {
-            next = 0;
-            imageContext.setGlobalAlpha(0.01);
-            imageContext.setFillStyle(printable ? "#ffffff" : "#202020");
-            imageContext.fillRect(0, 0, width, height);
-            imageContext.setGlobalAlpha(1.0);
+        int bg = printable ? 0xeeeeee : 0x202020;
+        int fg = printable ? 0x000000 : 0xffffff;
+        CanvasPixelArray data = imageData.getData();
+        int[] intensity = raster.getIntensityBuffer();
+        int maxX = Math.min(raster.getDirtyMaxX(), w - 1);
+        int maxY = Math.min(raster.getDirtyMaxY(), h - 1);
+        for (int y = Math.max(raster.getDirtyMinY(), 0); y <= maxY; y++) {
+            for (int x = Math.max(raster.getDirtyMinX(), 0); x <= maxX; x++) {
+                int i = y * w + x;
+                int c = XYPlotRaster.blend(bg, fg, intensity[i]);
+                int p = i * 4;
+                data.set(p, (c >> 16) & 0xff);
+                data.set(p + 1, (c >> 8) & 0xff);
+                data.set(p + 2, c & 0xff);
+                data.set(p + 3, 255);
+            }
         }
-        return next;
+        raster.clearDirty();
+        imageContext.putImageData(imageData, 0, 0);
+        return imageData;
     }
 
     static void selectY(CirSim sim, Vector<ScopePlot> plots) {
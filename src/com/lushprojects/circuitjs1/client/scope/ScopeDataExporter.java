@@ -252,6 +252,116 @@ final class ScopeDataExporter {
         return sb.toString();
     }
 
+    static ScopeTraceSnapshot[] snapshotCircularBuffer(
+            Vector<ScopePlot> visiblePlots,
+            Rectangle rect,
+            int scopePointCount,
+            CirSim sim,
+            int speed) {
+        int width = getCircularBufferDisplayWidth(visiblePlots, rect, scopePointCount);
+        if (width <= 0) {
+            return new ScopeTraceSnapshot[0];
+        }
+
+        double[] time = new double[width];
+        for (int x = 0; x < width; x++) {
+            time[x] = sim.getTime() - (width - 1 - x) * sim.getMaxTimeStep() * speed;
+        }
+
+        ScopeTraceSnapshot[] traces = new ScopeTraceSnapshot[visiblePlots.size()];
+        for (int i = 0; i < visiblePlots.size(); i++) {
+            ScopePlot p = visiblePlots.get(i);
+            double[] minValues = new double[width];
+            double[] maxValues = new double[width];
+            int ipa = p.startIndex(width);
+            for (int x = 0; x < width; x++) {
+                int ip = (x + ipa) & (scopePointCount - 1);
+                minValues[x] = p.minValues[ip];
+                maxValues[x] = p.maxValues[ip];
+            }
+            traces[i] = new ScopeTraceSnapshot(getPlotLabel(p, i), Scope.getScaleUnitsText(p.units), p.color,
+                    time, minValues, maxValues);
+        }
+        return traces;
+    }
+
+    static ScopeTraceSnapshot[] snapshotHistory(
+            Scope scope,
+            Vector<ScopePlot> visiblePlots,
+            boolean drawFromZero,
+            int historySize,
+            double historySampleInterval) {
+        if (!drawFromZero || historySize == 0) {
+            return new ScopeTraceSnapshot[0];
+        }
+
+        double[] time = new double[historySize];
+        for (int x = 0; x < historySize; x++) {
+            time[x] = x * historySampleInterval;
+        }
+
+        ScopeTraceSnapshot[] traces = new ScopeTraceSnapshot[visiblePlots.size()];
+        for (int i = 0; i < visiblePlots.size(); i++) {
+            ScopePlot p = visiblePlots.get(i);
+            VariableHistoryStore.SeriesSnapshot historySnapshot = scope.getHistorySnapshotForRender(p);
+            double[] minValues = new double[historySize];
+            double[] maxValues = new double[historySize];
+            if (historySnapshot != null) {
+                int n = Math.min(historySize, historySnapshot.minValues.length);
+                System.arraycopy(historySnapshot.minValues, 0, minValues, 0, n);
+                System.arraycopy(historySnapshot.maxValues, 0, maxValues, 0, n);
+            }
+            traces[i] = new ScopeTraceSnapshot(getPlotLabel(p, i), Scope.getScaleUnitsText(p.units), p.color,
+                    time, minValues, maxValues);
+        }
+        return traces;
+    }
+
+    /**
+     * Same header as the JSON exports, but plots carry only their name, units,
+     * colour and sample count; the samples themselves stay in the snapshots.
+     */
+    static String exportTraceSummaryAsJSON(
+            boolean useHistory,
+            ScopeTraceSnapshot[] traces,
+            CirSim sim,
+            int speed,
+            double absoluteStartTime,
+            int historySize,
+            double historySampleInterval) {
+        StringBuilder sb = new StringBuilder();
+        sb.append("{\n");
+        sb.append("  \"source\": \"CircuitJS1 Scope\",\n");
+        if (useHistory) {
+            sb.append("  \"exportType\": \"history\",\n");
+            sb.append("  \"startTime\": 0,\n");
+            sb.append("  \"absoluteStartTime\": ").append(absoluteStartTime).append(",\n");
+            sb.append("  \"historySize\": ").append(historySize).append(",\n");
+            sb.append("  \"sampleInterval\": ").append(historySampleInterval).append(",\n");
+        } else {
+            sb.append("  \"exportType\": \"circularBuffer\",\n");
+            sb.append("  \"simulationTime\": ").append(sim.getTime()).append(",\n");
+            sb.append("  \"timeStep\": ").append(sim.getMaxTimeStep() * speed).append(",\n");
+        }
+        sb.append("  \"plots\": [\n");
+        for (int i = 0; i < traces.length; i++) {
+            ScopeTraceSnapshot t = traces[i];
+            sb.append("    {\n");
+            sb.append("      \"name\": \"").append(escapeJSON(t.name)).append("\",\n");
+            sb.append("      \"units\": \"").append(t.units).append("\",\n");
+            sb.append("      \"color\": \"").append(t.color).append("\",\n");
+            sb.append("      \"sampleCount\": ").append(t.size()).append("\n");
+            sb.append("    }");
+            if (i < traces.length - 1) {
+                sb.append(",");
+            }
+            sb.append("\n");
+        }
+        sb.append("  ]\n");
+        sb.append("}\n");
+        return sb.toString();
+    }
+
     private static int getCircularBufferDisplayWidth(
             Vector<ScopePlot> visiblePlots,
             Rectangle rect,
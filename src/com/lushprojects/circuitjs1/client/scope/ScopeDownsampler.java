@@ -0,0 +1,149 @@
+package com.lushprojects.circuitjs1.client.scope;
+
+/**
+ * Visual downsampling for scope traces handed to external viewers.
+ *
+ * Both reducers work on a sub-range {@code [from, to)} of parallel arrays and
+ * produce indices into them, so callers can pick time, min and max samples
+ * from the same positions without copying the full series first.
+ */
+public final class ScopeDownsampler {
+    public static final int MODE_NONE = 0;
+    /** Largest-triangle-three-buckets: keeps the visual shape of a line. */
+    public static final int MODE_LTTB = 1;
+    /** Min/max envelope: keeps every peak, two points per bucket. */
+    public static final int MODE_MINMAX = 2;
+
+    private ScopeDownsampler() {
+    }
+
+    /** Parse "none", "lttb" or "minmax"; anything else gives LTTB. */
+    public static int parseMode(String name) {
+        if (name == null) {
+            return MODE_LTTB;
+        }
+        String n = name.trim().toLowerCase();
+        if (n.equals("none")) {
+            return MODE_NONE;
+        }
+        if (n.equals("minmax") || n.equals("envelope")) {
+            return MODE_MINMAX;
+        }
+        return MODE_LTTB;
+    }
+
+    /**
+     * Pick {@code threshold} indices from {@code [from, to)} with the LTTB
+     * algorithm. The first and last points are always kept. If the range
+     * already has no more than {@code threshold} points (or threshold is
+     * below 3) every index is returned.
+     */
+    public static int[] lttb(double[] x, double[] y, int from, int to, int threshold) {
+        int n = to - from;
+        if (n <= 0) {
+            return new int[0];
+        }
+        if (threshold >= n || threshold < 3) {
+            return allIndices(from, to);
+        }
+
+        int[] out = new int[threshold];
+        int count = 0;
+        out[count++] = from;
+
+        // buckets exclude the fixed first and last points
+        double every = (double) (n - 2) / (threshold - 2);
+        int a = from;
+        for (int i = 0; i < threshold - 2; i++) {
+            int avgStart = from + (int) Math.floor((i + 1) * every) + 1;
+            int avgEnd = Math.min(from + (int) Math.floor((i + 2) * every) + 1, to);
+            double avgX = 0;
+            double avgY = 0;
+            if (avgStart >= avgEnd) {
+                avgX = x[to - 1];
+                avgY = y[to - 1];
+            } else {
+                for (int j = avgStart; j < avgEnd; j++) {
+                    avgX += x[j];
+                    avgY += y[j];
+                }
+                avgX /= (avgEnd - avgStart);
+                avgY /= (avgEnd - avgStart);
+            }
+
+            int rangeStart = from + (int) Math.floor(i * every) + 1;
+            int rangeEnd = Math.min(from + (int) Math.floor((i + 1) * every) + 1, to - 1);
+            double ax = x[a];
+            double ay = y[a];
+            double maxArea = -1;
+            int next = rangeStart;
+            for (int j = rangeStart; j < rangeEnd; j++) {
+                double area = Math.abs((ax - avgX) * (y[j] - ay) - (ax - x[j]) * (avgY - ay));
+                if (area > maxArea) {
+                    maxArea = area;
+                    next = j;
+                }
+            }
+            out[count++] = next;
+            a = next;
+        }
+        out[count++] = to - 1;
+        return out;
+    }
+
+    /**
+     * Split {@code [from, to)} into {@code buckets} equal runs and emit, for
+     * each, the sample with the lowest {@code minY} and the one with the
+     * highest {@code maxY} in position order. Together they trace an envelope
+     * that keeps every extreme of the original series. Indices go to
+     * {@code indexOut} and the matching min or max value to {@code valueOut};
+     * both need room for {@code 2 * buckets} entries. Returns the number of
+     * points written.
+     */
+    public static int minMaxEnvelope(double[] minY, double[] maxY, int from, int to, int buckets,
+            int[] indexOut, double[] valueOut) {
+        int n = to - from;
+        if (n <= 0 || buckets < 1) {
+            return 0;
+        }
+        if (buckets > n) {
+            buckets = n;
+        }
+
+        int count = 0;
+        for (int b = 0; b < buckets; b++) {
+            int start = from + (int) ((long) b * n / buckets);
+            int end = from + (int) ((long) (b + 1) * n / buckets);
+            int lo = start;
+            int hi = start;
+            for (int j = start + 1; j < end; j++) {
+                if (minY[j] < minY[lo]) {
+                    lo = j;
+                }
+                if (maxY[j] > maxY[hi]) {
+                    hi = j;
+                }
+            }
+            if (hi < lo) {
+                indexOut[count] = hi;
+                valueOut[count++] = maxY[hi];
+                indexOut[count] = lo;
+                valueOut[count++] = minY[lo];
+            } else {
+                indexOut[count] = lo;
+                valueOut[count++] = minY[lo];
+                indexOut[count] = hi;
+                valueOut[count++] = maxY[hi];
+            }
+        }
+        return count;
+    }
+
+    private static int[] allIndices(int from, int to) {
+        int[] out = new int[to - from];
+        for (int i = 0; i < out.length; i++) {
+            out[i] = from + i;
+        }
+        return out;
+    }
+}
@@ -33,7 +33,7 @@ final class ScopeGridRenderer {
             int x = plotWidth * i / divs;
             if (x < prevEnd) continue;
             String s = ((int) Math.round(i * maxFrequency)) + "Hz";
-            int sWidth = (int) Math.ceil(g.context.measureText(s).getWidth());
+            int sWidth = (int) Math.ceil(g.measureText(s));
             prevEnd = x + sWidth + 4;
             if (i > 0) {
                 g.setColor("#880000");
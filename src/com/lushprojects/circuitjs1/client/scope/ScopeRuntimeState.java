@@ -5,7 +5,6 @@ import com.lushprojects.circuitjs1.client.*;
 final class ScopeRuntimeState {
     int drawOx = -1;
     int drawOy = -1;
-    int alphaCounter;
     double gridStepX;
     double gridStepY;
     double displayGridStepX;
@@ -0,0 +1,128 @@
+package com.lushprojects.circuitjs1.client.scope;
+
+import java.util.Arrays;
+
+/**
+ * Full-resolution copy of one scope plot (time plus per-sample min/max),
+ * taken when an external viewer is opened so it can ask for downsampled
+ * windows later while the simulation keeps overwriting the scope buffers.
+ */
+public final class ScopeTraceSnapshot {
+    public final String name;
+    public final String units;
+    public final String color;
+    public final double[] time;
+    /** Display value per sample: the min/max midpoint, or the envelope value for reduced windows. */
+    public final double[] values;
+    public final double[] minValues;
+    public final double[] maxValues;
+
+    public ScopeTraceSnapshot(String name, String units, String color,
+            double[] time, double[] minValues, double[] maxValues) {
+        this(name, units, color, time, midpoints(minValues, maxValues), minValues, maxValues);
+    }
+
+    private ScopeTraceSnapshot(String name, String units, String color,
+            double[] time, double[] values, double[] minValues, double[] maxValues) {
+        this.name = name;
+        this.units = units;
+        this.color = color;
+        this.time = time;
+        this.values = values;
+        this.minValues = minValues;
+        this.maxValues = maxValues;
+    }
+
+    public int size() {
+        return time.length;
+    }
+
+    /**
+     * Samples covering {@code [t0, t1]} reduced to about {@code points}
+     * entries. One sample on each side of the window is included so lines
+     * run to the plot edges. {@code points <= 0} or {@link ScopeDownsampler#MODE_NONE}
+     * returns the window at full resolution.
+     */
+    public ScopeTraceSnapshot window(double t0, double t1, int points, int mode) {
+        int from = Math.max(lowerBound(t0) - 1, 0);
+        int to = Math.min(upperBound(t1) + 1, time.length);
+        if (to <= from) {
+            return slice(new int[0]);
+        }
+
+        int n = to - from;
+        if (points <= 0 || mode == ScopeDownsampler.MODE_NONE || n <= points) {
+            int[] idx = new int[n];
+            for (int i = 0; i < n; i++) {
+                idx[i] = from + i;
+            }
+            return slice(idx);
+        }
+        if (mode == ScopeDownsampler.MODE_MINMAX) {
+            int buckets = Math.max(points / 2, 1);
+            int[] idx = new int[buckets * 2];
+            double[] y = new double[buckets * 2];
+            int count = ScopeDownsampler.minMaxEnvelope(minValues, maxValues, from, to, buckets, idx, y);
+            return slice(Arrays.copyOf(idx, count), Arrays.copyOf(y, count));
+        }
+        return slice(ScopeDownsampler.lttb(time, values, from, to, points));
+    }
+
+    /** Index of the first sample with time >= t (time is ascending). */
+    int lowerBound(double t) {
+        int lo = 0;
+        int hi = time.length;
+        while (lo < hi) {
+            int mid = (lo + hi) >>> 1;
+            if (time[mid] < t) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    /** Index of the first sample with time > t. */
+    int upperBound(double t) {
+        int lo = 0;
+        int hi = time.length;
+        while (lo < hi) {
+            int mid = (lo + hi) >>> 1;
+            if (time[mid] <= t) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    private ScopeTraceSnapshot slice(int[] idx) {
+        double[] y = new double[idx.length];
+        for (int i = 0; i < idx.length; i++) {
+            y[i] = values[idx[i]];
+        }
+        return slice(idx, y);
+    }
+
+    private ScopeTraceSnapshot slice(int[] idx, double[] y) {
+        double[] t = new double[idx.length];
+        double[] mn = new double[idx.length];
+        double[] mx = new double[idx.length];
+        for (int i = 0; i < idx.length; i++) {
+            t[i] = time[idx[i]];
+            mn[i] = minValues[idx[i]];
+            mx[i] = maxValues[idx[i]];
+        }
+        return new ScopeTraceSnapshot(name, units, color, t, y, mn, mx);
+    }
+
+    private static double[] midpoints(double[] minValues, double[] maxValues) {
+        double[] mid = new double[minValues.length];
+        for (int i = 0; i < mid.length; i++) {
+            mid[i] = (minValues[i] + maxValues[i]) / 2.0;
+        }
+        return mid;
+    }
+}
@@ -132,7 +132,7 @@ final class ScopeWaveformRenderer {
         String minorDiv = "#404040";
         String majorDiv = "#A0A0A0";
         String curColor = "#FFFF00";
-        if (scope.sim.printableCheckItem.getState()) {
+        if (scope.sim.isPrintableEnabledForExport()) {
             minorDiv = "#D0D0D0";
             majorDiv = "#808080";
             curColor = "#A0A000";
@@ -155,7 +155,7 @@ final class ScopeWaveformRenderer {
         scope.clearDrawGridLines();
 
         g.setColor(color);
-        g.context.setLineWidth(traceStrokeWidth);
+        g.setLineWidth(traceStrokeWidth);
 
         if (scope.isManualScale()) {
             // Draw zero point
@@ -177,7 +177,7 @@ final class ScopeWaveformRenderer {
         }
 
         g.endBatch();
-        g.context.setLineWidth(1.0);
+        g.setLineWidth(1.0);
     }
 
     /**
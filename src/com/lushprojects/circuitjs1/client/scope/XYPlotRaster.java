@@ -0,0 +1,260 @@
+package com.lushprojects.circuitjs1.client.scope;
+
+/**
+ * Persistence buffer for 2D (XY) scope plots.
+ *
+ * Each pixel holds a 16-bit intensity. New segments are rasterized at full
+ * intensity with integer Bresenham lines, and {@link #frame()} fades the
+ * buffer with one multiply pass over the lit area every few frames, in place
+ * of stroking a path per sample and alpha-filling the whole canvas. The
+ * buffer has no GWT dependencies: the browser blits it into an ImageData,
+ * and the headless runner converts it to ARGB for image output.
+ */
+public final class XYPlotRaster {
+    public static final int MAX_INTENSITY = 0xffff;
+    /** Frames between decay passes; matches the old canvas fade cadence. */
+    static final int DECAY_INTERVAL = 3;
+    /** Decay factor per pass, in 1/256ths (~1% like the old 0.01 alpha fill). */
+    static final int DECAY_NUMERATOR = 253;
+
+    private int width;
+    private int height;
+    private int[] intensity;
+    private int penX = -1;
+    private int penY = -1;
+    private int frameCounter;
+
+    // bounding box of non-zero pixels since the last clear
+    private int litMinX, litMinY, litMaxX, litMaxY;
+    // region changed since the last blit
+    private int dirtyMinX, dirtyMinY, dirtyMaxX, dirtyMaxY;
+
+    public XYPlotRaster(int width, int height) {
+        clearDirty();
+        resize(width, height);
+    }
+
+    /** Resize and clear; keeps the existing buffer when it is already big enough. */
+    public void resize(int w, int h) {
+        width = Math.max(w, 0);
+        height = Math.max(h, 0);
+        int n = width * height;
+        if (intensity == null || intensity.length < n) {
+            intensity = new int[n];
+        }
+        clear();
+    }
+
+    public void clear() {
+        for (int i = 0; i < width * height; i++) {
+            intensity[i] = 0;
+        }
+        penX = penY = -1;
+        litMinX = litMinY = Integer.MAX_VALUE;
+        litMaxX = litMaxY = -1;
+        markDirty(0, 0, width - 1, height - 1);
+    }
+
+    public int getWidth() {
+        return width;
+    }
+
+    public int getHeight() {
+        return height;
+    }
+
+    public int getPenX() {
+        return penX;
+    }
+
+    public int getPenY() {
+        return penY;
+    }
+
+    /** Forget the last point so the next {@link #lineTo} starts a new trace. */
+    public void liftPen() {
+        penX = penY = -1;
+    }
+
+    /** Draw from the previous point to (x, y); the first call only moves the pen. */
+    public void lineTo(int x, int y) {
+        if (penX != -1) {
+            drawLine(penX, penY, x, y);
+        }
+        penX = x;
+        penY = y;
+    }
+
+    /**
+     * Count one displayed frame; every {@link #DECAY_INTERVAL} frames fade the
+     * lit area. Returns true if a decay pass ran.
+     */
+    public boolean frame() {
+        if (++frameCounter < DECAY_INTERVAL) {
+            return false;
+        }
+        frameCounter = 0;
+        decay();
+        return true;
+    }
+
+    /** One bulk fade pass over the lit bounding box. */
+    public void decay() {
+        if (litMaxX < 0) {
+            return;
+        }
+        boolean anyLit = false;
+        for (int y = litMinY; y <= litMaxY; y++) {
+            int row = y * width;
+            for (int i = row + litMinX; i <= row + litMaxX; i++) {
+                int v = intensity[i];
+                if (v != 0) {
+                    v = (v * DECAY_NUMERATOR) >> 8;
+                    intensity[i] = v;
+                    anyLit |= v != 0;
+                }
+            }
+        }
+        markDirty(litMinX, litMinY, litMaxX, litMaxY);
+        if (!anyLit) {
+            litMinX = litMinY = Integer.MAX_VALUE;
+            litMaxX = litMaxY = -1;
+        }
+    }
+
+    public int getIntensity(int x, int y) {
+        return intensity[y * width + x];
+    }
+
+    /** Raw buffer, row-major with stride {@link #getWidth()}. */
+    int[] getIntensityBuffer() {
+        return intensity;
+    }
+
+    public boolean isDirty() {
+        return dirtyMaxX >= dirtyMinX && dirtyMaxY >= dirtyMinY;
+    }
+
+    public int getDirtyMinX() { return dirtyMinX; }
+    public int getDirtyMinY() { return dirtyMinY; }
+    public int getDirtyMaxX() { return dirtyMaxX; }
+    public int getDirtyMaxY() { return dirtyMaxY; }
+
+    /** Mark the whole buffer for the next blit, e.g. after a colour scheme change. */
+    public void invalidate() {
+        markDirty(0, 0, width - 1, height - 1);
+    }
+
+    /** Call after the dirty region has been copied out. */
+    public void clearDirty() {
+        dirtyMinX = dirtyMinY = Integer.MAX_VALUE;
+        dirtyMaxX = dirtyMaxY = -1;
+    }
+
+    /** Blend each pixel from background to foreground by its intensity (0xAARRGGBB). */
+    public int[] toArgb(int background, int foreground) {
+        int[] out = new int[width * height];
+        for (int i = 0; i < out.length; i++) {
+            out[i] = blend(background, foreground, intensity[i]);
+        }
+        return out;
+    }
+
+    static int blend(int background, int foreground, int level) {
+        int inv = MAX_INTENSITY - level;
+        int r = (((background >> 16) & 0xff) * inv + ((foreground >> 16) & 0xff) * level) / MAX_INTENSITY;
+        int g = (((background >> 8) & 0xff) * inv + ((foreground >> 8) & 0xff) * level) / MAX_INTENSITY;
+        int b = ((background & 0xff) * inv + (foreground & 0xff) * level) / MAX_INTENSITY;
+        return 0xff000000 | (r << 16) | (g << 8) | b;
+    }
+
+    private void drawLine(int x0, int y0, int x1, int y1) {
+        if (!inside(x0, y0) || !inside(x1, y1)) {
+            // clip first so far off-screen points (manual scale) don't walk long lines
+            double[] c = clip(x0, y0, x1, y1, width - 1, height - 1);
+            if (c == null) {
+                return;
+            }
+            x0 = (int) Math.round(c[0]);
+            y0 = (int) Math.round(c[1]);
+            x1 = (int) Math.round(c[2]);
+            y1 = (int) Math.round(c[3]);
+        }
+        int dx = Math.abs(x1 - x0);
+        int dy = -Math.abs(y1 - y0);
+        int sx = x0 < x1 ? 1 : -1;
+        int sy = y0 < y1 ? 1 : -1;
+        int err = dx + dy;
+        int minX = Integer.MAX_VALUE, minY = Integer.MAX_VALUE, maxX = -1, maxY = -1;
+        while (true) {
+            if (x0 >= 0 && y0 >= 0 && x0 < width && y0 < height) {
+                intensity[y0 * width + x0] = MAX_INTENSITY;
+                if (x0 < minX) minX = x0;
+                if (x0 > maxX) maxX = x0;
+                if (y0 < minY) minY = y0;
+                if (y0 > maxY) maxY = y0;
+            }
+            if (x0 == x1 && y0 == y1) {
+                break;
+            }
+            int e2 = 2 * err;
+            if (e2 >= dy) {
+                err += dy;
+                x0 += sx;
+            }
+            if (e2 <= dx) {
+                err += dx;
+                y0 += sy;
+            }
+        }
+        if (maxX < 0) {
+            return;
+        }
+        markDirty(minX, minY, maxX, maxY);
+        litMinX = Math.min(litMinX, minX);
+        litMinY = Math.min(litMinY, minY);
+        litMaxX = Math.max(litMaxX, maxX);
+        litMaxY = Math.max(litMaxY, maxY);
+    }
+
+    private boolean inside(int x, int y) {
+        return x >= 0 && y >= 0 && x < width && y < height;
+    }
+
+    /** Liang-Barsky clip of a segment to [0, maxX] x [0, maxY]; null if nothing is left. */
+    static double[] clip(double x0, double y0, double x1, double y1, double maxX, double maxY) {
+        double dx = x1 - x0;
+        double dy = y1 - y0;
+        double[] p = { -dx, dx, -dy, dy };
+        double[] q = { x0, maxX - x0, y0, maxY - y0 };
+        double t0 = 0;
+        double t1 = 1;
+        for (int i = 0; i < 4; i++) {
+            if (p[i] == 0) {
+                if (q[i] < 0) {
+                    return null;
+                }
+                continue;
+            }
+            double t = q[i] / p[i];
+            if (p[i] < 0) {
+                if (t > t1) return null;
+                if (t > t0) t0 = t;
+            } else {
+                if (t < t0) return null;
+                if (t < t1) t1 = t;
+            }
+        }
+        return new double[] { x0 + t0 * dx, y0 + t0 * dy, x0 + t1 * dx, y0 + t1 * dy };
+    }
+
+    private void markDirty(int minX, int minY, int maxX, int maxY) {
+        if (maxX < minX || maxY < minY) {
+            return;
+        }
+        dirtyMinX = Math.min(dirtyMinX, minX);
+        dirtyMinY = Math.min(dirtyMinY, minY);
+        dirtyMaxX = Math.max(dirtyMaxX, maxX);
+        dirtyMaxY = Math.max(dirtyMaxY, maxY);
+    }
+}
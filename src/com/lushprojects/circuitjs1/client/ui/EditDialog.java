@@ -345,6 +345,7 @@ public class EditDialog extends Dialog {
 			
 			// update slider if any
 			if (elm instanceof CircuitElm) {
+			    ((CircuitElm)elm).bumpContentVersion();
 			    Adjustable adj = cframe.findAdjustable((CircuitElm)elm, i);
 			    if (adj != null)
 				adj.setSliderValue(ei.value);
@@ -370,6 +371,8 @@ public class EditDialog extends Dialog {
 		    }
 		    
 		    elm.setEditValue(i, ei);
+		    if (elm instanceof CircuitElm)
+			((CircuitElm)elm).bumpContentVersion();
 		    if (ei.newDialog)
 			changed = true;
 		    cframe.needAnalyze();
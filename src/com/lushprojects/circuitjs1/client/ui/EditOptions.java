@@ -125,15 +125,30 @@ public class EditOptions implements Editable {
 		    ei.checkbox = new Checkbox("Auto-Open Model Info on Load", sim.autoOpenModelInfoOnLoad);
 		    return ei;
 		}
+		if (n == 23) {
+		    EditInfo ei = new EditInfo("", 0, -1, -1);
+		    ei.checkbox = new Checkbox("Compact Undo/Clipboard Storage", sim.compactInternalDumps);
+		    return ei;
+		}
+		if (n == 24) {
+		    EditInfo ei = new EditInfo("", 0, -1, -1);
+		    ei.checkbox = new Checkbox("EqnTable Anderson Acceleration", sim.equationTableAndersonAccelerationEnabled);
+		    return ei;
+		}
+		if (n == 25) {
+		    EditInfo ei = new EditInfo("", 0, -1, -1);
+		    ei.checkbox = new Checkbox("Reuse LU Factorizations", sim.luFactorCacheEnabled);
+		    return ei;
+		}
 		// Conditional items must be last. When the condition is false,
 		// getEditInfo() returns null which terminates the dialog loop,
 		// hiding any items that would follow.
-		if (n == 23) {
+		if (n == 26) {
 		    EditInfo ei = new EditInfo("", 0, -1, -1);
 		    ei.checkbox = new Checkbox("Auto-Adjust Timestep", sim.adjustTimeStep);
 		    return ei;
 		}
-		if (n == 24 && sim.adjustTimeStep)
+		if (n == 27 && sim.adjustTimeStep)
 		    return new EditInfo("Minimum time step size (s)", sim.getTimingState().minTimeStep, 0, 0);
 
 		return null;
@@ -261,10 +276,24 @@ public class EditOptions implements Editable {
 		    setOptionInStorage("autoOpenModelInfoOnLoad", sim.autoOpenModelInfoOnLoad);
 		}
 		if (n == 23) {
+		    sim.compactInternalDumps = ei.checkbox.getState();
+		    setOptionInStorage("compactInternalDumps", sim.compactInternalDumps);
+		}
+		if (n == 24) {
+		    sim.equationTableAndersonAccelerationEnabled = ei.checkbox.getState();
+		    setOptionInStorage("equationTableAndersonAccelerationEnabled", sim.equationTableAndersonAccelerationEnabled);
+		}
+		if (n == 25) {
+		    sim.luFactorCacheEnabled = ei.checkbox.getState();
+		    setOptionInStorage("luFactorCacheEnabled", sim.luFactorCacheEnabled);
+		    if (!sim.luFactorCacheEnabled)
+			sim.getSolverMatrixState().factorCache.clear();
+		}
+		if (n == 26) {
 		    sim.adjustTimeStep = ei.checkbox.getState();
 		    ei.newDialog = true;
 		}
-		if (n == 24 && ei.value > 0)
+		if (n == 27 && ei.value > 0)
 		    sim.getTimingState().minTimeStep = ei.value;
 	}
 
@@ -279,7 +308,7 @@ public class EditOptions implements Editable {
 	    String keys[] = {
 		"crossHair", "euroResistors", "euroGates", "whiteBackground", "conventionalCurrent",
 		"mouseWheelEdit", "weightedPriority", "showElectronicsCircuits", "alternativeColor",
-		"enableCacheBustedUrls", "tableRenderCacheEnabled", "autoOpenModelInfoOnLoad", "equationTableConvergenceTolerance", "equationTableNewtonJacobianEnabled", "equationTableBroydenJacobianEnabled",
+		"enableCacheBustedUrls", "tableRenderCacheEnabled", "autoOpenModelInfoOnLoad", "compactInternalDumps", "equationTableConvergenceTolerance", "equationTableNewtonJacobianEnabled", "equationTableBroydenJacobianEnabled", "equationTableAndersonAccelerationEnabled", "luFactorCacheEnabled",
 		"positiveColor", "negativeColor", "neutralColor", "selectColor", "currentColor",
 		"language", "wheelSensitivity", "graphicsUpdateInterval", "voltageUnitSymbol",
 		"scopeDefaults", "shortcuts"
@@ -21,6 +21,7 @@ package com.lushprojects.circuitjs1.client.ui;
 
 import com.lushprojects.circuitjs1.client.*;
 import com.lushprojects.circuitjs1.client.util.*;
+import com.lushprojects.circuitjs1.client.io.CompactCircuitCodec;
 
 import com.google.gwt.user.client.ui.TextArea;
 import com.google.gwt.user.client.ui.HasHorizontalAlignment;
@@ -140,13 +141,20 @@ public class ExportAsUrlDialog extends Dialog {
 	    return window.getLZString().compressToEncodedURIComponent(dump);
 	}
 	
+	// Prefer the compact binary encoding (cjb=) when it beats LZString (ctz=).
+	private String shortestQuery(String dump) {
+	    String ctz = "?ctz=" + compress(dump);
+	    String cjb = "?cjb=" + CompactCircuitCodec.encodeToBase64Url(dump);
+	    return cjb.length() < ctz.length() ? cjb : ctz;
+	}
+	
 	public ExportAsUrlDialog( String dump) {
 		super();
 		closeOnEnter = false;
 		String start[] = Location.getHref().split("\\?");
 		if (CirSim.getInstance().isElectron())
 		    start[0] = "https://johnnewto.github.io/circuitjs1/circuitjs.html";
-		String query="?ctz=" + compress(dump);
+		String query = shortestQuery(dump);
 		dump = start[0] + query;
 		requrl = URL.encodeQueryString(query);
 		Button okButton, copyButton;
@@ -62,7 +62,7 @@ private TextArea textArea;
 				closeDialog();
 				String s = textArea.getText();
 				sim.pushUndoForUi();
-				sim.getImportExportHelper().importCircuitFromText(s, Boolean.TRUE.equals(subCheck.getValue()));
+				sim.getImportExportHelper().importCircuitFromTextIncremental(s, Boolean.TRUE.equals(subCheck.getValue()));
 			}
 		});
 		hp.add(cancelButton = new Button(Locale.LS("Cancel")));
@@ -12,6 +12,7 @@ import com.lushprojects.circuitjs1.client.util.*;
 
 import com.lushprojects.circuitjs1.client.CirSim;
 import com.lushprojects.circuitjs1.client.elements.economics.InfoViewerLiveDataSerializer;
+import com.lushprojects.circuitjs1.client.elements.economics.InfoViewerLivePacket;
 import com.lushprojects.circuitjs1.client.elements.economics.InfoViewerTableMarkdown;
 import com.google.gwt.user.client.ui.DialogBox;
 import com.google.gwt.user.client.ui.HTML;
@@ -170,6 +171,12 @@ public class InfoViewerDialog extends DialogBox {
     private static boolean currentRenderSfcrConstructTables = true;
     private static boolean appendCircuitTablesAsBlocks = true;
     private static long lastLiveUpdateMs = 0;
+    private static String lastLiveMetaJson = null;
+    private static Object lastLiveMeta = null;
+    private static int liveMetaVersion = 0;
+    private static boolean liveMetaRequested = false;
+    private static WindowLike lastLivePopup = null;
+    private static WindowLike lastLiveIframe = null;
     private static final int DEFAULT_LIVE_UPDATE_INTERVAL_MS = 200;
     
     private VerticalPanel vp;
@@ -392,13 +399,13 @@ public class InfoViewerDialog extends DialogBox {
             return;
         }
 
-        String json = InfoViewerLiveDataSerializer.buildLiveDataJson(CirSim.getInstance());
-        if (json == null || json.isEmpty()) {
+        InfoViewerLivePacket packet = InfoViewerLiveDataSerializer.buildLivePacket(CirSim.getInstance());
+        if (packet == null) {
             return;
         }
 
         lastLiveUpdateMs = now;
-        postLiveDataToViewers(json);
+        postLivePacketToViewers(packet);
     }
 
     private static boolean hasActiveViewer() {
@@ -409,25 +416,54 @@ public class InfoViewerDialog extends DialogBox {
         return popupOpen || iframeOpen;
     }
 
-    private static void postLiveDataToViewers(String jsonData) {
-        Object payload;
+    /**
+     * Numbers go out as Float64Array channels; the names that say how to read
+     * them are parsed and re-sent only when they change, when a viewer window
+     * is new, or when a viewer asks for them after reloading.
+     */
+    private static void postLivePacketToViewers(InfoViewerLivePacket packet) {
+        boolean metaChanged = !packet.metaJson.equals(lastLiveMetaJson);
+        if (metaChanged) {
+            try {
+                lastLiveMeta = parseJson(packet.metaJson);
+            } catch (Throwable e) {
+                return;
+            }
+            lastLiveMetaJson = packet.metaJson;
+            liveMetaVersion++;
+        }
+        Object sankeys;
         try {
-            payload = parseJson(jsonData);
+            sankeys = parseJson(packet.sankeysJson);
         } catch (Throwable e) {
-            return;
+            sankeys = null;
         }
 
+        ViewerPacketTransport transport = new ViewerPacketTransport("circuit-live", liveMetaVersion);
+        transport.setMeta(lastLiveMeta);
+        transport.setExtra(sankeys);
+        transport.addChannel("clock", packet.clock);
+        transport.addChannel("vars", packet.vars);
+        transport.addChannel("tables", packet.tables);
+        transport.addChannel("scopes", packet.scopes);
+        boolean forceMeta = metaChanged || liveMetaRequested;
+        liveMetaRequested = false;
+
         WindowLike popup = GlobalWindowLike.getModelInfoWindow();
         if (popup != null && !popup.isClosed()) {
             try {
-                popup.postMessage(payload, "*");
+                transport.postTo((ViewerPacketTransport.MessageTarget) popup, forceMeta || popup != lastLivePopup);
+                lastLivePopup = popup;
             } catch (Throwable e1) {}
         }
 
         IframeLike iframe = (IframeLike) getDocument().getElementById("iframeViewerContent");
         if (iframe != null && iframe.getContentWindow() != null) {
+            WindowLike frameWindow = iframe.getContentWindow();
             try {
-                iframe.getContentWindow().postMessage(payload, "*");
+                transport.postTo((ViewerPacketTransport.MessageTarget) frameWindow,
+                        forceMeta || frameWindow != lastLiveIframe);
+                lastLiveIframe = frameWindow;
             } catch (Throwable e2) {}
         }
     }
@@ -450,6 +486,11 @@ public class InfoViewerDialog extends DialogBox {
                     handleSimulationCommand(data.getCommand() == null ? "" : data.getCommand());
                     return;
                 }
+                if ("info-viewer-request-live-meta".equals(type)) {
+                    liveMetaRequested = true;
+                    lastLiveUpdateMs = 0;
+                    return;
+                }
                 if ("info-viewer-option-changed".equals(type)) {
                     handleViewerOptionChanged(data.getKey() == null ? "" : data.getKey(), data.isEnabled());
                 }
@@ -59,6 +59,9 @@ final class InfoViewerHtmlBuilder {
             "    var liveTables = [];",
             "    var liveSankeys = {};",
             "    var liveScopes = {};",
+            "    var liveMeta = null;",
+            "    var liveMetaVersion = -1;",
+            "    var liveMetaRequested = false;",
             "    var nextCircuitPlotId = 1;",
             "    var simRunning = false;",
             "    function updateRunStopButton() {",
@@ -867,8 +870,50 @@ final class InfoViewerHtmlBuilder {
             "      });",
             "      updateCircuitPlotMounts();",
             "    }",
+            "    function requestLiveMeta() {",
+            "      if (liveMetaRequested) return;",
+            "      liveMetaRequested = true;",
+            "      const msg = { type: 'info-viewer-request-live-meta' };",
+            "      try { if (window.parent) window.parent.postMessage(msg, '*'); } catch (e1) {}",
+            "      try { if (window.opener) window.opener.postMessage(msg, '*'); } catch (e2) {}",
+            "    }",
+            "    // Live packets carry numbers in Float64Array channels; meta (names and",
+            "    // labels, in channel order) is only resent when it changes.",
+            "    function decodeLivePacket(data) {",
+            "      if (data.packet === undefined) return data;",
+            "      if (data.meta) { liveMeta = data.meta; liveMetaVersion = data.metaVersion; liveMetaRequested = false; }",
+            "      if (!liveMeta || liveMetaVersion !== data.metaVersion) { requestLiveMeta(); return null; }",
+            "      const ch = {};",
+            "      (data.channels || []).forEach(function(c) { ch[c.name] = c.data; });",
+            "      const clock = ch.clock || [];",
+            "      const vars = {};",
+            "      const varNames = liveMeta.vars || [];",
+            "      const varData = ch.vars || [];",
+            "      for (let i = 0; i < varNames.length && i < varData.length; i++) {",
+            "        if (isFinite(varData[i])) vars[varNames[i]] = varData[i];",
+            "      }",
+            "      const tableData = ch.tables || [];",
+            "      let off = 0;",
+            "      const tables = (liveMeta.tables || []).map(function(tm) {",
+            "        const values = tm.rowNames.map(function() {",
+            "          const row = [];",
+            "          for (let c = 0; c < tm.cols.length; c++) row.push(off < tableData.length ? tableData[off++] : 0);",
+            "          return row;",
+            "        });",
+            "        return Object.assign({}, tm, { values: values });",
+            "      });",
+            "      const scopeData = ch.scopes || [];",
+            "      let soff = 0;",
+            "      const scopes = (liveMeta.scopes || []).map(function(sm) {",
+            "        return { name: sm.name, traces: sm.traces.map(function(name) {",
+            "          return { name: name, value: soff < scopeData.length ? scopeData[soff++] : 0 };",
+            "        }) };",
+            "      });",
+            "      return { type: data.type, t: clock[0], dt: clock[1], running: clock.length > 2 ? clock[2] !== 0 : undefined,",
+            "        vars: vars, tables: tables, scopes: scopes, sankeys: data.extra };",
+            "    }",
             "    window.addEventListener('message', function(event) {",
-            "      const data = event.data;",
+            "      let data = event.data;",
             "      if (!data || !data.type) return;",
             "      if (data.type === 'info-viewer-sync-markdown') {",
             "        if (!editorEnabled) return;",
@@ -884,6 +929,8 @@ final class InfoViewerHtmlBuilder {
             "        return;",
             "      }",
             "      if (data.type !== 'circuit-live') return;",
+            "      data = decodeLivePacket(data);",
+            "      if (!data) return;",
             "      const prevT = (typeof liveValues.t === 'number') ? liveValues.t : null;",
             "      if (typeof data.running === 'boolean') { simRunning = data.running; updateRunStopButton(); }",
             "      liveValues = data.vars || {};",
@@ -1005,9 +1052,22 @@ final class InfoViewerHtmlBuilder {
         );
         appendMarkdownHelpersScript(html);
         appendLines(html,
+            "    let lastRenderKey = null;",
             "    function renderMarkdown(md) {",
             "      markdown = md;",
             "      const content = document.getElementById('content');",
+            "      // Re-sending the same text (editor sync echoes, option toggles back and forth) keeps",
+            "      // the existing DOM and mounts; live values are patched in place below.",
+            "      const renderKey = (parseCodeFenceConstructs ? '1' : '0') + (renderSfcrConstructTables ? '1' : '0') + markdown;",
+            "      if (renderKey === lastRenderKey && content.firstChild) {",
+            "        updateLiveValueSpans();",
+            "        updateCircuitTableMounts();",
+            "        updateCircuitPlotMounts();",
+            "        updateCircuitScopeMounts();",
+            "        updateCircuitSankeyMounts();",
+            "        return;",
+            "      }",
+            "      lastRenderKey = renderKey;",
             "      // Protect math segments so markdown emphasis parsing doesn't eat '*' inside $...$",
             "      const protectedMath = [];",
             "      const markdownForParse = markdown.replace(/\\$\\$[\\s\\S]*?\\$\\$|\\$[^$\\n]+\\$/g, function(match) {",
@@ -1071,6 +1131,7 @@ final class InfoViewerHtmlBuilder {
             "      }).catch(function(err) {",
             "        const c = document.getElementById('content');",
             "        c.innerHTML = '<p>Failed to load reference index.</p>';",
+            "        lastRenderKey = null;",
             "      });",
             "    }",
             "    ",
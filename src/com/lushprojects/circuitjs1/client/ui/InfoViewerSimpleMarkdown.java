@@ -10,14 +10,37 @@ import com.lushprojects.circuitjs1.client.util.*;
 
 import com.lushprojects.circuitjs1.client.util.Locale;
 
+import java.util.LinkedHashMap;
+import java.util.Map;
+
 final class InfoViewerSimpleMarkdown {
 
     private InfoViewerSimpleMarkdown() {
     }
 
+    /** Rendered blocks kept between refreshes; enough for a few large documents. */
+    static final int MAX_CACHED_BLOCKS = 512;
+
+    // block markdown -> HTML, least recently used first. The block text is the
+    // key, so its hash picks the bucket and equals() rules out collisions.
+    private static final LinkedHashMap<String, String> blockCache =
+        new LinkedHashMap<String, String>(64, 0.75f, true) {
+            @Override
+            protected boolean removeEldestEntry(Map.Entry<String, String> eldest) {
+                return size() > MAX_CACHED_BLOCKS;
+            }
+        };
+    private static int hits;
+    private static int misses;
+
     /**
      * Convert simple markdown to HTML without external libraries.
      * Supports basic formatting for fallback display.
+     *
+     * The text is split into blocks at blank lines that are outside code
+     * fences and lists, so each block renders the same on its own as it does
+     * in place. Blocks already seen are taken from the cache; only edited
+     * blocks are converted again.
      */
     public static String convert(String markdown) {
         if (markdown == null) {
@@ -30,8 +53,58 @@ final class InfoViewerSimpleMarkdown {
         String[] lines = markdown.split("\\n");
         boolean inCodeBlock = false;
         boolean inList = false;
+        int blockStart = 0;
+        for (int i = 0; i < lines.length; i++) {
+            String trimmed = lines[i].trim();
+            if (trimmed.startsWith("```")) {
+                inCodeBlock = !inCodeBlock;
+                continue;
+            }
+            if (inCodeBlock || isHeadingOrRule(lines[i])) {
+                // headings and rules leave an open list open, as in renderLines
+                continue;
+            }
+            if (trimmed.startsWith("- ") || trimmed.startsWith("* ")) {
+                inList = true;
+            } else if (!trimmed.isEmpty()) {
+                inList = false;
+            } else if (!inList) {
+                out.append(convertBlock(lines, blockStart, i + 1));
+                blockStart = i + 1;
+            }
+        }
+        if (blockStart < lines.length) {
+            out.append(convertBlock(lines, blockStart, lines.length));
+        }
+
+        out.append(closeTag("div"));
+        return out.toString();
+    }
+
+    private static String convertBlock(String[] lines, int from, int to) {
+        StringBuilder key = new StringBuilder();
+        for (int i = from; i < to; i++) {
+            key.append(lines[i]).append('\n');
+        }
+        String block = key.toString();
+        String html = blockCache.get(block);
+        if (html != null) {
+            hits++;
+            return html;
+        }
+        misses++;
+        html = renderLines(lines, from, to);
+        blockCache.put(block, html);
+        return html;
+    }
+
+    private static String renderLines(String[] lines, int from, int to) {
+        StringBuilder out = new StringBuilder();
+        boolean inCodeBlock = false;
+        boolean inList = false;
 
-        for (String line : lines) {
+        for (int i = from; i < to; i++) {
+            String line = lines[i];
             if (line.trim().startsWith("```")) {
                 if (inCodeBlock) {
                     out.append(closeTag("pre"));
@@ -93,10 +166,30 @@ final class InfoViewerSimpleMarkdown {
             out.append(closeTag("pre"));
         }
 
-        out.append(closeTag("div"));
         return out.toString();
     }
 
+    private static boolean isHeadingOrRule(String line) {
+        if (line.startsWith("### ") || line.startsWith("## ") || line.startsWith("# ")) {
+            return true;
+        }
+        return line.trim().matches("^[=]{3,}$") || line.trim().matches("^[-]{3,}$");
+    }
+
+    static void clearCache() {
+        blockCache.clear();
+        hits = 0;
+        misses = 0;
+    }
+
+    static int getCacheHitCount() {
+        return hits;
+    }
+
+    static int getCacheMissCount() {
+        return misses;
+    }
+
     private static String openTag(String tag) {
         return "<" + tag + ">";
     }
@@ -0,0 +1,107 @@
+package com.lushprojects.circuitjs1.client.ui;
+
+import com.lushprojects.circuitjs1.client.scope.ScopeDownsampler;
+import com.lushprojects.circuitjs1.client.scope.ScopeTraceSnapshot;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import jsinterop.annotations.JsFunction;
+import jsinterop.annotations.JsPackage;
+import jsinterop.annotations.JsProperty;
+import jsinterop.annotations.JsType;
+
+/**
+ * Serves scope samples to open viewer windows.
+ *
+ * The viewer page calls {@code window.opener.circuitjsScopeViewerRequest}
+ * for each trace, first for the whole run and then again for the visible
+ * window whenever the user zooms or pans. Samples come back as Float64Arrays
+ * reduced to the requested point count, so nothing is formatted as JSON text
+ * and zooming in reveals detail the first overview had dropped.
+ */
+final class ScopeViewerBridge {
+    /** Snapshots of older viewers are dropped; their zoom requests just keep the current data. */
+    private static final int MAX_VIEWERS = 8;
+
+    @JsType(isNative = true, namespace = JsPackage.GLOBAL, name = "Float64Array")
+    private static class Float64ArrayLike {
+        Float64ArrayLike(double[] values) {}
+    }
+
+    @JsType(isNative = true, namespace = JsPackage.GLOBAL, name = "Object")
+    private static class TraceWindowLike {
+        public Float64ArrayLike time;
+        public Float64ArrayLike values;
+        public Float64ArrayLike minValues;
+        public Float64ArrayLike maxValues;
+        public int sampleCount;
+        public double firstTime;
+        public double lastTime;
+    }
+
+    @JsFunction
+    interface TraceRequest {
+        TraceWindowLike request(double viewerId, double scopeIndex, double plotIndex,
+                double t0, double t1, double points, String mode);
+    }
+
+    @JsType(isNative = true, namespace = JsPackage.GLOBAL, name = "window")
+    private static class GlobalWindowLike {
+        @JsProperty(name = "circuitjsScopeViewerRequest") static native void setScopeViewerRequest(TraceRequest request);
+    }
+
+    private static final LinkedHashMap<Integer, ScopeTraceSnapshot[][]> viewers =
+            new LinkedHashMap<Integer, ScopeTraceSnapshot[][]>();
+    private static int nextViewerId = 1;
+    private static boolean installed;
+
+    private ScopeViewerBridge() {
+    }
+
+    /** Keep the snapshots for a new viewer window and return its id. */
+    static int register(ScopeTraceSnapshot[][] scopes) {
+        if (!installed) {
+            GlobalWindowLike.setScopeViewerRequest(new TraceRequest() {
+                public TraceWindowLike request(double viewerId, double scopeIndex, double plotIndex,
+                        double t0, double t1, double points, String mode) {
+                    return requestTrace((int) viewerId, (int) scopeIndex, (int) plotIndex,
+                            t0, t1, (int) points, mode);
+                }
+            });
+            installed = true;
+        }
+
+        int id = nextViewerId++;
+        viewers.put(id, scopes);
+        if (viewers.size() > MAX_VIEWERS) {
+            Iterator<Map.Entry<Integer, ScopeTraceSnapshot[][]>> it = viewers.entrySet().iterator();
+            it.next();
+            it.remove();
+        }
+        return id;
+    }
+
+    private static TraceWindowLike requestTrace(int viewerId, int scopeIndex, int plotIndex,
+            double t0, double t1, int points, String mode) {
+        ScopeTraceSnapshot[][] scopes = viewers.get(viewerId);
+        if (scopes == null || scopeIndex < 0 || scopeIndex >= scopes.length) {
+            return null;
+        }
+        ScopeTraceSnapshot[] traces = scopes[scopeIndex];
+        if (plotIndex < 0 || plotIndex >= traces.length) {
+            return null;
+        }
+
+        ScopeTraceSnapshot full = traces[plotIndex];
+        ScopeTraceSnapshot w = full.window(t0, t1, points, ScopeDownsampler.parseMode(mode));
+        TraceWindowLike out = new TraceWindowLike();
+        out.time = new Float64ArrayLike(w.time);
+        out.values = new Float64ArrayLike(w.values);
+        out.minValues = new Float64ArrayLike(w.minValues);
+        out.maxValues = new Float64ArrayLike(w.maxValues);
+        out.sampleCount = full.size();
+        out.firstTime = full.size() > 0 ? full.time[0] : 0;
+        out.lastTime = full.size() > 0 ? full.time[full.size() - 1] : 0;
+        return out;
+    }
+}
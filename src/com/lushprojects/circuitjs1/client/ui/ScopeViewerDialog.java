@@ -20,6 +20,7 @@
 package com.lushprojects.circuitjs1.client.ui;
 
 import com.lushprojects.circuitjs1.client.scope.Scope;
+import com.lushprojects.circuitjs1.client.scope.ScopeTraceSnapshot;
 
 import com.lushprojects.circuitjs1.client.elements.ActionScheduler;
 import com.lushprojects.circuitjs1.client.elements.misc.ScopeElm;
@@ -109,19 +110,19 @@ public class ScopeViewerDialog extends DialogBox {
     
     /**
      * Opens a new window with Plotly.js visualization of all scopes.
+     * Each scope is snapshotted at full resolution and registered with
+     * {@link ScopeViewerBridge}; the page itself only embeds metadata and
+     * pulls downsampled traces back as it is zoomed.
      */
     private void openViewer() {
-        // Collect all scope data
-        StringBuilder allDataJson = new StringBuilder();
-        allDataJson.append("[\n");
-        
-        boolean first = true;
-        
+        java.util.List<Scope> scopes = new java.util.ArrayList<Scope>();
+        java.util.List<String> names = new java.util.ArrayList<String>();
+
         // If single scope specified, only export that one
         if (singleScope != null) {
-            exportScope(allDataJson, singleScope, 0, getScopeName(singleScope, "Scope", 1));
+            scopes.add(singleScope);
+            names.add(getScopeName(singleScope, "Scope", 1));
         } else {
-            int exportedIndex = 0;
             int dockedOrdinal = 1;
             int undockedOrdinal = 1;
 
@@ -130,13 +131,8 @@ public class ScopeViewerDialog extends DialogBox {
                 Scope scope = sim.scopes[i];
                 if (scope == null || scope.getVisiblePlotCount() == 0)
                     continue;
-
-                if (!first)
-                    allDataJson.append(",\n");
-                first = false;
-
-                String scopeName = getScopeName(scope, "Scope", dockedOrdinal++);
-                exportScope(allDataJson, scope, exportedIndex++, scopeName);
+                scopes.add(scope);
+                names.add(getScopeName(scope, "Scope", dockedOrdinal++));
             }
 
             // Export all undocked (floating) ScopeElm scopes
@@ -147,19 +143,30 @@ public class ScopeViewerDialog extends DialogBox {
                 Scope scope = scopeElm.elmScope;
                 if (scope == null || scope.getVisiblePlotCount() == 0)
                     continue;
+                scopes.add(scope);
+                names.add(getScopeName(scope, "Undocked Scope", undockedOrdinal++));
+            }
+        }
 
-                if (!first)
-                    allDataJson.append(",\n");
-                first = false;
+        // Use history if available, otherwise circular buffer
+        boolean[] useHistory = new boolean[scopes.size()];
+        ScopeTraceSnapshot[][] traces = new ScopeTraceSnapshot[scopes.size()][];
+        for (int i = 0; i < scopes.size(); i++) {
+            useHistory[i] = scopes.get(i).hasHistoryForExport();
+            traces[i] = scopes.get(i).snapshotTracesForViewer(useHistory[i]);
+        }
+        int viewerId = ScopeViewerBridge.register(traces);
 
-                String scopeName = getScopeName(scope, "Undocked Scope", undockedOrdinal++);
-                exportScope(allDataJson, scope, exportedIndex++, scopeName);
-            }
+        StringBuilder allDataJson = new StringBuilder();
+        allDataJson.append("[\n");
+        for (int i = 0; i < scopes.size(); i++) {
+            if (i > 0)
+                allDataJson.append(",\n");
+            exportScope(allDataJson, scopes.get(i), i, names.get(i), viewerId, useHistory[i], traces[i]);
         }
-        
         allDataJson.append("\n]");
         
-        // Generate HTML with embedded data and Plotly
+        // Generate HTML with embedded metadata and Plotly
         String html = generatePlotlyHTML(allDataJson.toString());
         
         // Open in new window
@@ -172,12 +179,14 @@ public class ScopeViewerDialog extends DialogBox {
     }
     
     /**
-     * Exports a single scope's data to JSON.
+     * Exports a single scope's metadata to JSON; samples are served by {@link ScopeViewerBridge}.
      */
-    private void exportScope(StringBuilder allDataJson, Scope scope, int index, String scopeName) {
+    private void exportScope(StringBuilder allDataJson, Scope scope, int index, String scopeName,
+            int viewerId, boolean useHistory, ScopeTraceSnapshot[] traces) {
         allDataJson.append("{\n");
         allDataJson.append("  \"scopeName\": \"").append(PlotlyWindowHelper.escapeJSON(scopeName)).append("\",\n");
         allDataJson.append("  \"scopeIndex\": ").append(index).append(",\n");
+        allDataJson.append("  \"viewerId\": ").append(viewerId).append(",\n");
         
         // Add action times if available
         ActionScheduler scheduler = ActionScheduler.getInstance();
@@ -214,9 +223,7 @@ public class ScopeViewerDialog extends DialogBox {
             }
         }
         
-        // Use history if available, otherwise circular buffer
-        boolean useHistory = scope.hasHistoryForExport();
-        String dataJson = scope.exportDataAsJSON(useHistory);
+        String dataJson = scope.exportTraceSummaryAsJSON(useHistory, traces);
         
         // Strip outer braces and merge
         int startIdx = dataJson.indexOf('{') + 1;
@@ -222,8 +222,12 @@ public class ScrollValuePopup extends PopupPanel implements MouseOutHandler, Mou
     	if (i!=lastidx) {
     		lastidx=i;
     		inf.value=values[i];
-    		myElm.setEditValue(0, inf);
-    		sim.needAnalyze();
+    		boolean patched = sim.getCircuitAnalyzer().applyParameterEdit(myElm, 0, inf);
+    		myElm.bumpContentVersion();
+    		if (patched)
+    		    sim.repaint();
+    		else
+    		    sim.needAnalyze();
     	}
     }
     
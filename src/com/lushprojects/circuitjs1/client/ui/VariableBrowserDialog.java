@@ -54,6 +54,7 @@ public class VariableBrowserDialog extends DialogBox {
     private FlexTable varTable;
     private ScrollPanel scrollPanel;
     private List<VariableInfo> currentVariables = new ArrayList<VariableInfo>();
+    private int catalogVersion = -1;
     private Timer autoRefreshTimer;
     private static VariableBrowserDialog instance = null; // Singleton instance
     private static final int DIALOG_WIDTH = 320;
@@ -217,7 +218,9 @@ public class VariableBrowserDialog extends DialogBox {
             varTable.removeRow(1);
         }
         
-        List<VariableCatalog.VariableEntry> variables = VariableCatalog.collectVariables(sim);
+        VariableCatalog catalog = sim.getVariableCatalog();
+        List<VariableCatalog.VariableEntry> variables = catalog.getVariables();
+        catalogVersion = catalog.getVersion();
         currentVariables = new ArrayList<VariableInfo>(variables.size());
         for (int i = 0; i < variables.size(); i++) {
             VariableCatalog.VariableEntry entry = variables.get(i);
@@ -278,6 +281,11 @@ public class VariableBrowserDialog extends DialogBox {
     }
 
     private void refreshValueCells() {
+        // rebuild rows only when a variable was added, removed or renamed
+        if (sim.getVariableCatalog().getVersion() != catalogVersion) {
+            refresh();
+            return;
+        }
         if (currentVariables == null || currentVariables.isEmpty()) {
             return;
         }
@@ -0,0 +1,98 @@
+package com.lushprojects.circuitjs1.client.ui;
+
+import java.util.ArrayList;
+import jsinterop.annotations.JsPackage;
+import jsinterop.annotations.JsProperty;
+import jsinterop.annotations.JsType;
+
+/**
+ * Posts bulk numeric data to viewer windows as Float64Arrays.
+ *
+ * Message descriptor (schema {@link #SCHEMA}):
+ * <pre>
+ * { type, packet: 1, metaVersion, meta?, channels: [{ name, data: Float64Array }], extra? }
+ * </pre>
+ * {@code meta} is plain JSON-compatible data describing how to read the
+ * channels. It is included only when it changed or when the receiver has
+ * not seen it yet. Each post gets fresh arrays whose buffers are moved, not
+ * copied, into the target window.
+ */
+final class ViewerPacketTransport {
+    static final int SCHEMA = 1;
+
+    @JsType(isNative = true, namespace = JsPackage.GLOBAL, name = "Window")
+    interface MessageTarget {
+        void postMessage(Object message, String targetOrigin, Object[] transfer);
+    }
+
+    @JsType(isNative = true, namespace = JsPackage.GLOBAL, name = "Float64Array")
+    private static class Float64ArrayLike {
+        Float64ArrayLike(double[] values) {}
+        @JsProperty(name = "buffer") native Object getBuffer();
+    }
+
+    @JsType(isNative = true, namespace = JsPackage.GLOBAL, name = "Object")
+    private static class ChannelLike {
+        @JsProperty String name;
+        @JsProperty Float64ArrayLike data;
+    }
+
+    @JsType(isNative = true, namespace = JsPackage.GLOBAL, name = "Object")
+    private static class PacketLike {
+        @JsProperty String type;
+        @JsProperty int packet;
+        @JsProperty int metaVersion;
+        @JsProperty Object meta;
+        @JsProperty Object[] channels;
+        @JsProperty Object extra;
+    }
+
+    private final String type;
+    private final int metaVersion;
+    private final ArrayList<String> channelNames = new ArrayList<String>();
+    private final ArrayList<double[]> channelData = new ArrayList<double[]>();
+    private Object meta;
+    private Object extra;
+
+    ViewerPacketTransport(String type, int metaVersion) {
+        this.type = type;
+        this.metaVersion = metaVersion;
+    }
+
+    void setMeta(Object meta) {
+        this.meta = meta;
+    }
+
+    void setExtra(Object extra) {
+        this.extra = extra;
+    }
+
+    void addChannel(String name, double[] data) {
+        channelNames.add(name);
+        channelData.add(data);
+    }
+
+    /** Post to one window, with metadata only if {@code includeMeta}. */
+    void postTo(MessageTarget target, boolean includeMeta) {
+        Object[] channels = new Object[channelNames.size()];
+        Object[] transfer = new Object[channelNames.size()];
+        for (int i = 0; i < channels.length; i++) {
+            ChannelLike channel = new ChannelLike();
+            channel.name = channelNames.get(i);
+            channel.data = new Float64ArrayLike(channelData.get(i));
+            channels[i] = channel;
+            transfer[i] = channel.data.getBuffer();
+        }
+
+        PacketLike message = new PacketLike();
+        message.type = type;
+        message.packet = SCHEMA;
+        message.metaVersion = metaVersion;
+        if (includeMeta) {
+            message.meta = meta;
+        }
+        message.channels = channels;
+        message.extra = extra;
+        target.postMessage(message, "*", transfer);
+    }
+}
@@ -0,0 +1,90 @@
+package com.lushprojects.circuitjs1.client.util;
+
+/**
+ * Turns voltages sampled at simulation timesteps into a stream at a fixed
+ * audio sample rate.
+ *
+ * By default each audio sample is the box average of the simulation samples
+ * since the previous one (what AudioOutputElm always did). With
+ * interpolation on, each audio sample is instead the linear interpolation
+ * between the two simulation samples that straddle its exact instant, which
+ * avoids the jitter of snapping to whichever timestep happened to cross it
+ * when the timestep is not a divisor of the sample period. Either way a
+ * timestep longer than the sample period emits every sample it crosses.
+ */
+public final class AudioResampler {
+
+    public interface Sink {
+        void writeSample(double v);
+    }
+
+    // a time jump larger than this (e.g. a reset we weren't told about) restarts
+    // the sample clock instead of filling the gap
+    private static final double MAX_GAP = 1;
+
+    private final double sampleStep;
+    private boolean interpolate;
+    private double nextSampleTime;
+    private double sum;
+    private int count;
+    private double lastTime;
+    private double lastValue;
+    private boolean haveLast;
+
+    public AudioResampler(int sampleRate, boolean interpolate) {
+        sampleStep = 1. / sampleRate;
+        this.interpolate = interpolate;
+    }
+
+    public double getSampleStep() {
+        return sampleStep;
+    }
+
+    public void setInterpolate(boolean interpolate) {
+        this.interpolate = interpolate;
+    }
+
+    /** Restart the sample clock; the first audio sample falls one period after startTime. */
+    public void reset(double startTime) {
+        nextSampleTime = startTime + sampleStep;
+        sum = 0;
+        count = 0;
+        haveLast = false;
+    }
+
+    /** Feed the value v at simulation time t; emits any audio samples due. */
+    public void addSample(double t, double v, Sink sink) {
+        if (t - nextSampleTime > MAX_GAP)
+            nextSampleTime = t;
+        if (interpolate) {
+            double dt = t - lastTime;
+            while (t >= nextSampleTime) {
+                double s = v;
+                if (haveLast && dt > 0) {
+                    double f = (nextSampleTime - lastTime) / dt;
+                    if (f > 0)
+                        s = lastValue + (v - lastValue) * f;
+                    else
+                        s = lastValue;
+                }
+                sink.writeSample(s);
+                nextSampleTime += sampleStep;
+            }
+            lastTime = t;
+            lastValue = v;
+            haveLast = true;
+            return;
+        }
+        sum += v;
+        count++;
+        if (t < nextSampleTime)
+            return;
+        double avg = sum / count;
+        do {
+            sink.writeSample(avg);
+            nextSampleTime += sampleStep;
+        } while (t >= nextSampleTime);
+        sum = 0;
+        count = 0;
+    }
+}
@@ -0,0 +1,93 @@
+package com.lushprojects.circuitjs1.client.util;
+
+/**
+ * Small direct-mapped cache of formatted numeric strings keyed by
+ * (value, unit, precision).
+ *
+ * Table renderers format every visible cell value on every frame, but between
+ * frames most values are unchanged (paused simulation, converged stocks,
+ * parameters). A lookup here costs a hash and three compares and allocates
+ * nothing, so repeated values skip the NumFmt pass entirely.
+ *
+ * The precision argument is an opaque int chosen by the caller; it should
+ * change whenever the formatter's output for the same (value, unit) would
+ * change (decimal digits, short vs long format, economics mode, ...).
+ * Values are compared with {@code ==}, so NaN never hits and is simply
+ * re-formatted each time.
+ *
+ * Hashing avoids {@code long} arithmetic on purpose: longs are emulated in
+ * GWT and would cost more than the lookup saves.
+ */
+public final class FormattedValueCache {
+
+    private final int mask;
+    private final double[] values;
+    private final String[] units;
+    private final int[] precisions;
+    private final String[] texts;
+    private int hits;
+    private int misses;
+
+    /**
+     * @param capacity number of slots; rounded up to a power of two
+     */
+    public FormattedValueCache(int capacity) {
+        int size = 16;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask = size - 1;
+        values = new double[size];
+        units = new String[size];
+        precisions = new int[size];
+        texts = new String[size];
+    }
+
+    /** Returns the cached text, or null if this key is not cached. */
+    public String get(double value, String unit, int precision) {
+        int slot = slot(value, unit, precision);
+        String text = texts[slot];
+        if (text != null && values[slot] == value && precisions[slot] == precision
+                && unit.equals(units[slot])) {
+            hits++;
+            return text;
+        }
+        misses++;
+        return null;
+    }
+
+    /** Stores text for the key, replacing whatever shared its slot. */
+    public void put(double value, String unit, int precision, String text) {
+        int slot = slot(value, unit, precision);
+        values[slot] = value;
+        units[slot] = unit;
+        precisions[slot] = precision;
+        texts[slot] = text;
+    }
+
+    public void clear() {
+        for (int i = 0; i <= mask; i++) {
+            texts[i] = null;
+            units[i] = null;
+        }
+    }
+
+    public int getHitCount() {
+        return hits;
+    }
+
+    public int getMissCount() {
+        return misses;
+    }
+
+    private int slot(double value, String unit, int precision) {
+        // Mix integer part and scaled fraction; saturating casts keep huge
+        // values in range (they just share slots).
+        double whole = Math.floor(value);
+        int h = (int) whole * 0x9E3779B1;
+        h ^= (int) ((value - whole) * 1e9) * 0x85EBCA6B;
+        h ^= unit.hashCode() * 31 + precision;
+        h ^= h >>> 15;
+        return h & mask;
+    }
+}
@@ -19,10 +19,10 @@
 
 package com.lushprojects.circuitjs1.client.util;
 
+import com.google.gwt.canvas.dom.client.CanvasGradient;
 import com.google.gwt.canvas.dom.client.Context2d;
+import java.util.ArrayList;
 import java.util.HashMap;
-import java.util.Iterator;
-import java.util.Map;
 import jsinterop.annotations.JsMethod;
 import jsinterop.annotations.JsPackage;
 import jsinterop.annotations.JsProperty;
@@ -35,7 +35,11 @@ public class Graphics {
 		@JsProperty(name = "textAlign") native String getTextAlign();
 		@JsProperty(name = "textBaseline") native String getTextBaseline();
 		@JsMethod(name = "setLineDash") native void setLineDashNative(double[] pattern);
+		@JsMethod(name = "ellipse") native void ellipse(double x, double y, double rx, double ry, double rotation,
+				double startAngle, double endAngle, boolean anticlockwise);
 		@JsProperty(name = "letterSpacing") native public void setLetterSpacing(String spacing);
+		@JsProperty(name = "strokeStyle") native Object getStrokeStyleObject();
+		@JsProperty(name = "strokeStyle") native void setStrokeStyleObject(Object style);
 	}
 
 	@JsType(isNative = true, namespace = JsPackage.GLOBAL, name = "Element")
@@ -64,29 +68,60 @@ public class Graphics {
 	private int savedFontSize;
 	public static boolean isFullScreen=false;
 	
-	// Batch drawing optimization
-	private boolean batchMode = false;
-	private int batchedOperations = 0;
-	
-	// Text rendering cache
-	private static class TextCacheEntry {
-	    double width;
-	    long timestamp;
+	// Retained line batch: while batching, drawLine() only records segments,
+	// grouped by stroke style and line width; each group is stroked as one
+	// path when the batch is flushed.
+	private static class LineBatch {
+	    String style;
+	    double lineWidth;
+	    int[] coords = new int[64];
+	    int count;
+
+	    void add(int x1, int y1, int x2, int y2) {
+		if (count + 4 > coords.length) {
+		    int[] grown = new int[coords.length * 2];
+		    System.arraycopy(coords, 0, grown, 0, count);
+		    coords = grown;
+		}
+		coords[count++] = x1;
+		coords[count++] = y1;
+		coords[count++] = x2;
+		coords[count++] = y2;
+	    }
 	}
-	private static HashMap<String, TextCacheEntry> textWidthCache = new HashMap<String, TextCacheEntry>();
-	private static final int TEXT_CACHE_SIZE = 500;
-	private static final long TEXT_CACHE_LIFETIME_MS = 5000; // 5 seconds
+	private int batchDepth = 0;
+	private final ArrayList<LineBatch> lineBatches = new ArrayList<LineBatch>();
+	private int activeLineBatches = 0;
+	private LineBatch currentLineBatch;
+	private String strokeStyle;
+	
+	// Text width cache, keyed by canvas font and then by the raw string, so
+	// switching between fonts (header/cell) does not throw widths away.
+	private static HashMap<String, HashMap<String, Double>> textWidthCache = new HashMap<String, HashMap<String, Double>>();
+	private static HashMap<String, HashMap<String, String>> truncatedTextCache = new HashMap<String, HashMap<String, String>>();
+	private static final int TEXT_CACHE_SIZE = 2000; // entries per font
+	private static final int TEXT_CACHE_FONTS = 32;
 	
 	  public Graphics(Context2d context) {
 		    this.context = context;
 		    currentFontSize = 12;
 	  }
+
+	  /**
+	   * For offscreen backends (e.g. the JVM image writer) that have no
+	   * canvas: {@link #context} stays null and the subclass overrides the
+	   * drawing primitives and the text hooks below.
+	   */
+	  protected Graphics() {
+		    currentFontSize = 12;
+	  }
 	  
 	  public void setColor(Color color) {
 		    if (color != null) {
 		      String colorString = color.getHexValue();
 		      context.setStrokeStyle(colorString);
 		      context.setFillStyle(colorString);
+		      strokeStyle = colorString;
 		    } else {
 		      System.out.println("Ignoring null-Color");
 		    }
@@ -96,38 +131,45 @@ public class Graphics {
 	  public void setColor(String color) {
 	      context.setStrokeStyle(color);
 	      context.setFillStyle(color);
+	      strokeStyle = color;
 	      lastColor=null;
 	  }
 	  
 	  public void clipRect(int x, int y, int width, int height) {
+		  flushLineBatches();
 		  context.beginPath();
 		  context.rect(x, y, width, height);
 		  context.clip();
 	  }
 	  
 	  public void restore() {
+	      flushLineBatches();
 	      context.restore();
 	      currentFontSize = savedFontSize;
 	  }
 	  public void save() {
+	      flushLineBatches();
 	      context.save();
 	      savedFontSize = currentFontSize;
 	  }
 	  
 	  
 	  public void fillRect(int x, int y, int width, int height) {
+		  flushLineBatches();
 		//  context.beginPath();
 		  context.fillRect(x, y, width, height);
 		//  context.closePath();
 	  }
 	  
 	  public void drawRect(int x, int y, int width, int height) {
+		  flushLineBatches();
 		//  context.beginPath();
 		  context.strokeRect(x, y, width, height);
 		//  context.closePath();
 	  }
 	  
 	  public void fillOval(int x, int y, int width, int height) {
+		  flushLineBatches();
 		  context.beginPath();
 		  context.arc(x+width/2, y+width/2, width/2, 0, 2.0*3.14159);
 		  context.closePath();
@@ -137,7 +179,7 @@ public class Graphics {
 	  public void drawString(String str, int x, int y) {
 	      // Fast path: most strings have no backslash, underscore, or caret
 	      if (str.indexOf('\\') < 0 && str.indexOf('_') < 0 && str.indexOf('^') < 0) {
-	          context.fillText(str, x, y);
+	          fillText(str, x, y);
 	          return;
 	      }
 	      // Convert Greek symbols (e.g., \beta -> β) before rendering
@@ -147,7 +189,7 @@ public class Graphics {
 	      if (hasScripts(converted)) {
 	          drawStringWithScripts(converted, x, y);
 	      } else {
-	          context.fillText(converted, x, y);
+	          fillText(converted, x, y);
 	      }
 	  }
 	  
@@ -172,11 +214,11 @@ public class Graphics {
 	      if ("center".equals(savedAlign)) {
 	          double totalWidth = measureWidthWithScripts(str);
 	          startX = x - totalWidth / 2;
-	          context.setTextAlign("left"); // Reset to left for manual positioning
+	          setTextAlign("left"); // Reset to left for manual positioning
 	      } else if ("right".equals(savedAlign)) {
 	          double totalWidth = measureWidthWithScripts(str);
 	          startX = x - totalWidth;
-	          context.setTextAlign("left"); // Reset to left for manual positioning
+	          setTextAlign("left"); // Reset to left for manual positioning
 	      }
 	      
 	      int pos = 0;
@@ -219,8 +261,8 @@ public class Graphics {
 	              double yOffset = isSubscript ? savedFontSize * 0.3 : -savedFontSize * 0.4;
 	              
 	              setFontSize(scriptSize);
-	              context.fillText(scriptText, currentX, y + yOffset);
-	              currentX += context.measureText(scriptText).getWidth();
+	              fillText(scriptText, currentX, y + yOffset);
+	              currentX += measureText(scriptText);
 	              
 	              // Restore font size
 	              setFontSize(savedFontSize);
@@ -228,14 +270,14 @@ public class Graphics {
 	          } else {
 	              // Regular character
 	              String normalText = extractNormalText(str, pos);
-	              context.fillText(normalText, currentX, y);
-	              currentX += context.measureText(normalText).getWidth();
+	              fillText(normalText, currentX, y);
+	              currentX += measureText(normalText);
 	              pos += normalText.length();
 	          }
 	      }
 	      
 	      // Restore text alignment
-	      context.setTextAlign(savedAlign);
+	      setTextAlign(savedAlign);
 	  }
 	  
 	  /**
@@ -253,6 +295,34 @@ public class Graphics {
 	      String baseline = ((ContextLike) (Object) context).getTextBaseline();
 	      return baseline == null ? "alphabetic" : baseline;
 	  }
+
+	  public void setTextAlign(String align) {
+	      context.setTextAlign(align);
+	  }
+
+	  public void setTextBaseline(String baseline) {
+	      context.setTextBaseline(baseline);
+	  }
+
+	  /** Draw text as-is (no Greek or script handling) at the current align/baseline. */
+	  protected void fillText(String text, double x, double y) {
+	      context.fillText(text, x, y);
+	  }
+
+	  /** Width of text as-is in the current font, uncached. */
+	  public double measureText(String text) {
+	      return context.measureText(text).getWidth();
+	  }
+
+	  /** Set a canvas font string such as "bold 12px sans-serif". */
+	  public void setFontName(String fontName) {
+	      context.setFont(fontName);
+	  }
+
+	  /** Canvas font string currently in effect; keys the text caches. */
+	  protected String getFontName() {
+	      return context.getFont();
+	  }
 	  
 	  /**
 	   * Extract normal text until next script marker
@@ -275,41 +345,84 @@ public class Graphics {
 	  private void setFontSize(double size) {
 	      currentFontSize = (int) size;
 	      // Update the font with new size (assuming current font family)
-	      context.setFont(currentFontSize + "px sans-serif");
+	      setFontName(currentFontSize + "px sans-serif");
 	  }
 	  
 	  public double measureWidth(String s) {
+		  // Look up by the raw string so cache hits skip the Greek conversion
+		  HashMap<String, Double> widths = cacheForFont(textWidthCache);
+		  Double cached = widths.get(s);
+		  if (cached != null)
+			  return cached.doubleValue();
+		  
 		  // Convert Greek symbols first for accurate width measurement
 		  String converted = Locale.convertGreekSymbols(s);
 		  
-		  // Check cache first (cache the converted string)
-		  TextCacheEntry entry = textWidthCache.get(converted);
-		  long currentTime = System.currentTimeMillis();
-		  
-		  if (entry != null && currentTime - entry.timestamp < TEXT_CACHE_LIFETIME_MS) {
-			  return entry.width;
-		  }
-		  
 		  // Measure width accounting for subscripts/superscripts
 		  double width;
 		  if (hasScripts(converted)) {
 		      width = measureWidthWithScripts(converted);
 		  } else {
-		      width = context.measureText(converted).getWidth();
+		      width = measureText(converted);
 		  }
 		  
-		  // Add to cache
-		  if (textWidthCache.size() >= TEXT_CACHE_SIZE) {
-			  // Cache full, clear old entries
-			  clearOldTextCacheEntries(currentTime);
-		  }
+		  if (widths.size() >= TEXT_CACHE_SIZE)
+			  widths.clear();
+		  widths.put(s, width);
+		  return width;
+	  }
+	  
+	  /**
+	   * Truncate text to fit within maxWidth pixels in the current font,
+	   * appending ".." when shortened. Results are cached per font, so
+	   * table cells that redraw the same labels every frame only pay for
+	   * the binary search once.
+	   */
+	  public String truncateToWidth(String text, int maxWidth) {
+		  if (text == null || text.isEmpty())
+			  return text;
+		  HashMap<String, String> truncated = cacheForFont(truncatedTextCache);
+		  String key = maxWidth + "|" + text;
+		  String result = truncated.get(key);
+		  if (result != null)
+			  return result;
 		  
-		  entry = new TextCacheEntry();
-		  entry.width = width;
-		  entry.timestamp = currentTime;
-		  textWidthCache.put(converted, entry);
+		  result = text;
+		  if (measureWidth(text) > maxWidth) {
+			  // Binary search to find the longest prefix that fits
+			  int left = 1;
+			  int right = text.length();
+			  result = text.substring(0, Math.min(3, text.length())) + "..";
+			  while (left <= right) {
+				  int mid = (left + right) / 2;
+				  String candidate = text.substring(0, mid) + "..";
+				  if (measureWidth(candidate) <= maxWidth) {
+					  result = candidate;
+					  left = mid + 1;
+				  } else {
+					  right = mid - 1;
+				  }
+			  }
+		  }
 		  
-		  return width;
+		  if (truncated.size() >= TEXT_CACHE_SIZE)
+			  truncated.clear();
+		  truncated.put(key, result);
+		  return result;
+	  }
+	  
+	  // Per-font bucket of a text cache; the font is read back from the canvas
+	  // so fonts set directly on the context are keyed correctly too.
+	  private <T> HashMap<String, T> cacheForFont(HashMap<String, HashMap<String, T>> cache) {
+		  String font = getFontName();
+		  HashMap<String, T> bucket = cache.get(font);
+		  if (bucket == null) {
+			  if (cache.size() >= TEXT_CACHE_FONTS)
+				  cache.clear();
+			  bucket = new HashMap<String, T>();
+			  cache.put(font, bucket);
+		  }
+		  return bucket;
 	  }
 	  
 	  /**
@@ -347,13 +460,13 @@ public class Graphics {
 	              // Measure with smaller font
 	              double scriptSize = currentFontSize * 0.7;
 	              setFontSize(scriptSize);
-	              totalWidth += context.measureText(scriptText).getWidth();
+	              totalWidth += measureText(scriptText);
 	              setFontSize(savedFontSize);
 	              
 	          } else {
 	              // Regular character
 	              String normalText = extractNormalText(str, pos);
-	              totalWidth += context.measureText(normalText).getWidth();
+	              totalWidth += measureText(normalText);
 	              pos += normalText.length();
 	          }
 	      }
@@ -361,69 +474,218 @@ public class Graphics {
 	      return totalWidth;
 	  }
 	  
-	  // Clear text cache entries older than the cache lifetime
-	  private void clearOldTextCacheEntries(long currentTime) {
-		  Iterator<Map.Entry<String, TextCacheEntry>> iterator = textWidthCache.entrySet().iterator();
-		  while (iterator.hasNext()) {
-			  Map.Entry<String, TextCacheEntry> entry = iterator.next();
-			  if (currentTime - entry.getValue().timestamp >= TEXT_CACHE_LIFETIME_MS) {
-				  iterator.remove();
-			  }
-		  }
-		  
-		  // If still too big after removing old entries, clear half the cache
-		  if (textWidthCache.size() >= TEXT_CACHE_SIZE) {
-			  int toRemove = TEXT_CACHE_SIZE / 2;
-			  iterator = textWidthCache.entrySet().iterator();
-			  while (iterator.hasNext() && toRemove > 0) {
-				  iterator.next();
-				  iterator.remove();
-				  toRemove--;
-			  }
-		  }
-	  }
-	  
-	  // Clear the entire text width cache (call when font changes or for debugging)
-	  private static void clearTextCache() {
-		  textWidthCache.clear();
-	  }
-	  
 	  public void setLineWidth(double width){
 		  context.setLineWidth(width);
 	  }
+
+	  public void setLineCap(Context2d.LineCap cap) {
+		  flushLineBatches();
+		  context.setLineCap(cap);
+	  }
+
+	  public void translate(double x, double y) {
+		  flushLineBatches();
+		  context.translate(x, y);
+	  }
+
+	  public void scale(double x, double y) {
+		  flushLineBatches();
+		  context.scale(x, y);
+	  }
+
+	  public void drawCircle(double cx, double cy, double radius) {
+		  flushLineBatches();
+		  context.beginPath();
+		  context.arc(cx, cy, radius, 0, 2*Math.PI);
+		  context.stroke();
+	  }
+
+	  /** Multiply the current transform, as canvas transform(a, b, c, d, e, f). */
+	  public void transform(double a, double b, double c, double d, double e, double f) {
+		  flushLineBatches();
+		  context.transform(a, b, c, d, e, f);
+	  }
+
+	  public void setGlobalAlpha(double alpha) {
+		  flushLineBatches();
+		  context.setGlobalAlpha(alpha);
+	  }
+
+	  /**
+	   * Stroke with a linear gradient from one color at (x1, y1) to another
+	   * at (x2, y2) in the current transform, until the next setColor().
+	   */
+	  public void setStrokeGradient(double x1, double y1, double x2, double y2, Color from, Color to) {
+		  flushLineBatches();
+		  CanvasGradient grad = context.createLinearGradient(x1, y1, x2, y2);
+		  grad.addColorStop(0, from.getHexValue());
+		  grad.addColorStop(1.0, to.getHexValue());
+		  context.setStrokeStyle(grad);
+		  strokeStyle = null;
+	  }
+
+	  /** Drop shadow for following fills and strokes, until restore(). */
+	  public void setShadow(String color, double blur, double offsetX, double offsetY) {
+		  flushLineBatches();
+		  context.setShadowColor(color);
+		  context.setShadowBlur(blur);
+		  context.setShadowOffsetX(offsetX);
+		  context.setShadowOffsetY(offsetY);
+	  }
+
+	  /** Set only the fill color, leaving the stroke color as it is. */
+	  public void setFillColor(String color) {
+		  flushLineBatches();
+		  context.setFillStyle(color);
+	  }
+
+	  // Path building, for shapes the calls above don't cover (zigzags,
+	  // coils, arcs, curves). Same semantics as the canvas path API.
+
+	  public void beginPath() {
+		  flushLineBatches();
+		  context.beginPath();
+	  }
+
+	  public void moveTo(double x, double y) {
+		  context.moveTo(x, y);
+	  }
+
+	  public void lineTo(double x, double y) {
+		  context.lineTo(x, y);
+	  }
+
+	  public void quadraticCurveTo(double cpx, double cpy, double x, double y) {
+		  context.quadraticCurveTo(cpx, cpy, x, y);
+	  }
+
+	  public void bezierCurveTo(double cp1x, double cp1y, double cp2x, double cp2y, double x, double y) {
+		  context.bezierCurveTo(cp1x, cp1y, cp2x, cp2y, x, y);
+	  }
+
+	  /** Clockwise arc; angles in radians from the positive x axis. */
+	  public void arc(double cx, double cy, double radius, double startAngle, double endAngle) {
+		  context.arc(cx, cy, radius, startAngle, endAngle);
+	  }
+
+	  public void arc(double cx, double cy, double radius, double startAngle, double endAngle, boolean anticlockwise) {
+		  context.arc(cx, cy, radius, startAngle, endAngle, anticlockwise);
+	  }
+
+	  /** Elliptical arc, as canvas ellipse(); angles are parametric, rotation in radians. */
+	  public void ellipse(double cx, double cy, double rx, double ry, double rotation,
+			  double startAngle, double endAngle, boolean anticlockwise) {
+		  ((ContextLike) (Object) context).ellipse(cx, cy, rx, ry, rotation, startAngle, endAngle, anticlockwise);
+	  }
+
+	  public void closePath() {
+		  context.closePath();
+	  }
+
+	  public void stroke() {
+		  context.stroke();
+	  }
+
+	  public void fill() {
+		  context.fill();
+	  }
+
+	  public void strokeRect(double x, double y, double width, double height) {
+		  flushLineBatches();
+		  context.strokeRect(x, y, width, height);
+	  }
+
+	  public void fillRect(double x, double y, double width, double height) {
+		  flushLineBatches();
+		  context.fillRect(x, y, width, height);
+	  }
+
+	  /**
+	   * Copy a cached canvas layer into (x, y, width, height). Layers are only
+	   * created in the browser (see TableRenderer.initCache), so offscreen
+	   * backends never see this call.
+	   */
+	  public void drawLayer(Context2d layer, double x, double y, double width, double height) {
+		  flushLineBatches();
+		  context.drawImage(layer.getCanvas(), x, y, width, height);
+	  }
 	  
 	  /**
 	   * Start batched drawing mode for performance optimization.
-	   * Reduces context.beginPath()/stroke() calls by batching multiple operations.
-	   * Must call endBatch() when done.
+	   * Until the matching endBatch(), drawLine() records segments instead of
+	   * stroking them; segments are grouped by stroke style and line width and
+	   * each group is stroked with a single path on flush. Fills, rects,
+	   * save/restore and clipping flush first so they stay in order; text is
+	   * drawn immediately, so batch only lines that do not overlap text
+	   * (grid lines, waveforms). Batches may nest; only the outermost
+	   * endBatch() flushes.
 	   */
 	  public void startBatch() {
-		  if (!batchMode) {
-			  batchMode = true;
-			  batchedOperations = 0;
-			  context.beginPath();
-		  }
+		  batchDepth++;
 	  }
 	  
 	  /**
 	   * End batched drawing mode and flush all batched operations.
 	   */
 	  public void endBatch() {
-		  if (batchMode) {
-			  if (batchedOperations > 0) {
-				  context.stroke();
+		  if (batchDepth == 0)
+			  return;
+		  if (--batchDepth == 0)
+			  flushLineBatches();
+	  }
+	  
+	  public boolean isBatching() {
+		  return batchDepth > 0;
+	  }
+	  
+	  private void flushLineBatches() {
+		  if (activeLineBatches == 0)
+			  return;
+		  ContextLike ctx = (ContextLike) (Object) context;
+		  Object savedStyle = ctx.getStrokeStyleObject();
+		  double savedWidth = context.getLineWidth();
+		  for (int i = 0; i < activeLineBatches; i++) {
+			  LineBatch batch = lineBatches.get(i);
+			  context.setStrokeStyle(batch.style);
+			  context.setLineWidth(batch.lineWidth);
+			  context.beginPath();
+			  int[] c = batch.coords;
+			  for (int j = 0; j < batch.count; j += 4) {
+				  context.moveTo(c[j], c[j+1]);
+				  context.lineTo(c[j+2], c[j+3]);
 			  }
-			  batchMode = false;
-			  batchedOperations = 0;
+			  context.stroke();
+			  batch.count = 0;
 		  }
+		  activeLineBatches = 0;
+		  currentLineBatch = null;
+		  ctx.setStrokeStyleObject(savedStyle);
+		  context.setLineWidth(savedWidth);
+	  }
+	  
+	  private LineBatch lineBatchForCurrentStyle() {
+		  if (strokeStyle == null)
+			  strokeStyle = String.valueOf(((ContextLike) (Object) context).getStrokeStyleObject());
+		  double lineWidth = context.getLineWidth();
+		  LineBatch batch = currentLineBatch;
+		  if (batch != null && batch.lineWidth == lineWidth && batch.style.equals(strokeStyle))
+			  return batch;
+		  for (int i = 0; i < activeLineBatches; i++) {
+			  batch = lineBatches.get(i);
+			  if (batch.lineWidth == lineWidth && batch.style.equals(strokeStyle))
+				  return currentLineBatch = batch;
+		  }
+		  if (activeLineBatches == lineBatches.size())
+			  lineBatches.add(new LineBatch());
+		  batch = lineBatches.get(activeLineBatches++);
+		  batch.style = strokeStyle;
+		  batch.lineWidth = lineWidth;
+		  return currentLineBatch = batch;
 	  }
 	  
 		public void drawLine(int x1, int y1, int x2, int y2) {
-			if (batchMode) {
-				// In batch mode, add disconnected line segments to the current path
-				context.moveTo(x1, y1);  // Always moveTo for disconnected lines
-				context.lineTo(x2, y2);
-				batchedOperations++;
+			if (batchDepth > 0) {
+				lineBatchForCurrentStyle().add(x1, y1, x2, y2);
 			} else {
 				// Normal mode - individual draw calls
 				context.beginPath();
@@ -439,6 +701,7 @@ public class Graphics {
 
 	  public void drawPolyline(int[] xpoints, int[] ypoints, int n) {
 		  int i;
+		  flushLineBatches();
 		  context.beginPath();
 		  for (i=0; i<n;i++){
 			  if (i==0)
@@ -453,6 +716,7 @@ public class Graphics {
 	  
 	  public void fillPolygon(Polygon p) {
 		  int i;
+		  flushLineBatches();
 		  context.beginPath();
 		  for (i=0; i<p.npoints;i++){
 			  if (i==0)
@@ -466,10 +730,8 @@ public class Graphics {
 	  
 	  public void setFont(Font f){
 		  if (f!=null){
-			  context.setFont(f.fontname);
+			  setFontName(f.fontname);
 			  currentFontSize=f.size;
-			  // Clear cache when font changes since widths will be different
-			  clearTextCache();
 		  }
 	  }
 
@@ -479,6 +741,7 @@ public class Graphics {
 //	  }
 	  
 	  public void drawLock(int x, int y) {
+	      flushLineBatches();
 	      context.save();
 	      setColor(new Color(209,75,75));
 	      context.setLineWidth(3);
@@ -499,6 +762,7 @@ public class Graphics {
 	        }
 	  
 	   public void setLineDash(int a, int b) {
+	       flushLineBatches();
 	       setLineDash(context, a, b);
 	   }
 	   
@@ -560,6 +824,7 @@ public class Graphics {
     * @param radius Corner radius
     */
    public void fillRoundRect(int x, int y, int width, int height, int radius) {
+       flushLineBatches();
        context.beginPath();
        context.moveTo(x + radius, y);
        context.lineTo(x + width - radius, y);
@@ -583,6 +848,7 @@ public class Graphics {
     * @param radius Corner radius
     */
    public void drawRoundRect(int x, int y, int width, int height, int radius) {
+       flushLineBatches();
        context.beginPath();
        context.moveTo(x + radius, y);
        context.lineTo(x + width - radius, y);
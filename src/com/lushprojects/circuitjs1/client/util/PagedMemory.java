@@ -0,0 +1,101 @@
+package com.lushprojects.circuitjs1.client.util;
+
+/**
+ * Sparse word-addressed memory backed by lazily allocated fixed-size pages
+ * of primitive ints, with a written bit per word.
+ *
+ * Replaces a {@code HashMap<Integer, Integer>} in memory chips: reads and
+ * writes are an array index with no boxing, untouched pages cost nothing,
+ * and the written bits keep the "only dump what was stored" behaviour of the
+ * map. Reads of unwritten words return 0.
+ */
+public final class PagedMemory {
+
+    private static final int PAGE_BITS = 8;
+    private static final int PAGE_SIZE = 1 << PAGE_BITS;
+    private static final int PAGE_MASK = PAGE_SIZE - 1;
+
+    private final int capacity;
+    private final int pages[][];
+    private final int written[][];
+
+    /** @param addressBits largest address width this memory will be asked to hold */
+    public PagedMemory(int addressBits) {
+        capacity = 1 << addressBits;
+        int pageCount = (capacity + PAGE_SIZE - 1) >> PAGE_BITS;
+        pages = new int[pageCount][];
+        written = new int[pageCount][];
+    }
+
+    public int getCapacity() {
+        return capacity;
+    }
+
+    /** Word at addr, or 0 if never written or out of range. */
+    public int get(int addr) {
+        if (addr < 0 || addr >= capacity)
+            return 0;
+        int page[] = pages[addr >> PAGE_BITS];
+        return page == null ? 0 : page[addr & PAGE_MASK];
+    }
+
+    public boolean isWritten(int addr) {
+        if (addr < 0 || addr >= capacity)
+            return false;
+        int w[] = written[addr >> PAGE_BITS];
+        return w != null && (w[(addr & PAGE_MASK) >> 5] & (1 << (addr & 31))) != 0;
+    }
+
+    /** Store a word; writes outside the address range are ignored. */
+    public void put(int addr, int value) {
+        if (addr < 0 || addr >= capacity)
+            return;
+        int p = addr >> PAGE_BITS;
+        int page[] = pages[p];
+        if (page == null) {
+            page = pages[p] = new int[PAGE_SIZE];
+            written[p] = new int[PAGE_SIZE >> 5];
+        }
+        page[addr & PAGE_MASK] = value;
+        written[p][(addr & PAGE_MASK) >> 5] |= 1 << (addr & 31);
+    }
+
+    /** Store len words from src[off..] starting at addr. */
+    public void load(int addr, int src[], int off, int len) {
+        for (int i = 0; i != len; i++)
+            put(addr + i, src[off + i]);
+    }
+
+    /**
+     * First written address at or after addr and below limit, or -1.
+     * Skips unallocated pages and empty 32-word groups whole.
+     */
+    public int nextWritten(int addr, int limit) {
+        if (limit > capacity)
+            limit = capacity;
+        if (addr < 0)
+            addr = 0;
+        while (addr < limit) {
+            int w[] = written[addr >> PAGE_BITS];
+            if (w == null) {
+                addr = ((addr >> PAGE_BITS) + 1) << PAGE_BITS;
+                continue;
+            }
+            int bits = w[(addr & PAGE_MASK) >> 5] >>> (addr & 31);
+            if (bits == 0) {
+                addr = (addr | 31) + 1;
+                continue;
+            }
+            addr += Integer.numberOfTrailingZeros(bits);
+            return addr < limit ? addr : -1;
+        }
+        return -1;
+    }
+
+    public void clear() {
+        for (int i = 0; i != pages.length; i++) {
+            pages[i] = null;
+            written[i] = null;
+        }
+    }
+}
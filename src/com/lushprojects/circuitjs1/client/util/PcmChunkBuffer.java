@@ -0,0 +1,245 @@
+package com.lushprojects.circuitjs1.client.util;
+
+/**
+ * Bounded ring of fixed-size audio chunks, encoded to 16-bit PCM as each
+ * chunk fills.
+ *
+ * Keeps the most recent {@code capacity} samples (plus less than one chunk
+ * of slack), so memory does not grow with run length. Every completed chunk
+ * is encoded right away with the level set by the retained window at that
+ * moment: DC removed and the window's peak at a quarter of full scale, as
+ * the old play-time normalization did. Since the window includes the chunk
+ * itself, no chunk ever clips. {@link #snapshot} re-encodes only the chunks
+ * whose level has drifted from the final one, so building a WAV for playback
+ * costs little beyond the copy even for long recordings.
+ *
+ * An optional {@link ChunkListener} sees the raw samples of each chunk as
+ * it fills, which lets a writer stream audio of unbounded length to disk.
+ */
+public final class PcmChunkBuffer implements AudioResampler.Sink {
+
+    public interface ChunkListener {
+        /** samples[0..length) is only valid for the duration of the call. */
+        void chunkFilled(double samples[], int length);
+    }
+
+    public static final int DEFAULT_CHUNK_SIZE = 4096;
+
+    private static final double HEADROOM = .25 * 32766;
+    // chunks within this fraction of the final level are played as encoded
+    private static final double LEVEL_TOLERANCE = .01;
+
+    private final int capacity;
+    private final int chunkSize;
+    private final int slots;
+    private final double raw[][];
+    private final short pcm[][];
+    private final double chunkMin[];
+    private final double chunkMax[];
+    private final double chunkAdj[];
+    private final double chunkMult[];
+    private int completed;
+    private int fill;
+    private ChunkListener listener;
+
+    // window located by locateWindow(): oldest chunk and samples to skip in it
+    private int windowChunk;
+    private int windowSkip;
+    // level computed by computeLevel()
+    private double levelAdj;
+    private double levelMult;
+
+    public PcmChunkBuffer(int capacity, int chunkSize) {
+        this.capacity = Math.max(capacity, 0);
+        this.chunkSize = chunkSize;
+        slots = (this.capacity + chunkSize - 1) / chunkSize + 1;
+        raw = new double[slots][];
+        pcm = new short[slots][];
+        chunkMin = new double[slots];
+        chunkMax = new double[slots];
+        chunkAdj = new double[slots];
+        chunkMult = new double[slots];
+    }
+
+    public void setChunkListener(ChunkListener listener) {
+        this.listener = listener;
+    }
+
+    public int getCapacity() {
+        return capacity;
+    }
+
+    public void reset() {
+        completed = 0;
+        fill = 0;
+    }
+
+    /** Number of samples currently retained, at most the capacity. */
+    public int getSampleCount() {
+        locateWindow();
+        return (completed - windowChunk) * chunkSize + fill - windowSkip;
+    }
+
+    public boolean isFull() {
+        return getSampleCount() >= capacity;
+    }
+
+    public void writeSample(double v) {
+        if (capacity == 0)
+            return;
+        int slot = completed % slots;
+        if (raw[slot] == null) {
+            raw[slot] = new double[chunkSize];
+            pcm[slot] = new short[chunkSize];
+        }
+        if (fill == 0) {
+            chunkMin[slot] = v;
+            chunkMax[slot] = v;
+        } else if (v < chunkMin[slot]) {
+            chunkMin[slot] = v;
+        } else if (v > chunkMax[slot]) {
+            chunkMax[slot] = v;
+        }
+        raw[slot][fill++] = v;
+        if (fill == chunkSize) {
+            locateWindow();
+            computeLevel();
+            encode(slot, chunkSize);
+            if (listener != null)
+                listener.chunkFilled(raw[slot], chunkSize);
+            completed++;
+            fill = 0;
+        }
+    }
+
+    /**
+     * Hand the partial chunk to the listener. Call once when the stream
+     * ends; reset before writing again.
+     */
+    public void finish() {
+        if (fill == 0 || listener == null)
+            return;
+        listener.chunkFilled(raw[completed % slots], fill);
+    }
+
+    /** Gain that puts the larger swing of [min, max] about its midpoint at the headroom level. */
+    private static double levelMultiplier(double min, double max) {
+        double range = (max - min) / 2;
+        return range > 0 ? HEADROOM / range : 0;
+    }
+
+    /** One sample at level (adj, mult), clamped to 16 bits. */
+    private static short toPcm(double v, double adj, double mult) {
+        int s = (int) ((v + adj) * mult);
+        return (short) (s > 32767 ? 32767 : s < -32768 ? -32768 : s);
+    }
+
+    /**
+     * The retained samples as PCM parts in playback order, all at the final
+     * level, with a linear fade over the first and last fadeLen samples.
+     * Parts that needed no change are the ring's own arrays: treat them as
+     * read-only and use them before writing more samples.
+     */
+    public short[][] snapshot(int fadeLen) {
+        locateWindow();
+        computeLevel();
+        int count = (completed - windowChunk) * chunkSize + fill - windowSkip;
+        if (count <= 0)
+            return new short[0][];
+        if (fadeLen * 2 > count)
+            fadeLen = count / 2;
+        int partCount = completed - windowChunk + (fill > 0 ? 1 : 0);
+        short parts[][] = new short[partCount][];
+        int pos = 0;
+        int j = 0;
+        for (int k = windowChunk; k <= completed; k++) {
+            int len = k == completed ? fill : chunkSize;
+            if (len == 0)
+                continue;
+            int slot = k % slots;
+            if (k == completed || !levelMatches(slot))
+                encode(slot, len);
+            int from = k == windowChunk ? windowSkip : 0;
+            int n = len - from;
+            boolean fades = pos < fadeLen || pos + n > count - fadeLen;
+            short p[] = pcm[slot];
+            if (from != 0 || n != p.length || fades) {
+                short copy[] = new short[n];
+                System.arraycopy(p, from, copy, 0, n);
+                if (fades)
+                    applyFade(copy, pos, count, fadeLen);
+                p = copy;
+            }
+            parts[j++] = p;
+            pos += n;
+        }
+        return parts;
+    }
+
+    private static void applyFade(short part[], int pos, int count, int fadeLen) {
+        if (fadeLen == 0)
+            return;
+        for (int i = 0; i != part.length; i++) {
+            int at = pos + i;
+            int ramp = at < fadeLen ? at : count - at < fadeLen ? count - at : fadeLen;
+            if (ramp < fadeLen)
+                part[i] = (short) (part[i] * ramp / fadeLen);
+        }
+    }
+
+    private void locateWindow() {
+        int needed = capacity - fill;
+        if (needed <= 0) {
+            windowChunk = completed;
+            windowSkip = fill - capacity;
+            return;
+        }
+        int full = (needed + chunkSize - 1) / chunkSize;
+        if (full > completed) {
+            windowChunk = 0;
+            windowSkip = 0;
+        } else {
+            windowChunk = completed - full;
+            windowSkip = full * chunkSize - needed;
+        }
+    }
+
+    // uses whole-chunk extremes, so a partly retained oldest chunk can only
+    // make the level a little more conservative
+    private void computeLevel() {
+        double max = -Double.MAX_VALUE;
+        double min = Double.MAX_VALUE;
+        for (int k = windowChunk; k <= completed; k++) {
+            if (k == completed && fill == 0)
+                break;
+            int slot = k % slots;
+            if (chunkMax[slot] > max) max = chunkMax[slot];
+            if (chunkMin[slot] < min) min = chunkMin[slot];
+        }
+        if (max < min) {
+            levelAdj = 0;
+            levelMult = 0;
+            return;
+        }
+        levelAdj = -(max + min) / 2;
+        levelMult = levelMultiplier(min, max);
+    }
+
+    private boolean levelMatches(int slot) {
+        double m = chunkMult[slot];
+        if (Math.abs(m - levelMult) > LEVEL_TOLERANCE * levelMult)
+            return false;
+        return Math.abs(chunkAdj[slot] - levelAdj) * levelMult <= LEVEL_TOLERANCE * HEADROOM;
+    }
+
+    private void encode(int slot, int len) {
+        double r[] = raw[slot];
+        short p[] = pcm[slot];
+        double adj = levelAdj;
+        double mult = levelMult;
+        for (int i = 0; i != len; i++)
+            p[i] = toPcm(r[i], adj, mult);
+        chunkAdj[slot] = adj;
+        chunkMult[slot] = mult;
+    }
+}
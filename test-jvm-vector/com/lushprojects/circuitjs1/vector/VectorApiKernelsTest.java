@@ -0,0 +1,126 @@
+package com.lushprojects.circuitjs1.vector;
+
+import com.lushprojects.circuitjs1.client.core.NumericKernels;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.util.Arrays;
+import java.util.Random;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+
+@DisplayName("VectorApiKernels — same results as the scalar kernels")
+class VectorApiKernelsTest {
+
+    private static final NumericKernels SCALAR = new NumericKernels() { };
+    private static final VectorApiKernels VECTOR = new VectorApiKernels();
+
+    // below, at and well past the vector threshold, with ragged tails
+    private static final int[] LENGTHS = {0, 1, 3, 7, 8, 16, 17, 31, 64, 101, 257};
+
+    private static double[] random(Random r, int n) {
+        double[] a = new double[n];
+        for (int i = 0; i < n; i++) {
+            a[i] = r.nextDouble() * 2 - 1;
+        }
+        return a;
+    }
+
+    @Test
+    @DisplayName("dotSubtract matches to rounding, with offsets")
+    void dotSubtract() {
+        Random r = new Random(1);
+        for (int len : LENGTHS) {
+            double[] a = random(r, len + 5);
+            double[] b = random(r, len + 3);
+            double expected = SCALAR.dotSubtract(0.25, a, 5, b, 3, len);
+            double scale = 0.25;
+            for (int k = 0; k < len; k++) {
+                scale += Math.abs(a[5 + k] * b[3 + k]);
+            }
+            // lanes are summed in a different order, and with fma
+            assertEquals(expected, VECTOR.dotSubtract(0.25, a, 5, b, 3, len), 1e-12 * scale, "len=" + len);
+        }
+    }
+
+    @Test
+    @DisplayName("subtractScaled matches exactly, with offsets")
+    void subtractScaled() {
+        Random r = new Random(2);
+        for (int len : LENGTHS) {
+            double[] y = random(r, len + 2);
+            double[] x = random(r, len + 4);
+            double[] expected = y.clone();
+            SCALAR.subtractScaled(expected, 2, -1.5, x, 4, len);
+            VECTOR.subtractScaled(y, 2, -1.5, x, 4, len);
+            assertArrayEquals(expected, y, 0, "len=" + len);
+        }
+    }
+
+    @Test
+    @DisplayName("pairwiseMinMax gathers even/odd samples in place for odd and even sizes")
+    void pairwiseMinMax() {
+        Random r = new Random(3);
+        for (int len : LENGTHS) {
+            for (int size : new int[] {len, len + 1}) {
+                double[] min = random(r, size);
+                double[] max = random(r, size);
+                double[] expectedMin = min.clone();
+                double[] expectedMax = max.clone();
+                int expectedSize = SCALAR.pairwiseMinMax(expectedMin, expectedMax, size);
+                assertEquals(expectedSize, VECTOR.pairwiseMinMax(min, max, size), "size=" + size);
+                assertArrayEquals(Arrays.copyOf(expectedMin, expectedSize), Arrays.copyOf(min, expectedSize), 0,
+                        "min, size=" + size);
+                assertArrayEquals(Arrays.copyOf(expectedMax, expectedSize), Arrays.copyOf(max, expectedSize), 0,
+                        "max, size=" + size);
+            }
+        }
+    }
+
+    @Test
+    @DisplayName("batched interpolation matches exactly, inside and past both ends")
+    void interpolate() {
+        Random r = new Random(5);
+        int n = 9;
+        double[] xs = new double[n];
+        double[] ys = random(r, n);
+        for (int i = 1; i < n; i++) {
+            xs[i] = xs[i - 1] + r.nextDouble();
+        }
+        // a step: two breakpoints at the same x
+        xs[4] = xs[3];
+        for (int len : LENGTHS) {
+            double[] x = new double[len];
+            for (int i = 0; i < len; i++) {
+                x[i] = (r.nextDouble() * 1.4 - 0.2) * xs[n - 1];
+            }
+            for (boolean clamp : new boolean[] {true, false}) {
+                double[] expected = new double[len];
+                double[] actual = new double[len];
+                SCALAR.interpolate(xs, ys, n, x, expected, len, clamp);
+                VECTOR.interpolate(xs, ys, n, x, actual, len, clamp);
+                assertArrayEquals(expected, actual, 0, "len=" + len + " clamp=" + clamp);
+            }
+        }
+    }
+
+    @Test
+    @DisplayName("repeated halving of a long envelope matches the scalar result")
+    void pairwiseMinMaxRepeated() {
+        Random r = new Random(4);
+        int size = 1000;
+        double[] min = random(r, size);
+        double[] max = random(r, size);
+        double[] expectedMin = min.clone();
+        double[] expectedMax = max.clone();
+        int expectedSize = size;
+        while (size > 1) {
+            expectedSize = SCALAR.pairwiseMinMax(expectedMin, expectedMax, expectedSize);
+            size = VECTOR.pairwiseMinMax(min, max, size);
+            assertEquals(expectedSize, size);
+            assertArrayEquals(Arrays.copyOf(expectedMin, size), Arrays.copyOf(min, size), 0);
+            assertArrayEquals(Arrays.copyOf(expectedMax, size), Arrays.copyOf(max, size), 0);
+        }
+    }
+}
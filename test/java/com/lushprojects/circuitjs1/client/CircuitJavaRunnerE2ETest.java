@@ -4,6 +4,7 @@ import static org.junit.jupiter.api.Assertions.assertEquals;
 import static org.junit.jupiter.api.Assertions.assertFalse;
 import static org.junit.jupiter.api.Assertions.assertTrue;
 
+import java.awt.image.BufferedImage;
 import java.nio.charset.StandardCharsets;
 import java.nio.file.Files;
 import java.nio.file.Path;
@@ -12,6 +13,7 @@ import java.util.HashMap;
 import java.util.List;
 import java.util.Map;
 import java.util.regex.Pattern;
+import javax.imageio.ImageIO;
 
 import com.lushprojects.circuitjs1.client.elements.economics.ComputedValues;
 import com.lushprojects.circuitjs1.client.runner.CircuitJavaRunner;
@@ -292,6 +294,74 @@ class CircuitJavaRunnerE2ETest {
         }
     }
 
+    @Test
+    @DisplayName("writes schematic and scope PNGs without a browser")
+    void writesSchematicAndScopeImages() throws Exception {
+        Path outputCsv = Files.createTempFile("runner-images-", ".csv");
+        Path schematic = Files.createTempFile("runner-schematic-", ".png");
+        Path scopes = Files.createTempFile("runner-scopes-", ".png");
+        try {
+            CircuitJavaRunner.main(new String[] {
+                    getLrcCircuitPath().toString(),
+                    outputCsv.toString(),
+                    "50",
+                    "csv",
+                    "",
+                    "",
+                    schematic.toString(),
+                    scopes.toString()
+            });
+
+            BufferedImage schematicImage = ImageIO.read(schematic.toFile());
+            assertTrue(schematicImage != null && schematicImage.getWidth() > 0, "Expected a readable schematic PNG");
+            // lrc.txt spans x 176..752, y 80..416; export adds 70/50 margins at 2x scale
+            assertEquals((752 - 176 + 140) * 2, schematicImage.getWidth());
+            assertEquals((416 - 80 + 100) * 2, schematicImage.getHeight());
+            // R1 (176,80)-(384,80): zigzag between its leads at x 264..296 swings to y 86,
+            // the straight lead next to it stays on y 80 (value label goes above)
+            assertTrue(hasNonBackgroundPixel(schematicImage, schematicBox(268, 83, 292, 88)),
+                    "Expected the resistor zigzag below its lead line");
+            assertFalse(hasNonBackgroundPixel(schematicImage, schematicBox(200, 84, 240, 88)),
+                    "Expected nothing below the straight resistor lead");
+            // grid and traces inside both embedded scope boxes
+            assertTrue(hasNonBackgroundPixel(schematicImage, schematicBox(532, 100, 748, 236)),
+                    "Expected the first scope element to draw its plot");
+            assertTrue(hasNonBackgroundPixel(schematicImage, schematicBox(532, 260, 748, 412)),
+                    "Expected the second scope element to draw its plot");
+
+            BufferedImage scopesImage = ImageIO.read(scopes.toFile());
+            assertTrue(scopesImage != null && scopesImage.getHeight() > 0, "Expected a readable scopes PNG");
+            // three docked scopes, one 242px panel each with the plot at (70, 22), 720x200
+            assertEquals(3 * 242, scopesImage.getHeight());
+            for (int i = 0; i < 3; i++) {
+                int top = i * 242 + 22;
+                assertTrue(hasNonBackgroundPixel(scopesImage, new int[] {72, top + 2, 70 + 718, top + 198}),
+                        "Expected grid or traces inside scope panel " + (i + 1));
+            }
+        } finally {
+            Files.deleteIfExists(outputCsv);
+            Files.deleteIfExists(schematic);
+            Files.deleteIfExists(scopes);
+        }
+    }
+
+    // circuit coordinates -> pixel box {x0, y0, x1, y1} in the schematic export of lrc.txt
+    private static int[] schematicBox(int x0, int y0, int x1, int y1) {
+        return new int[] {(x0 - 176 + 70) * 2, (y0 - 80 + 50) * 2, (x1 - 176 + 70) * 2, (y1 - 80 + 50) * 2};
+    }
+
+    private static boolean hasNonBackgroundPixel(BufferedImage image, int[] box) {
+        int background = image.getRGB(0, 0);
+        for (int y = box[1]; y <= box[3]; y++) {
+            for (int x = box[0]; x <= box[2]; x++) {
+                if (image.getRGB(x, y) != background) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
     @Test
     @DisplayName("emits world2 formatted six-column table when format is world2")
     void emitsWorld2FormattedSixColumnTableWhenFormatIsWorld2() throws Exception {
@@ -375,6 +445,13 @@ class CircuitJavaRunnerE2ETest {
         return -1;
     }
 
+    private Path getLrcCircuitPath() {
+        String projectDir = System.getProperty("projectDir");
+        Path lrc = Paths.get(projectDir, "src/com/lushprojects/circuitjs1/public/circuits/economics/lrc.txt");
+        assertTrue(Files.exists(lrc), "Expected LRC example circuit to exist: " + lrc);
+        return lrc;
+    }
+
     private Path getWorld2CircuitPath() {
         String projectDir = System.getProperty("projectDir");
         Path world2Circuit = Paths.get(projectDir, "test/resources/sfcr/world2_fixture.md");
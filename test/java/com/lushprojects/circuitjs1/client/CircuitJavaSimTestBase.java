@@ -8,6 +8,7 @@ import java.nio.file.Path;
 import java.nio.file.Paths;
 
 import com.lushprojects.circuitjs1.client.elements.economics.ComputedValues;
+import com.lushprojects.circuitjs1.client.elements.economics.EquationTableElm;
 import com.lushprojects.circuitjs1.client.runner.RuntimeMode;
 import org.junit.jupiter.api.AfterEach;
 import org.junit.jupiter.api.BeforeEach;
@@ -15,6 +16,16 @@ import org.junit.jupiter.api.parallel.ResourceLock;
 
 @ResourceLock("ComputedValues")
 public abstract class CircuitJavaSimTestBase {
+    // two equation tables, the second reading the first
+    protected static final String TWO_EQUATION_TABLES =
+            "@equations Demo x=200 y=120\n" +
+            "  Y ~ 1 ; mode=param\n" +
+            "  Z ~ last(Y) + 2\n" +
+            "@end\n\n" +
+            "@equations Other x=400 y=120\n" +
+            "  W ~ Z * 3\n" +
+            "@end\n";
+
     protected CirSim sim;
 
     @BeforeEach
@@ -53,4 +64,13 @@ public abstract class CircuitJavaSimTestBase {
         assertNotNull(value, "No converged value for: " + name);
         return value;
     }
+
+    protected EquationTableElm findEquationTable(String name) {
+        for (int i = 0; i < sim.elmList.size(); i++) {
+            CircuitElm ce = sim.elmList.get(i);
+            if (ce instanceof EquationTableElm && name.equals(((EquationTableElm) ce).getTableName()))
+                return (EquationTableElm) ce;
+        }
+        return null;
+    }
 }
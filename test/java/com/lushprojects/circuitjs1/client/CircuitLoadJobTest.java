@@ -0,0 +1,69 @@
+package com.lushprojects.circuitjs1.client;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.parallel.ResourceLock;
+
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@ResourceLock("SFCRParser")
+@DisplayName("Time-sliced circuit load job")
+class CircuitLoadJobTest extends CircuitJavaSimTestBase {
+
+    private static final String SFCR_PATH =
+            "src/com/lushprojects/circuitjs1/public/circuits/economics/econ_Goodwin_Predator_Prey.txt";
+    private static final String DUMP_PATH =
+            "src/com/lushprojects/circuitjs1/public/circuits/electronics/traffic.txt";
+
+    @Test
+    @DisplayName("SFCR model built in zero-budget slices matches a synchronous load")
+    void slicedSfcrLoadMatchesSynchronous() throws Exception {
+        assertSlicedLoadMatches(read(SFCR_PATH));
+    }
+
+    @Test
+    @DisplayName("text dump built in zero-budget slices matches a synchronous load")
+    void slicedDumpLoadMatchesSynchronous() throws Exception {
+        assertSlicedLoadMatches(read(DUMP_PATH));
+    }
+
+    private void assertSlicedLoadMatches(String text) {
+        sim.getCircuitIOService().readCircuit(text, 0);
+        String expected = elementSignature();
+
+        CircuitLoadJob job = new CircuitLoadJob(sim.getCircuitIOService(), sim, text, 0);
+        int slices = 0;
+        double lastProgress = 0;
+        while (job.step(0)) {
+            double progress = job.getProgress();
+            assertTrue(progress >= lastProgress, "Progress should not go backwards");
+            lastProgress = progress;
+            slices++;
+        }
+        assertTrue(job.isDone());
+        assertTrue(slices > 2, "A zero budget should yield between lines or blocks");
+        assertEquals(expected, elementSignature());
+    }
+
+    private String elementSignature() {
+        StringBuilder sb = new StringBuilder();
+        for (int i = 0; i < sim.elmList.size(); i++) {
+            CircuitElm ce = sim.getElm(i);
+            sb.append(ce.getClass().getSimpleName()).append(' ')
+                    .append(ce.x).append(',').append(ce.y).append(' ')
+                    .append(ce.x2).append(',').append(ce.y2).append('\n');
+        }
+        return sb.toString();
+    }
+
+    private static String read(String relativePath) throws Exception {
+        Path path = Paths.get(System.getProperty("projectDir"), relativePath);
+        return new String(Files.readAllBytes(path), StandardCharsets.UTF_8);
+    }
+}
@@ -0,0 +1,53 @@
+package com.lushprojects.circuitjs1.client;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.parallel.ResourceLock;
+
+import java.nio.file.Path;
+
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertNull;
+import static org.junit.jupiter.api.Assertions.assertSame;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@ResourceLock("SFCRParser")
+@DisplayName("Circuit load pipeline stages")
+class CircuitLoadPipelineTest extends CircuitJavaSimTestBase {
+
+    private static final Path CIRCUIT_PATH = Path.of(
+            "src/com/lushprojects/circuitjs1/public/circuits/economics/econ_Goodwin_Predator_Prey.txt");
+
+    @Test
+    @DisplayName("every stage runs once and the load completes after stamping")
+    void allStagesRunAndLoadCompletes() throws Exception {
+        loadCircuit(CIRCUIT_PATH.toString());
+        CircuitLoadPipeline pipeline = sim.getCircuitLoadPipeline();
+        assertFalse(pipeline.isLoadComplete(), "Load should stay open until the stamp stage");
+
+        sim.preStampAndStampCircuit();
+        assertNull(sim.stopMessage, "Stamping should succeed");
+        assertTrue(pipeline.isLoadComplete(), "Load should complete after stamping");
+        for (CircuitLoadPipeline.Stage stage : CircuitLoadPipeline.Stage.values()) {
+            assertTrue(pipeline.hasStageRun(stage), "Stage should have run: " + stage.getLabel());
+            assertTrue(pipeline.getStageMillis(stage) >= 0, "Stage time should be non-negative");
+        }
+        assertTrue(pipeline.getTimingSummary().contains("stamp="), "Summary should list the stamp stage");
+    }
+
+    @Test
+    @DisplayName("timestep restamp reuses variable slots built for the node list")
+    void restampReusesVariableSlots() throws Exception {
+        loadCircuit(CIRCUIT_PATH.toString());
+        sim.preStampAndStampCircuit();
+        String[] slotNames = sim.slotNames;
+        assertNotNull(slotNames, "Slots should be built by the first stamp");
+
+        sim.stampCircuit();
+        assertSame(slotNames, sim.slotNames, "Restamp without re-analysis should keep existing slots");
+
+        sim.preStampAndStampCircuit();
+        assertFalse(slotNames == sim.slotNames, "A fresh pre-stamp should rebuild slots");
+    }
+}
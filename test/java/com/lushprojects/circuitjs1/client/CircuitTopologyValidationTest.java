@@ -0,0 +1,38 @@
+package com.lushprojects.circuitjs1.client;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertNull;
+
+@DisplayName("Circuit topology validation")
+class CircuitTopologyValidationTest extends CircuitJavaSimTestBase {
+
+    private static final String RAIL = "R 480 256 400 256 0 0 40 5 0 0 0.5 V\n";
+
+    @Test
+    @DisplayName("rail wired straight to ground is rejected")
+    void railShortedToGroundStops() throws Exception {
+        loadCircuitText("$ 1 0.000005 10 50 5 50 5e-11\n"
+                + RAIL
+                + "w 480 256 560 256 0\n"
+                + "w 560 256 560 320 0\n"
+                + "g 560 320 560 352 0 0\n");
+        sim.preStampAndStampCircuit();
+        assertEquals("Path to ground with no resistance!", sim.stopMessage);
+    }
+
+    @Test
+    @DisplayName("rail through a resistor chain to ground is accepted")
+    void railThroughResistorsIsValid() throws Exception {
+        StringBuilder sb = new StringBuilder("$ 1 0.000005 10 50 5 50 5e-11\n").append(RAIL);
+        int x = 480;
+        for (int i = 0; i < 2000; i++, x += 16)
+            sb.append("r ").append(x).append(" 256 ").append(x + 16).append(" 256 0 100\n");
+        sb.append("g ").append(x).append(" 256 ").append(x).append(" 288 0 0\n");
+        loadCircuitText(sb.toString());
+        sim.preStampAndStampCircuit();
+        assertNull(sim.stopMessage);
+    }
+}
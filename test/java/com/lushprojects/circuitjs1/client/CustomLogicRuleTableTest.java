@@ -0,0 +1,72 @@
+package com.lushprojects.circuitjs1.client;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.util.Vector;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@DisplayName("CustomLogicRuleTable — compiled custom logic rules")
+class CustomLogicRuleTableTest {
+
+    private static CustomLogicRuleTable compile(String... rules) {
+        Vector<String> left = new Vector<String>();
+        Vector<String> right = new Vector<String>();
+        for (String rule : rules) {
+            String[] parts = rule.split("=");
+            left.add(parts[0]);
+            right.add(parts[1]);
+        }
+        return CustomLogicRuleTable.compile(left, right);
+    }
+
+    @Test
+    @DisplayName("combinational rules use the lookup table and pick the first match")
+    void combinationalLookup() {
+        // XOR with a catch-all: A,B inputs, C output
+        CustomLogicRuleTable t = compile("01=1", "10=1", "??=0");
+        assertNotNull(t);
+        assertTrue(t.hasLookupTable());
+        assertEquals(2, t.match(0b00, 0));
+        assertEquals(1, t.match(0b01, 0));
+        assertEquals(0, t.match(0b10, 0));
+        assertEquals(2, t.match(0b11, 0));
+        assertEquals(1, t.getOutputBits(0, 0b10));
+        assertEquals(0, t.getOutputBits(2, 0b11));
+    }
+
+    @Test
+    @DisplayName("edge rules scan masks against the previous pin word")
+    void edgeRules() {
+        // D flip-flop: clock rising edge copies d to Q (pin 2)
+        CustomLogicRuleTable t = compile("+a?=a", "???=c");
+        assertNull(t, "A right-side letter with no binding on the left needs the interpreter");
+
+        t = compile("+a?=a", "??c=c");
+        assertNotNull(t);
+        assertFalse(t.hasLookupTable());
+        int word = 0b011;      // clock high, d high, q low
+        assertEquals(0, t.match(word, 0b010));
+        assertEquals(1, t.getOutputBits(0, word));
+        assertEquals(1, t.match(word, 0b011), "No edge when the clock was already high");
+        assertEquals(0, t.getOutputBits(1, word));
+    }
+
+    @Test
+    @DisplayName("repeated letters must agree and underscores mark high impedance")
+    void patternsAndTriState() {
+        CustomLogicRuleTable t = compile("aA=1_", "??=00");
+        assertNotNull(t);
+        assertEquals(0, t.match(0b00, 0));
+        assertEquals(0, t.match(0b11, 0));
+        assertEquals(1, t.match(0b01, 0));
+        assertEquals(0b10, t.getHighImpedanceMask(0));
+        assertEquals(0b01, t.getOutputBits(0, 0));
+        assertEquals(2, t.getOutputCount(0));
+    }
+}
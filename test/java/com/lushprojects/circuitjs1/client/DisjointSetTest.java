@@ -0,0 +1,44 @@
+package com.lushprojects.circuitjs1.client;
+
+import com.lushprojects.circuitjs1.client.core.DisjointSet;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@DisplayName("DisjointSet — union-find used for wire closure")
+class DisjointSetTest {
+
+    @Test
+    @DisplayName("unions merge sets and report repeated merges")
+    void unionsMergeSets() {
+        DisjointSet sets = new DisjointSet(2);
+        for (int i = 0; i < 6; i++)
+            assertEquals(i, sets.add());
+
+        assertTrue(sets.union(0, 1));
+        assertTrue(sets.union(2, 3));
+        assertFalse(sets.connected(1, 2));
+        assertTrue(sets.union(1, 3));
+        assertTrue(sets.connected(0, 2));
+        assertFalse(sets.union(0, 3), "Already-joined ids should not merge again");
+        assertFalse(sets.connected(4, 5));
+        assertEquals(6, sets.size());
+    }
+
+    @Test
+    @DisplayName("a long chain collapses to one representative")
+    void longChainCollapses() {
+        int n = 200000;
+        DisjointSet sets = new DisjointSet();
+        for (int i = 0; i < n; i++)
+            sets.add();
+        for (int i = 1; i < n; i++)
+            sets.union(i - 1, i);
+        int root = sets.find(0);
+        for (int i = 0; i < n; i++)
+            assertEquals(root, sets.find(i));
+    }
+}
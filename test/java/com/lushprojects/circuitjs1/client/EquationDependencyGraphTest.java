@@ -86,6 +86,51 @@ class EquationDependencyGraphTest {
         assertEquals(setOf("A"), graph.getDirectInputs("B"));
     }
 
+    @Test
+    @DisplayName("column coloring never gives two columns of one row the same color")
+    void testColumnColoringSeparatesSharedRows() {
+        // tridiagonal pattern over 8 columns plus a row spanning the two ends
+        int n = 8;
+        int[][] rows = new int[n + 1][];
+        for (int r = 0; r < n; r++) {
+            if (r == 0) {
+                rows[r] = new int[] {0, 1};
+            } else if (r == n - 1) {
+                rows[r] = new int[] {n - 2, n - 1};
+            } else {
+                rows[r] = new int[] {r - 1, r, r + 1};
+            }
+        }
+        rows[n] = new int[] {0, n - 1};
+
+        int[] colors = new int[n];
+        int colorCount = EquationDependencyGraph.colorStructurallyIndependentColumns(rows, n, colors);
+
+        assertTrue(colorCount <= 4, "colors=" + colorCount);
+        for (int[] row : rows) {
+            Set<Integer> seen = new LinkedHashSet<Integer>();
+            for (int c : row) {
+                assertTrue(seen.add(colors[c]), "row shares a color: " + Arrays.toString(row));
+            }
+        }
+    }
+
+    @Test
+    @DisplayName("independent rows collapse to the widest row's color count")
+    void testColumnColoringOfBlockDiagonalPattern() {
+        int[][] rows = {
+                {0, 1, 2},
+                {3, 4},
+                {5},
+                {6, 7, 8}
+        };
+        int[] colors = new int[9];
+
+        assertEquals(3, EquationDependencyGraph.colorStructurallyIndependentColumns(rows, 9, colors));
+        assertEquals(1, EquationDependencyGraph.colorStructurallyIndependentColumns(new int[][] {{0}, {1}}, 2, colors));
+        assertEquals(0, EquationDependencyGraph.colorStructurallyIndependentColumns(new int[0][], 0, colors));
+    }
+
     private static Set<String> setOf(String... values) {
         return new LinkedHashSet<String>(Arrays.asList(values));
     }
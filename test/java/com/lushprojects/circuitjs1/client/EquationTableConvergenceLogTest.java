@@ -0,0 +1,55 @@
+package com.lushprojects.circuitjs1.client;
+
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.parallel.ResourceLock;
+
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@ResourceLock("SFCRParser")
+@DisplayName("EquationTableElm — convergence failure events")
+class EquationTableConvergenceLogTest extends CircuitJavaSimTestBase {
+
+    private int savedConsoleLevel;
+
+    @BeforeEach
+    void quietConsole() {
+        savedConsoleLevel = SolverLog.getConsoleLevel();
+        SolverLog.setConsoleLevel(SolverLog.OFF);
+        SolverLog.setRecordLevel(SolverLog.DEBUG);
+        SolverLog.clear();
+    }
+
+    @AfterEach
+    void restoreConsole() {
+        SolverLog.setConsoleLevel(savedConsoleLevel);
+        SolverLog.clear();
+    }
+
+    @Test
+    @DisplayName("event names the table and gives t and dt")
+    void eventNamesTableAndTime() throws Exception {
+        loadCircuitText(TestFixtures.COUPLED_FIXED_POINT);
+        sim.equationTableAndersonAccelerationEnabled = false;
+        // the table needs more subiterations than this every step
+        sim.convergenceCheckThreshold = 2;
+        runSteps(1);
+
+        String event = null;
+        List<String> events = SolverLog.getRecentEvents(SolverLog.CAPACITY);
+        for (int i = 0; i < events.size() && event == null; i++) {
+            if (events.get(i).startsWith("Equation table convergence failure")) {
+                event = events.get(i);
+            }
+        }
+        assertNotNull(event, "events=" + events);
+        assertTrue(event.startsWith("Equation table convergence failure at t="), event);
+        assertTrue(event.contains(" dt=0.05: [Coupled] "), event);
+        assertTrue(event.contains(": diff="), event);
+    }
+}
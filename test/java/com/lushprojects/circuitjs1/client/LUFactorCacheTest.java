@@ -0,0 +1,187 @@
+package com.lushprojects.circuitjs1.client;
+
+import com.lushprojects.circuitjs1.client.core.CircuitMatrixOps;
+import com.lushprojects.circuitjs1.client.core.LUFactorCache;
+import com.lushprojects.circuitjs1.client.core.LUSolver;
+import com.lushprojects.circuitjs1.client.core.SolverMatrixState;
+import com.lushprojects.circuitjs1.client.elements.electronics.passives.ResistorElm;
+import com.lushprojects.circuitjs1.client.ui.EditInfo;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@DisplayName("LUFactorCache — reuse and low-rank updates of linear factorizations")
+class LUFactorCacheTest extends CircuitJavaSimTestBase {
+
+    private static SolverMatrixState state(double[][] m) {
+        int n = m.length;
+        SolverMatrixState sms = new SolverMatrixState();
+        sms.circuitMatrixSize = n;
+        sms.circuitPermute = new int[n];
+        sms.origMatrix = new double[n][];
+        sms.circuitMatrix = new double[n][];
+        for (int i = 0; i < n; i++) {
+            sms.origMatrix[i] = m[i].clone();
+            sms.circuitMatrix[i] = m[i].clone();
+        }
+        return sms;
+    }
+
+    private static double[] reference(double[][] m, double[] rhs) {
+        SolverMatrixState sms = state(m);
+        assertEquals(-1, LUSolver.factor(sms.circuitMatrix, m.length, sms.circuitPermute));
+        double[] b = rhs.clone();
+        LUSolver.solve(sms.circuitMatrix, m.length, sms.circuitPermute, b);
+        return b;
+    }
+
+    private static void assertSolves(SolverMatrixState sms, double[][] m, double[] rhs) {
+        double[] expected = reference(m, rhs);
+        double[] actual = rhs.clone();
+        CircuitMatrixOps.luSolve(sms, actual);
+        for (int i = 0; i < expected.length; i++) {
+            assertEquals(expected[i], actual[i], 1e-10 * Math.max(1, Math.abs(expected[i])), "row " + i);
+        }
+    }
+
+    // a conductance between nodes a and b added to a copy of m
+    private static double[][] withConductance(double[][] m, int a, int b, double g) {
+        double[][] changed = new double[m.length][];
+        for (int i = 0; i < m.length; i++) {
+            changed[i] = m[i].clone();
+        }
+        changed[a][a] += g;
+        changed[b][b] += g;
+        changed[a][b] -= g;
+        changed[b][a] -= g;
+        return changed;
+    }
+
+    @Test
+    @DisplayName("a few changed rows use a low-rank update; the original matrix is an exact hit")
+    void lowRankThenExactHit() {
+        int n = 48;
+        double[][] m = TestFixtures.randomMatrix(n, 11);
+        double[] rhs = new double[n];
+        for (int i = 0; i < n; i++) {
+            rhs[i] = Math.sin(i);
+        }
+        LUFactorCache cache = new LUFactorCache();
+
+        SolverMatrixState sms = state(m);
+        assertEquals(-1, cache.factor(sms));
+        assertEquals(1, cache.getMissCount());
+        assertSolves(sms, m, rhs);
+
+        // a component value edit restamps only the rows of its two nodes
+        double[][] changed = withConductance(m, 3, 17, 10);
+        sms = state(changed);
+        assertEquals(-1, cache.factor(sms));
+        assertEquals(1, cache.getLowRankHitCount());
+        assertEquals(1, cache.getMissCount());
+        assertNotNull(sms.lowRankUpdate);
+        assertEquals(2, sms.lowRankUpdate.getRank());
+        assertSolves(sms, changed, rhs);
+
+        sms = state(m);
+        assertEquals(-1, cache.factor(sms));
+        assertEquals(1, cache.getHitCount());
+        assertNull(sms.lowRankUpdate);
+        assertSolves(sms, m, rhs);
+    }
+
+    @Test
+    @DisplayName("small matrices and changes past the rank limit are factored afresh")
+    void thresholdsFallBackToFactor() {
+        // below LUFactorCache.LOW_RANK_MIN_SIZE
+        double[][] small = TestFixtures.randomMatrix(24, 7);
+        LUFactorCache cache = new LUFactorCache();
+        assertEquals(-1, cache.factor(state(small)));
+        SolverMatrixState sms = state(withConductance(small, 1, 2, 10));
+        assertEquals(-1, cache.factor(sms));
+        assertNull(sms.lowRankUpdate);
+
+        int n = 48;
+        double[][] m = TestFixtures.randomMatrix(n, 13);
+        assertEquals(-1, cache.factor(state(m)));
+        double[][] changed = withConductance(withConductance(m, 1, 2, 10), 5, 6, 10);
+        changed = withConductance(changed, 8, 9, 10);
+        sms = state(changed);
+        assertEquals(-1, cache.factor(sms));
+        assertNull(sms.lowRankUpdate);
+        assertEquals(0, cache.getLowRankHitCount());
+        assertEquals(4, cache.getMissCount());
+        double[] rhs = new double[n];
+        for (int i = 0; i < n; i++) {
+            rhs[i] = Math.cos(i);
+        }
+        assertSolves(sms, changed, rhs);
+    }
+
+    @Test
+    @DisplayName("a singular low-rank change falls back to a full factorization that reports it")
+    void singularChangeIsReported() {
+        int n = 40;
+        double[][] m = TestFixtures.randomMatrix(n, 5);
+        LUFactorCache cache = new LUFactorCache();
+        assertEquals(-1, cache.factor(state(m)));
+
+        double[][] singular = new double[n][];
+        for (int i = 0; i < n; i++) {
+            singular[i] = m[i].clone();
+        }
+        // a node left with nothing connected
+        singular[9] = new double[n];
+        SolverMatrixState sms = state(singular);
+        assertEquals(9, cache.factor(sms));
+        assertNull(sms.lowRankUpdate);
+        assertEquals(9, cache.factor(state(singular)));
+        assertEquals(3, cache.getMissCount());
+        assertEquals(0, cache.getHitCount());
+    }
+
+    @Test
+    @DisplayName("returning to an earlier timestep reuses its factorization")
+    void timestepToggleHitsCache() throws Exception {
+        loadCircuit("src/com/lushprojects/circuitjs1/public/circuits/economics/lrc.txt");
+        sim.preStampAndStampCircuit();
+        LUFactorCache cache = sim.getSolverMatrixState().factorCache;
+        int hits = cache.getHitCount();
+
+        double dt = sim.getTimingState().timeStep;
+        sim.getTimingState().timeStep = dt / 2;
+        sim.stampCircuit();
+        sim.getTimingState().timeStep = dt;
+        sim.stampCircuit();
+        assertEquals(hits + 1, cache.getHitCount());
+    }
+
+    @Test
+    @DisplayName("dragging a slider back to its old value reuses the old factorization")
+    void sliderReturnHitsCache() throws Exception {
+        loadCircuitText(TestFixtures.VOLTAGE_DIVIDER);
+        sim.preStampAndStampCircuit();
+        sim.analyzeFlag = false;
+        runSteps(1);
+        ResistorElm lower = (ResistorElm) sim.getElm(2);
+        LUFactorCache cache = sim.getSolverMatrixState().factorCache;
+        int hits = cache.getHitCount();
+
+        EditInfo ei = lower.getEditInfo(0);
+        ei.value = 3000;
+        assertTrue(sim.getCircuitAnalyzer().applyParameterEdit(lower, 0, ei));
+        runSteps(1);
+        assertEquals(7.5, lower.volts[0], 1e-9);
+
+        ei = lower.getEditInfo(0);
+        ei.value = 1000;
+        assertTrue(sim.getCircuitAnalyzer().applyParameterEdit(lower, 0, ei));
+        assertEquals(hits + 1, cache.getHitCount());
+        runSteps(1);
+        assertEquals(5.0, lower.volts[0], 1e-9);
+    }
+}
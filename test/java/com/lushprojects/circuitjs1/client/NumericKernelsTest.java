@@ -0,0 +1,101 @@
+package com.lushprojects.circuitjs1.client;
+
+import com.lushprojects.circuitjs1.client.core.LUSolver;
+import com.lushprojects.circuitjs1.client.core.NumericKernels;
+import com.lushprojects.circuitjs1.client.io.LookupTableRegistry;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.parallel.ResourceLock;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+
+@ResourceLock("ComputedValues")
+@DisplayName("NumericKernels — scalar kernels and the accelerated LU path")
+class NumericKernelsTest {
+
+    @AfterEach
+    void restoreScalar() {
+        NumericKernels.install(null);
+    }
+
+    private static double[] solve(double[][] matrix, double[] rhs) {
+        int n = rhs.length;
+        double[][] a = new double[n][];
+        for (int i = 0; i < n; i++) {
+            a[i] = matrix[i].clone();
+        }
+        int[] ipvt = new int[n];
+        assertEquals(-1, LUSolver.factor(a, n, ipvt));
+        double[] b = rhs.clone();
+        LUSolver.solve(a, n, ipvt, b);
+        return b;
+    }
+
+    @Test
+    @DisplayName("row-oriented factorization used with accelerated kernels solves the same systems")
+    void rightLookingMatchesCrout() {
+        int n = 40;
+        double[][] m = TestFixtures.randomMatrix(n, 7);
+        double[] rhs = new double[n];
+        for (int i = 0; i < n; i++) {
+            rhs[i] = i - 10;
+        }
+        double[] crout = solve(m, rhs);
+
+        NumericKernels.install(new NumericKernels() {
+            @Override
+            public boolean isAccelerated() {
+                return true;
+            }
+        });
+        double[] rowOriented = solve(m, rhs);
+
+        for (int i = 0; i < n; i++) {
+            assertEquals(crout[i], rowOriented[i], 1e-10 * Math.max(1, Math.abs(crout[i])));
+        }
+    }
+
+    @Test
+    @DisplayName("pairwise min/max halves an odd-length envelope and keeps the last sample")
+    void pairwiseMinMaxOddLength() {
+        double[] min = {1, 0, 5, 4, -2};
+        double[] max = {2, 3, 6, 7, 9};
+        int size = NumericKernels.get().pairwiseMinMax(min, max, 5);
+        assertEquals(3, size);
+        assertArrayEquals(new double[] {0, 4, -2}, Arrays.copyOf(min, 3), 0);
+        assertArrayEquals(new double[] {3, 7, 9}, Arrays.copyOf(max, 3), 0);
+    }
+
+    @Test
+    @DisplayName("batched lookup gives the same values as single lookups")
+    void batchedLookupMatchesSingle() {
+        LookupTableRegistry.clear();
+        ArrayList<Double> xs = new ArrayList<Double>(Arrays.asList(0.0, 1.0, 1.0, 3.0));
+        ArrayList<Double> ys = new ArrayList<Double>(Arrays.asList(10.0, 20.0, 25.0, 5.0));
+        LookupTableRegistry.registerGlobal("Curve", xs, ys);
+
+        double[] x = {-1, 0, 0.5, 1, 2, 3, 4, Double.NaN};
+        // a step at x=1 takes the right-hand value
+        assertEquals(15, LookupTableRegistry.evaluate("Curve", 0.5, true), 0);
+        assertEquals(25, LookupTableRegistry.evaluate("Curve", 1, true), 0);
+        assertEquals(15, LookupTableRegistry.evaluate("Curve", 2, true), 0);
+        assertEquals(10, LookupTableRegistry.evaluate("Curve", -1, true), 0);
+        assertEquals(0, LookupTableRegistry.evaluate("Curve", -1, false), 0);
+        assertEquals(5, LookupTableRegistry.evaluate("Curve", 4, true), 0);
+        assertEquals(-5, LookupTableRegistry.evaluate("Curve", 4, false), 0);
+        for (boolean clamp : new boolean[] {true, false}) {
+            double[] out = new double[x.length];
+            LookupTableRegistry.evaluateAll("Curve", x, out, x.length, clamp);
+            for (int i = 0; i < x.length; i++) {
+                assertEquals(LookupTableRegistry.evaluate("Curve", x[i], clamp), out[i], 0,
+                        "x=" + x[i] + " clamp=" + clamp);
+            }
+        }
+        LookupTableRegistry.clear();
+    }
+}
@@ -0,0 +1,117 @@
+package com.lushprojects.circuitjs1.client;
+
+import com.lushprojects.circuitjs1.client.elements.economics.EquationTableElm;
+import com.lushprojects.circuitjs1.client.elements.electronics.passives.ResistorElm;
+import com.lushprojects.circuitjs1.client.ui.EditInfo;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.parallel.ResourceLock;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@ResourceLock("SFCRParser")
+@DisplayName("Parameter-only slider edits patch the stamped matrix")
+class ParameterEditFastPathTest extends CircuitJavaSimTestBase {
+
+    private ResistorElm loadDivider() throws Exception {
+        loadCircuitText(TestFixtures.VOLTAGE_DIVIDER);
+        sim.preStampAndStampCircuit();
+        sim.analyzeFlag = false;
+        runSteps(1);
+        return (ResistorElm) sim.getElm(2);
+    }
+
+    private static double midVoltage(ResistorElm lower) {
+        return lower.volts[0];
+    }
+
+    @Test
+    @DisplayName("resistor slider updates the solution without re-analysis")
+    void resistorEditSkipsAnalysis() throws Exception {
+        ResistorElm lower = loadDivider();
+        assertEquals(5.0, midVoltage(lower), 1e-9);
+
+        EditInfo ei = lower.getEditInfo(0);
+        ei.value = 3000;
+        assertTrue(sim.getCircuitAnalyzer().applyParameterEdit(lower, 0, ei));
+        assertFalse(sim.analyzeFlag);
+        assertEquals(3000, lower.getResistance(), 0);
+
+        runSteps(1);
+        assertEquals(7.5, midVoltage(lower), 1e-9);
+    }
+
+    @Test
+    @DisplayName("patched matrix matches a full restamp")
+    void patchedMatrixMatchesRestamp() throws Exception {
+        ResistorElm lower = loadDivider();
+        EditInfo ei = lower.getEditInfo(0);
+        ei.value = 470;
+        assertTrue(sim.getCircuitAnalyzer().applyParameterEdit(lower, 0, ei));
+        double[][] patched = copy(sim.getSolverMatrixState().origMatrix);
+        double[] patchedRhs = sim.getSolverMatrixState().origRightSide.clone();
+
+        sim.preStampAndStampCircuit();
+        double[][] fresh = sim.getSolverMatrixState().origMatrix;
+        for (int i = 0; i < fresh.length; i++) {
+            for (int j = 0; j < fresh.length; j++)
+                assertEquals(fresh[i][j], patched[i][j], 1e-15);
+            assertEquals(sim.getSolverMatrixState().origRightSide[i], patchedRhs[i], 1e-12);
+        }
+    }
+
+    @Test
+    @DisplayName("edits without a parameter-only contract fall back to re-analysis")
+    void otherEditsRequestAnalysis() throws Exception {
+        loadDivider();
+        CircuitElm rail = sim.getElm(0);
+        EditInfo ei = rail.getEditInfo(0);
+        assertFalse(rail.isParameterOnlyEdit(0));
+        assertFalse(sim.getCircuitAnalyzer().applyParameterEdit(rail, 0, ei));
+        assertTrue(sim.analyzeFlag);
+    }
+
+    @Test
+    @DisplayName("an element outside the stamped circuit falls back to re-analysis")
+    void strayElementRequestsAnalysis() throws Exception {
+        loadDivider();
+        ResistorElm stray = new ResistorElm(0, 0);
+        EditInfo ei = stray.getEditInfo(0);
+        ei.value = 2000;
+        assertTrue(stray.isParameterOnlyEdit(0));
+        assertFalse(sim.getCircuitAnalyzer().applyParameterEdit(stray, 0, ei));
+        assertTrue(sim.analyzeFlag);
+    }
+
+    @Test
+    @DisplayName("a wheel edit of a numeric equation row goes through the parameter edit")
+    void equationRowValueEdit() throws Exception {
+        loadCircuitText(TWO_EQUATION_TABLES);
+        runSteps(2);
+        EquationTableElm demo = findEquationTable("Demo");
+        int item = EquationTableElm.ROW_VALUE_EDIT;
+        assertTrue(demo.isParameterOnlyEdit(item));
+        // Z ~ last(Y) + 2 is not a plain number
+        assertFalse(demo.isParameterOnlyEdit(item + 1));
+
+        EditInfo ei = demo.getEditInfo(item);
+        assertEquals(1, ei.value, 0);
+        ei.value = 4;
+        int version = demo.getContentVersion();
+        sim.getCircuitAnalyzer().applyParameterEdit(demo, item, ei);
+        assertTrue(demo.getContentVersion() > version);
+        assertEquals(4, demo.getEditInfo(item).value, 0);
+
+        runSteps(2);
+        assertEquals(4, getConverged("Y"), 1e-12);
+    }
+
+    private static double[][] copy(double[][] m) {
+        double[][] out = new double[m.length][];
+        for (int i = 0; i < m.length; i++)
+            out[i] = m[i].clone();
+        return out;
+    }
+}
@@ -0,0 +1,70 @@
+package com.lushprojects.circuitjs1.client;
+
+import com.lushprojects.circuitjs1.client.elements.economics.EquationTableElm;
+import com.lushprojects.circuitjs1.client.io.SFCRExporter;
+import com.lushprojects.circuitjs1.client.io.sfcr.SFCRBlankLineNormalizer;
+import com.lushprojects.circuitjs1.client.io.sfcr.SFCRExportCache;
+import com.lushprojects.circuitjs1.client.io.sfcr.SFCRTemplateMerger;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.parallel.ResourceLock;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@ResourceLock("SFCRParser")
+@DisplayName("Incremental SFCR export")
+class SFCRExportCacheTest extends CircuitJavaSimTestBase {
+
+    @Test
+    @DisplayName("unchanged tables are reused and edited ones regenerated")
+    void reusesUnchangedBlocks() throws Exception {
+        loadCircuitText(TWO_EQUATION_TABLES);
+        sim.getSFCRDocumentManager().setModelInfoSourceText(null);
+        SFCRExportCache cache = sim.getSFCRDocumentManager().getExportCache();
+        SFCRExporter exporter = new SFCRExporter(sim, SFCRExporter.ExportSyntax.BLOCK_FORMAT);
+
+        String first = exporter.export();
+        int hits = cache.getHitCount();
+        String second = exporter.export();
+        assertEquals(first, second);
+        assertEquals(hits + 2, cache.getHitCount(), "Both tables should come from the cache");
+
+        EquationTableElm demo = findEquationTable("Demo");
+        assertNotNull(demo);
+        demo.setEquation(1, "last(Y) + 5");
+        String third = exporter.export();
+        assertTrue(third.contains("last(Y) + 5"), third);
+        assertFalse(third.contains("last(Y) + 2"));
+        assertEquals(hits + 3, cache.getHitCount(), "Only the untouched table should be reused");
+
+        String rStyle = new SFCRExporter(sim, SFCRExporter.ExportSyntax.R_STYLE).export();
+        assertTrue(rStyle.contains("Demo <- sfcr_set("), "Syntax change must not reuse block-format text");
+    }
+
+    @Test
+    @DisplayName("streaming export matches the string export")
+    void streamingMatchesString() throws Exception {
+        loadCircuitText(TWO_EQUATION_TABLES);
+        StringBuilder out = new StringBuilder();
+        new SFCRExporter(sim).export(out);
+        assertEquals(new SFCRExporter(sim).export(), out.toString());
+    }
+
+    @Test
+    @DisplayName("blank-line normalizer gives the same result however the text is split")
+    void normalizerIsSplitIndependent() throws Exception {
+        String text = "# head\n\n\n\nA\n```{r}\nx\n\n\ny\n```\n\n\nB  \n   \n\n\n\n";
+        String expected = SFCRTemplateMerger.normalizeBlankLinesOutsideFences(text);
+        assertEquals("# head\n\nA\n```{r}\nx\n\n\ny\n```\n\nB  \n\n", expected);
+
+        StringBuilder out = new StringBuilder();
+        SFCRBlankLineNormalizer normalizer = new SFCRBlankLineNormalizer(out);
+        for (int i = 0; i < text.length(); i += 3)
+            normalizer.append(text, i, Math.min(text.length(), i + 3));
+        normalizer.finish();
+        assertEquals(expected, out.toString());
+    }
+}
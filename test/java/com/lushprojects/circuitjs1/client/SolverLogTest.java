@@ -0,0 +1,106 @@
+package com.lushprojects.circuitjs1.client;
+
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.parallel.ResourceLock;
+
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@ResourceLock("ComputedValues")
+@DisplayName("SolverLog — leveled, lazily formatted solver events")
+class SolverLogTest {
+
+    private int savedConsoleLevel;
+
+    @BeforeEach
+    void quietConsole() {
+        savedConsoleLevel = SolverLog.getConsoleLevel();
+        SolverLog.setConsoleLevel(SolverLog.OFF);
+        SolverLog.setRecordLevel(SolverLog.DEBUG);
+        SolverLog.clear();
+    }
+
+    @AfterEach
+    void restoreConsole() {
+        SolverLog.setConsoleLevel(savedConsoleLevel);
+        SolverLog.clear();
+    }
+
+    @Test
+    @DisplayName("templates are formatted only when read back")
+    void formatsPlaceholdersOnRead() {
+        SolverLog.log(SolverLog.DEBUG, "converged after {} iterations, timeStep = {}", 12, 0.5);
+        SolverLog.log(SolverLog.WARN, "row {@} diff={}", "Income", 1e-3, 0);
+
+        List<String> events = SolverLog.getRecentEvents(10);
+        assertEquals(2, events.size());
+        assertEquals("DEBUG: converged after 12 iterations, timeStep = 0.5", events.get(0));
+        assertEquals("WARN: row Income diff=0.001", events.get(1));
+    }
+
+    @Test
+    @DisplayName("a source is described with its part only when the event is read")
+    void describesSourceOnRead() {
+        final int[] described = new int[1];
+        SolverLog.Source table = new SolverLog.Source() {
+            public void appendLogDescription(StringBuilder sb, int part) {
+                described[0]++;
+                sb.append("[T] row").append(part);
+            }
+        };
+        SolverLog.log(SolverLog.INFO, "failure at t={} dt={}: {@}: diff={} limit={} last={} new={}",
+                table, 3, 2, 0.5, 1e-3, 1e-6, 4, 5);
+        assertEquals(0, described[0]);
+
+        List<String> events = SolverLog.getRecentEvents(1);
+        assertEquals(1, described[0]);
+        assertEquals("failure at t=2 dt=0.5: [T] row3: diff=0.001 limit=1.0E-6 last=4 new=5", events.get(0));
+    }
+
+    @Test
+    @DisplayName("ring buffer keeps only the most recent events, oldest first")
+    void ringBufferWrapsAround() {
+        int total = SolverLog.CAPACITY + 5;
+        for (int i = 0; i < total; i++) {
+            SolverLog.log(SolverLog.DEBUG, "event {}", i);
+        }
+
+        assertEquals(SolverLog.CAPACITY, SolverLog.getRecordedCount());
+        List<String> last = SolverLog.getRecentEvents(3);
+        assertEquals("DEBUG: event " + (total - 3), last.get(0));
+        assertEquals("DEBUG: event " + (total - 1), last.get(2));
+    }
+
+    @Test
+    @DisplayName("record level filters what the buffer keeps")
+    void recordLevelFiltersEvents() {
+        SolverLog.setRecordLevel(SolverLog.WARN);
+        try {
+            SolverLog.log(SolverLog.DEBUG, "ignored");
+            SolverLog.log(SolverLog.ERROR, "kept");
+            assertFalse(SolverLog.isLoggable(SolverLog.INFO));
+            assertTrue(SolverLog.isLoggable(SolverLog.ERROR));
+            assertFalse(SolverLog.isLoggable(SolverLog.OFF));
+        } finally {
+            SolverLog.setRecordLevel(SolverLog.DEBUG);
+        }
+        assertEquals(1, SolverLog.getRecordedCount());
+        assertEquals("ERROR: kept", SolverLog.getRecentEvents(1).get(0));
+    }
+
+    @Test
+    @DisplayName("level names parse case-insensitively with a fallback")
+    void parsesLevelNames() {
+        assertEquals(SolverLog.DEBUG, SolverLog.parseLevel("debug", SolverLog.INFO));
+        assertEquals(SolverLog.WARN, SolverLog.parseLevel(" Warning ", SolverLog.INFO));
+        assertEquals(SolverLog.OFF, SolverLog.parseLevel("OFF", SolverLog.INFO));
+        assertEquals(SolverLog.INFO, SolverLog.parseLevel("verbose", SolverLog.INFO));
+        assertEquals(SolverLog.INFO, SolverLog.parseLevel(null, SolverLog.INFO));
+    }
+}
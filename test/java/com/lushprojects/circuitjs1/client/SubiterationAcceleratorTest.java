@@ -0,0 +1,49 @@
+package com.lushprojects.circuitjs1.client;
+
+import com.lushprojects.circuitjs1.client.elements.economics.ComputedValues;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.parallel.ResourceLock;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@ResourceLock("SFCRParser")
+@DisplayName("SubiterationAccelerator — Anderson mixing in the simulation loop")
+class SubiterationAcceleratorTest extends CircuitJavaSimTestBase {
+
+    private static final int STEPS = 40;
+
+    // total subiterations over STEPS timesteps
+    private int run(boolean anderson) throws Exception {
+        ComputedValues.resetForTesting();
+        sim = new CirSim();
+        sim.getBootstrap().initRunner();
+        loadCircuitText(TestFixtures.COUPLED_FIXED_POINT);
+        sim.equationTableAndersonAccelerationEnabled = anderson;
+        int total = 0;
+        for (int i = 0; i < STEPS; i++) {
+            sim.getSimulationLoop().runCircuit(i == 0);
+            ComputedValues.commitConvergedValues();
+            total += sim.getSubIterations() + 1;
+        }
+        assertNull(sim.stopMessage);
+        return total;
+    }
+
+    @Test
+    @DisplayName("coupled equation table settles in fewer subiterations with the same result")
+    void reducesSubiterationsOnEquationTable() throws Exception {
+        int plain = run(false);
+        double plainA = getConverged("a");
+        double plainB = getConverged("b");
+
+        int accelerated = run(true);
+        assertEquals(plainA, getConverged("a"), 1e-3 * Math.max(1, Math.abs(plainA)));
+        assertEquals(plainB, getConverged("b"), 1e-3 * Math.max(1, Math.abs(plainB)));
+
+        assertTrue(plain > 5 * STEPS, "plain=" + plain);
+        assertTrue(accelerated < plain, "plain=" + plain + " accelerated=" + accelerated);
+    }
+}
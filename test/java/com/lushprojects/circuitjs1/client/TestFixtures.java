@@ -3,12 +3,58 @@ package com.lushprojects.circuitjs1.client;
 import java.io.ByteArrayOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
+import java.util.Random;
 
 final class TestFixtures {
 
+    // 10V rail -> R1 -> mid -> R2 -> ground; R2 is element 2
+    static final String VOLTAGE_DIVIDER = "$ 1 0.000005 10 50 5 50 5e-11\n"
+            + "R 480 256 400 256 0 0 40 10 0 0 0.5 V\n"
+            + "r 480 256 560 256 0 1000\n"
+            + "r 560 256 560 320 0 1000\n"
+            + "g 560 320 560 352 0 0\n";
+
+    // two param rows feeding each other, driven by t, so every timestep
+    // settles by a slowly contracting fixed-point iteration
+    static final String COUPLED_FIXED_POINT = "# Coupled fixed point\n"
+            + "```{circuit}\n"
+            + "@init\n"
+            + "  timestep: 0.05\n"
+            + "  autoAdjustTimestep: false\n"
+            + "  equationTableMnaMode: false\n"
+            + "  equationTableTolerance: 0.00001\n"
+            + "@end\n"
+            + "```\n"
+            + "\n"
+            + "```{r}\n"
+            + "@equations Coupled\n"
+            + "  a ~ 0.9 * b + sin(t) ; mode=param\n"
+            + "  b ~ 0.9 * a + 1 ; mode=param\n"
+            + "@end\n"
+            + "```\n";
+
     private TestFixtures() {
     }
 
+    /**
+     * Sparse-ish, diagonally weighted matrix like a circuit matrix, with a
+     * zero leading pivot so factoring has to exchange rows.
+     */
+    static double[][] randomMatrix(int n, long seed) {
+        Random r = new Random(seed);
+        double[][] a = new double[n][n];
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                a[i][j] = (i == j || r.nextInt(4) == 0) ? r.nextDouble() * 2 - 1 : 0;
+            }
+            a[i][i] += 3;
+        }
+        a[0][0] = 0;
+        a[0][1] = 1;
+        a[1][0] = 1;
+        return a;
+    }
+
     static String loadSfcr(String fileName) throws IOException {
         return loadResource("sfcr/" + fileName);
     }
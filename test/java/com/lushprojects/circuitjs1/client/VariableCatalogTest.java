@@ -0,0 +1,90 @@
+package com.lushprojects.circuitjs1.client;
+
+import com.lushprojects.circuitjs1.client.elements.economics.EquationTableElm;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.parallel.ResourceLock;
+
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertNull;
+import static org.junit.jupiter.api.Assertions.assertSame;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@ResourceLock("SFCRParser")
+@DisplayName("Indexed variable catalog")
+class VariableCatalogTest extends CircuitJavaSimTestBase {
+
+    private static final String SOURCE =
+            "@equations Demo x=200 y=120\n" +
+            "  Income ~ 10 ; mode=param\n" +
+            "  Interest ~ 0.05 * Income\n" +
+            "  Spending ~ Income - Interest\n" +
+            "@end\n";
+
+    private EquationTableElm findTable(String name) {
+        for (int i = 0; i < sim.elmList.size(); i++) {
+            CircuitElm ce = sim.elmList.get(i);
+            if (ce instanceof EquationTableElm && name.equals(((EquationTableElm) ce).getTableName()))
+                return (EquationTableElm) ce;
+        }
+        return null;
+    }
+
+    private static String names(List<VariableCatalog.VariableEntry> entries) {
+        StringBuilder sb = new StringBuilder();
+        for (VariableCatalog.VariableEntry e : entries)
+            sb.append(sb.length() == 0 ? "" : ",").append(e.name);
+        return sb.toString();
+    }
+
+    @Test
+    @DisplayName("equation outputs carry type and owner metadata")
+    void entriesCarryMetadata() throws Exception {
+        loadCircuitText(SOURCE);
+        VariableCatalog catalog = sim.getVariableCatalog();
+        EquationTableElm demo = findTable("Demo");
+        assertNotNull(demo);
+
+        VariableCatalog.VariableEntry income = catalog.get("Income");
+        assertNotNull(income);
+        assertEquals(VariableCatalog.TYPE_EQUATION, income.type);
+        assertSame(demo, income.getOwner());
+        assertFalse(income.isStock());
+        assertTrue(catalog.getNames().contains("Spending"));
+    }
+
+    @Test
+    @DisplayName("prefix and substring queries ignore case and stay sorted")
+    void indexedQueries() throws Exception {
+        loadCircuitText(SOURCE);
+        VariableCatalog catalog = sim.getVariableCatalog();
+
+        assertEquals("Income,Interest", names(catalog.findByPrefix("in")));
+        assertEquals("Interest", names(catalog.findContaining("TERE")));
+        assertEquals("Spending", names(catalog.findContaining("pen")));
+        assertTrue(catalog.findContaining("zzzz").isEmpty());
+    }
+
+    @Test
+    @DisplayName("renaming an output updates the index without reanalysis")
+    void renameUpdatesIncrementally() throws Exception {
+        loadCircuitText(SOURCE);
+        VariableCatalog catalog = sim.getVariableCatalog();
+        EquationTableElm demo = findTable("Demo");
+        int version = catalog.getVersion();
+        List<VariableCatalog.VariableEntry> before = catalog.getVariables();
+        assertSame(before, catalog.getVariables(), "Unchanged catalog should share its view");
+
+        demo.setOutputName(2, "Consumption");
+
+        assertTrue(catalog.getVersion() != version);
+        assertNull(catalog.get("Spending"));
+        assertNotNull(catalog.get("Consumption"));
+        assertEquals("Consumption", names(catalog.findContaining("sum")));
+        assertTrue(catalog.findContaining("spend").isEmpty());
+    }
+}
@@ -208,6 +208,46 @@ class ExprTest {
         assertEquals(6.0, expr.evalFresh(state), 1e-12);
     }
 
+    @Test
+    @DisplayName("step-invariant subtrees are tagged at parse time")
+    void testStepInvariantTagging() {
+        Expr mixed = parse("sin(t) * X + last(Y)");
+        Expr sinT = mixed.children.get(0).children.get(0);
+
+        assertFalse(mixed.isStepInvariantRoot());
+        assertTrue(sinT.isStepInvariantRoot());
+        assertTrue(mixed.children.get(1).isStepInvariantRoot(), "last(Y) should be cached");
+        assertTrue(parse("last(Y) * 2 + t").isStepInvariantRoot());
+        assertFalse(parse("lag(Y, 1)").isStepInvariantRoot());
+        assertFalse(parse("t").isStepInvariantRoot(), "bare leaves are not worth caching");
+    }
+
+    @Test
+    @DisplayName("invariant subtrees are evaluated once per timestep")
+    void testStepInvariantValueReusedWithinTimestep() {
+        LookupTableRegistry.clear();
+        java.util.ArrayList<Double> xs = new java.util.ArrayList<Double>();
+        java.util.ArrayList<Double> ys = new java.util.ArrayList<Double>();
+        xs.add(0.0); ys.add(0.0);
+        xs.add(2.0); ys.add(4.0);
+        LookupTableRegistry.registerGlobal("Demand", xs, ys);
+
+        Expr expr = parse("lookup(Demand, t) + _a");
+        ExprState state = new ExprState(0);
+        state.t = 1.5;
+        Expr.beginTimestep();
+        assertEquals(3.0, expr.evalFresh(state), 1e-12);
+
+        // same timestep: the lookup is not re-evaluated, the same-period slot is
+        ys.set(1, 8.0);
+        LookupTableRegistry.registerGlobal("Demand", xs, ys);
+        state.values[0] = 1.0;
+        assertEquals(4.0, expr.evalFresh(state), 1e-12);
+
+        Expr.beginTimestep();
+        assertEquals(7.0, expr.evalFresh(state), 1e-12);
+    }
+
     @Test
     @DisplayName("diff() uses committed previous input to compute derivative")
     void testDiffUsesCommittedPreviousInput() {
@@ -0,0 +1,93 @@
+package com.lushprojects.circuitjs1.client.elements.economics;
+
+import com.lushprojects.circuitjs1.client.CircuitJavaSimTestBase;
+import com.lushprojects.circuitjs1.client.elements.ExprState;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.parallel.ResourceLock;
+
+import java.util.ArrayList;
+import java.util.LinkedHashSet;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@ResourceLock("SFCRParser")
+@DisplayName("EquationTableJacobianHelper — colored finite differences")
+class EquationTableJacobianColoringTest extends CircuitJavaSimTestBase {
+
+    // four voltage rows on labeled nodes; a and d, and b and c, are never
+    // referenced by the same row, so the sweep needs two colors, not four
+    private static final String COUPLED_MNA_TABLE = "# Coupled MNA table\n"
+            + "```{circuit}\n"
+            + "@init\n"
+            + "  timestep: 1\n"
+            + "  autoAdjustTimestep: false\n"
+            + "  equationTableMnaMode: true\n"
+            + "  equationTableNewtonJacobianEnabled: true\n"
+            + "@end\n"
+            + "```\n"
+            + "\n"
+            + "```{r}\n"
+            + "@equations Coupled\n"
+            + "  a ~ 0.5 * b + 0.1 * c * c + 1\n"
+            + "  b ~ 0.3 * a * a + 2\n"
+            + "  c ~ sin(a) + 0.2 * d\n"
+            + "  d ~ 2 * b\n"
+            + "@end\n"
+            + "```\n";
+
+    private static EquationTableJacobianHelper.PendingRow pending(EquationTableElm table, int row) {
+        EquationTableElm.EquationRow rowData = table.getEquationRow(row);
+        assertNull(EquationTableJacobianHelper.getVoltageModeIneligibilityReason(table, rowData), rowData.outputName);
+        LinkedHashSet<String> refs = new LinkedHashSet<String>();
+        rowData.compiledExpr.collectSamePeriodRefs(refs);
+        ExprState state = rowData.exprState;
+        assertNotNull(state, rowData.outputName);
+        double fVal = rowData.compiledExpr.eval(state);
+        return new EquationTableJacobianHelper.PendingRow(row, rowData, rowData.compiledExpr, state, refs, fVal, 0);
+    }
+
+    @Test
+    @DisplayName("each entry matches a finite difference taken one reference at a time")
+    void coloredMatchesPerReference() throws Exception {
+        loadCircuitText(COUPLED_MNA_TABLE);
+        // Broyden rows would skip the sweep; compare plain finite differences
+        sim.equationTableBroydenJacobianEnabled = false;
+        runSteps(2);
+
+        EquationTableElm table = findEquationTable("Coupled");
+        assertNotNull(table);
+        ArrayList<EquationTableJacobianHelper.PendingRow> rows = new ArrayList<EquationTableJacobianHelper.PendingRow>();
+        for (int row = 0; row < table.getRowCount(); row++) {
+            rows.add(pending(table, row));
+        }
+        EquationTableJacobianHelper.ColoringCache cache = new EquationTableJacobianHelper.ColoringCache();
+        EquationTableJacobianHelper.prepareJacobians(rows, cache);
+        assertEquals(4, cache.getColumnCount());
+        assertEquals(2, cache.getColorCount());
+
+        int entries = 0;
+        for (int i = 0; i < rows.size(); i++) {
+            EquationTableJacobianHelper.PendingRow p = rows.get(i);
+            EquationTableJacobianHelper.JacobianComputation colored = p.jacobian;
+            EquationTableJacobianHelper.JacobianComputation single =
+                    EquationTableJacobianHelper.prepareSingleNodeJacobian(p.rowData, p.expr, p.state, p.refs, p.fVal);
+            String name = p.rowData.outputName;
+
+            assertEquals("finite-difference", colored.method, name);
+            assertTrue(colored.derivatives.length > 0, name);
+            assertArrayEquals(single.refNames, colored.refNames, name);
+            assertArrayEquals(single.labeledNodes, colored.labeledNodes, name);
+            // the other columns of a color are not read by this row, so
+            // every perturbed evaluation is the same as on its own
+            assertArrayEquals(single.derivatives, colored.derivatives, 0, name);
+            entries += colored.derivatives.length;
+        }
+        assertEquals(6, entries);
+        assertEquals(entries, cache.getLastEvaluationCount());
+    }
+}
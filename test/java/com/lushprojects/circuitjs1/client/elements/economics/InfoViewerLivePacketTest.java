@@ -0,0 +1,70 @@
+package com.lushprojects.circuitjs1.client.elements.economics;
+
+import com.lushprojects.circuitjs1.client.CircuitJavaSimTestBase;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.util.Arrays;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@DisplayName("Info viewer live packets")
+class InfoViewerLivePacketTest extends CircuitJavaSimTestBase {
+
+    private static final String FIXTURE =
+            "$ 1 0.000005 10.20027730826997 50 5 50 5e-11\n" +
+            "207 480 256 544 256 4 wages\n" +
+            "R 480 256 400 256 0 0 40 5 0 0 0.5 V\n";
+
+    private static int varIndex(String name) {
+        String[] names = ComputedValues.getComputedValueNames();
+        int index = 2; // t and dt come first
+        for (String n : names) {
+            if (n == null || n.isEmpty())
+                continue;
+            if (n.equals(name))
+                return index;
+            index++;
+        }
+        return -1;
+    }
+
+    @Test
+    @DisplayName("numbers travel in channels laid out in metadata order")
+    void valuesFollowMetadataOrder() throws Exception {
+        loadCircuitText(FIXTURE);
+        runSteps(2);
+        ComputedValues.setComputedValueDirect("gdp", 4.5);
+        ComputedValues.commitConvergedValues();
+
+        InfoViewerLivePacket packet = InfoViewerLiveDataSerializer.buildLivePacket(sim);
+
+        assertTrue(packet.metaJson.startsWith("{\"vars\":[\"t\",\"dt\""));
+        assertTrue(packet.metaJson.contains("\"gdp\""));
+        assertEquals(3, packet.clock.length);
+        assertEquals(sim.getTime(), packet.clock[0], 0);
+        assertEquals(sim.getTime(), packet.vars[0], 0);
+        assertEquals(4.5, packet.vars[varIndex("gdp")], 0);
+        assertEquals(0, packet.tables.length);
+        assertEquals("[]", packet.sankeysJson);
+    }
+
+    @Test
+    @DisplayName("metadata is unchanged when only values move")
+    void metadataStableAcrossValueChanges() throws Exception {
+        loadCircuitText(FIXTURE);
+        runSteps(1);
+        ComputedValues.setComputedValueDirect("gdp", 1.0);
+        ComputedValues.commitConvergedValues();
+        InfoViewerLivePacket first = InfoViewerLiveDataSerializer.buildLivePacket(sim);
+
+        ComputedValues.setComputedValueDirect("gdp", 2.0);
+        ComputedValues.commitConvergedValues();
+        InfoViewerLivePacket second = InfoViewerLiveDataSerializer.buildLivePacket(sim);
+
+        assertEquals(first.metaJson, second.metaJson);
+        assertEquals(2.0, second.vars[varIndex("gdp")], 0);
+        assertTrue(!Arrays.equals(first.vars, second.vars));
+    }
+}
@@ -0,0 +1,128 @@
+package com.lushprojects.circuitjs1.client.elements.economics;
+
+import com.lushprojects.circuitjs1.client.CircuitElm;
+import com.lushprojects.circuitjs1.client.CircuitJavaSimTestBase;
+import com.lushprojects.circuitjs1.client.registry.HintRegistry;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.parallel.ResourceLock;
+
+import java.util.ArrayList;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@ResourceLock("SFCRParser")
+@DisplayName("Info viewer table markdown cache")
+class InfoViewerTableMarkdownCacheTest extends CircuitJavaSimTestBase {
+
+    @Test
+    @DisplayName("running the simulation reuses table markdown, edits regenerate only that table")
+    void reusesUnchangedTables() throws Exception {
+        loadCircuitText(TWO_EQUATION_TABLES);
+        String first = InfoViewerTableMarkdown.generateCircuitTablesMarkdown();
+        runSteps(3);
+
+        int hits = InfoViewerTableMarkdown.getTableCacheHitCount();
+        int misses = InfoViewerTableMarkdown.getTableCacheMissCount();
+        assertEquals(first, InfoViewerTableMarkdown.generateCircuitTablesMarkdown());
+        assertEquals(hits + 2, InfoViewerTableMarkdown.getTableCacheHitCount());
+        assertEquals(misses, InfoViewerTableMarkdown.getTableCacheMissCount());
+
+        EquationTableElm demo = findEquationTable("Demo");
+        assertNotNull(demo);
+        demo.setEquation(1, "last(Y) + 5");
+        String edited = InfoViewerTableMarkdown.generateCircuitTablesMarkdown();
+        assertTrue(edited.contains("last(Y) + 5"), edited);
+        assertFalse(edited.contains("last(Y) + 2"));
+        assertEquals(hits + 3, InfoViewerTableMarkdown.getTableCacheHitCount());
+        assertEquals(misses + 1, InfoViewerTableMarkdown.getTableCacheMissCount());
+    }
+
+    @Test
+    @DisplayName("tables removed from the circuit are dropped from the cache")
+    void prunesDeletedTables() throws Exception {
+        loadCircuitText(TWO_EQUATION_TABLES);
+        InfoViewerTableMarkdown.generateCircuitTablesMarkdown();
+        assertEquals(2, InfoViewerTableMarkdown.getTableCacheSize());
+
+        EquationTableElm other = findEquationTable("Other");
+        assertNotNull(other);
+        sim.elmList.remove(other);
+        String md = InfoViewerTableMarkdown.generateCircuitTablesMarkdown();
+        assertTrue(md.contains("### Demo"), md);
+        assertFalse(md.contains("### Other"), md);
+        assertEquals(1, InfoViewerTableMarkdown.getTableCacheSize());
+    }
+
+    @Test
+    @DisplayName("a hint change regenerates every table")
+    void hintChangeInvalidatesTables() throws Exception {
+        loadCircuitText(TWO_EQUATION_TABLES);
+        InfoViewerTableMarkdown.generateCircuitTablesMarkdown();
+        int hits = InfoViewerTableMarkdown.getTableCacheHitCount();
+        int misses = InfoViewerTableMarkdown.getTableCacheMissCount();
+
+        HintRegistry.setHint("W", "three times Z");
+        try {
+            String md = InfoViewerTableMarkdown.generateCircuitTablesMarkdown();
+            assertTrue(md.contains("three times Z"), md);
+            assertEquals(hits, InfoViewerTableMarkdown.getTableCacheHitCount());
+            assertEquals(misses + 2, InfoViewerTableMarkdown.getTableCacheMissCount());
+
+            InfoViewerTableMarkdown.generateCircuitTablesMarkdown();
+            assertEquals(hits + 2, InfoViewerTableMarkdown.getTableCacheHitCount());
+        } finally {
+            HintRegistry.removeHint("W");
+        }
+    }
+
+    @Test
+    @DisplayName("a transaction matrix rebuilt from edited master tables regenerates")
+    void masterEditRegeneratesTransactionMatrix() throws Exception {
+        loadCircuit("src/com/lushprojects/circuitjs1/public/circuits/economics/1dbg_CTM&GodleyTest.txt");
+        runSteps(1);
+        CurrentTransactionsMatrixElm ctm = null;
+        ArrayList<TableElm> masters = new ArrayList<TableElm>();
+        for (int i = 0; i < sim.elmList.size(); i++) {
+            CircuitElm ce = sim.elmList.get(i);
+            if (ce instanceof CurrentTransactionsMatrixElm) {
+                ctm = (CurrentTransactionsMatrixElm) ce;
+            } else if (ce instanceof TableElm) {
+                masters.add((TableElm) ce);
+            }
+        }
+        assertNotNull(ctm);
+        ctm.reset();
+        String before = matrixSection(InfoViewerTableMarkdown.generateCircuitTablesMarkdown());
+        assertTrue(before.contains("Flow"), before);
+        assertFalse(before.contains("17"), before);
+
+        for (TableElm master : masters) {
+            for (int col = 0; col < master.getCols(); col++) {
+                if (master.getColumn(col).isALE()) {
+                    continue;
+                }
+                for (int row = 0; row < master.getRows(); row++) {
+                    String eq = master.getCellEquation(row, col);
+                    if (eq != null && !eq.trim().isEmpty()) {
+                        master.setCellEquation(row, col, "17*ten");
+                    }
+                }
+            }
+        }
+        // the matrix copies its cells from the masters when it is reset
+        ctm.reset();
+        String after = matrixSection(InfoViewerTableMarkdown.generateCircuitTablesMarkdown());
+        assertTrue(after.contains("17"), after);
+    }
+
+    private static String matrixSection(String md) {
+        int start = md.indexOf("## Current Transactions Matrices");
+        assertTrue(start >= 0, md);
+        int end = md.indexOf("\n## ", start + 1);
+        return end < 0 ? md.substring(start) : md.substring(start, end);
+    }
+}
@@ -0,0 +1,82 @@
+package com.lushprojects.circuitjs1.client.io;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("Compact binary circuit dump codec")
+class CompactCircuitCodecTest {
+
+    private static final String[] SAMPLES = {
+        "",
+        "\n",
+        "$ 1 5.0E-6 10.20027730826997 50 5 50 5e-11\n",
+        "r 176 80 384 80 0 100\nw 384 80 448 80 0\n",
+        "no trailing newline",
+        "double  space and trailing space \n\n\nblank lines",
+        "-0 007 -12 123456789 99999999 -99999999 0 -1",
+        "% lookup demand 0,1 10,2.5 scope=Main\n! 1 0 0 A,B \\u03b1\u03b2\u03b3 \u2211\n",
+        "crlf line\r\nnext\r\n",
+    };
+
+    @Test
+    @DisplayName("round trips exactly with and without compression")
+    void roundTripsSamples() {
+        for (String sample : SAMPLES) {
+            assertEquals(sample, CompactCircuitCodec.decode(CompactCircuitCodec.encode(sample, false)));
+            assertEquals(sample, CompactCircuitCodec.decode(CompactCircuitCodec.encode(sample, true)));
+            assertEquals(sample, CompactCircuitCodec.decodeFromBase64Url(CompactCircuitCodec.encodeToBase64Url(sample)));
+        }
+    }
+
+    @Test
+    @DisplayName("base64url output is URL safe")
+    void base64UrlIsUrlSafe() {
+        String encoded = CompactCircuitCodec.encodeToBase64Url(SAMPLES[3] + SAMPLES[7]);
+        for (int i = 0; i < encoded.length(); i++) {
+            char c = encoded.charAt(i);
+            assertTrue(Character.isLetterOrDigit(c) || c == '-' || c == '_', "Unexpected character: " + c);
+        }
+    }
+
+    @Test
+    @DisplayName("storage helpers pass plain text through unchanged")
+    void storageHelpersAcceptPlainText() {
+        String plain = SAMPLES[3];
+        assertEquals(plain, CompactCircuitCodec.decodeFromStorage(plain));
+        String stored = CompactCircuitCodec.encodeForStorage(plain);
+        assertTrue(CompactCircuitCodec.isStorageEncoded(stored));
+        assertFalse(CompactCircuitCodec.isStorageEncoded(plain));
+        assertEquals(plain, CompactCircuitCodec.decodeFromStorage(stored));
+    }
+
+    @Test
+    @DisplayName("example circuit shrinks and round trips")
+    void exampleCircuitShrinks() throws Exception {
+        Path path = Paths.get(System.getProperty("projectDir"),
+                "src/com/lushprojects/circuitjs1/public/circuits/economics/econ_Goodwin_Predator_Prey.txt");
+        String text = new String(Files.readAllBytes(path), StandardCharsets.UTF_8);
+        byte[] compact = CompactCircuitCodec.encode(text, true);
+        assertEquals(text, CompactCircuitCodec.decode(compact));
+        assertTrue(compact.length < text.length(), "Compact form should be smaller than the text dump");
+    }
+
+    @Test
+    @DisplayName("rejects corrupt input")
+    void rejectsCorruptInput() {
+        byte[] data = CompactCircuitCodec.encode(SAMPLES[3], true);
+        byte[] truncated = new byte[data.length - 3];
+        System.arraycopy(data, 0, truncated, 0, truncated.length);
+        assertThrows(IllegalArgumentException.class, () -> CompactCircuitCodec.decode(truncated));
+        assertThrows(IllegalArgumentException.class, () -> CompactCircuitCodec.decode("plain".getBytes(StandardCharsets.UTF_8)));
+    }
+}
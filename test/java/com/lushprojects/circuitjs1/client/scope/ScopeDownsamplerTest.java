@@ -0,0 +1,94 @@
+package com.lushprojects.circuitjs1.client.scope;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("Scope viewer downsampling")
+class ScopeDownsamplerTest {
+
+    private static ScopeTraceSnapshot sineWithSpike(int n, int spikeAt) {
+        double[] time = new double[n];
+        double[] min = new double[n];
+        double[] max = new double[n];
+        for (int i = 0; i < n; i++) {
+            time[i] = i / 1000.0;
+            double v = Math.sin(i * 0.01);
+            min[i] = v - 0.01;
+            max[i] = v + 0.01;
+        }
+        min[spikeAt] = 6;
+        max[spikeAt] = 8;
+        return new ScopeTraceSnapshot("v", "V", "#fff", time, min, max);
+    }
+
+    @Test
+    @DisplayName("LTTB keeps both endpoints, hits the point budget and the spike")
+    void lttbKeepsEndpointsAndSpike() {
+        ScopeTraceSnapshot full = sineWithSpike(10000, 4321);
+        int[] idx = ScopeDownsampler.lttb(full.time, full.values, 0, full.size(), 500);
+
+        assertEquals(500, idx.length);
+        assertEquals(0, idx[0]);
+        assertEquals(9999, idx[idx.length - 1]);
+        boolean sawSpike = false;
+        for (int i = 1; i < idx.length; i++) {
+            assertTrue(idx[i] > idx[i - 1]);
+            sawSpike |= idx[i] == 4321;
+        }
+        assertTrue(sawSpike);
+    }
+
+    @Test
+    @DisplayName("min/max envelope preserves the extremes of every bucket")
+    void envelopePreservesExtremes() {
+        ScopeTraceSnapshot full = sineWithSpike(10000, 777);
+        ScopeTraceSnapshot reduced = full.window(Double.NEGATIVE_INFINITY, Double.POSITIVE_INFINITY,
+                400, ScopeDownsampler.MODE_MINMAX);
+
+        assertEquals(400, reduced.size());
+        double expectedLo = Double.POSITIVE_INFINITY;
+        for (int i = 0; i < full.size(); i++)
+            expectedLo = Math.min(expectedLo, full.minValues[i]);
+        double lo = Double.POSITIVE_INFINITY;
+        double hi = Double.NEGATIVE_INFINITY;
+        for (int i = 0; i < reduced.size(); i++) {
+            lo = Math.min(lo, reduced.values[i]);
+            hi = Math.max(hi, reduced.values[i]);
+            if (i > 0)
+                assertTrue(reduced.time[i] >= reduced.time[i - 1]);
+        }
+        assertEquals(expectedLo, lo, 0);
+        assertEquals(8, hi, 0);
+    }
+
+    @Test
+    @DisplayName("zoom windows cover the range plus one sample each side")
+    void windowCoversRequestedRange() {
+        ScopeTraceSnapshot full = sineWithSpike(10000, 10);
+        ScopeTraceSnapshot w = full.window(2.0, 2.5, 2000, ScopeDownsampler.MODE_LTTB);
+
+        // 501 samples lie in [2.0, 2.5]; that fits the budget so nothing is dropped
+        assertEquals(503, w.size());
+        assertEquals(1.999, w.time[0], 1e-12);
+        assertEquals(2.501, w.time[w.size() - 1], 1e-12);
+
+        ScopeTraceSnapshot coarse = full.window(2.0, 2.5, 100, ScopeDownsampler.MODE_LTTB);
+        assertEquals(100, coarse.size());
+        assertEquals(1.999, coarse.time[0], 1e-12);
+    }
+
+    @Test
+    @DisplayName("point budget of zero or mode none returns every sample")
+    void noneModeReturnsFullResolution() {
+        ScopeTraceSnapshot full = sineWithSpike(3000, 5);
+        assertEquals(3000, full.window(Double.NEGATIVE_INFINITY, Double.POSITIVE_INFINITY, 0,
+                ScopeDownsampler.MODE_LTTB).size());
+        assertEquals(3000, full.window(Double.NEGATIVE_INFINITY, Double.POSITIVE_INFINITY, 100,
+                ScopeDownsampler.parseMode("none")).size());
+        assertEquals(ScopeDownsampler.MODE_MINMAX, ScopeDownsampler.parseMode(" MinMax "));
+        assertEquals(ScopeDownsampler.MODE_LTTB, ScopeDownsampler.parseMode(null));
+    }
+}
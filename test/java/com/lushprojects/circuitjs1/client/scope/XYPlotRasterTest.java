@@ -0,0 +1,81 @@
+package com.lushprojects.circuitjs1.client.scope;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("XY plot raster")
+class XYPlotRasterTest {
+
+    @Test
+    @DisplayName("segments light every pixel between their endpoints")
+    void rasterizesContinuousLines() {
+        XYPlotRaster r = new XYPlotRaster(40, 20);
+        r.lineTo(2, 3);
+        assertEquals(0, r.getIntensity(2, 3), "first point only moves the pen");
+        r.lineTo(30, 15);
+
+        assertEquals(XYPlotRaster.MAX_INTENSITY, r.getIntensity(2, 3));
+        assertEquals(XYPlotRaster.MAX_INTENSITY, r.getIntensity(30, 15));
+        for (int x = 2; x <= 30; x++) {
+            int lit = 0;
+            for (int y = 0; y < 20; y++)
+                if (r.getIntensity(x, y) > 0)
+                    lit++;
+            assertTrue(lit >= 1, "gap in column " + x);
+        }
+        assertTrue(r.isDirty());
+        assertEquals(2, r.getDirtyMinX());
+        assertEquals(15, r.getDirtyMaxY());
+    }
+
+    @Test
+    @DisplayName("periodic decay fades traces to nothing")
+    void decayFadesToZero() {
+        XYPlotRaster r = new XYPlotRaster(10, 10);
+        r.lineTo(0, 5);
+        r.lineTo(9, 5);
+        r.clearDirty();
+
+        assertFalse(r.frame());
+        assertFalse(r.frame());
+        assertTrue(r.frame());
+        int once = r.getIntensity(4, 5);
+        assertTrue(once < XYPlotRaster.MAX_INTENSITY && once > XYPlotRaster.MAX_INTENSITY * 9 / 10);
+        assertTrue(r.isDirty());
+
+        for (int i = 0; i < 2000; i++)
+            r.decay();
+        assertEquals(0, r.getIntensity(4, 5));
+    }
+
+    @Test
+    @DisplayName("far off-screen points are clipped, not walked")
+    void clipsOffscreenSegments() {
+        XYPlotRaster r = new XYPlotRaster(20, 20);
+        r.lineTo(-1000000000, 10);
+        r.lineTo(1000000000, 10);
+        assertEquals(XYPlotRaster.MAX_INTENSITY, r.getIntensity(0, 10));
+        assertEquals(XYPlotRaster.MAX_INTENSITY, r.getIntensity(19, 10));
+
+        r.clear();
+        r.clearDirty();
+        r.lineTo(-50, -50);
+        r.lineTo(-10, -40);
+        assertFalse(r.isDirty());
+    }
+
+    @Test
+    @DisplayName("ARGB export blends background to foreground by intensity")
+    void exportsArgb() {
+        XYPlotRaster r = new XYPlotRaster(4, 1);
+        r.lineTo(0, 0);
+        r.lineTo(1, 0);
+        int[] argb = r.toArgb(0x202020, 0xffffff);
+        assertEquals(0xffffffff, argb[0]);
+        assertEquals(0xff202020, argb[3]);
+    }
+}
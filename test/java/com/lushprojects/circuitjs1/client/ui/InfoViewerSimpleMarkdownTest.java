@@ -0,0 +1,44 @@
+package com.lushprojects.circuitjs1.client.ui;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@DisplayName("Fallback markdown block cache")
+class InfoViewerSimpleMarkdownTest {
+
+    private static final String DOC =
+            "# Title\n" +
+            "\n" +
+            "Intro with **bold** text\n" +
+            "\n" +
+            "- one\n" +
+            "\n" +
+            "- two\n" +
+            "Closing line\n" +
+            "\n" +
+            "```\n" +
+            "a < b\n" +
+            "\n" +
+            "```\n";
+
+    @Test
+    @DisplayName("cached blocks give the same HTML and only edited blocks re-render")
+    void onlyEditedBlocksRerender() {
+        InfoViewerSimpleMarkdown.clearCache();
+        String first = InfoViewerSimpleMarkdown.convert(DOC);
+        // the blank line inside the list and the fence keeps those blocks whole
+        assertTrue(first.contains("<ul><li>one</li><br><li>two</li></ul><p>Closing line</p>"), first);
+        assertTrue(first.contains("a &lt; b\\n\\n</pre>"), first);
+        int misses = InfoViewerSimpleMarkdown.getCacheMissCount();
+
+        assertEquals(first, InfoViewerSimpleMarkdown.convert(DOC));
+        assertEquals(misses, InfoViewerSimpleMarkdown.getCacheMissCount());
+
+        String edited = InfoViewerSimpleMarkdown.convert(DOC.replace("Intro with", "Intro without"));
+        assertTrue(edited.contains("Intro without"));
+        assertEquals(misses + 1, InfoViewerSimpleMarkdown.getCacheMissCount());
+    }
+}
@@ -0,0 +1,48 @@
+package com.lushprojects.circuitjs1.client.util;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertNull;
+
+@DisplayName("FormattedValueCache keyed lookups")
+class FormattedValueCacheTest {
+
+    @Test
+    @DisplayName("hits only when value, unit and precision all match")
+    void hitsOnlyOnFullKeyMatch() {
+        FormattedValueCache cache = new FormattedValueCache(64);
+        cache.put(1.5, "V", 3, "1.5 V");
+
+        assertEquals("1.5 V", cache.get(1.5, "V", 3));
+        assertNull(cache.get(1.5, "A", 3));
+        assertNull(cache.get(1.5, "V", 2));
+        assertNull(cache.get(1.25, "V", 3));
+        assertEquals(1, cache.getHitCount());
+    }
+
+    @Test
+    @DisplayName("colliding keys replace each other and clear empties the cache")
+    void collisionsReplaceAndClearEmpties() {
+        FormattedValueCache cache = new FormattedValueCache(1);
+        for (int i = 0; i < 100; i++) {
+            cache.put(i * 0.37, "$", 1, "v" + i);
+            assertEquals("v" + i, cache.get(i * 0.37, "$", 1));
+        }
+        cache.clear();
+        assertNull(cache.get(99 * 0.37, "$", 1));
+    }
+
+    @Test
+    @DisplayName("NaN and huge values are formatted without hitting stale entries")
+    void nanAndHugeValues() {
+        FormattedValueCache cache = new FormattedValueCache(16);
+        cache.put(Double.NaN, "", 0, "NaN");
+        assertNull(cache.get(Double.NaN, "", 0));
+
+        cache.put(1e300, "", 0, "big");
+        cache.put(-1e300, "", 0, "small");
+        assertEquals("small", cache.get(-1e300, "", 0));
+    }
+}
@@ -0,0 +1,65 @@
+package com.lushprojects.circuitjs1.client.util;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@DisplayName("PagedMemory word storage")
+class PagedMemoryTest {
+
+    @Test
+    @DisplayName("unwritten words read as zero and writes are tracked")
+    void readsAndWrites() {
+        PagedMemory mem = new PagedMemory(16);
+        assertEquals(0, mem.get(1234));
+        assertFalse(mem.isWritten(1234));
+
+        mem.put(1234, 0);
+        assertTrue(mem.isWritten(1234), "Writing zero should still mark the word");
+        mem.put(65535, 42);
+        assertEquals(42, mem.get(65535));
+
+        mem.put(65536, 7);
+        mem.put(-1, 7);
+        assertEquals(0, mem.get(65536), "Out-of-range writes are ignored");
+    }
+
+    @Test
+    @DisplayName("nextWritten walks runs across pages and skips empty ones")
+    void nextWrittenSkipsGaps() {
+        PagedMemory mem = new PagedMemory(16);
+        mem.put(3, 1);
+        mem.put(4, 2);
+        mem.put(300, 3);
+        mem.put(40000, 4);
+
+        assertEquals(3, mem.nextWritten(0, 65536));
+        assertEquals(4, mem.nextWritten(4, 65536));
+        assertEquals(300, mem.nextWritten(5, 65536));
+        assertEquals(40000, mem.nextWritten(301, 65536));
+        assertEquals(-1, mem.nextWritten(40001, 65536));
+        assertEquals(-1, mem.nextWritten(301, 40000), "Limit is exclusive");
+    }
+
+    @Test
+    @DisplayName("bulk load stores every word; clear empties everything")
+    void bulkLoadRoundTrip() {
+        PagedMemory mem = new PagedMemory(12);
+        int[] image = new int[1000];
+        for (int i = 0; i < image.length; i++)
+            image[i] = (i * 37) & 0xff;
+        mem.load(100, image, 0, image.length);
+
+        for (int i = 0; i < image.length; i++)
+            assertEquals(image[i], mem.get(100 + i));
+        assertEquals(100, mem.nextWritten(0, mem.getCapacity()));
+        assertEquals(-1, mem.nextWritten(100 + image.length, mem.getCapacity()));
+
+        mem.clear();
+        assertEquals(-1, mem.nextWritten(0, mem.getCapacity()));
+        assertEquals(0, mem.get(500));
+    }
+}
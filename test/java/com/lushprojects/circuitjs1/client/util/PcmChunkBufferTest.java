@@ -0,0 +1,163 @@
+package com.lushprojects.circuitjs1.client.util;
+
+import com.lushprojects.circuitjs1.client.runner.WavFileWriter;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@DisplayName("Streaming audio resampling and PCM chunk encoding")
+class PcmChunkBufferTest {
+
+    private static List<Double> resample(AudioResampler r, double... timeValuePairs) {
+        final List<Double> out = new ArrayList<Double>();
+        AudioResampler.Sink sink = new AudioResampler.Sink() {
+            public void writeSample(double v) {
+                out.add(v);
+            }
+        };
+        for (int i = 0; i < timeValuePairs.length; i += 2)
+            r.addSample(timeValuePairs[i], timeValuePairs[i + 1], sink);
+        return out;
+    }
+
+    private static void writeAlternating(PcmChunkBuffer buf, int count) {
+        for (int i = 0; i < count; i++)
+            buf.writeSample(i % 2 == 0 ? -1 : 1);
+    }
+
+    @Test
+    @DisplayName("averaging emits one sample per period crossed")
+    void averagingResampler() {
+        AudioResampler r = new AudioResampler(10, false);
+        r.reset(0);
+        List<Double> out = resample(r, .05, 1, .1, 3, .35, 5);
+        assertEquals(3, out.size());
+        assertEquals(2, out.get(0), 1e-12);
+        assertEquals(5, out.get(1), 1e-12);
+        assertEquals(5, out.get(2), 1e-12);
+    }
+
+    @Test
+    @DisplayName("interpolation samples at the exact audio instants")
+    void interpolatingResampler() {
+        AudioResampler r = new AudioResampler(10, true);
+        r.reset(0);
+        List<Double> out = resample(r, 0, 0, .25, 2.5);
+        assertEquals(2, out.size());
+        assertEquals(1, out.get(0), 1e-9);
+        assertEquals(2, out.get(1), 1e-9);
+    }
+
+    @Test
+    @DisplayName("ring keeps only the most recent capacity samples")
+    void boundedWindow() {
+        PcmChunkBuffer buf = new PcmChunkBuffer(10, 4);
+        writeAlternating(buf, 14);
+        assertEquals(10, buf.getSampleCount());
+        assertTrue(buf.isFull());
+
+        short[][] parts = buf.snapshot(0);
+        int total = 0;
+        for (short[] p : parts)
+            total += p.length;
+        assertEquals(10, total);
+        assertEquals(-8191, parts[0][0], "Window starts at sample 4");
+        assertEquals(8191, parts[parts.length - 1][1]);
+    }
+
+    @Test
+    @DisplayName("chunks encoded before the level settled are re-encoded at play time")
+    void reencodesStaleChunks() {
+        PcmChunkBuffer buf = new PcmChunkBuffer(8, 4);
+        for (int i = 0; i < 4; i++)
+            buf.writeSample(i % 2 == 0 ? -.5 : .5);
+        writeAlternating(buf, 4);
+
+        short[][] parts = buf.snapshot(0);
+        assertEquals(2, parts.length);
+        assertEquals(-4095, parts[0][0]);
+        assertEquals(4095, parts[0][1]);
+        assertEquals(8191, parts[1][1]);
+    }
+
+    @Test
+    @DisplayName("fade ramps the first and last samples")
+    void fadeInAndOut() {
+        PcmChunkBuffer buf = new PcmChunkBuffer(100, 16);
+        writeAlternating(buf, 100);
+        short[][] parts = buf.snapshot(10);
+
+        short[] flat = new short[100];
+        int pos = 0;
+        for (short[] p : parts) {
+            System.arraycopy(p, 0, flat, pos, p.length);
+            pos += p.length;
+        }
+        assertEquals(0, flat[0]);
+        assertEquals(4095, flat[5]);
+        assertEquals(-8191, flat[50]);
+        assertEquals(819, flat[99]);
+
+        short[][] again = buf.snapshot(0);
+        assertEquals(-8191, again[0][0], "Fading must not touch the ring's own chunks");
+    }
+
+    @Test
+    @DisplayName("listener sees every chunk, including the final partial one")
+    void streamsEveryChunk() {
+        final int[] received = new int[2];
+        PcmChunkBuffer buf = new PcmChunkBuffer(8, 4);
+        buf.setChunkListener(new PcmChunkBuffer.ChunkListener() {
+            public void chunkFilled(double[] samples, int length) {
+                received[0]++;
+                received[1] += length;
+            }
+        });
+        writeAlternating(buf, 22);
+        buf.finish();
+        assertEquals(6, received[0]);
+        assertEquals(22, received[1]);
+    }
+
+    @Test
+    @DisplayName("streamed WAV holds every raw sample and patches the sizes on close")
+    void wavStreamsRawSamples() throws Exception {
+        Path wav = Files.createTempFile("pcm-stream-", ".wav");
+        try {
+            PcmChunkBuffer buf = new PcmChunkBuffer(8, 4);
+            WavFileWriter writer = new WavFileWriter(wav.toString(), 8000);
+            buf.setChunkListener(writer);
+            // a quiet ramp across the first two chunks, then a loud partial chunk
+            for (int i = 0; i < 8; i++)
+                buf.writeSample(.01 * i);
+            buf.writeSample(-3);
+            buf.writeSample(3);
+            buf.writeSample(-3);
+            buf.finish();
+            writer.close();
+
+            ByteBuffer bytes = ByteBuffer.wrap(Files.readAllBytes(wav)).order(ByteOrder.LITTLE_ENDIAN);
+            assertEquals(58 + 11 * 4, bytes.capacity());
+            assertEquals(bytes.capacity() - 8, bytes.getInt(4), "RIFF size");
+            assertEquals(3, bytes.getShort(20), "IEEE float format");
+            assertEquals(11, bytes.getInt(46), "fact sample count");
+            assertEquals(11 * 4, bytes.getInt(54), "data size");
+            for (int i = 0; i < 8; i++)
+                assertEquals((float) (.01 * i), bytes.getFloat(58 + 4 * i), "sample " + i);
+            assertEquals(-3f, bytes.getFloat(58 + 4 * 8));
+            assertEquals(3f, bytes.getFloat(58 + 4 * 9));
+            assertEquals(-3f, bytes.getFloat(58 + 4 * 10));
+        } finally {
+            Files.deleteIfExists(wav);
+        }
+    }
+}